@@ -0,0 +1,80 @@
+﻿//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.IO;
+
+namespace zuki.data.sqlite.benchmark
+{
+	/// <summary>
+	/// Loads, saves and compares against a stored set of benchmark results
+	/// </summary>
+	/// <remarks>
+	/// The baseline file is plain text with one tab-separated line per benchmark
+	/// (name, nanoseconds per operation, bytes per operation) so that it diffs
+	/// nicely when it's updated along with a change that moves the numbers
+	/// </remarks>
+	internal static class Baseline
+	{
+		/// <summary>
+		/// Loads a baseline file
+		/// </summary>
+		/// <param name="path">Path to the baseline file</param>
+		public static Dictionary<string, BenchmarkResult> Load(string path)
+		{
+			var results = new Dictionary<string, BenchmarkResult>(StringComparer.Ordinal);
+
+			foreach(string line in File.ReadAllLines(path))
+			{
+				if((line.Length == 0) || (line[0] == '#')) continue;
+
+				string[] fields = line.Split('\t');
+				if(fields.Length != 3) throw new InvalidDataException("Invalid baseline entry: " + line);
+
+				results[fields[0]] = new BenchmarkResult(fields[0], double.Parse(fields[1], CultureInfo.InvariantCulture),
+					double.Parse(fields[2], CultureInfo.InvariantCulture));
+			}
+
+			return results;
+		}
+
+		/// <summary>
+		/// Saves a set of results as a baseline file
+		/// </summary>
+		/// <param name="path">Path to the baseline file</param>
+		/// <param name="results">Results to be saved</param>
+		public static void Save(string path, IEnumerable<BenchmarkResult> results)
+		{
+			using(StreamWriter writer = new StreamWriter(path))
+			{
+				writer.WriteLine("# {0} {1} {2}", Environment.MachineName, Environment.Is64BitProcess ? "x64" : "x86",
+					DateTime.UtcNow.ToString("u", CultureInfo.InvariantCulture));
+
+				foreach(BenchmarkResult result in results)
+					writer.WriteLine(string.Format(CultureInfo.InvariantCulture, "{0}\t{1:F1}\t{2:F1}", result.Name,
+						result.NanosecondsPerOperation, result.BytesPerOperation));
+			}
+		}
+	}
+}
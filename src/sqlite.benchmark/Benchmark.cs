@@ -0,0 +1,73 @@
+﻿//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+using System;
+
+namespace zuki.data.sqlite.benchmark
+{
+	/// <summary>
+	/// A single named operation to be measured by the BenchmarkRunner
+	/// </summary>
+	internal sealed class Benchmark
+	{
+		/// <summary>
+		/// Instance Constructor
+		/// </summary>
+		/// <param name="name">Unique name of the benchmark</param>
+		/// <param name="action">Action that performs a single operation</param>
+		public Benchmark(string name, Action action) : this(name, 1, action)
+		{
+		}
+
+		/// <summary>
+		/// Instance Constructor
+		/// </summary>
+		/// <param name="name">Unique name of the benchmark</param>
+		/// <param name="operations">Number of operations performed by each invocation of the action</param>
+		/// <param name="action">Action that performs the operations</param>
+		public Benchmark(string name, int operations, Action action)
+		{
+			if(name == null) throw new ArgumentNullException("name");
+			if(operations <= 0) throw new ArgumentOutOfRangeException("operations");
+			if(action == null) throw new ArgumentNullException("action");
+
+			Name = name;
+			Operations = operations;
+			Action = action;
+		}
+
+		/// <summary>
+		/// Action that performs the operations being measured
+		/// </summary>
+		public Action Action { get; }
+
+		/// <summary>
+		/// Unique name of the benchmark
+		/// </summary>
+		public string Name { get; }
+
+		/// <summary>
+		/// Number of operations performed by each invocation of the action
+		/// </summary>
+		public int Operations { get; }
+	}
+}
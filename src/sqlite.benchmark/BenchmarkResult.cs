@@ -0,0 +1,62 @@
+﻿//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+using System;
+
+namespace zuki.data.sqlite.benchmark
+{
+	/// <summary>
+	/// Measured (or baseline) result of a single benchmark
+	/// </summary>
+	internal sealed class BenchmarkResult
+	{
+		/// <summary>
+		/// Instance Constructor
+		/// </summary>
+		/// <param name="name">Name of the benchmark</param>
+		/// <param name="nanoseconds">Median time per operation, in nanoseconds</param>
+		/// <param name="bytes">Managed bytes allocated per operation</param>
+		public BenchmarkResult(string name, double nanoseconds, double bytes)
+		{
+			if(name == null) throw new ArgumentNullException("name");
+
+			Name = name;
+			NanosecondsPerOperation = nanoseconds;
+			BytesPerOperation = bytes;
+		}
+
+		/// <summary>
+		/// Managed bytes allocated per operation
+		/// </summary>
+		public double BytesPerOperation { get; }
+
+		/// <summary>
+		/// Name of the benchmark
+		/// </summary>
+		public string Name { get; }
+
+		/// <summary>
+		/// Median time per operation, in nanoseconds
+		/// </summary>
+		public double NanosecondsPerOperation { get; }
+	}
+}
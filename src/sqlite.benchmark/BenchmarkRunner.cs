@@ -0,0 +1,137 @@
+﻿//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+using System;
+using System.Diagnostics;
+
+namespace zuki.data.sqlite.benchmark
+{
+	/// <summary>
+	/// Runs a Benchmark and measures the time and managed allocations per operation
+	/// </summary>
+	/// <remarks>
+	/// Each benchmark is invoked once to JIT everything, then a pilot phase works out
+	/// how many invocations fill an iteration of the target length.  The reported time
+	/// is the median of the measured iterations, which is far less sensitive to the
+	/// odd context switch or GC than the mean.  Allocations come from the AppDomain
+	/// resource monitoring counters, which are only accurate after a collection, so
+	/// a full collection is done (outside of the timed region) around each iteration.
+	/// </remarks>
+	internal sealed class BenchmarkRunner
+	{
+		/// <summary>
+		/// Instance Constructor
+		/// </summary>
+		/// <param name="iterations">Number of measured iterations</param>
+		/// <param name="iterationTime">Target length of each iteration</param>
+		public BenchmarkRunner(int iterations, TimeSpan iterationTime)
+		{
+			if(iterations <= 0) throw new ArgumentOutOfRangeException("iterations");
+			if(iterationTime <= TimeSpan.Zero) throw new ArgumentOutOfRangeException("iterationTime");
+
+			m_iterations = iterations;
+			m_iterationTicks = (long)(iterationTime.TotalSeconds * Stopwatch.Frequency);
+
+			AppDomain.MonitoringIsEnabled = true;
+		}
+
+		/// <summary>
+		/// Runs a benchmark
+		/// </summary>
+		/// <param name="benchmark">Benchmark to be run</param>
+		public BenchmarkResult Run(Benchmark benchmark)
+		{
+			if(benchmark == null) throw new ArgumentNullException("benchmark");
+
+			Action action = benchmark.Action;
+			action();						// JIT and warm up
+
+			// Pilot: double the number of invocations until an iteration takes at
+			// least a quarter of the target, then scale it up to fill the target
+
+			long invocations = 1;
+			long elapsed = Time(action, invocations);
+
+			while((elapsed < m_iterationTicks / 4) && (invocations < (1L << 30)))
+			{
+				invocations *= 2;
+				elapsed = Time(action, invocations);
+			}
+
+			invocations = Math.Max(1, (long)((double)invocations * m_iterationTicks / Math.Max(1, elapsed)));
+
+			double[] samples = new double[m_iterations];
+			long allocated = 0;
+
+			for(int index = 0; index < m_iterations; index++)
+			{
+				long before = GetAllocatedBytes();
+				elapsed = Time(action, invocations);
+				allocated += GetAllocatedBytes() - before;
+
+				samples[index] = (elapsed * 1000000000.0 / Stopwatch.Frequency) / (invocations * benchmark.Operations);
+			}
+
+			Array.Sort(samples);
+
+			double median = ((m_iterations % 2) == 1) ? samples[m_iterations / 2] :
+				(samples[(m_iterations / 2) - 1] + samples[m_iterations / 2]) / 2.0;
+
+			return new BenchmarkResult(benchmark.Name, median, (double)allocated / ((double)m_iterations * invocations * benchmark.Operations));
+		}
+
+		//-------------------------------------------------------------------
+		// Private Member Functions
+		//-------------------------------------------------------------------
+
+		/// <summary>
+		/// Forces a full collection and returns the total bytes allocated in this AppDomain
+		/// </summary>
+		private static long GetAllocatedBytes()
+		{
+			GC.Collect();
+			GC.WaitForPendingFinalizers();
+			GC.Collect();
+
+			return AppDomain.CurrentDomain.MonitoringTotalAllocatedMemorySize;
+		}
+
+		/// <summary>
+		/// Invokes an action the specified number of times and returns the elapsed Stopwatch ticks
+		/// </summary>
+		/// <param name="action">Action to be invoked</param>
+		/// <param name="invocations">Number of times to invoke the action</param>
+		private static long Time(Action action, long invocations)
+		{
+			long start = Stopwatch.GetTimestamp();
+			for(long index = 0; index < invocations; index++) action();
+			return Stopwatch.GetTimestamp() - start;
+		}
+
+		//-------------------------------------------------------------------
+		// Member Variables
+		//-------------------------------------------------------------------
+
+		private readonly int m_iterations;
+		private readonly long m_iterationTicks;
+	}
+}
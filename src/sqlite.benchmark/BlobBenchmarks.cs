@@ -0,0 +1,126 @@
+﻿//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+using System;
+using System.Collections.Generic;
+
+namespace zuki.data.sqlite.benchmark
+{
+	/// <summary>
+	/// BLOB write and read throughput at several sizes
+	/// </summary>
+	internal sealed class BlobBenchmarks : IBenchmarkSuite
+	{
+		/// <summary>
+		/// Instance Constructor
+		/// </summary>
+		public BlobBenchmarks()
+		{
+			m_connection = new SqliteConnection("Data Source=:memory:");
+			m_connection.Open();
+
+			Database.Execute(m_connection, "CREATE TABLE blobs(id INTEGER PRIMARY KEY, data BLOB)");
+		}
+
+		/// <summary>
+		/// Disposes of the suite
+		/// </summary>
+		public void Dispose()
+		{
+			foreach(SqliteCommand command in m_commands) command.Dispose();
+			m_connection.Dispose();
+		}
+
+		/// <summary>
+		/// Enumerates the benchmarks provided by the suite
+		/// </summary>
+		public IEnumerable<Benchmark> GetBenchmarks()
+		{
+			foreach(int size in s_sizes)
+			{
+				byte[] data = new byte[size];
+				new Random(size).NextBytes(data);
+
+				// Write: replaces the row for this size with the same data each time
+
+				SqliteCommand write = CreateCommand("INSERT OR REPLACE INTO blobs(id, data) VALUES(@id, @data)");
+				write.Parameters.AddWithValue("@id", size);
+				write.Parameters.AddWithValue("@data", data);
+				write.Prepare();
+
+				yield return new Benchmark("blob.write." + SizeName(size), () => write.ExecuteNonQuery());
+
+				// Read: pulls the row written above back into a preallocated buffer
+
+				SqliteCommand read = CreateCommand("SELECT data FROM blobs WHERE id = @id");
+				read.Parameters.AddWithValue("@id", size);
+				read.Prepare();
+
+				byte[] buffer = new byte[size];
+
+				yield return new Benchmark("blob.read." + SizeName(size), () =>
+				{
+					using(SqliteDataReader reader = read.ExecuteReader())
+					{
+						reader.Read();
+						reader.GetBytes(0, 0, buffer, 0, buffer.Length);
+					}
+				});
+			}
+		}
+
+		//-------------------------------------------------------------------
+		// Private Member Functions
+		//-------------------------------------------------------------------
+
+		/// <summary>
+		/// Creates a command that is disposed of along with the suite
+		/// </summary>
+		/// <param name="commandText">Command text</param>
+		private SqliteCommand CreateCommand(string commandText)
+		{
+			SqliteCommand command = new SqliteCommand(commandText, m_connection);
+			m_commands.Add(command);
+			return command;
+		}
+
+		/// <summary>
+		/// Generates the short name for a BLOB size
+		/// </summary>
+		/// <param name="size">BLOB size in bytes</param>
+		private static string SizeName(int size)
+		{
+			if(size >= 1048576) return (size / 1048576).ToString() + "m";
+			if(size >= 1024) return (size / 1024).ToString() + "k";
+			return size.ToString();
+		}
+
+		//-------------------------------------------------------------------
+		// Member Variables
+		//-------------------------------------------------------------------
+
+		private static readonly int[] s_sizes = new int[] { 16, 1024, 65536, 1048576 };
+
+		private readonly SqliteConnection m_connection;
+		private readonly List<SqliteCommand> m_commands = new List<SqliteCommand>();
+	}
+}
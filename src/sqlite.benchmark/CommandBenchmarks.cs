@@ -0,0 +1,105 @@
+﻿//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+using System;
+using System.Collections.Generic;
+
+namespace zuki.data.sqlite.benchmark
+{
+	/// <summary>
+	/// Statement preparation versus cached execution, and parameter binding by type
+	/// </summary>
+	internal sealed class CommandBenchmarks : IBenchmarkSuite
+	{
+		/// <summary>
+		/// Instance Constructor
+		/// </summary>
+		public CommandBenchmarks()
+		{
+			m_connection = new SqliteConnection("Data Source=:memory:");
+			m_connection.Open();
+
+			m_prepared = new SqliteCommand("SELECT 1", m_connection);
+			m_prepared.Prepare();
+		}
+
+		/// <summary>
+		/// Disposes of the suite
+		/// </summary>
+		public void Dispose()
+		{
+			foreach(SqliteCommand command in m_commands) command.Dispose();
+			m_prepared.Dispose();
+			m_connection.Dispose();
+		}
+
+		/// <summary>
+		/// Enumerates the benchmarks provided by the suite
+		/// </summary>
+		public IEnumerable<Benchmark> GetBenchmarks()
+		{
+			yield return new Benchmark("command.prepare-execute", () =>
+			{
+				using(SqliteCommand command = new SqliteCommand("SELECT 1", m_connection)) command.ExecuteScalar();
+			});
+
+			yield return new Benchmark("command.cached-execute", () => m_prepared.ExecuteScalar());
+
+			yield return Bind("command.bind.null", DBNull.Value);
+			yield return Bind("command.bind.int32", 12345);
+			yield return Bind("command.bind.int64", 1234567890123L);
+			yield return Bind("command.bind.double", 12345.678);
+			yield return Bind("command.bind.string", "The quick brown fox jumps over the lazy dog");
+			yield return Bind("command.bind.binary", new byte[256]);
+			yield return Bind("command.bind.guid", Guid.NewGuid());
+			yield return Bind("command.bind.datetime", new DateTime(2022, 1, 1, 12, 0, 0, DateTimeKind.Utc));
+		}
+
+		//-------------------------------------------------------------------
+		// Private Member Functions
+		//-------------------------------------------------------------------
+
+		/// <summary>
+		/// Creates a benchmark that binds a value to a cached command and executes it
+		/// </summary>
+		/// <param name="name">Name of the benchmark</param>
+		/// <param name="value">Value to be bound</param>
+		private Benchmark Bind(string name, object value)
+		{
+			SqliteCommand command = new SqliteCommand("SELECT @p", m_connection);
+			m_commands.Add(command);
+
+			SqliteParameter parameter = command.Parameters.AddWithValue("@p", value);
+			command.Prepare();
+
+			return new Benchmark(name, () => { parameter.Value = value; command.ExecuteScalar(); });
+		}
+
+		//-------------------------------------------------------------------
+		// Member Variables
+		//-------------------------------------------------------------------
+
+		private readonly SqliteConnection m_connection;
+		private readonly SqliteCommand m_prepared;
+		private readonly List<SqliteCommand> m_commands = new List<SqliteCommand>();
+	}
+}
@@ -0,0 +1,91 @@
+﻿//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+using System.Collections.Generic;
+using System.IO;
+
+namespace zuki.data.sqlite.benchmark
+{
+	/// <summary>
+	/// Connection open/close overhead against in-memory and on-disk databases
+	/// </summary>
+	internal sealed class ConnectionBenchmarks : IBenchmarkSuite
+	{
+		/// <summary>
+		/// Instance Constructor
+		/// </summary>
+		public ConnectionBenchmarks()
+		{
+			m_path = Path.GetTempFileName();
+
+			// Create a small schema in the file database so that opening it has
+			// something to read and the first statement has a schema to load
+
+			using(SqliteConnection connection = new SqliteConnection("Data Source=" + m_path))
+			{
+				connection.Open();
+				using(SqliteCommand command = new SqliteCommand("CREATE TABLE IF NOT EXISTS t(id INTEGER PRIMARY KEY, value TEXT)", connection))
+					command.ExecuteNonQuery();
+			}
+		}
+
+		/// <summary>
+		/// Disposes of the suite
+		/// </summary>
+		public void Dispose()
+		{
+			File.Delete(m_path);
+		}
+
+		/// <summary>
+		/// Enumerates the benchmarks provided by the suite
+		/// </summary>
+		public IEnumerable<Benchmark> GetBenchmarks()
+		{
+			yield return new Benchmark("connection.open-close.memory", () => OpenClose("Data Source=:memory:"));
+			yield return new Benchmark("connection.open-close.file", () => OpenClose("Data Source=" + m_path));
+		}
+
+		//-------------------------------------------------------------------
+		// Private Member Functions
+		//-------------------------------------------------------------------
+
+		/// <summary>
+		/// Opens and closes a connection
+		/// </summary>
+		/// <param name="connectionString">Connection string</param>
+		private static void OpenClose(string connectionString)
+		{
+			using(SqliteConnection connection = new SqliteConnection(connectionString))
+			{
+				connection.Open();
+				connection.Close();
+			}
+		}
+
+		//-------------------------------------------------------------------
+		// Member Variables
+		//-------------------------------------------------------------------
+
+		private readonly string m_path;
+	}
+}
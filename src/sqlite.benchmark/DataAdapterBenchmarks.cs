@@ -0,0 +1,75 @@
+﻿//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+using System.Collections.Generic;
+using System.Data;
+
+namespace zuki.data.sqlite.benchmark
+{
+	/// <summary>
+	/// SqliteDataAdapter.Fill into a new DataTable
+	/// </summary>
+	internal sealed class DataAdapterBenchmarks : IBenchmarkSuite
+	{
+		/// <summary>
+		/// Instance Constructor
+		/// </summary>
+		public DataAdapterBenchmarks()
+		{
+			m_connection = new SqliteConnection("Data Source=:memory:");
+			m_connection.Open();
+
+			Database.CreateRows(m_connection, RowCount);
+
+			m_adapter = new SqliteDataAdapter("SELECT id, name, amount, created FROM rows", m_connection);
+		}
+
+		/// <summary>
+		/// Disposes of the suite
+		/// </summary>
+		public void Dispose()
+		{
+			m_adapter.Dispose();
+			m_connection.Dispose();
+		}
+
+		/// <summary>
+		/// Enumerates the benchmarks provided by the suite
+		/// </summary>
+		public IEnumerable<Benchmark> GetBenchmarks()
+		{
+			yield return new Benchmark("adapter.fill", RowCount, () =>
+			{
+				using(DataTable table = new DataTable()) m_adapter.Fill(table);
+			});
+		}
+
+		//-------------------------------------------------------------------
+		// Member Variables
+		//-------------------------------------------------------------------
+
+		private const int RowCount = 1000;
+
+		private readonly SqliteConnection m_connection;
+		private readonly SqliteDataAdapter m_adapter;
+	}
+}
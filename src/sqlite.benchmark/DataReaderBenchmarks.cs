@@ -0,0 +1,112 @@
+﻿//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+using System.Collections.Generic;
+
+namespace zuki.data.sqlite.benchmark
+{
+	/// <summary>
+	/// GetValue versus the typed getters, and GetOrdinal lookups
+	/// </summary>
+	internal sealed class DataReaderBenchmarks : IBenchmarkSuite
+	{
+		/// <summary>
+		/// Instance Constructor
+		/// </summary>
+		public DataReaderBenchmarks()
+		{
+			m_connection = new SqliteConnection("Data Source=:memory:");
+			m_connection.Open();
+
+			Database.CreateRows(m_connection, RowCount);
+
+			m_command = new SqliteCommand("SELECT id, name, amount, created FROM rows", m_connection);
+			m_command.Prepare();
+
+			// The GetOrdinal benchmark runs against a single reader positioned on
+			// the first row so that only the lookup itself is being measured
+
+			m_ordinalCommand = new SqliteCommand("SELECT id, name, amount, created FROM rows LIMIT 1", m_connection);
+			m_ordinalReader = m_ordinalCommand.ExecuteReader();
+			m_ordinalReader.Read();
+		}
+
+		/// <summary>
+		/// Disposes of the suite
+		/// </summary>
+		public void Dispose()
+		{
+			m_ordinalReader.Dispose();
+			m_ordinalCommand.Dispose();
+			m_command.Dispose();
+			m_connection.Dispose();
+		}
+
+		/// <summary>
+		/// Enumerates the benchmarks provided by the suite
+		/// </summary>
+		public IEnumerable<Benchmark> GetBenchmarks()
+		{
+			yield return new Benchmark("reader.getvalue", RowCount, () =>
+			{
+				using(SqliteDataReader reader = m_command.ExecuteReader())
+				{
+					while(reader.Read())
+					{
+						reader.GetValue(0);
+						reader.GetValue(1);
+						reader.GetValue(2);
+						reader.GetValue(3);
+					}
+				}
+			});
+
+			yield return new Benchmark("reader.typed", RowCount, () =>
+			{
+				using(SqliteDataReader reader = m_command.ExecuteReader())
+				{
+					while(reader.Read())
+					{
+						reader.GetInt64(0);
+						reader.GetString(1);
+						reader.GetDouble(2);
+						reader.GetDateTime(3);
+					}
+				}
+			});
+
+			yield return new Benchmark("reader.getordinal", () => m_ordinalReader.GetOrdinal("created"));
+			yield return new Benchmark("reader.getordinal.ignorecase", () => m_ordinalReader.GetOrdinal("CREATED"));
+		}
+
+		//-------------------------------------------------------------------
+		// Member Variables
+		//-------------------------------------------------------------------
+
+		private const int RowCount = 1000;
+
+		private readonly SqliteConnection m_connection;
+		private readonly SqliteCommand m_command;
+		private readonly SqliteCommand m_ordinalCommand;
+		private readonly SqliteDataReader m_ordinalReader;
+	}
+}
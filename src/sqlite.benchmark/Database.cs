@@ -0,0 +1,79 @@
+﻿//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+using System;
+
+namespace zuki.data.sqlite.benchmark
+{
+	/// <summary>
+	/// Helpers to generate the test data shared by the benchmark suites
+	/// </summary>
+	internal static class Database
+	{
+		/// <summary>
+		/// Creates and populates the rows(id, name, amount, created) table
+		/// </summary>
+		/// <param name="connection">Open connection</param>
+		/// <param name="count">Number of rows to generate</param>
+		public static void CreateRows(SqliteConnection connection, int count)
+		{
+			Execute(connection, "CREATE TABLE rows(id INTEGER PRIMARY KEY, name TEXT, amount REAL, created DATETIME)");
+
+			// The random number generator is seeded so that every run works
+			// against exactly the same data, otherwise the sort and aggregate
+			// benchmarks wouldn't be comparable against a baseline
+
+			Random random = new Random(20220101);
+			DateTime epoch = new DateTime(2022, 1, 1, 0, 0, 0, DateTimeKind.Utc);
+
+			using(SqliteTransaction transaction = connection.BeginTransaction())
+			using(SqliteCommand command = new SqliteCommand("INSERT INTO rows VALUES(@id, @name, @amount, @created)", connection))
+			{
+				SqliteParameter id = command.Parameters.AddWithValue("@id", 0);
+				SqliteParameter name = command.Parameters.AddWithValue("@name", string.Empty);
+				SqliteParameter amount = command.Parameters.AddWithValue("@amount", 0.0);
+				SqliteParameter created = command.Parameters.AddWithValue("@created", epoch);
+
+				for(int index = 0; index < count; index++)
+				{
+					id.Value = index;
+					name.Value = "name" + random.Next().ToString("x8");
+					amount.Value = random.NextDouble() * 1000.0;
+					created.Value = epoch.AddSeconds(random.Next(0, 365 * 86400));
+					command.ExecuteNonQuery();
+				}
+
+				transaction.Commit();
+			}
+		}
+
+		/// <summary>
+		/// Executes a non-query statement
+		/// </summary>
+		/// <param name="connection">Open connection</param>
+		/// <param name="commandText">Statement to execute</param>
+		public static void Execute(SqliteConnection connection, string commandText)
+		{
+			using(SqliteCommand command = new SqliteCommand(commandText, connection)) command.ExecuteNonQuery();
+		}
+	}
+}
@@ -0,0 +1,120 @@
+﻿//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+using System;
+using System.Collections.Generic;
+using System.Security;
+
+namespace zuki.data.sqlite.benchmark
+{
+	/// <summary>
+	/// Throughput of the built-in COMPRESS/DECOMPRESS and ENCRYPT/DECRYPT functions
+	/// </summary>
+	internal sealed class ExtensionBenchmarks : IBenchmarkSuite
+	{
+		/// <summary>
+		/// Instance Constructor
+		/// </summary>
+		public ExtensionBenchmarks()
+		{
+			m_connection = new SqliteConnection("Data Source=:memory:");
+			m_connection.Open();
+
+			using(SecureString password = new SecureString())
+			{
+				foreach(char ch in "benchmark") password.AppendChar(ch);
+				m_connection.FieldEncryptionPassword = password;
+			}
+
+			// Half random and half zero so the compressor has something to do
+			// without the data being either incompressible or trivially so
+
+			m_data = new byte[DataSize];
+			new Random(DataSize).NextBytes(m_data);
+			Array.Clear(m_data, DataSize / 2, DataSize / 2);
+
+			using(SqliteCommand command = new SqliteCommand("SELECT compress(@data), encrypt(@data)", m_connection))
+			{
+				command.Parameters.AddWithValue("@data", m_data);
+				using(SqliteDataReader reader = command.ExecuteReader())
+				{
+					reader.Read();
+					m_compressed = (byte[])reader.GetValue(0);
+					m_encrypted = (byte[])reader.GetValue(1);
+				}
+			}
+		}
+
+		/// <summary>
+		/// Disposes of the suite
+		/// </summary>
+		public void Dispose()
+		{
+			foreach(SqliteCommand command in m_commands) command.Dispose();
+			m_connection.Dispose();
+		}
+
+		/// <summary>
+		/// Enumerates the benchmarks provided by the suite
+		/// </summary>
+		public IEnumerable<Benchmark> GetBenchmarks()
+		{
+			yield return Scalar("extension.compress.64k", "SELECT length(compress(@data))", m_data);
+			yield return Scalar("extension.decompress.64k", "SELECT length(decompress(@data))", m_compressed);
+			yield return Scalar("extension.encrypt.64k", "SELECT length(encrypt(@data))", m_data);
+			yield return Scalar("extension.decrypt.64k", "SELECT length(decrypt(@data))", m_encrypted);
+		}
+
+		//-------------------------------------------------------------------
+		// Private Member Functions
+		//-------------------------------------------------------------------
+
+		/// <summary>
+		/// Creates a benchmark that executes a cached scalar query with a BLOB argument
+		/// </summary>
+		/// <param name="name">Name of the benchmark</param>
+		/// <param name="commandText">Query to be executed</param>
+		/// <param name="data">Value for the @data parameter</param>
+		private Benchmark Scalar(string name, string commandText, byte[] data)
+		{
+			SqliteCommand command = new SqliteCommand(commandText, m_connection);
+			m_commands.Add(command);
+
+			command.Parameters.AddWithValue("@data", data);
+			command.Prepare();
+
+			return new Benchmark(name, () => command.ExecuteScalar());
+		}
+
+		//-------------------------------------------------------------------
+		// Member Variables
+		//-------------------------------------------------------------------
+
+		private const int DataSize = 65536;
+
+		private readonly SqliteConnection m_connection;
+		private readonly byte[] m_data;
+		private readonly byte[] m_compressed;
+		private readonly byte[] m_encrypted;
+		private readonly List<SqliteCommand> m_commands = new List<SqliteCommand>();
+	}
+}
@@ -0,0 +1,120 @@
+﻿//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+using System;
+using System.Collections.Generic;
+
+namespace zuki.data.sqlite.benchmark
+{
+	/// <summary>
+	/// Managed scalar function, aggregate and collation call overhead, measured
+	/// against the equivalent built-in implementation
+	/// </summary>
+	internal sealed class FunctionBenchmarks : IBenchmarkSuite
+	{
+		/// <summary>
+		/// Instance Constructor
+		/// </summary>
+		public FunctionBenchmarks()
+		{
+			m_connection = new SqliteConnection("Data Source=:memory:");
+			m_connection.Open();
+
+			Database.CreateRows(m_connection, RowCount);
+
+			m_connection.Functions.Add("bench_abs", 1, (conn, args, result) => result.SetInt64(Math.Abs(args[0].ToInt64())));
+			m_connection.Aggregates.Add("bench_sum", 1, typeof(SumAggregate));
+			m_connection.Collations.Add("bench_ordinal", (conn, left, right) => string.CompareOrdinal(left, right));
+		}
+
+		/// <summary>
+		/// Disposes of the suite
+		/// </summary>
+		public void Dispose()
+		{
+			foreach(SqliteCommand command in m_commands) command.Dispose();
+			m_connection.Dispose();
+		}
+
+		/// <summary>
+		/// Enumerates the benchmarks provided by the suite
+		/// </summary>
+		public IEnumerable<Benchmark> GetBenchmarks()
+		{
+			yield return Scalar("function.builtin", "SELECT sum(abs(id)) FROM rows");
+			yield return Scalar("function.managed", "SELECT sum(bench_abs(id)) FROM rows");
+			yield return Scalar("aggregate.builtin", "SELECT sum(id) FROM rows");
+			yield return Scalar("aggregate.managed", "SELECT bench_sum(id) FROM rows");
+			yield return Scalar("collation.builtin", "SELECT max(name) FROM (SELECT name FROM rows ORDER BY name COLLATE BINARY)");
+			yield return Scalar("collation.managed", "SELECT max(name) FROM (SELECT name FROM rows ORDER BY name COLLATE bench_ordinal)");
+		}
+
+		//-------------------------------------------------------------------
+		// Private Member Functions
+		//-------------------------------------------------------------------
+
+		/// <summary>
+		/// Creates a benchmark that executes a cached scalar query over every row
+		/// </summary>
+		/// <param name="name">Name of the benchmark</param>
+		/// <param name="commandText">Query to be executed</param>
+		private Benchmark Scalar(string name, string commandText)
+		{
+			SqliteCommand command = new SqliteCommand(commandText, m_connection);
+			m_commands.Add(command);
+			command.Prepare();
+
+			return new Benchmark(name, RowCount, () => command.ExecuteScalar());
+		}
+
+		//-------------------------------------------------------------------
+		// Class SumAggregate
+		//-------------------------------------------------------------------
+
+		/// <summary>
+		/// Managed equivalent of the built-in sum() aggregate for integers
+		/// </summary>
+		private sealed class SumAggregate : SqliteAggregate
+		{
+			protected override void Accumulate(SqliteArgumentCollection args)
+			{
+				m_sum += args[0].ToInt64();
+			}
+
+			protected override void GetResult(SqliteResult result)
+			{
+				result.SetInt64(m_sum);
+			}
+
+			private long m_sum;
+		}
+
+		//-------------------------------------------------------------------
+		// Member Variables
+		//-------------------------------------------------------------------
+
+		private const int RowCount = 1000;
+
+		private readonly SqliteConnection m_connection;
+		private readonly List<SqliteCommand> m_commands = new List<SqliteCommand>();
+	}
+}
@@ -0,0 +1,166 @@
+﻿//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+
+namespace zuki.data.sqlite.benchmark
+{
+	/// <summary>
+	/// Runs the benchmark suites and compares the results against a baseline
+	/// </summary>
+	/// <remarks>
+	/// zuki.data.sqlite.benchmark [filter] [-baseline file] [-save file] [-threshold percent] [-iterations count]
+	///
+	///	filter		- Only run benchmarks whose name contains this string
+	///	-baseline	- Compare the results against a previously saved baseline
+	///	-save		- Save the results as a new baseline
+	///	-threshold	- Percentage slower (or larger) than the baseline that counts as a regression (default 10)
+	///	-iterations	- Number of measured iterations per benchmark (default 10)
+	///
+	/// The exit code is 1 if any benchmark regressed against the baseline, 2 if the
+	/// command line is invalid, and 0 otherwise.  The baseline is machine-specific;
+	/// record it with -save on the machine that will be running the comparison.
+	/// </remarks>
+	internal static class Program
+	{
+		/// <summary>
+		/// The main entry point for the application.
+		/// </summary>
+		/// <param name="args">Command line arguments</param>
+		static int Main(string[] args)
+		{
+			string filter = null;
+			string baselinePath = null;
+			string savePath = null;
+			double threshold = 10.0;
+			int iterations = 10;
+
+			try
+			{
+				for(int index = 0; index < args.Length; index++)
+				{
+					string arg = args[index];
+
+					if(string.Equals(arg, "-baseline", StringComparison.OrdinalIgnoreCase)) baselinePath = args[++index];
+					else if(string.Equals(arg, "-save", StringComparison.OrdinalIgnoreCase)) savePath = args[++index];
+					else if(string.Equals(arg, "-threshold", StringComparison.OrdinalIgnoreCase)) threshold = double.Parse(args[++index], CultureInfo.InvariantCulture);
+					else if(string.Equals(arg, "-iterations", StringComparison.OrdinalIgnoreCase)) iterations = int.Parse(args[++index], CultureInfo.InvariantCulture);
+					else if((filter == null) && !arg.StartsWith("-")) filter = arg;
+					else throw new ArgumentException("Unrecognized argument: " + arg);
+				}
+			}
+
+			catch(Exception ex) when(ex is ArgumentException || ex is FormatException || ex is IndexOutOfRangeException)
+			{
+				Console.Error.WriteLine(ex.Message);
+				Console.Error.WriteLine("usage: zuki.data.sqlite.benchmark [filter] [-baseline file] [-save file] [-threshold percent] [-iterations count]");
+				return 2;
+			}
+
+			Dictionary<string, BenchmarkResult> baseline = (baselinePath != null) ? Baseline.Load(baselinePath) : null;
+			BenchmarkRunner runner = new BenchmarkRunner(iterations, TimeSpan.FromMilliseconds(100));
+			List<BenchmarkResult> results = new List<BenchmarkResult>();
+			int regressions = 0;
+
+			Console.WriteLine("{0,-36} {1,14} {2,12} {3,10} {4,10}", "Benchmark", "ns/op", "bytes/op", "time", "alloc");
+
+			foreach(Func<IBenchmarkSuite> factory in s_suites)
+			{
+				using(IBenchmarkSuite suite = factory())
+				{
+					foreach(Benchmark benchmark in suite.GetBenchmarks())
+					{
+						if((filter != null) && (benchmark.Name.IndexOf(filter, StringComparison.OrdinalIgnoreCase) < 0)) continue;
+
+						BenchmarkResult result = runner.Run(benchmark);
+						results.Add(result);
+
+						string time = string.Empty, alloc = string.Empty;
+						BenchmarkResult reference;
+
+						if((baseline != null) && baseline.TryGetValue(result.Name, out reference))
+						{
+							double timeDelta = Delta(result.NanosecondsPerOperation, reference.NanosecondsPerOperation);
+							double allocDelta = Delta(result.BytesPerOperation, reference.BytesPerOperation);
+
+							time = timeDelta.ToString("+0.0;-0.0", CultureInfo.InvariantCulture) + "%";
+							alloc = allocDelta.ToString("+0.0;-0.0", CultureInfo.InvariantCulture) + "%";
+
+							// Allocations are deterministic enough that any growth of more than a
+							// few bytes per operation is worth flagging, whatever the percentage
+
+							bool regressed = (timeDelta > threshold) || ((allocDelta > threshold) && (result.BytesPerOperation - reference.BytesPerOperation >= 8.0));
+							if(regressed) { regressions++; time += " !"; }
+						}
+
+						Console.WriteLine(string.Format(CultureInfo.InvariantCulture, "{0,-36} {1,14:N1} {2,12:N1} {3,10} {4,10}", result.Name,
+							result.NanosecondsPerOperation, result.BytesPerOperation, time, alloc));
+					}
+				}
+			}
+
+			if(savePath != null) Baseline.Save(savePath, results);
+
+			if(regressions > 0)
+			{
+				Console.WriteLine();
+				Console.WriteLine("{0} benchmark(s) regressed by more than {1}% against {2}", regressions, threshold, baselinePath);
+				return 1;
+			}
+
+			return 0;
+		}
+
+		//-------------------------------------------------------------------
+		// Private Member Functions
+		//-------------------------------------------------------------------
+
+		/// <summary>
+		/// Calculates the percentage change of a value against a baseline value
+		/// </summary>
+		/// <param name="value">Measured value</param>
+		/// <param name="reference">Baseline value</param>
+		private static double Delta(double value, double reference)
+		{
+			if(reference <= 0.0) return (value <= 0.0) ? 0.0 : 100.0;
+			return ((value - reference) / reference) * 100.0;
+		}
+
+		//-------------------------------------------------------------------
+		// Member Variables
+		//-------------------------------------------------------------------
+
+		private static readonly Func<IBenchmarkSuite>[] s_suites = new Func<IBenchmarkSuite>[]
+		{
+			() => new ConnectionBenchmarks(),
+			() => new CommandBenchmarks(),
+			() => new DataReaderBenchmarks(),
+			() => new BlobBenchmarks(),
+			() => new FunctionBenchmarks(),
+			() => new VirtualTableBenchmarks(),
+			() => new ExtensionBenchmarks(),
+			() => new DataAdapterBenchmarks(),
+		};
+	}
+}
@@ -0,0 +1,142 @@
+﻿//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+using System.Collections.Generic;
+using System.Globalization;
+using System.IO;
+using System.Linq;
+
+namespace zuki.data.sqlite.benchmark
+{
+	/// <summary>
+	/// Full scans of the built-in collection and CSV virtual tables
+	/// </summary>
+	internal sealed class VirtualTableBenchmarks : IBenchmarkSuite
+	{
+		/// <summary>
+		/// Instance Constructor
+		/// </summary>
+		public VirtualTableBenchmarks()
+		{
+			m_connection = new SqliteConnection("Data Source=:memory:");
+			m_connection.Open();
+
+			// Collection: an in-memory list of items exposed as an eponymous table
+
+			var items = Enumerable.Range(0, RowCount).Select(index => new Item(index, "name" + index.ToString("x8"), index * 1.5)).ToList();
+			m_connection.RegisterCollectionTable(new SqliteCollectionTable<Item>(items), "items");
+
+			// CSV: the same data written out to a temporary file
+
+			m_path = Path.GetTempFileName();
+			using(StreamWriter writer = new StreamWriter(m_path))
+			{
+				writer.WriteLine("id,name,amount");
+				foreach(Item item in items)
+					writer.WriteLine(string.Format(CultureInfo.InvariantCulture, "{0},\"{1}\",{2}", item.Id, item.Name, item.Amount));
+			}
+
+			m_connection.RegisterVirtualTable(typeof(SqliteCsvVirtualTable), "csv");
+			Database.Execute(m_connection, "CREATE VIRTUAL TABLE csvitems USING csv(filename='" + m_path.Replace("'", "''") + "', header=yes)");
+		}
+
+		/// <summary>
+		/// Disposes of the suite
+		/// </summary>
+		public void Dispose()
+		{
+			foreach(SqliteCommand command in m_commands) command.Dispose();
+			m_connection.Dispose();
+			File.Delete(m_path);
+		}
+
+		/// <summary>
+		/// Enumerates the benchmarks provided by the suite
+		/// </summary>
+		public IEnumerable<Benchmark> GetBenchmarks()
+		{
+			yield return Scan("vtab.collection.scan", "SELECT id, name, amount FROM items");
+			yield return Scan("vtab.csv.scan", "SELECT id, name, amount FROM csvitems");
+		}
+
+		//-------------------------------------------------------------------
+		// Private Member Functions
+		//-------------------------------------------------------------------
+
+		/// <summary>
+		/// Creates a benchmark that reads every column of every row of a query
+		/// </summary>
+		/// <param name="name">Name of the benchmark</param>
+		/// <param name="commandText">Query to be executed</param>
+		private Benchmark Scan(string name, string commandText)
+		{
+			SqliteCommand command = new SqliteCommand(commandText, m_connection);
+			m_commands.Add(command);
+
+			return new Benchmark(name, RowCount, () =>
+			{
+				using(SqliteDataReader reader = command.ExecuteReader())
+				{
+					while(reader.Read())
+					{
+						reader.GetInt64(0);
+						reader.GetString(1);
+						reader.GetDouble(2);
+					}
+				}
+			});
+		}
+
+		//-------------------------------------------------------------------
+		// Class Item
+		//-------------------------------------------------------------------
+
+		/// <summary>
+		/// Element type of the collection table
+		/// </summary>
+		public sealed class Item
+		{
+			public Item(long id, string name, double amount)
+			{
+				Id = id;
+				Name = name;
+				Amount = amount;
+			}
+
+			public double Amount { get; }
+
+			public long Id { get; }
+
+			public string Name { get; }
+		}
+
+		//-------------------------------------------------------------------
+		// Member Variables
+		//-------------------------------------------------------------------
+
+		private const int RowCount = 10000;
+
+		private readonly SqliteConnection m_connection;
+		private readonly List<SqliteCommand> m_commands = new List<SqliteCommand>();
+		private readonly string m_path;
+	}
+}
@@ -0,0 +1,98 @@
+﻿using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using zuki.data.sqlite;
+
+namespace sqlite.test
+{
+	[TestClass]
+	public class Command
+	{
+		[TestMethod]
+		public void LazyPrepareSeesEarlierObjects()
+		{
+			using(SqliteConnection conn = OpenDatabase())
+			using(SqliteCommand cmd = conn.CreateCommand())
+			{
+				cmd.CommandText = "CREATE TABLE test(value INTEGER); INSERT INTO test VALUES(1); SELECT value FROM test";
+
+				// Compiling everything up front fails, the table doesn't exist yet
+				Assert.IsFalse(cmd.LazyPrepare);
+				Assert.ThrowsException<SqliteException>(() => cmd.ExecuteScalar());
+
+				cmd.LazyPrepare = true;
+				Assert.AreEqual(1L, Convert.ToInt64(cmd.ExecuteScalar()));
+			}
+		}
+
+		[TestMethod]
+		public void LazyPrepareLateCompileError()
+		{
+			using(SqliteConnection conn = OpenDatabase())
+			using(SqliteCommand cmd = conn.CreateCommand())
+			{
+				Execute(conn, "CREATE TABLE test(value INTEGER)");
+
+				// Nothing runs when the command is compiled up front
+				cmd.CommandText = "INSERT INTO test VALUES(1); INSERT INTO nosuchtable VALUES(2)";
+				Assert.ThrowsException<SqliteException>(() => cmd.ExecuteNonQuery());
+				Assert.AreEqual(0L, Scalar(conn, "SELECT COUNT(*) FROM test"));
+
+				// Compiled lazily, the first statement runs before the error is reported
+				cmd.LazyPrepare = true;
+				Assert.ThrowsException<SqliteException>(() => cmd.ExecuteNonQuery());
+				Assert.AreEqual(1L, Scalar(conn, "SELECT COUNT(*) FROM test"));
+
+				// The same applies to a data reader, the error surfaces from NextResult
+				cmd.CommandText = "SELECT value FROM test; SELECT * FROM nosuchtable";
+				using(SqliteDataReader reader = cmd.ExecuteReader())
+				{
+					Assert.IsTrue(reader.Read());
+					Assert.AreEqual(1L, reader.GetInt64(0));
+					Assert.ThrowsException<SqliteException>(() => reader.NextResult());
+				}
+			}
+		}
+
+		[TestMethod]
+		public void LazyPrepareIgnoredWhenPrepared()
+		{
+			using(SqliteConnection conn = OpenDatabase())
+			using(SqliteCommand cmd = conn.CreateCommand())
+			{
+				cmd.CommandText = "CREATE TABLE test(value INTEGER); INSERT INTO test VALUES(1)";
+				cmd.LazyPrepare = true;
+
+				// An explicitly prepared command always compiles every statement
+				Assert.ThrowsException<SqliteException>(() => cmd.Prepare());
+			}
+		}
+
+		//-------------------------------------------------------------------
+		// Helpers
+
+		private static void Execute(SqliteConnection conn, string sql)
+		{
+			using(SqliteCommand cmd = conn.CreateCommand())
+			{
+				cmd.CommandText = sql;
+				cmd.ExecuteNonQuery();
+			}
+		}
+
+		private static SqliteConnection OpenDatabase()
+		{
+			SqliteConnection conn = new SqliteConnection("Data Source=:memory:");
+			conn.Open();
+			return conn;
+		}
+
+		private static long Scalar(SqliteConnection conn, string sql)
+		{
+			using(SqliteCommand cmd = conn.CreateCommand())
+			{
+				cmd.CommandText = sql;
+				return Convert.ToInt64(cmd.ExecuteScalar());
+			}
+		}
+	}
+}
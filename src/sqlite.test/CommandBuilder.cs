@@ -0,0 +1,77 @@
+﻿using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using zuki.data.sqlite;
+
+namespace sqlite.test
+{
+	[TestClass]
+	public class CommandBuilder
+	{
+		[TestMethod]
+		public void SchemaChangeAfterInsertCommand()
+		{
+			foreach(string table in new string[] { "test", "other.test" })
+			{
+				using(SqliteConnection conn = new SqliteConnection("Data Source=:memory:"))
+				{
+					conn.Open();
+					Execute(conn, "ATTACH DATABASE ':memory:' AS other");
+					Execute(conn, "CREATE TABLE " + table + "(id INTEGER PRIMARY KEY, name TEXT)");
+
+					Assert.IsFalse(GetInsertCommandText(conn, table).Contains("extra"));
+
+					// The cached builder schema must be thrown away after the DDL, whether
+					// it was made against the main database or an attached one
+					Execute(conn, "ALTER TABLE " + table + " ADD COLUMN extra TEXT");
+
+					string insert = GetInsertCommandText(conn, table);
+					Assert.IsTrue(insert.Contains("name"));
+					Assert.IsTrue(insert.Contains("extra"));
+				}
+			}
+		}
+
+		[TestMethod]
+		public void SchemaChangeAfterRefreshSchema()
+		{
+			using(SqliteConnection conn = new SqliteConnection("Data Source=:memory:"))
+			using(SqliteDataAdapter adapter = new SqliteDataAdapter("SELECT * FROM test", conn))
+			using(SqliteCommandBuilder builder = new SqliteCommandBuilder(adapter))
+			{
+				conn.Open();
+				Execute(conn, "CREATE TABLE test(id INTEGER PRIMARY KEY, name TEXT)");
+
+				Assert.IsFalse(builder.GetInsertCommand().CommandText.Contains("extra"));
+
+				Execute(conn, "ALTER TABLE test ADD COLUMN extra TEXT");
+
+				// The builder holds onto it's commands until RefreshSchema() is called
+				Assert.IsFalse(builder.GetInsertCommand().CommandText.Contains("extra"));
+
+				builder.RefreshSchema();
+				Assert.IsTrue(builder.GetInsertCommand().CommandText.Contains("extra"));
+			}
+		}
+
+		//-------------------------------------------------------------------
+		// Helpers
+
+		private static void Execute(SqliteConnection conn, string sql)
+		{
+			using(SqliteCommand cmd = conn.CreateCommand())
+			{
+				cmd.CommandText = sql;
+				cmd.ExecuteNonQuery();
+			}
+		}
+
+		private static string GetInsertCommandText(SqliteConnection conn, string table)
+		{
+			using(SqliteDataAdapter adapter = new SqliteDataAdapter("SELECT * FROM " + table, conn))
+			using(SqliteCommandBuilder builder = new SqliteCommandBuilder(adapter))
+			{
+				return builder.GetInsertCommand().CommandText;
+			}
+		}
+	}
+}
@@ -7,6 +7,75 @@ namespace sqlite.test
 	[TestClass]
 	public class Connection
 	{
+		[TestMethod]
+		public void BackupCancel()
+		{
+			using(SqliteConnection source = OpenDatabase())
+			using(SqliteConnection destination = new SqliteConnection("Data Source=:memory:"))
+			{
+				FillDatabase(source);
+				destination.Open();
+
+				int events = 0;
+				source.BackupProgress += (sender, args) => { events++; args.Cancel = true; };
+
+				// A cancelled backup returns false and leaves the destination alone
+				Assert.IsFalse(source.BackupTo(destination, "main", 1, TimeSpan.Zero));
+				Assert.AreEqual(1, events);
+				Assert.AreEqual(0L, Convert.ToInt64(Scalar(destination, "SELECT COUNT(*) FROM sqlite_master")));
+			}
+		}
+
+		[TestMethod]
+		public void BackupInSteps()
+		{
+			using(SqliteConnection source = OpenDatabase())
+			using(SqliteConnection destination = new SqliteConnection("Data Source=:memory:"))
+			{
+				FillDatabase(source);
+				destination.Open();
+
+				int events = 0, remaining = -1;
+				source.BackupProgress += (sender, args) => { events++; remaining = args.RemainingPages; };
+
+				Assert.IsTrue(source.BackupTo(destination, "main", 1, TimeSpan.Zero));
+				Assert.IsTrue(events > 1);
+				Assert.AreEqual(0, remaining);
+				Assert.AreEqual(Count(source), Count(destination));
+			}
+		}
+
+		[TestMethod]
+		public void BackupRetriesWhenBusy()
+		{
+			string path = System.IO.Path.GetTempFileName();
+
+			try
+			{
+				using(SqliteConnection source = OpenDatabase())
+				using(SqliteConnection destination = new SqliteConnection("Data Source=" + path))
+				using(SqliteConnection reader = new SqliteConnection("Data Source=" + path))
+				{
+					FillDatabase(source);
+					destination.Open();
+					reader.Open();
+
+					// An open read transaction on the destination file keeps the backup
+					// from committing; the step is retried after the handler releases it
+					SqliteTransaction trans = reader.BeginTransaction();
+					Scalar(reader, "SELECT COUNT(*) FROM sqlite_master");
+
+					source.BackupProgress += (sender, args) => { if(trans != null) { trans.Rollback(); trans = null; } };
+
+					Assert.IsTrue(source.BackupTo(destination, "main", -1, TimeSpan.Zero));
+					Assert.IsNull(trans);
+					Assert.AreEqual(Count(source), Count(destination));
+				}
+			}
+
+			finally { System.IO.File.Delete(path); }
+		}
+
 		[TestMethod]
 		public void Construct()
 		{
@@ -16,5 +85,215 @@ public void Construct()
 				conn.Open();
 			}
 		}
+
+		[TestMethod]
+		public void NestedTransactionCommit()
+		{
+			using(SqliteConnection conn = OpenDatabase())
+			{
+				SqliteTransaction outer = conn.BeginTransaction();
+				Execute(conn, "INSERT INTO test VALUES(1)");
+
+				SqliteTransaction inner = conn.BeginTransaction();
+				Execute(conn, "INSERT INTO test VALUES(2)");
+
+				// The outer transaction cannot be committed while the nested one is open
+				Assert.ThrowsException<InvalidOperationException>(() => outer.Commit());
+
+				inner.Commit();
+				outer.Commit();
+
+				Assert.AreEqual(2L, Count(conn));
+			}
+		}
+
+		[TestMethod]
+		public void NestedTransactionRollback()
+		{
+			using(SqliteConnection conn = OpenDatabase())
+			{
+				SqliteTransaction outer = conn.BeginTransaction();
+				Execute(conn, "INSERT INTO test VALUES(1)");
+
+				SqliteTransaction inner = conn.BeginTransaction();
+				Execute(conn, "INSERT INTO test VALUES(2)");
+				inner.Rollback();
+
+				outer.Commit();
+				Assert.AreEqual(1L, Count(conn));
+			}
+		}
+
+		[TestMethod]
+		public void OuterTransactionRollbackClosesNested()
+		{
+			using(SqliteConnection conn = OpenDatabase())
+			{
+				SqliteTransaction outer = conn.BeginTransaction();
+				Execute(conn, "INSERT INTO test VALUES(1)");
+
+				SqliteTransaction inner = conn.BeginTransaction();
+				Execute(conn, "INSERT INTO test VALUES(2)");
+
+				outer.Rollback();
+				Assert.ThrowsException<InvalidOperationException>(() => inner.Commit());
+				Assert.AreEqual(0L, Count(conn));
+
+				// The connection must be able to start a new transaction afterwards
+				SqliteTransaction trans = conn.BeginTransaction();
+				Execute(conn, "INSERT INTO test VALUES(3)");
+				trans.Commit();
+				Assert.AreEqual(1L, Count(conn));
+			}
+		}
+
+		[TestMethod]
+		public void ReadOnlyRejectsWrites()
+		{
+			string path = System.IO.Path.GetTempFileName();
+
+			try
+			{
+				using(SqliteConnection conn = new SqliteConnection("Data Source=" + path))
+				{
+					conn.Open();
+					Execute(conn, "CREATE TABLE test(value INTEGER PRIMARY KEY)");
+					Execute(conn, "INSERT INTO test VALUES(1)");
+				}
+
+				using(SqliteConnection conn = new SqliteConnection("Data Source=" + path + ";Read Only=true"))
+				{
+					conn.Open();
+					Assert.AreEqual(1L, Count(conn));
+					Assert.ThrowsException<SqliteException>(() => Execute(conn, "INSERT INTO test VALUES(2)"));
+				}
+			}
+
+			finally { System.IO.File.Delete(path); }
+		}
+
+		[TestMethod]
+		public void SharedCacheMemoryDatabase()
+		{
+			string cs = "Data Source=file:sharedcachetest?mode=memory;Shared Cache=true;No Mutex=true";
+
+			using(SqliteConnection first = new SqliteConnection(cs))
+			using(SqliteConnection second = new SqliteConnection(cs))
+			{
+				first.Open();
+				second.Open();
+
+				// Both connections see the same in-memory database
+				Execute(first, "CREATE TABLE test(value INTEGER PRIMARY KEY)");
+				Execute(first, "INSERT INTO test VALUES(1)");
+				Assert.AreEqual(1L, Count(second));
+			}
+
+			// The database is released once the last connection to it is closed
+			using(SqliteConnection conn = new SqliteConnection(cs))
+			{
+				conn.Open();
+				Assert.AreEqual(0L, Convert.ToInt64(Scalar(conn, "SELECT COUNT(*) FROM sqlite_master")));
+			}
+		}
+
+		[TestMethod]
+		public void TransactionAutoRollback()
+		{
+			using(SqliteConnection conn = OpenDatabase())
+			{
+				SqliteTransaction outer = conn.BeginTransaction();
+				SqliteTransaction inner = conn.BeginTransaction();
+				Execute(conn, "INSERT INTO test VALUES(1)");
+
+				// ON CONFLICT ROLLBACK causes the engine to roll back the entire
+				// transaction, which must close out every transaction object
+				Assert.ThrowsException<SqliteException>(() => Execute(conn, "INSERT OR ROLLBACK INTO test VALUES(1)"));
+
+				inner.Rollback();
+				Assert.ThrowsException<InvalidOperationException>(() => outer.Commit());
+				Assert.ThrowsException<InvalidOperationException>(() => outer.Rollback());
+				Assert.AreEqual(0L, Count(conn));
+
+				SqliteTransaction trans = conn.BeginTransaction();
+				Execute(conn, "INSERT INTO test VALUES(2)");
+				trans.Commit();
+				Assert.AreEqual(1L, Count(conn));
+			}
+		}
+
+		[TestMethod]
+		public void TransactionSavepointNames()
+		{
+			using(SqliteConnection conn = OpenDatabase())
+			{
+				SqliteTransaction outer = conn.BeginTransaction();
+
+				// Sibling nested transactions reuse the same SAVEPOINT name; the
+				// second one must not be affected by the rollback of the first
+				SqliteTransaction first = conn.BeginTransaction();
+				Execute(conn, "INSERT INTO test VALUES(1)");
+				first.Rollback();
+
+				SqliteTransaction second = conn.BeginTransaction();
+				Execute(conn, "INSERT INTO test VALUES(2)");
+
+				SqliteTransaction third = conn.BeginTransaction();
+				Execute(conn, "INSERT INTO test VALUES(3)");
+				third.Rollback();
+
+				second.Commit();
+
+				// An application SAVEPOINT inside of a nested transaction is unaffected
+				SqliteTransaction fourth = conn.BeginTransaction();
+				Execute(conn, "SAVEPOINT app; INSERT INTO test VALUES(4); RELEASE app");
+				fourth.Commit();
+
+				outer.Commit();
+
+				Assert.AreEqual(2L, Count(conn));
+				Assert.AreEqual(6L, Convert.ToInt64(Scalar(conn, "SELECT SUM(value) FROM test")));
+			}
+		}
+
+		//-------------------------------------------------------------------
+		// Helpers
+
+		private static SqliteConnection OpenDatabase()
+		{
+			SqliteConnection conn = new SqliteConnection("Data Source=:memory:");
+			conn.Open();
+			Execute(conn, "CREATE TABLE test(value INTEGER PRIMARY KEY)");
+			return conn;
+		}
+
+		private static void FillDatabase(SqliteConnection conn)
+		{
+			Execute(conn, "WITH RECURSIVE n(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM n WHERE x < 500) INSERT INTO test SELECT x FROM n");
+			Execute(conn, "CREATE TABLE data AS SELECT value, randomblob(1000) AS blob FROM test");
+		}
+
+		private static long Count(SqliteConnection conn)
+		{
+			return Convert.ToInt64(Scalar(conn, "SELECT COUNT(*) FROM test"));
+		}
+
+		private static void Execute(SqliteConnection conn, string sql)
+		{
+			using(SqliteCommand cmd = conn.CreateCommand())
+			{
+				cmd.CommandText = sql;
+				cmd.ExecuteNonQuery();
+			}
+		}
+
+		private static object Scalar(SqliteConnection conn, string sql)
+		{
+			using(SqliteCommand cmd = conn.CreateCommand())
+			{
+				cmd.CommandText = sql;
+				return cmd.ExecuteScalar();
+			}
+		}
 	}
 }
@@ -15,5 +15,26 @@ public void Construct()
 				AllowExtensions = true
 			};
 		}
+
+		[TestMethod]
+		public void OpenFlags()
+		{
+			SqliteConnectionStringBuilder csb = new SqliteConnectionStringBuilder
+			{
+				NoMutex = true,
+				ReadOnly = true,
+				SharedCache = true
+			};
+
+			SqliteConnectionStringBuilder parsed = new SqliteConnectionStringBuilder(csb.ConnectionString);
+			Assert.IsTrue(parsed.NoMutex);
+			Assert.IsTrue(parsed.ReadOnly);
+			Assert.IsTrue(parsed.SharedCache);
+
+			parsed = new SqliteConnectionStringBuilder("Data Source=:memory:");
+			Assert.IsFalse(parsed.NoMutex);
+			Assert.IsFalse(parsed.ReadOnly);
+			Assert.IsFalse(parsed.SharedCache);
+		}
 	}
 }
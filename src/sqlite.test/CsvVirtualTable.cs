@@ -0,0 +1,90 @@
+﻿using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.IO;
+using zuki.data.sqlite;
+
+namespace sqlite.test
+{
+	[TestClass]
+	public class CsvVirtualTable
+	{
+		[TestMethod]
+		public void RowIDEqual()
+		{
+			string path = Path.GetTempFileName();
+
+			try
+			{
+				File.WriteAllText(path, "name,value\r\none,1\r\ntwo,2\r\nthree,3\r\n");
+
+				using(SqliteConnection conn = new SqliteConnection("Data Source=:memory:"))
+				{
+					conn.Open();
+					conn.RegisterVirtualTable(typeof(SqliteCsvVirtualTable), "csv");
+					Execute(conn, "CREATE VIRTUAL TABLE test USING csv(filename='" + path.Replace("'", "''") + "', index=yes)");
+
+					Assert.AreEqual("one", Scalar(conn, "SELECT name FROM test WHERE rowid = 1"));
+					Assert.AreEqual("three", Scalar(conn, "SELECT name FROM test WHERE rowid = 3"));
+
+					// ROWIDs outside of the file, including zero and negative values,
+					// must not be mapped onto the first record
+					Assert.AreEqual(0L, Convert.ToInt64(Scalar(conn, "SELECT COUNT(*) FROM test WHERE rowid = 0")));
+					Assert.AreEqual(0L, Convert.ToInt64(Scalar(conn, "SELECT COUNT(*) FROM test WHERE rowid = -1")));
+					Assert.AreEqual(0L, Convert.ToInt64(Scalar(conn, "SELECT COUNT(*) FROM test WHERE rowid = 4")));
+				}
+			}
+
+			finally { File.Delete(path); }
+		}
+
+		[TestMethod]
+		public void RowIDText()
+		{
+			string path = Path.GetTempFileName();
+
+			try
+			{
+				File.WriteAllText(path, "name,value\r\none,1\r\ntwo,2\r\nthree,3\r\n");
+
+				using(SqliteConnection conn = new SqliteConnection("Data Source=:memory:"))
+				{
+					conn.Open();
+					conn.RegisterVirtualTable(typeof(SqliteCsvVirtualTable), "csv");
+					Execute(conn, "CREATE VIRTUAL TABLE test USING csv(filename='" + path.Replace("'", "''") + "', index=yes)");
+
+					// TEXT that isn't numeric sorts after every ROWID
+					Assert.AreEqual(3L, Convert.ToInt64(Scalar(conn, "SELECT COUNT(*) FROM test WHERE rowid < 'abc'")));
+					Assert.AreEqual(0L, Convert.ToInt64(Scalar(conn, "SELECT COUNT(*) FROM test WHERE rowid > 'abc'")));
+					Assert.AreEqual(0L, Convert.ToInt64(Scalar(conn, "SELECT COUNT(*) FROM test WHERE rowid = 'abc'")));
+
+					// TEXT that looks like a number is compared as one
+					Assert.AreEqual(2L, Convert.ToInt64(Scalar(conn, "SELECT COUNT(*) FROM test WHERE rowid <= '2'")));
+					Assert.AreEqual("two", Scalar(conn, "SELECT name FROM test WHERE rowid = '2'"));
+				}
+			}
+
+			finally { File.Delete(path); }
+		}
+
+		//-------------------------------------------------------------------
+		// Helpers
+
+		private static void Execute(SqliteConnection conn, string sql)
+		{
+			using(SqliteCommand cmd = conn.CreateCommand())
+			{
+				cmd.CommandText = sql;
+				cmd.ExecuteNonQuery();
+			}
+		}
+
+		private static object Scalar(SqliteConnection conn, string sql)
+		{
+			using(SqliteCommand cmd = conn.CreateCommand())
+			{
+				cmd.CommandText = sql;
+				return cmd.ExecuteScalar();
+			}
+		}
+	}
+}
@@ -0,0 +1,349 @@
+﻿using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Data;
+using System.Reflection;
+using zuki.data.sqlite;
+
+namespace sqlite.test
+{
+	[TestClass]
+	public class DataAdapter
+	{
+		[TestMethod]
+		public void BatchedParameters()
+		{
+			using(SqliteConnection conn = OpenDatabase())
+			using(SqliteDataAdapter adapter = CreateAdapter(conn, "INSERT INTO test(id, name) VALUES(@id, @name)"))
+			{
+				SqliteCommand cmd = adapter.InsertCommand;
+
+				// Drive the batching protocol the same way DbDataAdapter.Update() does
+				Invoke(adapter, "InitializeBatching");
+
+				cmd.Parameters[0].Value = 10L;
+				cmd.Parameters[1].Value = "ten";
+				Assert.AreEqual(0, Invoke(adapter, "AddToBatch", cmd));
+
+				cmd.Parameters[0].Value = 11L;
+				cmd.Parameters[1].Value = "eleven";
+				Assert.AreEqual(1, Invoke(adapter, "AddToBatch", cmd));
+
+				Assert.AreEqual(2, Invoke(adapter, "ExecuteBatch"));
+				Assert.IsTrue(IsPrepared(cmd));
+
+				// Each batched parameter reflects the values of it's own row rather
+				// than whatever was last set on the command
+				IDataParameter first = (IDataParameter)Invoke(adapter, "GetBatchedParameter", 0, 1);
+				IDataParameter second = (IDataParameter)Invoke(adapter, "GetBatchedParameter", 1, 1);
+				Assert.AreEqual("ten", first.Value);
+				Assert.AreEqual("eleven", second.Value);
+				Assert.AreEqual("name", first.SourceColumn);
+				Assert.AreNotSame(cmd.Parameters[1], first);
+
+				// The adapter undoes the Prepare() it did on the command
+				Invoke(adapter, "TerminateBatching");
+				Assert.IsFalse(IsPrepared(cmd));
+				Assert.AreEqual(7L, Scalar(conn, "SELECT COUNT(*) FROM test"));
+			}
+		}
+
+		[TestMethod]
+		public void FillColumnNames()
+		{
+			// Duplicate names are compared without regard to case, and a generated name
+			// must not collide with a name that appears later in the result set
+			CompareFill("SELECT id, name, ID, name AS name1, name, 1 AS \"\", 2 AS \"\" FROM test ORDER BY id",
+				(adapter, dataSet) => adapter.Fill(dataSet));
+		}
+
+		[TestMethod]
+		public void FillDataTables()
+		{
+			// The UPDATE doesn't generate a result set and must not use up a table
+			CompareFill("SELECT id FROM test ORDER BY id; UPDATE test SET name = name; SELECT name FROM test ORDER BY id",
+				(adapter, dataSet) => adapter.Fill(0, 0, dataSet.Tables.Add("first"), dataSet.Tables.Add("second")));
+
+			CompareFill("SELECT id, name FROM test ORDER BY id",
+				(adapter, dataSet) => adapter.Fill(1, 2, dataSet.Tables.Add("range")));
+		}
+
+		[TestMethod]
+		public void FillError()
+		{
+			int fastErrors = 0, baseErrors = 0;
+
+			// The name column can only be loaded into the existing table for the one
+			// row where it happens to be numeric, every other row raises FillError
+			CompareFill("SELECT id, name FROM test ORDER BY id", (adapter, dataSet) =>
+			{
+				dataSet.Tables.Add("Table").Columns.Add("name", typeof(int));
+				adapter.FillError += (sender, args) =>
+				{
+					Assert.IsInstanceOfType(args.Errors, typeof(ArgumentException));
+					if(adapter.TableMappings.Count == 0) fastErrors++; else baseErrors++;
+					args.Continue = true;
+				};
+				return adapter.Fill(dataSet);
+			});
+
+			Assert.AreEqual(3, fastErrors);
+			Assert.AreEqual(baseErrors, fastErrors);
+
+			// Without a handler, the error is thrown from Fill
+			using(SqliteConnection conn = OpenDatabase())
+			using(SqliteDataAdapter adapter = new SqliteDataAdapter("SELECT id, name FROM test ORDER BY id", conn))
+			{
+				DataSet dataSet = new DataSet();
+				dataSet.Tables.Add("Table").Columns.Add("name", typeof(int));
+				Assert.ThrowsException<ArgumentException>(() => adapter.Fill(dataSet));
+			}
+		}
+
+		[TestMethod]
+		public void FillIgnore()
+		{
+			// Only the existing columns of existing tables are loaded
+			CompareFill("SELECT id, name FROM test ORDER BY id; SELECT id FROM test", (adapter, dataSet) =>
+			{
+				adapter.MissingSchemaAction = MissingSchemaAction.Ignore;
+				DataTable table = dataSet.Tables.Add("Table");
+				table.Columns.Add("name", typeof(string));
+				table.Columns.Add("other", typeof(string)).DefaultValue = "default";
+				return adapter.Fill(dataSet);
+			});
+
+			// A table without any matching columns doesn't get any rows
+			CompareFill("SELECT id, name FROM test ORDER BY id", (adapter, dataSet) =>
+			{
+				adapter.MissingSchemaAction = MissingSchemaAction.Ignore;
+				dataSet.Tables.Add("Table").Columns.Add("other", typeof(string));
+				return adapter.Fill(dataSet);
+			});
+		}
+
+		[TestMethod]
+		public void FillLoadOption()
+		{
+			foreach(LoadOption option in new LoadOption[] { LoadOption.OverwriteChanges, LoadOption.PreserveChanges, LoadOption.Upsert })
+			{
+				CompareFill("SELECT id, name FROM test ORDER BY id", (adapter, dataSet) =>
+				{
+					DataTable table = dataSet.Tables.Add("Table");
+					table.Columns.Add("id", typeof(long));
+					table.Columns.Add("name", typeof(string));
+					table.PrimaryKey = new DataColumn[] { table.Columns["id"] };
+
+					// One unchanged row, one modified row and one added row
+					table.Rows.Add(1L, "original");
+					table.Rows.Add(2L, "original");
+					table.AcceptChanges();
+					table.Rows[1]["name"] = "modified";
+					table.Rows.Add(3L, "added");
+
+					adapter.FillLoadOption = option;
+					return adapter.Fill(dataSet);
+				});
+			}
+		}
+
+		[TestMethod]
+		public void FillMultipleResults()
+		{
+			CompareFill("SELECT id, name FROM test ORDER BY id; SELECT name, id FROM test WHERE id > 2; SELECT COUNT(*) FROM test",
+				(adapter, dataSet) => adapter.Fill(dataSet));
+
+			CompareFill("SELECT id, name FROM test ORDER BY id; SELECT name FROM test",
+				(adapter, dataSet) => adapter.Fill(dataSet, "source"));
+		}
+
+		[TestMethod]
+		public void UpdateBatch()
+		{
+			using(SqliteConnection conn = OpenDatabase())
+			using(SqliteDataAdapter adapter = CreateAdapter(conn, "INSERT INTO test(id, name) VALUES(@id, @name)"))
+			{
+				DataTable table = new DataTable();
+				adapter.Fill(table);
+
+				table.Rows[0]["name"] = "changed";
+				table.Rows[1].Delete();
+				table.Rows.Add(10L, "ten");
+				table.Rows.Add(11L, "eleven");
+
+				// A command that the application prepared itself is left alone
+				adapter.UpdateCommand.Prepare();
+
+				Assert.AreEqual(4, adapter.Update(table));
+				Assert.AreEqual(6L, Scalar(conn, "SELECT COUNT(*) FROM test"));
+				Assert.AreEqual("changed", Convert.ToString(Scalar(conn, "SELECT name FROM test WHERE id = 1")));
+
+				foreach(DataRow row in table.Rows) Assert.AreEqual(DataRowState.Unchanged, row.RowState);
+
+				Assert.IsTrue(IsPrepared(adapter.UpdateCommand));
+				Assert.IsFalse(IsPrepared(adapter.InsertCommand));
+				Assert.IsFalse(IsPrepared(adapter.DeleteCommand));
+			}
+		}
+
+		[TestMethod]
+		public void UpdateBatchContinueOnError()
+		{
+			using(SqliteConnection conn = OpenDatabase())
+			using(SqliteDataAdapter adapter = CreateAdapter(conn, "INSERT INTO test(id, name) VALUES(@id, @name)"))
+			{
+				DataTable table = new DataTable();
+				adapter.Fill(table);
+
+				table.Rows.Add(10L, "ten");
+				DataRow duplicate = table.Rows.Add(1L, "duplicate");
+				table.Rows.Add(11L, "eleven");
+
+				// Only the row that failed is left with an error, the rest are committed
+				adapter.ContinueUpdateOnError = true;
+				adapter.Update(table);
+
+				Assert.AreEqual(7L, Scalar(conn, "SELECT COUNT(*) FROM test"));
+				Assert.AreEqual(1, table.GetErrors().Length);
+				Assert.AreSame(duplicate, table.GetErrors()[0]);
+				Assert.AreEqual(DataRowState.Added, duplicate.RowState);
+			}
+		}
+
+		[TestMethod]
+		public void UpdateBatchEngineRollback()
+		{
+			using(SqliteConnection conn = OpenDatabase())
+			using(SqliteDataAdapter adapter = CreateAdapter(conn, "INSERT OR ROLLBACK INTO test(id, name) VALUES(@id, @name)"))
+			{
+				DataTable table = new DataTable();
+				adapter.Fill(table);
+
+				table.Rows.Add(10L, "ten");
+				table.Rows.Add(1L, "duplicate");
+				table.Rows.Add(11L, "eleven");
+
+				// ON CONFLICT ROLLBACK throws away the whole batch transaction, so every
+				// row fails, including the one that had already been inserted
+				adapter.ContinueUpdateOnError = true;
+				adapter.Update(table);
+
+				Assert.AreEqual(5L, Scalar(conn, "SELECT COUNT(*) FROM test"));
+				Assert.AreEqual(3, table.GetErrors().Length);
+				foreach(DataRow row in table.GetErrors()) Assert.AreEqual(DataRowState.Added, row.RowState);
+				Assert.IsFalse(conn.InTransaction);
+			}
+		}
+
+		//-------------------------------------------------------------------
+		// Helpers
+
+		private static void AssertTablesEqual(DataTable expected, DataTable actual)
+		{
+			Assert.AreEqual(expected.TableName, actual.TableName);
+			Assert.AreEqual(expected.Columns.Count, actual.Columns.Count);
+
+			for(int index = 0; index < expected.Columns.Count; index++)
+			{
+				Assert.AreEqual(expected.Columns[index].ColumnName, actual.Columns[index].ColumnName);
+				Assert.AreEqual(expected.Columns[index].DataType, actual.Columns[index].DataType);
+			}
+
+			Assert.AreEqual(expected.Rows.Count, actual.Rows.Count);
+
+			for(int index = 0; index < expected.Rows.Count; index++)
+			{
+				DataRow expectedRow = expected.Rows[index], actualRow = actual.Rows[index];
+
+				Assert.AreEqual(expectedRow.RowState, actualRow.RowState);
+				if(expectedRow.RowState == DataRowState.Deleted) continue;
+
+				CollectionAssert.AreEqual(expectedRow.ItemArray, actualRow.ItemArray);
+				if(expectedRow.HasVersion(DataRowVersion.Original))
+					for(int column = 0; column < expected.Columns.Count; column++)
+						Assert.AreEqual(expectedRow[column, DataRowVersion.Original], actualRow[column, DataRowVersion.Original]);
+			}
+		}
+
+		// Runs the same fill operation through the adapter's own implementation and
+		// the generic DbDataAdapter one, which is used whenever there are table mappings
+		private static void CompareFill(string sql, Func<SqliteDataAdapter, DataSet, int> fill)
+		{
+			using(SqliteConnection conn = OpenDatabase())
+			{
+				DataSet fastSet = new DataSet(), baseSet = new DataSet();
+				int fastRows, baseRows;
+
+				using(SqliteDataAdapter adapter = new SqliteDataAdapter(sql, conn)) fastRows = fill(adapter, fastSet);
+
+				using(SqliteDataAdapter adapter = new SqliteDataAdapter(sql, conn))
+				{
+					adapter.TableMappings.Add("Table", "Table");
+					baseRows = fill(adapter, baseSet);
+				}
+
+				Assert.AreEqual(baseRows, fastRows);
+				Assert.AreEqual(baseSet.Tables.Count, fastSet.Tables.Count);
+				for(int index = 0; index < baseSet.Tables.Count; index++) AssertTablesEqual(baseSet.Tables[index], fastSet.Tables[index]);
+			}
+		}
+
+		private static SqliteDataAdapter CreateAdapter(SqliteConnection conn, string insert)
+		{
+			SqliteDataAdapter adapter = new SqliteDataAdapter("SELECT id, name FROM test ORDER BY id", conn);
+
+			adapter.InsertCommand = CreateCommand(conn, insert, "id", "name");
+			adapter.UpdateCommand = CreateCommand(conn, "UPDATE test SET name = @name WHERE id = @id", "name", "id");
+			adapter.DeleteCommand = CreateCommand(conn, "DELETE FROM test WHERE id = @id", "id");
+			adapter.UpdateBatchSize = 0;
+
+			return adapter;
+		}
+
+		private static SqliteCommand CreateCommand(SqliteConnection conn, string sql, params string[] columns)
+		{
+			SqliteCommand cmd = conn.CreateCommand();
+			cmd.CommandText = sql;
+			cmd.UpdatedRowSource = SqliteUpdateRowSource.None;
+
+			foreach(string column in columns) cmd.Parameters.Add("@" + column).SourceColumn = column;
+			return cmd;
+		}
+
+		// The batching members are protected and IsPrepared is internal
+		private static object Invoke(SqliteDataAdapter adapter, string method, params object[] args)
+		{
+			return typeof(SqliteDataAdapter).GetMethod(method, BindingFlags.Instance | BindingFlags.NonPublic).Invoke(adapter, args);
+		}
+
+		private static bool IsPrepared(SqliteCommand cmd)
+		{
+			return (bool)typeof(SqliteCommand).GetProperty("IsPrepared", BindingFlags.Instance | BindingFlags.NonPublic).GetValue(cmd);
+		}
+
+		private static SqliteConnection OpenDatabase()
+		{
+			SqliteConnection conn = new SqliteConnection("Data Source=:memory:");
+			conn.Open();
+
+			using(SqliteCommand cmd = conn.CreateCommand())
+			{
+				cmd.CommandText = "CREATE TABLE test(id INTEGER PRIMARY KEY, name TEXT)";
+				cmd.ExecuteNonQuery();
+
+				cmd.CommandText = "INSERT INTO test VALUES(1, 'one'), (2, 'original'), (3, '3'), (4, NULL), (5, 'five')";
+				cmd.ExecuteNonQuery();
+			}
+
+			return conn;
+		}
+
+		private static object Scalar(SqliteConnection conn, string sql)
+		{
+			using(SqliteCommand cmd = conn.CreateCommand())
+			{
+				cmd.CommandText = sql;
+				return cmd.ExecuteScalar();
+			}
+		}
+	}
+}
@@ -0,0 +1,172 @@
+﻿using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Data;
+using System.Data.Common;
+using System.IO;
+using System.Text;
+using zuki.data.sqlite;
+
+namespace sqlite.test
+{
+	[TestClass]
+	public class DataReader
+	{
+		[TestMethod]
+		public void SchemaTableAttachedDatabase()
+		{
+			using(SqliteConnection conn = new SqliteConnection("Data Source=:memory:"))
+			{
+				conn.Open();
+				Execute(conn, "ATTACH DATABASE ':memory:' AS other");
+				Execute(conn, "CREATE TABLE other.test(id INTEGER PRIMARY KEY, name TEXT)");
+
+				using(SqliteCommand cmd = conn.CreateCommand())
+				{
+					cmd.CommandText = "SELECT id, name FROM other.test";
+					cmd.Prepare();
+
+					DataTable schema = GetSchemaTable(cmd);
+					Assert.AreEqual(2, schema.Rows.Count);
+					Assert.AreEqual("other", schema.Rows[1][SchemaTableOptionalColumn.BaseCatalogName]);
+					Assert.AreEqual("test", schema.Rows[1][SchemaTableColumn.BaseTableName]);
+					Assert.AreEqual(true, schema.Rows[0][SchemaTableColumn.IsKey]);
+					Assert.AreEqual(true, schema.Rows[1][SchemaTableColumn.AllowDBNull]);
+
+					// Changing the attached database's schema must be picked up even though
+					// the prepared statement hasn't been executed (and re-prepared) since
+					Execute(conn, "DROP TABLE other.test");
+					Execute(conn, "CREATE TABLE other.test(id INTEGER PRIMARY KEY, name TEXT NOT NULL)");
+
+					schema = GetSchemaTable(cmd);
+					Assert.AreEqual(false, schema.Rows[1][SchemaTableColumn.AllowDBNull]);
+				}
+			}
+		}
+
+		[TestMethod]
+		public void SequentialGetStream()
+		{
+			using(SqliteConnection conn = OpenDatabase())
+			using(SqliteCommand cmd = conn.CreateCommand())
+			{
+				cmd.CommandText = "SELECT id, data, text FROM test ORDER BY id";
+
+				using(SqliteDataReader reader = cmd.ExecuteReader(SqliteCommandBehavior.SequentialAccess))
+				{
+					Assert.IsTrue(reader.Read());
+					Assert.AreEqual(1L, reader.GetInt64(0));
+
+					Stream stream = reader.GetStream(1);
+					Assert.AreEqual(4096L, stream.Length);
+					Assert.IsTrue(stream.CanRead);
+					Assert.IsFalse(stream.CanWrite);
+
+					// Read the value back in small pieces to exercise the position tracking
+					byte[] buffer = new byte[4096];
+					int offset = 0, read;
+					while((read = stream.Read(buffer, offset, Math.Min(100, buffer.Length - offset))) > 0) offset += read;
+					Assert.AreEqual(4096, offset);
+					for(int index = 0; index < buffer.Length; index++) Assert.AreEqual((byte)(index % 256), buffer[index]);
+
+					// Earlier columns can't be read once a later one has been accessed
+					ThrowsInvalidOperation(() => reader.GetInt64(0));
+
+					// The stream can't be used after the reader moves to the next row
+					Assert.IsTrue(reader.Read());
+					ThrowsInvalidOperation(() => stream.Read(buffer, 0, 1));
+
+					// The sequential position is reset for each new row
+					Assert.AreEqual(2L, reader.GetInt64(0));
+					Assert.ThrowsException<InvalidCastException>(() => reader.GetStream(1));
+				}
+			}
+		}
+
+		[TestMethod]
+		public void SequentialGetTextReader()
+		{
+			using(SqliteConnection conn = OpenDatabase())
+			using(SqliteCommand cmd = conn.CreateCommand())
+			{
+				cmd.CommandText = "SELECT id, data, text FROM test ORDER BY id";
+
+				using(SqliteDataReader reader = cmd.ExecuteReader(SqliteCommandBehavior.SequentialAccess))
+				{
+					Assert.IsTrue(reader.Read());
+
+					TextReader text = reader.GetTextReader(2);
+					Assert.AreEqual('\u00e9', (char)text.Peek());
+					Assert.AreEqual(ExpectedText(), text.ReadToEnd());
+					Assert.AreEqual(-1, text.Read());
+
+					// The same column can be read again, but not an earlier one
+					Assert.AreEqual(ExpectedText(), reader.GetTextReader(2).ReadToEnd());
+					ThrowsInvalidOperation(() => reader.GetStream(1));
+
+					// GetBinaryReader() isn't available with SequentialAccess
+					ThrowsInvalidOperation(() => reader.GetBinaryReader(2));
+
+					Assert.IsTrue(reader.Read());
+					ThrowsInvalidOperation(() => text.Read());
+					Assert.AreEqual(string.Empty, reader.GetTextReader(2).ReadToEnd());
+				}
+			}
+		}
+
+		//-------------------------------------------------------------------
+		// Helpers
+
+		private static void Execute(SqliteConnection conn, string sql)
+		{
+			using(SqliteCommand cmd = conn.CreateCommand())
+			{
+				cmd.CommandText = sql;
+				cmd.ExecuteNonQuery();
+			}
+		}
+
+		private static string ExpectedText()
+		{
+			StringBuilder builder = new StringBuilder();
+			for(int index = 0; index < 1000; index++) builder.Append("\u00e9t\u00e9 ");
+			return builder.ToString();
+		}
+
+		private static DataTable GetSchemaTable(SqliteCommand cmd)
+		{
+			using(SqliteDataReader reader = cmd.ExecuteReader(SqliteCommandBehavior.SchemaOnly)) return reader.GetSchemaTable();
+		}
+
+		private static SqliteConnection OpenDatabase()
+		{
+			SqliteConnection conn = new SqliteConnection("Data Source=:memory:");
+			conn.Open();
+
+			byte[] data = new byte[4096];
+			for(int index = 0; index < data.Length; index++) data[index] = (byte)(index % 256);
+
+			using(SqliteCommand cmd = conn.CreateCommand())
+			{
+				cmd.CommandText = "CREATE TABLE test(id INTEGER PRIMARY KEY, data BLOB, text TEXT)";
+				cmd.ExecuteNonQuery();
+
+				cmd.CommandText = "INSERT INTO test VALUES(1, @data, @text), (2, NULL, '')";
+				cmd.Parameters.Add("@data").Value = data;
+				cmd.Parameters.Add("@text").Value = ExpectedText();
+				cmd.ExecuteNonQuery();
+			}
+
+			return conn;
+		}
+
+		// The sequential access and obsolete row exceptions are internal types
+		// that derive from InvalidOperationException
+		private static void ThrowsInvalidOperation(Action action)
+		{
+			try { action(); }
+			catch(InvalidOperationException) { return; }
+
+			Assert.Fail("Expected an InvalidOperationException");
+		}
+	}
+}
@@ -0,0 +1,134 @@
+﻿using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Collections.Generic;
+using System.Data;
+using System.IO;
+using System.Text;
+using zuki.data.sqlite;
+
+namespace sqlite.test
+{
+	[TestClass]
+	public class DataSourceEnumerator
+	{
+		[TestMethod]
+		public void HeaderDecoding()
+		{
+			string folder = CreateFolder();
+
+			try
+			{
+				// A page size of 1 means 65536; the page count comes from the header
+				// when the change counter matches the version-valid-for number
+				WriteHeader(Path.Combine(folder, "wal.db"), 1, 2, 2, 65536 * 3, 3);
+
+				// Without a valid in-header size, the page count is the file length
+				// divided by the page size
+				WriteHeader(Path.Combine(folder, "legacy.db"), 4096, 1, 1, 4096 * 2, 0);
+
+				File.WriteAllText(Path.Combine(folder, "text.db"), "This is not a database");
+				File.WriteAllBytes(Path.Combine(folder, "short.db"), Encoding.ASCII.GetBytes("SQLite format 3\0"));
+
+				Dictionary<string, SqliteDataSourceInfo> infos = new Dictionary<string, SqliteDataSourceInfo>(StringComparer.OrdinalIgnoreCase);
+				foreach(SqliteDataSourceInfo info in new SqliteDataSourceEnumerator(folder).EnumerateDataSources())
+					infos.Add(Path.GetFileName(info.FileName), info);
+
+				Assert.AreEqual(2, infos.Count);
+
+				SqliteDataSourceInfo wal = infos["wal.db"];
+				Assert.AreEqual(65536, wal.PageSize);
+				Assert.AreEqual(3L, wal.PageCount);
+				Assert.IsTrue(wal.IsWalMode);
+				Assert.AreEqual(2, (int)wal.WriteVersion);
+				Assert.AreEqual(2, (int)wal.ReadVersion);
+				Assert.AreEqual(SqliteTextEncodingMode.UTF16LittleEndian, wal.TextEncoding);
+				Assert.AreEqual(42, wal.SchemaCookie);
+
+				SqliteDataSourceInfo legacy = infos["legacy.db"];
+				Assert.AreEqual(4096, legacy.PageSize);
+				Assert.AreEqual(2L, legacy.PageCount);
+				Assert.IsFalse(legacy.IsWalMode);
+				Assert.AreEqual(SqliteTextEncodingMode.UTF8, legacy.TextEncoding);
+			}
+
+			finally { Directory.Delete(folder, true); }
+		}
+
+		[TestMethod]
+		public void RecursiveSorted()
+		{
+			string folder = CreateFolder();
+
+			try
+			{
+				Directory.CreateDirectory(Path.Combine(folder, "sub", "deeper"));
+
+				WriteHeader(Path.Combine(folder, "b.db"), 4096, 1, 1, 4096, 1);
+				WriteHeader(Path.Combine(folder, "A.sqlite"), 4096, 1, 1, 4096, 1);
+				WriteHeader(Path.Combine(folder, "sub", "c.db"), 4096, 1, 1, 4096, 1);
+				WriteHeader(Path.Combine(folder, "sub", "deeper", "a.db"), 4096, 1, 1, 4096, 1);
+
+				SqliteDataSourceEnumerator enumerator = new SqliteDataSourceEnumerator(folder);
+				Assert.AreEqual(2, enumerator.GetDataSources().Rows.Count);
+
+				// Overlapping patterns must not produce the same file twice
+				enumerator.SearchPattern = "*.db; *.d*";
+				Assert.AreEqual(1, enumerator.GetDataSources().Rows.Count);
+
+				enumerator.SearchPattern = "*";
+				enumerator.Recursive = true;
+
+				DataTable sources = enumerator.GetDataSources();
+				string[] expected = new string[] { Path.Combine(folder, "A.sqlite"), Path.Combine(folder, "b.db"),
+					Path.Combine(folder, "sub", "c.db"), Path.Combine(folder, "sub", "deeper", "a.db") };
+
+				Assert.AreEqual(expected.Length, sources.Rows.Count);
+				for(int index = 0; index < expected.Length; index++) Assert.AreEqual(expected[index], sources.Rows[index]["ServerName"]);
+
+				Assert.AreEqual("A", sources.Rows[0]["InstanceName"]);
+				Assert.AreEqual("W1;R1", sources.Rows[0]["Version"]);
+			}
+
+			finally { Directory.Delete(folder, true); }
+		}
+
+		//-------------------------------------------------------------------
+		// Helpers
+
+		private static string CreateFolder()
+		{
+			string folder = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName());
+			Directory.CreateDirectory(folder);
+			return folder;
+		}
+
+		private static void WriteBigEndian(byte[] buffer, int offset, uint value)
+		{
+			buffer[offset] = (byte)(value >> 24);
+			buffer[offset + 1] = (byte)(value >> 16);
+			buffer[offset + 2] = (byte)(value >> 8);
+			buffer[offset + 3] = (byte)value;
+		}
+
+		// Writes a database header padded out to the specified file length.  The
+		// page size is written as is, so use 1 rather than 65536
+		private static void WriteHeader(string path, int pageSize, byte writeVersion, byte readVersion, int length, uint pageCount)
+		{
+			byte[] file = new byte[length];
+			Encoding.ASCII.GetBytes("SQLite format 3\0").CopyTo(file, 0);
+
+			file[16] = (byte)(pageSize >> 8);
+			file[17] = (byte)pageSize;
+			file[18] = writeVersion;
+			file[19] = readVersion;
+
+			WriteBigEndian(file, 24, 5);										// File change counter
+			WriteBigEndian(file, 28, pageCount);								// In-header database size
+			WriteBigEndian(file, 40, 42);										// Schema cookie
+			WriteBigEndian(file, 56, (writeVersion == 2) ? 2u : 1u);			// Text encoding
+			WriteBigEndian(file, 92, 5);										// Version-valid-for number
+
+			File.WriteAllBytes(path, file);
+		}
+	}
+}
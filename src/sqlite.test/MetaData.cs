@@ -0,0 +1,189 @@
+﻿using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Data;
+using zuki.data.sqlite;
+
+namespace sqlite.test
+{
+	[TestClass]
+	public class MetaData
+	{
+		[TestMethod]
+		public void Columns()
+		{
+			using(SqliteConnection conn = OpenDatabase())
+			{
+				DataTable dt = conn.GetSchema("Columns", new string[] { "main", "parent" });
+				Assert.AreEqual(3, dt.Rows.Count);
+
+				// An INTEGER PRIMARY KEY is an alias for the rowid and can't be NULL
+				Assert.AreEqual("id", dt.Rows[0]["COLUMN_NAME"]);
+				Assert.AreEqual("INTEGER", dt.Rows[0]["DATA_TYPE"]);
+				Assert.AreEqual(false, dt.Rows[0]["IS_NULLABLE"]);
+				Assert.AreEqual(1, dt.Rows[0]["PRIMARY_KEY_ORDINAL"]);
+
+				Assert.AreEqual("code", dt.Rows[1]["COLUMN_NAME"]);
+				Assert.AreEqual(false, dt.Rows[1]["IS_NULLABLE"]);
+
+				Assert.AreEqual("note", dt.Rows[2]["COLUMN_NAME"]);
+				Assert.AreEqual(2, dt.Rows[2]["ORDINAL_POSITION"]);
+				Assert.AreEqual("'x'", dt.Rows[2]["COLUMN_DEFAULT"]);
+				Assert.AreEqual(true, dt.Rows[2]["IS_NULLABLE"]);
+
+				// Neither a column of a composite primary key nor a primary key that isn't
+				// an INTEGER is a rowid alias
+				dt = conn.GetSchema("Columns", new string[] { "main", "child" });
+				Assert.AreEqual(3, dt.Rows.Count);
+				Assert.AreEqual(true, dt.Rows[0]["IS_NULLABLE"]);
+				Assert.AreEqual(2, dt.Rows[1]["PRIMARY_KEY_ORDINAL"]);
+
+				dt = conn.GetSchema("Columns", new string[] { "other", "parent", "id" });
+				Assert.AreEqual(1, dt.Rows.Count);
+				Assert.AreEqual("TEXT", dt.Rows[0]["DATA_TYPE"]);
+				Assert.AreEqual(true, dt.Rows[0]["IS_NULLABLE"]);
+
+				dt = conn.GetSchema("Columns", new string[] { null, null, "value" });
+				Assert.AreEqual(1, dt.Rows.Count);
+				Assert.AreEqual("REAL", dt.Rows[0]["DATA_TYPE"]);
+			}
+		}
+
+		[TestMethod]
+		public void ForeignKeys()
+		{
+			using(SqliteConnection conn = OpenDatabase())
+			{
+				DataTable dt = conn.GetSchema("ForeignKeys", new string[] { "main", "child" });
+				Assert.AreEqual(1, dt.Rows.Count);
+				Assert.AreEqual("parent_id", dt.Rows[0]["COLUMN_NAME"]);
+				Assert.AreEqual("parent", dt.Rows[0]["REFERENCED_TABLE_NAME"]);
+				Assert.AreEqual("id", dt.Rows[0]["REFERENCED_COLUMN_NAME"]);
+				Assert.AreEqual("NO ACTION", dt.Rows[0]["UPDATE_RULE"]);
+				Assert.AreEqual("CASCADE", dt.Rows[0]["DELETE_RULE"]);
+
+				Assert.AreEqual(1, conn.GetSchema("ForeignKeys", new string[] { null, null, "parent" }).Rows.Count);
+				Assert.AreEqual(0, conn.GetSchema("ForeignKeys", new string[] { null, null, "child" }).Rows.Count);
+				Assert.AreEqual(0, conn.GetSchema("ForeignKeys", new string[] { "other" }).Rows.Count);
+			}
+		}
+
+		[TestMethod]
+		public void IndexColumns()
+		{
+			using(SqliteConnection conn = OpenDatabase())
+			{
+				DataTable dt = conn.GetSchema("IndexColumns", new string[] { "main", "child" });
+				Assert.AreEqual(3, dt.Rows.Count);
+
+				DataRow row = conn.GetSchema("IndexColumns", new string[] { "main", "child", "child_value" }).Rows[0];
+				Assert.AreEqual("value", row["COLUMN_NAME"]);
+				Assert.AreEqual(0, row["ORDINAL_POSITION"]);
+				Assert.AreEqual(2, row["TABLE_ORDINAL"]);
+				Assert.AreEqual(true, row["IS_DESCENDING"]);
+				Assert.AreEqual("BINARY", row["COLLATION_NAME"]);
+
+				dt = conn.GetSchema("IndexColumns", new string[] { "main", "child", null, "parent_id" });
+				Assert.AreEqual(1, dt.Rows.Count);
+				Assert.AreEqual("sqlite_autoindex_child_1", dt.Rows[0]["INDEX_NAME"]);
+				Assert.AreEqual(1, dt.Rows[0]["ORDINAL_POSITION"]);
+				Assert.AreEqual(false, dt.Rows[0]["IS_DESCENDING"]);
+			}
+		}
+
+		[TestMethod]
+		public void Indexes()
+		{
+			using(SqliteConnection conn = OpenDatabase())
+			{
+				DataTable dt = conn.GetSchema("Indexes", new string[] { "main" });
+				Assert.AreEqual(3, dt.Rows.Count);
+
+				Assert.AreEqual("child_value", dt.Rows[0]["INDEX_NAME"]);
+				Assert.AreEqual(false, dt.Rows[0]["IS_UNIQUE"]);
+				Assert.AreEqual("c", dt.Rows[0]["ORIGIN"]);
+
+				Assert.AreEqual("sqlite_autoindex_child_1", dt.Rows[1]["INDEX_NAME"]);
+				Assert.AreEqual(true, dt.Rows[1]["IS_PRIMARY_KEY"]);
+
+				Assert.AreEqual("parent", dt.Rows[2]["TABLE_NAME"]);
+				Assert.AreEqual(true, dt.Rows[2]["IS_UNIQUE"]);
+				Assert.AreEqual(false, dt.Rows[2]["IS_PRIMARY_KEY"]);
+				Assert.AreEqual("u", dt.Rows[2]["ORIGIN"]);
+
+				Assert.AreEqual(1, conn.GetSchema("Indexes", new string[] { null, null, "child_value" }).Rows.Count);
+				Assert.AreEqual(1, conn.GetSchema("Indexes", new string[] { "other", "parent" }).Rows.Count);
+			}
+		}
+
+		[TestMethod]
+		public void Restrictions()
+		{
+			using(SqliteConnection conn = OpenDatabase())
+			{
+				Assert.ThrowsException<ArgumentException>(() => conn.GetSchema("Views", new string[] { "main", "parent_view", "extra" }));
+				Assert.ThrowsException<ArgumentException>(() => conn.GetSchema("NoSuchCollection"));
+			}
+		}
+
+		[TestMethod]
+		public void Tables()
+		{
+			using(SqliteConnection conn = OpenDatabase())
+			{
+				DataTable dt = conn.GetSchema("Tables", new string[] { "main", null, "table" });
+				Assert.AreEqual(2, dt.Rows.Count);
+				Assert.AreEqual("child", dt.Rows[0]["TABLE_NAME"]);
+				Assert.AreEqual("parent", dt.Rows[1]["TABLE_NAME"]);
+				Assert.AreEqual(3, dt.Rows[1]["COLUMN_COUNT"]);
+				Assert.AreEqual(false, dt.Rows[1]["WITHOUT_ROWID"]);
+
+				// Views aren't tables, and the internal schema tables are system tables
+				Assert.AreEqual(0, conn.GetSchema("Tables", new string[] { null, "parent_view" }).Rows.Count);
+
+				dt = conn.GetSchema("Tables", new string[] { "other" });
+				Assert.AreEqual(2, dt.Rows.Count);
+				Assert.AreEqual("parent", dt.Rows[0]["TABLE_NAME"]);
+				Assert.AreEqual("sqlite_schema", dt.Rows[1]["TABLE_NAME"]);
+				Assert.AreEqual("SYSTEM TABLE", dt.Rows[1]["TABLE_TYPE"]);
+			}
+		}
+
+		[TestMethod]
+		public void Views()
+		{
+			using(SqliteConnection conn = OpenDatabase())
+			{
+				DataTable dt = conn.GetSchema("Views");
+				Assert.AreEqual(1, dt.Rows.Count);
+				Assert.AreEqual("main", dt.Rows[0]["TABLE_CATALOG"]);
+				Assert.AreEqual("parent_view", dt.Rows[0]["TABLE_NAME"]);
+				Assert.AreEqual(2, dt.Rows[0]["COLUMN_COUNT"]);
+
+				Assert.AreEqual(0, conn.GetSchema("Views", new string[] { "other" }).Rows.Count);
+			}
+		}
+
+		//-------------------------------------------------------------------
+		// Helpers
+
+		private static SqliteConnection OpenDatabase()
+		{
+			SqliteConnection conn = new SqliteConnection("Data Source=:memory:");
+			conn.Open();
+
+			using(SqliteCommand cmd = conn.CreateCommand())
+			{
+				cmd.CommandText = "CREATE TABLE parent(id INTEGER PRIMARY KEY, code TEXT NOT NULL UNIQUE, note TEXT DEFAULT 'x'); " +
+					"CREATE TABLE child(id INTEGER, parent_id INTEGER REFERENCES parent(id) ON DELETE CASCADE, value REAL, PRIMARY KEY(id, parent_id)); " +
+					"CREATE INDEX child_value ON child(value DESC); " +
+					"CREATE VIEW parent_view AS SELECT id, code FROM parent; " +
+					"ATTACH DATABASE ':memory:' AS other; " +
+					"CREATE TABLE other.parent(id TEXT PRIMARY KEY)";
+				cmd.LazyPrepare = true;
+				cmd.ExecuteNonQuery();
+			}
+
+			return conn;
+		}
+	}
+}
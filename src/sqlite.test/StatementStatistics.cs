@@ -0,0 +1,106 @@
+﻿using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Collections.Generic;
+using zuki.data.sqlite;
+
+namespace sqlite.test
+{
+	[TestClass]
+	public class StatementStatistics
+	{
+		[TestMethod]
+		public void CommandCounters()
+		{
+			using(SqliteConnection conn = OpenDatabase())
+			using(SqliteCommand cmd = conn.CreateCommand())
+			{
+				cmd.CommandText = "SELECT COUNT(*) FROM test WHERE data > 50";
+				Assert.AreEqual(49L, Convert.ToInt64(cmd.ExecuteScalar()));
+
+				SqliteStatementStatistics stats = cmd.Statistics;
+				Assert.AreEqual(1L, stats.Runs);
+				Assert.IsTrue(stats.FullScanSteps >= 99);
+				Assert.IsTrue(stats.VirtualMachineSteps > 0);
+				Assert.AreEqual(0L, stats.Sorts);
+
+				// Counters accumulate across executions until they are reset
+				cmd.ExecuteScalar();
+				Assert.AreEqual(2L, cmd.Statistics.Runs);
+
+				cmd.ResetStatistics();
+				Assert.AreEqual(0L, cmd.Statistics.Runs);
+				Assert.AreEqual(0L, cmd.Statistics.FullScanSteps);
+			}
+		}
+
+		[TestMethod]
+		public void ReaderCounters()
+		{
+			using(SqliteConnection conn = OpenDatabase())
+			using(SqliteCommand cmd = conn.CreateCommand())
+			{
+				cmd.CommandText = "SELECT value FROM test ORDER BY data DESC; SELECT a.value FROM test a, test b WHERE a.data = b.data";
+
+				using(SqliteDataReader reader = cmd.ExecuteReader())
+				{
+					do { while(reader.Read()) { } } while(reader.NextResult());
+
+					Assert.IsTrue(reader.Statistics.Sorts >= 1);
+					Assert.IsTrue(reader.Statistics.AutoIndexes >= 1);
+					Assert.AreEqual(2L, reader.Statistics.Runs);
+				}
+
+				// The reader adds it's counters to the command when it's closed
+				Assert.IsTrue(cmd.Statistics.Sorts >= 1);
+				Assert.IsTrue(cmd.Statistics.AutoIndexes >= 1);
+			}
+		}
+
+		[TestMethod]
+		public void Sampling()
+		{
+			using(SqliteConnection conn = OpenDatabase())
+			using(SqliteCommand cmd = conn.CreateCommand())
+			{
+				cmd.CommandText = "SELECT COUNT(*) FROM test";
+
+				// Sampling is disabled by default
+				cmd.ExecuteScalar();
+				Assert.AreEqual(0, conn.GetStatementStatistics().Count);
+
+				// Every second execution is sampled
+				conn.StatisticsSampleRate = 2;
+				for(int index = 0; index < 4; index++) cmd.ExecuteScalar();
+
+				Dictionary<string, SqliteStatementStatistics> samples = conn.GetStatementStatistics();
+				Assert.AreEqual(1, samples.Count);
+				Assert.AreEqual(2L, samples[cmd.CommandText].Runs);
+
+				conn.ResetStatementStatistics();
+				Assert.AreEqual(0, conn.GetStatementStatistics().Count);
+
+				Assert.ThrowsException<ArgumentOutOfRangeException>(() => conn.StatisticsSampleRate = -1);
+			}
+		}
+
+		//-------------------------------------------------------------------
+		// Helpers
+
+		private static SqliteConnection OpenDatabase()
+		{
+			SqliteConnection conn = new SqliteConnection("Data Source=:memory:");
+			conn.Open();
+
+			using(SqliteCommand cmd = conn.CreateCommand())
+			{
+				cmd.CommandText = "CREATE TABLE test(value INTEGER PRIMARY KEY, data INTEGER)";
+				cmd.ExecuteNonQuery();
+
+				cmd.CommandText = "WITH RECURSIVE n(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM n WHERE x < 100) INSERT INTO test SELECT x, x FROM n";
+				cmd.ExecuteNonQuery();
+			}
+
+			return conn;
+		}
+	}
+}
@@ -0,0 +1,198 @@
+﻿using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Data;
+using zuki.data.sqlite;
+
+namespace sqlite.test
+{
+	[TestClass]
+	public class VirtualTableStatistics
+	{
+		[TestMethod]
+		public void FullScanUsesRowCount()
+		{
+			Estimate(stats => stats.RowCount = 500, "SELECT * FROM test");
+			Assert.AreEqual(500L, StatsTable.EstimatedRows);
+			Assert.AreEqual(500.0, StatsTable.EstimatedCost);
+			Assert.IsFalse(StatsTable.UniqueScan);
+
+			// An unknown row count assumes a large table
+			Estimate(stats => stats.RowCount = -1, "SELECT * FROM test");
+			Assert.AreEqual(1000000L, StatsTable.EstimatedRows);
+		}
+
+		[TestMethod]
+		public void EqualityUsesDistinctCount()
+		{
+			Estimate(stats => { stats.RowCount = 1000; stats.SetDistinctCount(0, 100); }, "SELECT * FROM test WHERE a = 5");
+			Assert.AreEqual(10L, StatsTable.EstimatedRows);
+			Assert.AreEqual(Math.Log(1001, 2) + 10, StatsTable.EstimatedCost, 0.0001);
+			Assert.IsFalse(StatsTable.UniqueScan);
+
+			// Without a distinct count the default equality selectivity is used
+			Estimate(stats => stats.RowCount = 1000, "SELECT * FROM test WHERE a = 5");
+			Assert.AreEqual(100L, StatsTable.EstimatedRows);
+		}
+
+		[TestMethod]
+		public void EqualityOnUniqueColumn()
+		{
+			Estimate(stats => { stats.RowCount = 1000; stats.SetDistinctCount(0, 1000); }, "SELECT * FROM test WHERE a = 5");
+			Assert.AreEqual(1L, StatsTable.EstimatedRows);
+			Assert.IsTrue(StatsTable.UniqueScan);
+
+			Estimate(stats => stats.RowCount = 1000, "SELECT * FROM test WHERE rowid = 5");
+			Assert.AreEqual(1L, StatsTable.EstimatedRows);
+			Assert.IsTrue(StatsTable.UniqueScan);
+		}
+
+		[TestMethod]
+		public void RangeUsesHistogram()
+		{
+			Action<SqliteVirtualTableStatistics> configure = stats => 
+			{ 
+				stats.RowCount = 1000; 
+				stats.SetHistogram(1, new double[] { 0, 25, 50, 75, 100 }); 
+			};
+
+			Estimate(configure, "SELECT * FROM test WHERE b < 50");
+			Assert.AreEqual(500L, StatsTable.EstimatedRows);
+
+			Estimate(configure, "SELECT * FROM test WHERE b >= 90");
+			Assert.AreEqual(100L, StatsTable.EstimatedRows);
+
+			// A right-hand value that isn't known while planning uses the default
+			Estimate(configure, "SELECT * FROM test WHERE b < (SELECT 50)");
+			Assert.AreEqual(250L, StatsTable.EstimatedRows);
+		}
+
+		[TestMethod]
+		public void BuildHistogram()
+		{
+			double[] samples = new double[101];
+			for(int index = 0; index < samples.Length; index++) samples[index] = 100 - index;
+
+			double[] histogram = null;
+			Estimate(stats => 
+			{
+				stats.RowCount = 1000;
+				stats.BuildHistogram(1, samples, 4);
+				histogram = stats.GetHistogram(1);
+			}, "SELECT * FROM test WHERE b > 75");
+
+			CollectionAssert.AreEqual(new double[] { 0, 25, 50, 75, 100 }, histogram);
+			Assert.AreEqual(250L, StatsTable.EstimatedRows);
+		}
+
+		[TestMethod]
+		public void Validation()
+		{
+			Estimate(stats => 
+			{
+				Assert.ThrowsException<ArgumentOutOfRangeException>(() => stats.RowCount = -2);
+				Assert.ThrowsException<ArgumentOutOfRangeException>(() => stats.SetDistinctCount(-1, 10));
+				Assert.ThrowsException<ArgumentException>(() => stats.SetHistogram(0, new double[] { 10, 5 }));
+				Assert.ThrowsException<ArgumentException>(() => stats.SetHistogram(0, new double[] { 10 }));
+
+				stats.SetDistinctCount(3, 7);
+				Assert.AreEqual(7L, stats.GetDistinctCount(3));
+				stats.Clear();
+				Assert.AreEqual(0L, stats.GetDistinctCount(3));
+				Assert.AreEqual(-1L, stats.RowCount);
+			}, "SELECT * FROM test");
+		}
+
+		//-------------------------------------------------------------------
+		// Helpers
+
+		private static void Estimate(Action<SqliteVirtualTableStatistics> configure, string sql)
+		{
+			StatsTable.Configure = configure;
+			StatsTable.EstimatedRows = -1;
+
+			using(SqliteConnection conn = new SqliteConnection("Data Source=:memory:"))
+			{
+				conn.Open();
+				conn.RegisterVirtualTable(typeof(StatsTable), "stats");
+
+				using(SqliteCommand cmd = conn.CreateCommand())
+				{
+					cmd.CommandText = "CREATE VIRTUAL TABLE test USING stats";
+					cmd.ExecuteNonQuery();
+
+					cmd.CommandText = sql;
+					using(SqliteDataReader reader = cmd.ExecuteReader()) while(reader.Read()) { }
+				}
+			}
+		}
+
+		//-------------------------------------------------------------------
+		// StatsTable
+		//
+		// Virtual table that consumes every usable constraint and records the
+		// estimates produced by the default cost model
+
+		private class StatsTable : SqliteVirtualTable<StatsCursor>
+		{
+			public static Action<SqliteVirtualTableStatistics> Configure;
+			public static double EstimatedCost;
+			public static long EstimatedRows;
+			public static bool UniqueScan;
+
+			protected override void SelectBestIndex(SqliteIndexSelectionArgs args)
+			{
+				Statistics.Clear();
+				Configure(Statistics);
+
+				int consumed = 0;
+				foreach(SqliteIndexConstraint constraint in args.Constraints)
+					if(constraint.IsUsable) constraint.FilterArgumentIndex = ++consumed;
+
+				base.SelectBestIndex(args);
+
+				// Keep the estimate from the call with the most usable constraints;
+				// the engine may also ask for a plan with none of them
+				if((consumed > 0) || (EstimatedRows < 0))
+				{
+					EstimatedCost = args.EstimatedCost;
+					EstimatedRows = args.EstimatedRows;
+					UniqueScan = args.UniqueScan;
+				}
+			}
+
+			protected override DataTable GetSchema()
+			{
+				DataTable schema = new DataTable();
+				schema.Columns.Add("a", typeof(long));
+				schema.Columns.Add("b", typeof(double));
+				return schema;
+			}
+
+			protected override StatsCursor CreateCursor() { return new StatsCursor(); }
+			protected override void BeginTransaction() { }
+			protected override void Close() { }
+			protected override void CommitTransaction() { }
+			protected override void DeleteRow(long rowid) { throw new NotSupportedException(); }
+			protected override void InsertRow(long rowid, SqliteArgumentCollection values) { throw new NotSupportedException(); }
+			protected override long NewRowID() { throw new NotSupportedException(); }
+			protected override void Open() { }
+			protected override void RollbackTransaction() { }
+			protected override void UpdateRow(long rowid, SqliteArgumentCollection values) { throw new NotSupportedException(); }
+			protected override void UpdateRowID(long oldrowid, long newrowid) { throw new NotSupportedException(); }
+		}
+
+		//-------------------------------------------------------------------
+		// StatsCursor
+		//
+		// Cursor for StatsTable, which never has any rows
+
+		private class StatsCursor : SqliteVirtualTableCursor
+		{
+			protected override void Close() { }
+			protected override long GetRowID() { return 0; }
+			protected override void GetValue(int ordinal, SqliteResult result) { result.SetNull(); }
+			protected override bool MoveNext() { return false; }
+			protected override bool SetFilter(SqliteIndexIdentifier index, SqliteArgumentCollection args) { return false; }
+		}
+	}
+}
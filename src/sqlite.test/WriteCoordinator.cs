@@ -0,0 +1,104 @@
+﻿using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.IO;
+using System.Threading.Tasks;
+using zuki.data.sqlite;
+
+namespace sqlite.test
+{
+	[TestClass]
+	public class WriteCoordinator
+	{
+		[TestMethod]
+		public void GroupCommit()
+		{
+			string path = CreateDatabase();
+
+			try
+			{
+				Task[] tasks = new Task[50];
+
+				using(SqliteWriteCoordinator coordinator = new SqliteWriteCoordinator("Data Source=" + path, 100, TimeSpan.FromMilliseconds(50)))
+				{
+					for(int index = 0; index < tasks.Length; index++)
+					{
+						int value = index;
+						tasks[index] = coordinator.Enqueue(conn => Execute(conn, "INSERT INTO test VALUES(" + value + ")"));
+					}
+
+					Task.WaitAll(tasks);
+				}
+
+				Assert.AreEqual(50L, Count(path));
+			}
+
+			finally { File.Delete(path); }
+		}
+
+		[TestMethod]
+		public void FailedWorkItemIsIsolated()
+		{
+			string path = CreateDatabase();
+
+			try
+			{
+				using(SqliteWriteCoordinator coordinator = new SqliteWriteCoordinator("Data Source=" + path, 100, TimeSpan.FromMilliseconds(50)))
+				{
+					Task first = coordinator.Enqueue(conn => Execute(conn, "INSERT INTO test VALUES(1)"));
+					Task failed = coordinator.Enqueue(conn => { Execute(conn, "INSERT INTO test VALUES(2)"); Execute(conn, "INSERT INTO test VALUES(1)"); });
+					Task last = coordinator.Enqueue(conn => Execute(conn, "INSERT INTO test VALUES(3)"));
+
+					// Only the failing work item is faulted, and only it's own changes
+					// are rolled back; the rest of the batch still commits
+					first.Wait();
+					last.Wait();
+					Assert.ThrowsException<AggregateException>(() => failed.Wait());
+					Assert.IsTrue(failed.IsFaulted);
+				}
+
+				Assert.AreEqual(2L, Count(path));
+			}
+
+			finally { File.Delete(path); }
+		}
+
+		//-------------------------------------------------------------------
+		// Helpers
+
+		private static string CreateDatabase()
+		{
+			string path = Path.GetTempFileName();
+
+			using(SqliteConnection conn = new SqliteConnection("Data Source=" + path))
+			{
+				conn.Open();
+				Execute(conn, "CREATE TABLE test(value INTEGER PRIMARY KEY)");
+			}
+
+			return path;
+		}
+
+		private static long Count(string path)
+		{
+			using(SqliteConnection conn = new SqliteConnection("Data Source=" + path))
+			{
+				conn.Open();
+
+				using(SqliteCommand cmd = conn.CreateCommand())
+				{
+					cmd.CommandText = "SELECT COUNT(*) FROM test";
+					return Convert.ToInt64(cmd.ExecuteScalar());
+				}
+			}
+		}
+
+		private static void Execute(SqliteConnection conn, string sql)
+		{
+			using(SqliteCommand cmd = conn.CreateCommand())
+			{
+				cmd.CommandText = sql;
+				cmd.ExecuteNonQuery();
+			}
+		}
+	}
+}
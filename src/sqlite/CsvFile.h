@@ -0,0 +1,518 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __CSVFILE_H_
+#define __CSVFILE_H_
+#pragma once
+
+#include <emmintrin.h>					// Include SSE2 intrinsic declarations
+#include <locale.h>						// Include CRT locale declarations
+#include <stdlib.h>						// Include CRT conversion declarations
+#include <string>						// Include STL string<> declarations
+#include <vector>						// Include STL vector<> declarations
+#include "RowBatch.h"					// Include RowBatch declarations
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+#pragma managed(push, off)				// SSE2 intrinsics require native code
+
+//---------------------------------------------------------------------------
+// Class CsvFile
+//
+// CsvFile is a read-only, memory-mapped view of a delimited text file.  The
+// parser works directly against the mapped view; the common case of finding
+// the next delimiter, quote or line break is done sixteen bytes at a time with
+// SSE2 compares, and rows are written straight into a RowBatch so the engine
+// is served without any managed code in the loop.  Records are numbered from
+// one, and a sparse index of record offsets can be built to make seeking to a
+// specific record cheap when the file is queried repeatedly.
+//---------------------------------------------------------------------------
+
+class CsvFile
+{
+public:
+
+	// Constructor / Destructor
+	//
+	CsvFile(char delimiter) : m_delimiter(delimiter), m_file(INVALID_HANDLE_VALUE), m_mapping(NULL), 
+		m_view(NULL), m_size(0), m_first(0), m_records(-1) { m_locale = _create_locale(LC_NUMERIC, "C"); }
+
+	~CsvFile() { Close(); _free_locale(m_locale); }
+
+	//-----------------------------------------------------------------------
+	// Type Declarations
+
+	// Field
+	//
+	// Location of a single field within the mapped view
+	struct Field
+	{
+		size_t				Offset;			// Offset of the field data
+		int					Length;			// Length of the field data
+		bool				Quoted;			// Field was enclosed in quotes
+		bool				Escaped;		// Field contains doubled quotes
+	};
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// BuildIndex
+	//
+	// Scans the entire file and records the offset of every INDEX_STRIDE'th
+	// record, which also establishes the total number of records
+	void BuildIndex(void)
+	{
+		__int64 record = 1;
+
+		m_index.clear();
+
+		for(size_t offset = SkipBlankLines(m_first); offset < m_size; offset = SkipBlankLines(offset)) {
+
+			if(((record - 1) % INDEX_STRIDE) == 0) m_index.push_back(offset);
+			offset = ParseRecord(offset, NULL);
+			record++;
+		}
+
+		m_records = record - 1;
+	}
+
+	// Close
+	//
+	// Releases the mapped view and the underlying file handles
+	void Close(void)
+	{
+		if(m_view) UnmapViewOfFile(m_view);
+		if(m_mapping) CloseHandle(m_mapping);
+		if(m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+
+		m_view = NULL;
+		m_mapping = NULL;
+		m_file = INVALID_HANDLE_VALUE;
+		m_size = m_first = 0;
+		m_records = -1;
+		m_index.clear();
+	}
+
+	// Fill
+	//
+	// Parses records into a RowBatch, starting at the record located at offset,
+	// until the batch is full, the end of the file is reached, or the record
+	// number exceeds last.  Returns the number of rows written into the batch
+	int Fill(RowBatch* batch, size_t& offset, __int64& record, __int64 last, const int* types) const
+	{
+		std::vector<Field>		fields;			// Parsed record fields
+		std::string				scratch;		// Unescaped field buffer
+		int						count = 0;		// Number of rows written
+
+		while((count < batch->Capacity) && (record <= last)) {
+
+			offset = SkipBlankLines(offset);
+			if(offset >= m_size) break;
+
+			offset = ParseRecord(offset, &fields);
+
+			int columns = min(batch->ColumnCount, static_cast<int>(fields.size()));
+			for(int ordinal = 0; ordinal < columns; ordinal++) SetField(batch, count, ordinal, fields[ordinal], types[ordinal], scratch);
+
+			batch->SetRowID(count++, record++);
+		}
+
+		return count;
+	}
+
+	// GetField
+	//
+	// Copies the data for a field into a string, removing any escaped quotes
+	void GetField(const Field& field, std::string& value) const
+	{
+		value.assign(m_view + field.Offset, field.Length);
+		if(!field.Escaped) return;
+
+		// Collapse every doubled quote into a single one in place
+
+		size_t write = 0;
+		for(size_t read = 0; read < value.size(); read++) {
+
+			value[write++] = value[read];
+			if((value[read] == '"') && ((read + 1) < value.size()) && (value[read + 1] == '"')) read++;
+		}
+
+		value.resize(write);
+	}
+
+	// InferTypes
+	//
+	// Examines up to sample records starting at offset and determines the
+	// SQLITE_INTEGER, SQLITE_FLOAT or SQLITE_TEXT type of each column.  Returns
+	// the number of records examined and the number of bytes they occupied
+	int InferTypes(size_t offset, int sample, int columns, int* types, size_t& bytes) const
+	{
+		std::vector<Field>		fields;				// Parsed record fields
+		std::vector<int>		integers(columns);	// Integer values per column
+		std::vector<int>		reals(columns);		// Real values per column
+		std::vector<int>		values(columns);	// Non-empty values per column
+		__int64					integer;			// Converted integer value
+		double					real;				// Converted real value
+
+		int						record = 0;			// Number of records examined
+
+		size_t start = SkipBlankLines(offset);
+		offset = start;
+
+		for(record = 0; (record < sample) && (offset < m_size); record++) {
+
+			offset = ParseRecord(offset, &fields);
+
+			int count = min(columns, static_cast<int>(fields.size()));
+			for(int ordinal = 0; ordinal < count; ordinal++) {
+
+				const Field& field = fields[ordinal];
+				if(field.Length == 0) continue;
+
+				values[ordinal]++;
+				if(field.Quoted) continue;
+
+				if(ToInt64(field, integer)) integers[ordinal]++;
+				else if(ToDouble(field, real)) reals[ordinal]++;
+			}
+
+			offset = SkipBlankLines(offset);
+		}
+
+		// A column is numeric only if every non-empty value in the sample was
+		// numeric; columns without any values at all are treated as TEXT
+
+		for(int ordinal = 0; ordinal < columns; ordinal++) {
+
+			if(values[ordinal] == 0) types[ordinal] = SQLITE_TEXT;
+			else if(integers[ordinal] == values[ordinal]) types[ordinal] = SQLITE_INTEGER;
+			else if((integers[ordinal] + reals[ordinal]) == values[ordinal]) types[ordinal] = SQLITE_FLOAT;
+			else types[ordinal] = SQLITE_TEXT;
+		}
+
+		bytes = offset - start;
+		return record;
+	}
+
+	// Open
+	//
+	// Opens and maps the specified file; returns a Win32 error code
+	DWORD Open(const wchar_t* path)
+	{
+		LARGE_INTEGER			size;			// Size of the file
+
+		Close();
+
+		m_file = CreateFileW(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if(m_file == INVALID_HANDLE_VALUE) return GetLastError();
+
+		if(!GetFileSizeEx(m_file, &size)) { DWORD dwResult = GetLastError(); Close(); return dwResult; }
+		if(static_cast<unsigned __int64>(size.QuadPart) > SIZE_MAX) { Close(); return ERROR_FILE_TOO_LARGE; }
+
+		// Zero-length files cannot be mapped; they are simply files with no records
+
+		m_size = static_cast<size_t>(size.QuadPart);
+		if(m_size == 0) return ERROR_SUCCESS;
+
+		m_mapping = CreateFileMappingW(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if(m_mapping == NULL) { DWORD dwResult = GetLastError(); Close(); return dwResult; }
+
+		m_view = reinterpret_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+		if(m_view == NULL) { DWORD dwResult = GetLastError(); Close(); return dwResult; }
+
+		// Skip over a UTF-8 byte order mark if one is present
+
+		if((m_size >= 3) && (memcmp(m_view, "\xEF\xBB\xBF", 3) == 0)) m_first = 3;
+		return ERROR_SUCCESS;
+	}
+
+	// ParseRecord
+	//
+	// Parses the record that starts at offset and returns the offset of the
+	// next one.  If fields is NULL the record is only skipped over
+	size_t ParseRecord(size_t offset, std::vector<Field>* fields) const
+	{
+		const char*		end = m_view + m_size;		// End of the mapped view
+		const char*		pos = m_view + offset;		// Current position
+		Field			field;						// Current field
+
+		if(fields) fields->clear();
+
+		for(;;) {
+
+			field.Quoted = field.Escaped = false;
+
+			if((pos < end) && (*pos == '"')) {
+
+				// Quoted field; everything up to the closing quote is data, and
+				// a doubled quote is an escaped quote rather than the end
+
+				const char* start = ++pos;
+				field.Quoted = true;
+
+				for(;;) {
+
+					pos = reinterpret_cast<const char*>(memchr(pos, '"', end - pos));
+					if(pos == NULL) { pos = end; break; }
+
+					if(((pos + 1) < end) && (pos[1] == '"')) { field.Escaped = true; pos += 2; }
+					else break;
+				}
+
+				field.Offset = start - m_view;
+				field.Length = static_cast<int>(pos - start);
+
+				// Anything between the closing quote and the next delimiter or
+				// line break is malformed and gets ignored
+
+				if(pos < end) pos++;
+				while((pos < end) && (*pos != m_delimiter) && (*pos != '\r') && (*pos != '\n')) pos++;
+			}
+
+			else {
+
+				// Unquoted field; a quote that does not start the field is just
+				// part of the data, so keep scanning past any of those
+
+				const char* start = pos;
+
+				pos = Scan(pos, end, m_delimiter);
+				while((pos < end) && (*pos == '"')) pos = Scan(pos + 1, end, m_delimiter);
+
+				field.Offset = start - m_view;
+				field.Length = static_cast<int>(pos - start);
+			}
+
+			if(fields) fields->push_back(field);
+
+			if((pos < end) && (*pos == m_delimiter)) pos++;
+			else break;
+		}
+
+		// Consume the line break that terminated the record, if any
+
+		if((pos < end) && (*pos == '\r')) pos++;
+		if((pos < end) && (*pos == '\n')) pos++;
+
+		return pos - m_view;
+	}
+
+	// Seek
+	//
+	// Locates the offset of the specified record, using the sparse index when
+	// it has been built.  If the file contains fewer records, returns the size
+	// of the file
+	size_t Seek(__int64 record) const
+	{
+		__int64 current = 1;
+		size_t offset = m_first;
+
+		if(record <= 1) return m_first;
+
+		if(!m_index.empty()) {
+
+			size_t slot = min(static_cast<size_t>((record - 1) / INDEX_STRIDE), m_index.size() - 1);
+			current = (static_cast<__int64>(slot) * INDEX_STRIDE) + 1;
+			offset = m_index[slot];
+		}
+
+		for(offset = SkipBlankLines(offset); (current < record) && (offset < m_size); current++)
+			offset = SkipBlankLines(ParseRecord(offset, NULL));
+
+		return offset;
+	}
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// FirstRecord
+	//
+	// Gets/sets the offset of the first record in the file.  This is moved past
+	// the header line, if there is one, before any records are accessed
+	__declspec(property(get=GetFirstRecord, put=SetFirstRecord)) size_t FirstRecord;
+	size_t GetFirstRecord(void) const { return m_first; }
+	void SetFirstRecord(size_t value) { m_first = SkipBlankLines(value); }
+
+	// HasIndex
+	//
+	// Determines if the sparse record index has been built
+	__declspec(property(get=GetHasIndex)) bool HasIndex;
+	bool GetHasIndex(void) const { return (m_records >= 0); }
+
+	// RecordCount
+	//
+	// Gets the number of records in the file, or -1 if the index has not been built
+	__declspec(property(get=GetRecordCount)) __int64 RecordCount;
+	__int64 GetRecordCount(void) const { return m_records; }
+
+	// Size
+	//
+	// Gets the size of the mapped file, in bytes
+	__declspec(property(get=GetSize)) size_t Size;
+	size_t GetSize(void) const { return m_size; }
+
+	//-----------------------------------------------------------------------
+	// Public Constants
+
+	// INDEX_STRIDE
+	//
+	// Number of records between entries in the sparse record index
+	static const int INDEX_STRIDE = 1024;
+
+private:
+
+	// DISABLED COPY CONSTRUCTOR / ASSIGNMENT OPERATOR
+	CsvFile(const CsvFile& rhs);
+	CsvFile& operator=(const CsvFile& rhs);
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// Scan
+	//
+	// Locates the next delimiter, quote, carriage return or line feed character.
+	// Sixteen bytes are compared at a time until fewer than that remain
+	static const char* Scan(const char* pos, const char* end, char delimiter)
+	{
+		const __m128i delimiters = _mm_set1_epi8(delimiter);
+		const __m128i quotes = _mm_set1_epi8('"');
+		const __m128i returns = _mm_set1_epi8('\r');
+		const __m128i newlines = _mm_set1_epi8('\n');
+
+		while((end - pos) >= 16) {
+
+			__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+			__m128i matches = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, delimiters), _mm_cmpeq_epi8(block, quotes)),
+				_mm_or_si128(_mm_cmpeq_epi8(block, returns), _mm_cmpeq_epi8(block, newlines)));
+
+			unsigned long mask = static_cast<unsigned long>(_mm_movemask_epi8(matches));
+			unsigned long bit;
+
+			if(_BitScanForward(&bit, mask)) return pos + bit;
+			pos += 16;
+		}
+
+		while((pos < end) && (*pos != delimiter) && (*pos != '"') && (*pos != '\r') && (*pos != '\n')) pos++;
+		return pos;
+	}
+
+	// SetField
+	//
+	// Converts a field into a RowBatch cell based on the column type.  Values
+	// that cannot be converted are stored as TEXT so that no data is lost
+	void SetField(RowBatch* batch, int row, int ordinal, const Field& field, int type, std::string& scratch) const
+	{
+		__int64				integer;			// Converted integer value
+		double				real;				// Converted real value
+
+		if(field.Quoted || (type == SQLITE_TEXT)) {
+
+			if(!field.Escaped) batch->SetText(row, ordinal, m_view + field.Offset, field.Length);
+			else { GetField(field, scratch); batch->SetText(row, ordinal, scratch.data(), static_cast<int>(scratch.size())); }
+			return;
+		}
+
+		// Empty values in a numeric column are NULL (the cell default)
+
+		if(field.Length == 0) return;
+
+		if((type == SQLITE_INTEGER) && ToInt64(field, integer)) batch->SetInt64(row, ordinal, integer);
+		else if(ToDouble(field, real)) batch->SetDouble(row, ordinal, real);
+		else batch->SetText(row, ordinal, m_view + field.Offset, field.Length);
+	}
+
+	// SkipBlankLines
+	//
+	// Advances past any empty lines; they are not considered to be records
+	size_t SkipBlankLines(size_t offset) const
+	{
+		while((offset < m_size) && ((m_view[offset] == '\r') || (m_view[offset] == '\n'))) offset++;
+		return offset;
+	}
+
+	// ToDouble
+	//
+	// Converts a field into a floating point value using the invariant locale
+	bool ToDouble(const Field& field, double& value) const
+	{
+		char		buffer[64];			// NULL terminated copy of the field
+		char*		stop;				// Conversion stop position
+
+		// The mapped data is not NULL terminated; anything too long to copy
+		// into the local buffer isn't going to be a reasonable number anyway
+
+		if((field.Length == 0) || (field.Length >= _countof(buffer))) return false;
+
+		memcpy(buffer, m_view + field.Offset, field.Length);
+		buffer[field.Length] = '\0';
+
+		value = _strtod_l(buffer, &stop, m_locale);
+		return (stop == &buffer[field.Length]);
+	}
+
+	// ToInt64
+	//
+	// Converts a field into a 64-bit integer value, without overflow
+	bool ToInt64(const Field& field, __int64& value) const
+	{
+		const char*			pos = m_view + field.Offset;
+		const char*			end = pos + field.Length;
+		unsigned __int64	magnitude = 0;
+		bool				negative = false;
+
+		if((pos < end) && ((*pos == '-') || (*pos == '+'))) negative = (*pos++ == '-');
+		if(pos == end) return false;
+
+		for(; pos < end; pos++) {
+
+			if((*pos < '0') || (*pos > '9')) return false;
+
+			unsigned __int64 digit = static_cast<unsigned __int64>(*pos - '0');
+			if(magnitude > ((static_cast<unsigned __int64>(_I64_MAX) + 1 - digit) / 10)) return false;
+			magnitude = (magnitude * 10) + digit;
+		}
+
+		if(!negative && (magnitude > static_cast<unsigned __int64>(_I64_MAX))) return false;
+
+		value = (negative) ? static_cast<__int64>(0 - magnitude) : static_cast<__int64>(magnitude);
+		return true;
+	}
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	char					m_delimiter;		// Field delimiter character
+	HANDLE					m_file;				// File handle
+	HANDLE					m_mapping;			// File mapping handle
+	const char*				m_view;				// Mapped view of the file
+	size_t					m_size;				// Size of the mapped view
+	size_t					m_first;			// Offset of the first record
+	__int64					m_records;			// Number of records, if known
+	std::vector<size_t>		m_index;			// Sparse record offset index
+	_locale_t				m_locale;			// Invariant numeric locale
+};
+
+//---------------------------------------------------------------------------
+
+#pragma managed(pop)
+#pragma warning(pop)
+
+#endif	// __CSVFILE_H_
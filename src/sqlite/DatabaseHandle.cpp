@@ -22,6 +22,7 @@
 
 #include "stdafx.h"						// Include project pre-compiled headers
 #include "DatabaseHandle.h"				// Include DatabaseHandle declarations
+#include "TraceDispatcher.h"				// Include TraceDispatcher declarations
 
 #pragma warning(push, 4)				// Enable maximum compiler warnings
 #pragma warning(disable:4100)			// "unreferenced formal parameter"
@@ -35,7 +36,7 @@
 //	hDatabase		- The database handle to take ownership of
 
 DatabaseHandle::DatabaseHandle(Object^ caller, sqlite3* hDatabase) : 
-	m_hDatabase(hDatabase), m_cRefCount(1)
+	m_hDatabase(hDatabase), m_cRefCount(1), m_pTrace(NULL)
 {
 	if(!hDatabase) throw gcnew ArgumentNullException();	// Cannot be NULL
 
@@ -53,6 +54,11 @@ DatabaseHandle::~DatabaseHandle()
 	int nResult = sqlite3_close(m_hDatabase);
 	if(nResult != SQLITE_OK) {} /* TODO (REMOVED): throw gcnew SqliteException(m_hDatabase, nResult); */
 
+	// An adopted trace dispatcher can only be destroyed once the handle is
+	// actually closed; if it isn't, the callback is still registered with it
+
+	if((nResult == SQLITE_OK) && m_pTrace) delete m_pTrace;
+
 #ifdef SQLITE_TRACE_HANDLEREF
 	Debug::WriteLine(String::Format("DatabaseHandle 0x{0:X} destroyed.", 
 		IntPtr(this)));
@@ -79,6 +85,24 @@ void DatabaseHandle::AddRef(Object^ caller)
 #endif
 }
 
+//---------------------------------------------------------------------------
+// DatabaseHandle::AdoptTraceDispatcher
+//
+// Takes ownership of a trace dispatcher that is still registered with the
+// handle, destroying it after the handle has been closed.  Used when the
+// owning connection is finalized, since the callback can't be removed from
+// the finalizer thread while another thread may still be using the handle
+//
+// Arguments:
+//
+//	pTrace		- Trace dispatcher to take ownership of
+
+void DatabaseHandle::AdoptTraceDispatcher(TraceDispatcher* pTrace)
+{
+	if(m_pTrace && (m_pTrace != pTrace)) delete m_pTrace;
+	m_pTrace = pTrace;
+}
+
 //---------------------------------------------------------------------------
 // DatabaseHandle::Release
 //
@@ -32,6 +32,8 @@ using namespace zuki::data::sqlite;
 
 #pragma warning(push, 4)				// Enable maximum compiler warnings
 
+class TraceDispatcher;					// Forward declaration
+
 //---------------------------------------------------------------------------
 // Class DatabaseHandle
 //
@@ -68,6 +70,7 @@ public:
 	// Member Functions
 
 	void AddRef(Object^ caller);
+	void AdoptTraceDispatcher(TraceDispatcher* pTrace);
 	void Release(Object^ caller);
 
 	//-----------------------------------------------------------------------
@@ -95,6 +98,7 @@ private:
 
 	sqlite3*				m_hDatabase;		// Contained database handle
 	volatile long			m_cRefCount;		// Reference counter
+	TraceDispatcher*		m_pTrace;			// Adopted trace dispatcher
 };
 
 //---------------------------------------------------------------------------
@@ -0,0 +1,244 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __ROWBATCH_H_
+#define __ROWBATCH_H_
+#pragma once
+
+#include <vector>						// Include STL vector<> declarations
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+//---------------------------------------------------------------------------
+// Class RowBatch
+//
+// RowBatch is an unmanaged block of virtual table rows, filled in by a managed
+// SqliteBatchVirtualTableCursor and then served directly to the engine by the
+// xNext, xColumn and xRowid callbacks without transitioning into managed code.
+// Column values are stored in typed cells; TEXT and BLOB data is copied into
+// a single arena that is reset along with the rest of the batch.
+//---------------------------------------------------------------------------
+
+class RowBatch
+{
+public:
+
+	// Constructor
+	//
+	// Allocates the cell storage for the specified number of rows and columns
+	RowBatch(int columns, int capacity) : m_columns(columns), m_capacity(capacity), 
+		m_cells(static_cast<size_t>(columns) * capacity), m_rowids(capacity) { Clear(); }
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Clear
+	//
+	// Resets the batch to contain no rows; all cells revert to NULL
+	void Clear(void)
+	{
+		if(!m_cells.empty()) memset(&m_cells[0], 0, m_cells.size() * sizeof(Cell));
+		m_arena.clear();
+
+		m_count = 0;
+		m_position = 0;
+	}
+
+	// GetColumn
+	//
+	// Sets a result context to the value of a column in the current row
+	void GetColumn(int ordinal, sqlite3_context* context) const
+	{
+		const Cell& cell = GetCell(m_position, ordinal);
+
+		switch(cell.Type) {
+
+			case SQLITE_INTEGER: sqlite3_result_int64(context, cell.Integer); break;
+			case SQLITE_FLOAT: sqlite3_result_double(context, cell.Real); break;
+			case SQLITE_TEXT: sqlite3_result_text16(context, (cell.Length) ? static_cast<const void*>(&m_arena[cell.Offset]) : L"", cell.Length, SQLITE_TRANSIENT); break;
+			case TEXT_UTF8: sqlite3_result_text(context, (cell.Length) ? reinterpret_cast<const char*>(&m_arena[cell.Offset]) : "", cell.Length, SQLITE_TRANSIENT); break;
+			case SQLITE_BLOB:
+				if(cell.Length) sqlite3_result_blob(context, &m_arena[cell.Offset], cell.Length, SQLITE_TRANSIENT);
+				else sqlite3_result_zeroblob(context, 0);		// A NULL pointer would be NULL
+				break;
+			default: sqlite3_result_null(context); break;
+		}
+	}
+
+	// MoveNext
+	//
+	// Advances to the next row in the batch; returns false when the batch has
+	// been exhausted and needs to be refilled
+	bool MoveNext(void) { return (++m_position < m_count); }
+
+	// SetBlob
+	//
+	// Sets a cell to a BLOB value, the data is copied into the arena
+	void SetBlob(int row, int ordinal, const void* pv, int cb) { SetData(row, ordinal, SQLITE_BLOB, pv, cb); }
+
+	// SetDouble
+	//
+	// Sets a cell to a floating point value
+	void SetDouble(int row, int ordinal, double value)
+	{
+		Cell& cell = GetCell(row, ordinal);
+		cell.Type = SQLITE_FLOAT;
+		cell.Real = value;
+	}
+
+	// SetInt64
+	//
+	// Sets a cell to an integer value
+	void SetInt64(int row, int ordinal, __int64 value)
+	{
+		Cell& cell = GetCell(row, ordinal);
+		cell.Type = SQLITE_INTEGER;
+		cell.Integer = value;
+	}
+
+	// SetNull
+	//
+	// Sets a cell to NULL
+	void SetNull(int row, int ordinal) { GetCell(row, ordinal).Type = SQLITE_NULL; }
+
+	// SetText
+	//
+	// Sets a cell to a UTF-16 TEXT value, the data is copied into the arena
+	void SetText(int row, int ordinal, const wchar_t* pwsz, int cch) { SetData(row, ordinal, SQLITE_TEXT, pwsz, cch * sizeof(wchar_t)); }
+
+	// SetText
+	//
+	// Sets a cell to a UTF-8 TEXT value, the data is copied into the arena
+	void SetText(int row, int ordinal, const char* psz, int cb) { SetData(row, ordinal, TEXT_UTF8, psz, cb); }
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Capacity
+	//
+	// Gets the maximum number of rows the batch can hold
+	__declspec(property(get=GetCapacity)) int Capacity;
+	int GetCapacity(void) const { return m_capacity; }
+
+	// ColumnCount
+	//
+	// Gets the number of columns in each row of the batch
+	__declspec(property(get=GetColumnCount)) int ColumnCount;
+	int GetColumnCount(void) const { return m_columns; }
+
+	// Count
+	//
+	// Gets/sets the number of rows present in the batch.  Setting the count
+	// also resets the current position to the first row
+	__declspec(property(get=GetCount, put=SetCount)) int Count;
+	int GetCount(void) const { return m_count; }
+	void SetCount(int value) { m_count = value; m_position = 0; }
+
+	// Position
+	//
+	// Gets the index of the current row in the batch
+	__declspec(property(get=GetPosition)) int Position;
+	int GetPosition(void) const { return m_position; }
+
+	// RowID
+	//
+	// Gets the ROWID of the current row in the batch
+	__declspec(property(get=GetRowID)) __int64 RowID;
+	__int64 GetRowID(void) const { return m_rowids[m_position]; }
+
+	// SetRowID
+	//
+	// Sets the ROWID for a row in the batch
+	void SetRowID(int row, __int64 rowid) { m_rowids[row] = rowid; }
+
+private:
+
+	// DISABLED COPY CONSTRUCTOR / ASSIGNMENT OPERATOR
+	RowBatch(const RowBatch& rhs);
+	RowBatch& operator=(const RowBatch& rhs);
+
+	//-----------------------------------------------------------------------
+	// Private Constants
+
+	// TEXT_UTF8
+	//
+	// Cell type used for TEXT values that were stored as UTF-8 rather than UTF-16
+	static const int TEXT_UTF8 = SQLITE_TEXT | 0x100;
+
+	//-----------------------------------------------------------------------
+	// Private Type Declarations
+
+	// Cell
+	//
+	// Single typed column value; a Type of zero indicates an unset (NULL) cell
+	struct Cell
+	{
+		int					Type;			// SQLITE_xxxx data type
+		int					Length;			// TEXT/BLOB length in bytes
+		union {
+			__int64			Integer;		// SQLITE_INTEGER value
+			double			Real;			// SQLITE_FLOAT value
+			size_t			Offset;			// SQLITE_TEXT/SQLITE_BLOB arena offset
+		};
+	};
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// GetCell
+	//
+	// Accesses the cell for a specific row and column
+	Cell& GetCell(int row, int ordinal) { return m_cells[(static_cast<size_t>(ordinal) * m_capacity) + row]; }
+	const Cell& GetCell(int row, int ordinal) const { return m_cells[(static_cast<size_t>(ordinal) * m_capacity) + row]; }
+
+	// SetData
+	//
+	// Copies variable length data into the arena and references it from a cell
+	void SetData(int row, int ordinal, int type, const void* pv, int cb)
+	{
+		Cell& cell = GetCell(row, ordinal);
+
+		cell.Type = type;
+		cell.Length = cb;
+		cell.Offset = m_arena.size();
+
+		if(cb > 0) m_arena.insert(m_arena.end(), reinterpret_cast<const unsigned __int8*>(pv), 
+			reinterpret_cast<const unsigned __int8*>(pv) + cb);
+	}
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	int								m_columns;		// Number of columns
+	int								m_capacity;		// Maximum number of rows
+	int								m_count;		// Number of rows present
+	int								m_position;		// Current row position
+	std::vector<Cell>				m_cells;		// Column-major cell storage
+	std::vector<__int64>			m_rowids;		// Row identifiers
+	std::vector<unsigned __int8>	m_arena;		// TEXT/BLOB data arena
+};
+
+//---------------------------------------------------------------------------
+
+#pragma warning(pop)
+
+#endif	// __ROWBATCH_H_
@@ -22,6 +22,7 @@
 
 #include "stdafx.h"					// Include project pre-compiled headers
 #include "SqliteAggregateCollection.h"	// Include SqliteAggregateCollection decls
+#include "SqliteEventSource.h"			// Include SqliteEventSource declarations
 
 #pragma warning(push, 4)			// Enable maximum compiler warnings
 
@@ -42,8 +43,10 @@ namespace zuki::data::sqlite {
 void sqlite_aggregate_step(sqlite3_context* context, int argc, sqlite3_value** argv)
 {
 	intptr_t*				pStateHandle;		// Serialized instance GCHandle		
+	__int64					start;				// Invocation start time
 
 	GCHandleRef<SqliteAggregateWrapper^> wrapper(sqlite3_user_data(context));
+	start = SqliteEventSource::Timestamp();
 
 	// Grab the aggregate context object from SQLite.  The first time xStep is 
 	// called, the value will be zero, which indicates to us that we need to
@@ -64,6 +67,8 @@ void sqlite_aggregate_step(sqlite3_context* context, int argc, sqlite3_value** a
 	try { agg->Accumulate(args); }
 	catch(Exception^ ex) { sqlite3_result_error(context, AutoAnsiString(ex->Message), -1); }
 	finally { delete args; }
+
+	SqliteEventSource::AggregateInvoked(start);
 }
 
 //---------------------------------------------------------------------------
@@ -79,8 +84,10 @@ void sqlite_aggregate_step(sqlite3_context* context, int argc, sqlite3_value** a
 void sqlite_aggregate_final(sqlite3_context* context)
 {
 	intptr_t*				pStateHandle;		// Serialized instance GCHandle		
+	__int64					start;				// Invocation start time
 
 	GCHandleRef<SqliteAggregateWrapper^> wrapper(sqlite3_user_data(context));
+	start = SqliteEventSource::Timestamp();
 
 	pStateHandle = reinterpret_cast<intptr_t*>(sqlite3_aggregate_context(context, sizeof(intptr_t)));
 	if(*pStateHandle == 0) { /* ERROR */ }
@@ -99,6 +106,8 @@ void sqlite_aggregate_final(sqlite3_context* context)
 		GCHandle::FromIntPtr(IntPtr(*pStateHandle)).Free();		// Release GCHandle
 		*pStateHandle = 0;										// Reset state data
 	}
+
+	SqliteEventSource::AggregateInvoked(start);
 }
 
 //---------------------------------------------------------------------------
@@ -22,12 +22,54 @@
 
 #include "stdafx.h"					// Include project pre-compiled headers
 #include "SqliteArgument.h"			// Include SqliteArgument declarations
+#include "SqliteException.h"			// Include SqliteException declarations
 
 #pragma warning(push, 4)			// Enable maximum compiler warnings
 #pragma warning(disable:4100)		// "unreferenced formal parameter"
 
 namespace zuki::data::sqlite {
 
+//---------------------------------------------------------------------------
+// SqliteArgument::GetInValues
+//
+// Retrieves all of the values from an IN list argument passed into a virtual
+// table's filter method using sqlite3_vtab_in_first/sqlite3_vtab_in_next
+//
+// Arguments:
+//
+//	NONE
+
+array<Object^>^ SqliteArgument::GetInValues(void)
+{
+	sqlite3_value*			pValue = NULL;		// Current IN list value
+	SqliteArgument^			value = nullptr;	// Reusable value wrapper
+	int						nResult;			// Result from function call
+
+	CHECK_DISPOSED(m_disposed);
+
+	List<Object^>^ values = gcnew List<Object^>();
+
+	try {
+
+		// Walk the IN list with a single SqliteArgument that gets attached to
+		// each of the values in turn, and convert them into generic objects
+
+		for(nResult = sqlite3_vtab_in_first(m_value, &pValue); nResult == SQLITE_OK; nResult = sqlite3_vtab_in_next(m_value, &pValue)) {
+
+			if(value == nullptr) value = gcnew SqliteArgument(pValue);
+			else value->Attach(pValue);
+
+			values->Add(value->Value);
+		}
+
+		if(nResult != SQLITE_DONE) throw gcnew SqliteException(nResult);
+	}
+
+	finally { if(value != nullptr) value->Detach(); }
+
+	return values->ToArray();
+}
+
 //---------------------------------------------------------------------------
 // SqliteArgument::GetTypeCode
 //
@@ -30,6 +30,7 @@
 #pragma warning(disable:4100)			// "unreferenced formal parameter"
 
 using namespace System;
+using namespace System::Collections::Generic;
 using namespace System::Data;
 
 namespace zuki::data::sqlite {
@@ -75,6 +76,13 @@ public:
 	//-----------------------------------------------------------------------
 	// Member Functions
 
+	// GetInValues
+	//
+	// Retrieves all of the values of an IN list passed to a virtual table's
+	// Filter() method.  Only valid for constraints that were marked with
+	// SqliteIndexConstraint.ProcessInList during index selection
+	array<Object^>^ GetInValues(void);
+
 	// GetTypeCode (IConvertible)
 	//
 	// Gets a TypeCode that defines the underlying data type of the argument
@@ -193,6 +201,24 @@ internal:
 	//-----------------------------------------------------------------------
 	// Internal Member Functions
 
+	// Attach
+	//
+	// Re-points a detached argument at a new value pointer so that a single
+	// instance can be reused rather than constructing one for every value
+	void Attach(sqlite3_value* value)
+	{
+		m_value = value;
+		m_type = sqlite3_value_type(value);
+		m_length = sqlite3_value_bytes(value);
+		m_disposed = false;
+	}
+
+	// Detach
+	//
+	// Releases the value pointer; the object acts as if it were disposed
+	// until it has been attached to a new value
+	void Detach(void) { m_value = NULL; m_disposed = true; }
+
 	// IsDisposed (ITrackableObject)
 	//
 	// Exposes this object's internal dispose state
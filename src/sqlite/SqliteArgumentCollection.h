@@ -55,6 +55,31 @@ internal:
 	// INTERNAL CONSTRUCTORS
 	SqliteArgumentCollection(int argc, sqlite3_value** argv) : ReadOnlyCollection(MakeList(argc, argv)) {}
 
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Attach
+	//
+	// Re-points the collection at a new set of values, reusing the existing
+	// SqliteArgument instances and adding or removing them only as necessary
+	void Attach(int argc, sqlite3_value** argv)
+	{
+		IList<SqliteArgument^>^ items = Items;		// Underlying List<>
+
+		while(items->Count > argc) items->RemoveAt(items->Count - 1);
+
+		for(int index = 0; index < argc; index++) {
+
+			if(index < items->Count) items[index]->Attach(argv[index]);
+			else items->Add(gcnew SqliteArgument(argv[index]));
+		}
+	}
+
+	// Detach
+	//
+	// Detaches all of the contained arguments from their values
+	void Detach(void) { for each(SqliteArgument^ arg in this) arg->Detach(); }
+
 private:
 
 	// DESTRUCTOR
@@ -0,0 +1,205 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"							// Include project pre-compiled headers
+#include "SqliteBatchVirtualTableCursor.h"		// Include SqliteBatchVirtualTableCursor
+
+#pragma warning(push, 4)					// Enable maximum compiler warnings
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// SqliteBatchVirtualTableCursor Constructor
+//
+// Arguments:
+//
+//	NONE
+
+SqliteBatchVirtualTableCursor::SqliteBatchVirtualTableCursor() : m_batchSize(DEFAULT_BATCH_SIZE)
+{
+}
+
+//---------------------------------------------------------------------------
+// SqliteBatchVirtualTableCursor Constructor
+//
+// Arguments:
+//
+//	batchSize		- Maximum number of rows to request from FillBatch()
+
+SqliteBatchVirtualTableCursor::SqliteBatchVirtualTableCursor(int batchSize) : m_batchSize(batchSize)
+{
+	if(batchSize <= 0) throw gcnew ArgumentOutOfRangeException("batchSize");
+}
+
+//---------------------------------------------------------------------------
+// SqliteBatchVirtualTableCursor Destructor
+
+SqliteBatchVirtualTableCursor::~SqliteBatchVirtualTableCursor()
+{
+	if(m_disposed) return;
+
+	if(m_batch != nullptr) delete m_batch;	// Detach the managed wrapper
+	this->!SqliteBatchVirtualTableCursor();	// Release unmanaged storage
+
+	m_disposed = true;						// Object is now disposed of
+}
+
+//---------------------------------------------------------------------------
+// SqliteBatchVirtualTableCursor Finalizer
+
+SqliteBatchVirtualTableCursor::!SqliteBatchVirtualTableCursor()
+{
+	if(m_pBatch) delete m_pBatch;			// Release the row storage
+	m_pBatch = NULL;						// Reset pointer to NULL
+}
+
+//---------------------------------------------------------------------------
+// SqliteBatchVirtualTableCursor::Batch::get (internal)
+//
+// Exposes the unmanaged row storage, which is allocated on first access
+
+RowBatch* SqliteBatchVirtualTableCursor::Batch::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(m_pBatch == NULL) m_pBatch = new RowBatch(ColumnCount, m_batchSize);
+	return m_pBatch;
+}
+
+//---------------------------------------------------------------------------
+// SqliteBatchVirtualTableCursor::Fill (private)
+//
+// Clears the row storage and invokes FillBatch() on the derived class
+//
+// Arguments:
+//
+//	NONE
+
+bool SqliteBatchVirtualTableCursor::Fill(void)
+{
+	RowBatch* pBatch = Batch;				// Allocates on first access
+
+	pBatch->Clear();						// Reset all rows to NULL
+
+	if(m_batch == nullptr) m_batch = gcnew SqliteRowBatch(pBatch);
+	int count = FillBatch(m_batch);
+
+	if((count < 0) || (count > pBatch->Capacity)) throw gcnew InvalidOperationException();
+
+	pBatch->Count = count;					// Also resets the position
+	return (count > 0);
+}
+
+//---------------------------------------------------------------------------
+// SqliteBatchVirtualTableCursor::GetHiddenValue (internal)
+//
+// Gets the value of a column that isn't held in the batch.  The base class
+// doesn't have any such columns; SqliteTableValuedFunction overrides this to
+// return the values of it's hidden parameter columns
+//
+// Arguments:
+//
+//	ordinal		- Ordinal of the column to retrieve
+//	result		- Result object to receive the value
+
+void SqliteBatchVirtualTableCursor::GetHiddenValue(int ordinal, SqliteResult^ result)
+{
+	(result);
+	throw gcnew ArgumentOutOfRangeException("ordinal");
+}
+
+//---------------------------------------------------------------------------
+// SqliteBatchVirtualTableCursor::GetRowID
+//
+// Gets the ROWID of the current row in the batch.  Normally the engine is
+// served this directly from the unmanaged row storage
+//
+// Arguments:
+//
+//	NONE
+
+__int64 SqliteBatchVirtualTableCursor::GetRowID(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return Batch->RowID;
+}
+
+//---------------------------------------------------------------------------
+// SqliteBatchVirtualTableCursor::GetValue
+//
+// Gets the value of a column in the current row of the batch.  Normally the
+// engine is served this directly from the unmanaged row storage
+//
+// Arguments:
+//
+//	ordinal		- Ordinal of the column to retrieve
+//	result		- Result object to receive the value
+
+void SqliteBatchVirtualTableCursor::GetValue(int ordinal, SqliteResult^ result)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(result == nullptr) throw gcnew ArgumentNullException("result");
+	if(ordinal < 0) throw gcnew ArgumentOutOfRangeException("ordinal");
+
+	if(ordinal < Batch->ColumnCount) Batch->GetColumn(ordinal, result->Handle);
+	else GetHiddenValue(ordinal, result);
+}
+
+//---------------------------------------------------------------------------
+// SqliteBatchVirtualTableCursor::MoveNext
+//
+// Moves to the next row in the batch, refilling it when it runs out
+//
+// Arguments:
+//
+//	NONE
+
+bool SqliteBatchVirtualTableCursor::MoveNext(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return (Batch->MoveNext()) ? true : Fill();
+}
+
+//---------------------------------------------------------------------------
+// SqliteBatchVirtualTableCursor::SetFilter
+//
+// Invokes SetBatchFilter() and then fills the first block of rows
+//
+// Arguments:
+//
+//	index		- Index identifier from SelectBestIndex()
+//	args		- Filter arguments
+
+bool SqliteBatchVirtualTableCursor::SetFilter(SqliteIndexIdentifier^ index, SqliteArgumentCollection^ args)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	SetBatchFilter(index, args);			// Let the derived class reset itself
+	return Fill();							// Retrieve the first block of rows
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
@@ -0,0 +1,167 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __SQLITEBATCHVIRTUALTABLECURSOR_H_
+#define __SQLITEBATCHVIRTUALTABLECURSOR_H_
+#pragma once
+
+#include "RowBatch.h"						// Include RowBatch declarations
+#include "SqliteRowBatch.h"				// Include SqliteRowBatch declarations
+#include "SqliteVirtualTableCursor.h"		// Include SqliteVirtualTableCursor decls
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// Class SqliteBatchVirtualTableCursor
+//
+// SqliteBatchVirtualTableCursor is an alternate base class for virtual table
+// cursors that produce rows in blocks rather than one at a time.  The derived
+// class fills a SqliteRowBatch with up to BatchSize rows in a single call, and
+// the engine's xNext, xColumn and xRowid callbacks are then served directly
+// from unmanaged memory until the block has been exhausted:
+//
+//	internal class MyCursor : public SqliteBatchVirtualTableCursor
+//	internal class MyTable : public SqliteVirtualTable<MyCursor> 
+//---------------------------------------------------------------------------
+
+public ref class SqliteBatchVirtualTableCursor abstract : public SqliteVirtualTableCursor
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// BatchSize
+	//
+	// Gets the maximum number of rows that will be requested from FillBatch()
+	property int BatchSize
+	{
+		int get(void) { return m_batchSize; }
+	}
+
+protected public:
+
+	// PROTECTED CONSTRUCTORS
+	SqliteBatchVirtualTableCursor();
+	SqliteBatchVirtualTableCursor(int batchSize);
+
+	//-----------------------------------------------------------------------
+	// Protected/Public Member Functions
+
+	// FillBatch (must override)
+	//
+	// Writes up to batch.Capacity rows into the batch, starting at row zero,
+	// and returns the number of rows that were written.  Returning zero will
+	// indicate that there are no more rows available from the cursor
+	virtual int FillBatch(SqliteRowBatch^ batch) abstract;
+
+	// GetRowID
+	//
+	// Gets the ROWID of the current row in the batch
+	virtual __int64 GetRowID(void) override sealed;
+
+	// GetValue
+	//
+	// Gets the value of a column in the current row of the batch
+	virtual void GetValue(int ordinal, SqliteResult^ result) override sealed;
+
+	// MoveNext
+	//
+	// Moves to the next row in the batch, refilling it as necessary
+	virtual bool MoveNext(void) override sealed;
+
+	// SetBatchFilter (must override)
+	//
+	// Invoked to set/change the filter information for this cursor, see
+	// SqliteVirtualTableCursor::SetFilter().  FillBatch() will be invoked 
+	// immediately afterwards to retrieve the first block of rows
+	virtual void SetBatchFilter(SqliteIndexIdentifier^ index, SqliteArgumentCollection^ args) abstract;
+
+	// SetFilter
+	//
+	// Invokes SetBatchFilter() and then fills the first block of rows
+	virtual bool SetFilter(SqliteIndexIdentifier^ index, SqliteArgumentCollection^ args) override sealed;
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// GetHiddenValue
+	//
+	// Gets the value of a column beyond those held in the batch; the native
+	// fast path only serves the batch columns, this is called for the rest
+	virtual void GetHiddenValue(int ordinal, SqliteResult^ result);
+
+	//-----------------------------------------------------------------------
+	// Internal Properties
+
+	// Batch
+	//
+	// Exposes the unmanaged row storage, which is allocated on first access
+	property RowBatch* Batch
+	{
+		RowBatch* get(void);
+	}
+
+private:
+
+	// DESTRUCTOR / FINALIZER
+	~SqliteBatchVirtualTableCursor();
+	!SqliteBatchVirtualTableCursor();
+
+	//-----------------------------------------------------------------------
+	// Private Constants
+
+	// DEFAULT_BATCH_SIZE
+	//
+	// Default number of rows requested from FillBatch()
+	literal int DEFAULT_BATCH_SIZE = 1024;
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// Fill
+	//
+	// Clears the row storage and invokes FillBatch() on the derived class
+	bool Fill(void);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	bool					m_disposed;			// Object disposal flag
+	int						m_batchSize;		// Rows per batch
+	RowBatch*				m_pBatch;			// Unmanaged row storage
+	SqliteRowBatch^			m_batch;			// Managed row storage wrapper
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
+
+#endif		// __SQLITEBATCHVIRTUALTABLECURSOR_H_
@@ -22,6 +22,7 @@
 
 #include "stdafx.h"					// Include project pre-compiled headers
 #include "SqliteCollationCollection.h"	// Include SqliteCollationCollection decls
+#include "SqliteEventSource.h"			// Include SqliteEventSource declarations
 
 #pragma warning(push, 4)			// Enable maximum compiler warnings
 
@@ -44,13 +45,18 @@ namespace zuki::data::sqlite {
 int sqlite_collation_func(void* context, int cbLeft, const void* pvLeft, int cbRight, const void* pvRight)
 {
 	GCHandleRef<SqliteCollationWrapper^> collation(context);	// Unwrap the GCHandle
+	__int64 start = SqliteEventSource::Timestamp();				// Invocation start
+	int result = 0;												// Collation result
 
 	// The invocation logic is really contained in the SqliteCollationWrapper, so
 	// all we do in here is call that.  There is no way to convert exceptions into
 	// errors when working with collations, so the best we can do is return zero
 
-	try { return collation->Invoke(pvLeft, cbLeft, pvRight, cbRight); }
-	catch(Exception^) { return 0; }
+	try { result = collation->Invoke(pvLeft, cbLeft, pvRight, cbRight); }
+	catch(Exception^) { result = 0; }
+
+	SqliteEventSource::CollationInvoked(start);
+	return result;
 }
 
 //---------------------------------------------------------------------------
@@ -0,0 +1,380 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __SQLITECOLLECTIONINDEX_H_
+#define __SQLITECOLLECTIONINDEX_H_
+#pragma once
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+#pragma warning(disable:4100)			// "unreferenced formal parameter"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Globalization;
+using namespace System::Linq;
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// Class SqliteCollectionIndex (internal)
+//
+// SqliteCollectionIndex is the common base for the application-supplied
+// indexes that a SqliteCollectionTable can push constraints down into.  The
+// rows returned may be a superset of the matching rows; the engine is always
+// asked to double-check the constraints, so key conversions and inclusive
+// range bounds only ever need to err on the side of returning more rows
+//---------------------------------------------------------------------------
+
+generic<typename T>
+ref class SqliteCollectionIndex abstract
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Equal
+	//
+	// Returns the rows with a key equal to the specified value
+	virtual IEnumerable<T>^ Equal(Object^ value) abstract;
+
+	// Range
+	//
+	// Returns the rows with a key between the specified (inclusive) bounds, 
+	// a null bound is treated as unbounded.  Only valid for sorted indexes
+	virtual IEnumerable<T>^ Range(Object^ lower, Object^ upper, bool descending) abstract;
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// DistinctCount
+	//
+	// Gets the number of distinct keys in the index, or zero if unknown
+	property __int64 DistinctCount
+	{
+		virtual __int64 get(void) abstract;
+	}
+
+	// IsOrdered
+	//
+	// Gets a flag indicating that the key order matches the order that the
+	// engine would produce for an ORDER BY against the column
+	property bool IsOrdered
+	{
+		virtual bool get(void) abstract;
+	}
+
+	// RowCount
+	//
+	// Gets the number of rows in the index, or -1 if unknown
+	property __int64 RowCount
+	{
+		virtual __int64 get(void) abstract;
+	}
+
+protected:
+
+	//-----------------------------------------------------------------------
+	// Protected Member Functions
+
+	// ConvertKey
+	//
+	// Converts a filter argument value into the index key type
+	generic<typename TKey>
+	static bool ConvertKey(Object^ value, TKey% key)
+	{
+		if(value == nullptr) return false;
+
+		Type^ type = Nullable::GetUnderlyingType(TKey::typeid);
+		if(type == nullptr) type = TKey::typeid;
+
+		// Values that cannot be converted into the key type are reported back
+		// as such and it's up to the caller to decide what that means
+
+		try {
+
+			if(type->IsInstanceOfType(value)) key = safe_cast<TKey>(value);
+			else if(type->IsEnum) key = safe_cast<TKey>(Enum::ToObject(type, value));
+			else key = safe_cast<TKey>(Convert::ChangeType(value, type, CultureInfo::InvariantCulture));
+		}
+
+		catch(Exception^) { return false; }
+
+		return true;
+	}
+};
+
+//---------------------------------------------------------------------------
+// Class SqliteCollectionLookupIndex (internal)
+//
+// Equality-only index implemented with an application-supplied ILookup
+//---------------------------------------------------------------------------
+
+generic<typename T, typename TKey>
+ref class SqliteCollectionLookupIndex sealed : public SqliteCollectionIndex<T>
+{
+public:
+
+	// CONSTRUCTOR
+	SqliteCollectionLookupIndex(ILookup<TKey, T>^ lookup) : m_lookup(lookup) {}
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Equal (SqliteCollectionIndex)
+	//
+	// Returns the rows with a key equal to the specified value
+	virtual IEnumerable<T>^ Equal(Object^ value) override
+	{
+		TKey key = TKey();
+
+		// NULL never compares equal to anything, and a value that can't be
+		// converted into the key type can't match any of the keys either
+
+		if(!ConvertKey(value, key)) return Enumerable::Empty<T>();
+		return m_lookup[key];
+	}
+
+	// Range (SqliteCollectionIndex)
+	//
+	// Not supported by lookup indexes
+	virtual IEnumerable<T>^ Range(Object^ lower, Object^ upper, bool descending) override
+	{
+		throw gcnew NotSupportedException();
+	}
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// DistinctCount (SqliteCollectionIndex)
+	//
+	// Gets the number of distinct keys in the index
+	property __int64 DistinctCount
+	{
+		virtual __int64 get(void) override { return m_lookup->Count; }
+	}
+
+	// IsOrdered (SqliteCollectionIndex)
+	//
+	// Lookup indexes have no ordering
+	property bool IsOrdered
+	{
+		virtual bool get(void) override { return false; }
+	}
+
+	// RowCount (SqliteCollectionIndex)
+	//
+	// The number of rows in a lookup is not known
+	property __int64 RowCount
+	{
+		virtual __int64 get(void) override { return -1; }
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	ILookup<TKey, T>^			m_lookup;			// Application lookup
+};
+
+//---------------------------------------------------------------------------
+// Class SqliteCollectionSortedIndex (internal)
+//
+// Equality and range index implemented with an application-supplied array
+// that has been sorted by a key.  Lookups are done with a binary search
+//---------------------------------------------------------------------------
+
+generic<typename T, typename TKey>
+ref class SqliteCollectionSortedIndex sealed : public SqliteCollectionIndex<T>
+{
+public:
+
+	// CONSTRUCTOR
+	SqliteCollectionSortedIndex(array<T>^ rows, Func<T, TKey>^ selector, IComparer<TKey>^ comparer) :
+		m_rows(rows), m_selector(selector), m_comparer(comparer)
+	{
+		// Verify the sort order up front, a binary search against an array that
+		// is not sorted would silently produce the wrong rows
+
+		for(int index = 1; index < m_rows->Length; index++)
+			if(m_comparer->Compare(m_selector(m_rows[index - 1]), m_selector(m_rows[index])) > 0)
+				throw gcnew ArgumentException("The array is not sorted by the specified key", "rows");
+
+		// The rows can only be returned to satisfy an ORDER BY if the comparer
+		// orders the keys the same way that SQLite's BINARY collation would
+
+		Type^ type = Nullable::GetUnderlyingType(TKey::typeid);
+		if(type == nullptr) type = TKey::typeid;
+
+		switch(Type::GetTypeCode(type)) {
+
+			case TypeCode::Boolean:
+			case TypeCode::Byte:
+			case TypeCode::Decimal:
+			case TypeCode::Double:
+			case TypeCode::Int16:
+			case TypeCode::Int32:
+			case TypeCode::Int64:
+			case TypeCode::SByte:
+			case TypeCode::Single:
+			case TypeCode::UInt16:
+			case TypeCode::UInt32:
+			case TypeCode::UInt64:
+				m_ordered = Object::ReferenceEquals(m_comparer, Comparer<TKey>::Default);
+				break;
+
+			case TypeCode::String:
+				m_ordered = Object::ReferenceEquals(m_comparer, StringComparer::Ordinal);
+				break;
+
+			default: m_ordered = false;
+		}
+	}
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Equal (SqliteCollectionIndex)
+	//
+	// Returns the rows with a key equal to the specified value
+	virtual IEnumerable<T>^ Equal(Object^ value) override
+	{
+		TKey key = TKey();
+
+		if(!ConvertKey(value, key)) return Enumerable::Empty<T>();
+		return Slice(LowerBound(key), UpperBound(key), false);
+	}
+
+	// Range (SqliteCollectionIndex)
+	//
+	// Returns the rows with a key between the specified (inclusive) bounds
+	virtual IEnumerable<T>^ Range(Object^ lower, Object^ upper, bool descending) override
+	{
+		TKey key = TKey();
+		int start = 0;
+		int end = m_rows->Length;
+
+		// A bound that can't be converted into the key type is ignored, that
+		// only means that more rows are returned than strictly necessary
+
+		if(ConvertKey(lower, key)) start = LowerBound(key);
+		if(ConvertKey(upper, key)) end = UpperBound(key);
+
+		return Slice(start, end, descending);
+	}
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// DistinctCount (SqliteCollectionIndex)
+	//
+	// The number of distinct keys in a sorted array is not known
+	property __int64 DistinctCount
+	{
+		virtual __int64 get(void) override { return 0; }
+	}
+
+	// IsOrdered (SqliteCollectionIndex)
+	//
+	// Gets a flag indicating that the key order matches SQLite's
+	property bool IsOrdered
+	{
+		virtual bool get(void) override { return m_ordered; }
+	}
+
+	// RowCount (SqliteCollectionIndex)
+	//
+	// Gets the number of rows in the index
+	property __int64 RowCount
+	{
+		virtual __int64 get(void) override { return m_rows->Length; }
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// LowerBound
+	//
+	// Locates the first row with a key greater than or equal to a key
+	int LowerBound(TKey key)
+	{
+		int low = 0;
+		int high = m_rows->Length;
+
+		while(low < high) {
+
+			int mid = low + ((high - low) >> 1);
+			if(m_comparer->Compare(m_selector(m_rows[mid]), key) < 0) low = mid + 1;
+			else high = mid;
+		}
+
+		return low;
+	}
+
+	// Slice
+	//
+	// Generates an enumerable range of rows from the array
+	IEnumerable<T>^ Slice(int start, int end, bool descending)
+	{
+		if(end <= start) return Enumerable::Empty<T>();
+
+		IEnumerable<T>^ rows = safe_cast<IEnumerable<T>^>(ArraySegment<T>(m_rows, start, end - start));
+		return (descending) ? Enumerable::Reverse(rows) : rows;
+	}
+
+	// UpperBound
+	//
+	// Locates the first row with a key greater than a key
+	int UpperBound(TKey key)
+	{
+		int low = 0;
+		int high = m_rows->Length;
+
+		while(low < high) {
+
+			int mid = low + ((high - low) >> 1);
+			if(m_comparer->Compare(m_selector(m_rows[mid]), key) <= 0) low = mid + 1;
+			else high = mid;
+		}
+
+		return low;
+	}
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	array<T>^					m_rows;				// Sorted rows
+	Func<T, TKey>^				m_selector;			// Key selector
+	IComparer<TKey>^			m_comparer;			// Key comparer
+	bool						m_ordered;			// Flag if ORDER BY compatible
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
+
+#endif		// __SQLITECOLLECTIONINDEX_H_
@@ -0,0 +1,591 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"						// Include project pre-compiled headers
+#include "SqliteCollectionTable.h"			// Include SqliteCollectionTable decls
+#include "SqliteCollectionTableCursor.h"	// Include SqliteCollectionTableCursor decls
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+#pragma warning(disable:4100)			// "unreferenced formal parameter"
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// SqliteCollectionTable Constructor
+//
+// Arguments:
+//
+//	source		- Source collection to be exposed as a virtual table
+
+generic<typename T>
+SqliteCollectionTable<T>::SqliteCollectionTable(IEnumerable<T>^ source) : m_source(source), m_sortOrdinal(-1)
+{
+	if(source == nullptr) throw gcnew ArgumentNullException("source");
+
+	// Every public readable, non-indexed property of the type becomes a column
+	// of the virtual table, in the order that reflection provides them
+
+	List<PropertyInfo^>^ properties = gcnew List<PropertyInfo^>();
+	for each(PropertyInfo^ property in T::typeid->GetProperties(BindingFlags::Public | BindingFlags::Instance))
+		if(property->CanRead && (property->GetGetMethod() != nullptr) && (property->GetIndexParameters()->Length == 0))
+			properties->Add(property);
+
+	if(properties->Count == 0) 
+		throw gcnew ArgumentException(String::Format("Type {0} does not have any public readable properties", T::typeid->Name));
+
+	m_properties = properties->ToArray();
+	m_writer = CompileRowWriter(m_properties);
+
+	m_lookups = gcnew Dictionary<int, SqliteCollectionIndex<T>^>();
+	m_sorted = gcnew Dictionary<int, SqliteCollectionIndex<T>^>();
+	m_stats = gcnew SqliteVirtualTableStatistics();
+}
+
+//---------------------------------------------------------------------------
+// SqliteCollectionTable::CompileRowWriter (private, static)
+//
+// Compiles a delegate that writes every column of a row into a batch.  Each
+// property is read and converted directly into the matching typed setter of
+// SqliteRowBatch, so there is no reflection or boxing of the common types.
+// DateTime values are written as ISO-8601 text so that range constraints the
+// engine double-checks compare in chronological order
+//
+// Arguments:
+//
+//	properties	- Properties that make up the table columns
+
+generic<typename T>
+Action<T, SqliteRowBatch^, int>^ SqliteCollectionTable<T>::CompileRowWriter(array<PropertyInfo^>^ properties)
+{
+	ParameterExpression^ item = Expression::Parameter(T::typeid, "item");
+	ParameterExpression^ batch = Expression::Parameter(SqliteRowBatch::typeid, "batch");
+	ParameterExpression^ row = Expression::Parameter(int::typeid, "row");
+
+	List<Expression^>^ body = gcnew List<Expression^>(properties->Length);
+
+	MethodInfo^ formatDateTime = DateTime::typeid->GetMethod("ToString", gcnew array<Type^>{ String::typeid, IFormatProvider::typeid });
+	Expression^ format = Expression::Constant(DATETIME_FORMAT);
+	Expression^ culture = Expression::Constant(CultureInfo::InvariantCulture, IFormatProvider::typeid);
+
+	for(int ordinal = 0; ordinal < properties->Length; ordinal++) {
+
+		Type^ type = properties[ordinal]->PropertyType;
+		Expression^ value = Expression::Property(item, properties[ordinal]);
+		String^ method = "SetValue";
+
+		if(type == array<System::Byte>::typeid) method = "SetBytes";
+
+		else if(Nullable::GetUnderlyingType(type) == DateTime::typeid) {
+
+			value = Expression::Condition(Expression::Property(value, "HasValue"), 
+				Expression::Call(Expression::Property(value, "Value"), formatDateTime, format, culture), 
+				Expression::Constant(nullptr, String::typeid));
+			method = "SetString";
+		}
+
+		else switch(Type::GetTypeCode(type)) {
+
+			case TypeCode::Boolean:
+				value = Expression::Condition(value, Expression::Constant(static_cast<__int64>(1)), Expression::Constant(static_cast<__int64>(0)));
+				method = "SetInt64";
+				break;
+
+			case TypeCode::Byte:
+			case TypeCode::Int16:
+			case TypeCode::Int32:
+			case TypeCode::Int64:
+			case TypeCode::SByte:
+			case TypeCode::UInt16:
+			case TypeCode::UInt32:
+			case TypeCode::UInt64:
+				value = Expression::Convert(value, __int64::typeid);
+				method = "SetInt64";
+				break;
+
+			case TypeCode::Decimal:
+			case TypeCode::Double:
+			case TypeCode::Single:
+				value = Expression::Convert(value, double::typeid);
+				method = "SetDouble";
+				break;
+
+			case TypeCode::DateTime:
+				value = Expression::Call(value, formatDateTime, format, culture);
+				method = "SetString";
+				break;
+
+			case TypeCode::String:
+				method = "SetString";
+				break;
+
+			// Everything else, including nullable types, goes through SetValue()
+			default: value = Expression::Convert(value, Object::typeid); break;
+		}
+
+		body->Add(Expression::Call(batch, SqliteRowBatch::typeid->GetMethod(method), row, Expression::Constant(ordinal), value));
+	}
+
+	// A null reference in the source collection produces a row of NULLs rather
+	// than a NullReferenceException; the batch defaults every column to NULL
+
+	Expression^ block = Expression::Block(body);
+	if(!T::typeid->IsValueType) block = Expression::IfThen(Expression::NotEqual(item, Expression::Constant(nullptr, T::typeid)), block);
+
+	return Expression::Lambda<Action<T, SqliteRowBatch^, int>^>(block, gcnew array<ParameterExpression^>{ item, batch, row })->Compile();
+}
+
+//---------------------------------------------------------------------------
+// SqliteCollectionTable::CreateCursor (private)
+//
+// Creates a new cursor over the collection
+//
+// Arguments:
+//
+//	NONE
+
+generic<typename T>
+SqliteVirtualTableCursor^ SqliteCollectionTable<T>::CreateCursor(void)
+{
+	return gcnew SqliteCollectionTableCursor<T>(this);
+}
+
+//---------------------------------------------------------------------------
+// SqliteCollectionTable::EvaluatePlan (private)
+//
+// Applies a candidate plan to the index selection arguments and estimates
+// the cost.  Plans that leave the engine to sort the rows are charged for
+// that sort so they can be compared against plans that are already ordered
+//
+// Arguments:
+//
+//	args		- Index selection arguments
+//	first		- Index of the constraint passed as the first filter argument
+//	second		- Index of the constraint passed as the second filter argument
+//	ordered		- Flag if the plan satisfies the ORDER BY
+
+generic<typename T>
+double SqliteCollectionTable<T>::EvaluatePlan(SqliteIndexSelectionArgs^ args, int first, int second, bool ordered)
+{
+	// The indexes can return more rows than strictly match the constraints,
+	// so the engine is always asked to double-check them
+
+	for each(SqliteIndexConstraint^ constraint in args->Constraints) {
+
+		constraint->FilterArgumentIndex = 0;
+		constraint->DoubleCheck = true;
+	}
+
+	if(first >= 0) args->Constraints[first]->FilterArgumentIndex = 1;
+	if(second >= 0) args->Constraints[second]->FilterArgumentIndex = 2;
+
+	m_stats->EstimateCost(args);
+
+	double cost = args->EstimatedCost;
+	if((!ordered) && (args->SortColumns->Count > 0)) {
+
+		double rows = Math::Max(2.0, static_cast<double>(args->EstimatedRows));
+		cost += rows * Math::Log(rows, 2.0);
+	}
+
+	return cost;
+}
+
+//---------------------------------------------------------------------------
+// SqliteCollectionTable::GetCreateTableStatement (private)
+//
+// Generates the CREATE TABLE statement from the properties of T
+//
+// Arguments:
+//
+//	name		- Table name (purely academic)
+
+generic<typename T>
+String^ SqliteCollectionTable<T>::GetCreateTableStatement(String^ name)
+{
+	StringBuilder^ sb = gcnew StringBuilder();
+
+	sb->Append("CREATE TABLE " + QuoteIdentifier(name) + "(");
+
+	for(int ordinal = 0; ordinal < m_properties->Length; ordinal++) {
+
+		if(ordinal > 0) sb->Append(", ");
+		sb->AppendFormat("{0} {1}", QuoteIdentifier(m_properties[ordinal]->Name), GetDeclaredType(m_properties[ordinal]->PropertyType));
+	}
+
+	return sb->Append(")")->ToString();
+}
+
+//---------------------------------------------------------------------------
+// SqliteCollectionTable::GetDeclaredType (private, static)
+//
+// Gets the declared column type for a property type, which matches the way
+// the compiled row writer stores the values
+//
+// Arguments:
+//
+//	type		- Property type
+
+generic<typename T>
+String^ SqliteCollectionTable<T>::GetDeclaredType(Type^ type)
+{
+	Type^ underlying = Nullable::GetUnderlyingType(type);
+	if(underlying != nullptr) type = underlying;
+
+	if(type == array<System::Byte>::typeid) return "BLOB";
+
+	switch(Type::GetTypeCode(type)) {
+
+		case TypeCode::Boolean:
+		case TypeCode::Byte:
+		case TypeCode::Int16:
+		case TypeCode::Int32:
+		case TypeCode::Int64:
+		case TypeCode::SByte:
+		case TypeCode::UInt16:
+		case TypeCode::UInt32:
+		case TypeCode::UInt64:
+			return "INTEGER";
+
+		case TypeCode::Decimal:
+		case TypeCode::Double:
+		case TypeCode::Single:
+			return "REAL";
+
+		default: return "TEXT";
+	}
+}
+
+//---------------------------------------------------------------------------
+// SqliteCollectionTable::GetOrdinal (private)
+//
+// Gets the ordinal of a column by name
+//
+// Arguments:
+//
+//	column		- Column (property) name, case-insensitive
+
+generic<typename T>
+int SqliteCollectionTable<T>::GetOrdinal(String^ column)
+{
+	if(column == nullptr) throw gcnew ArgumentNullException("column");
+
+	for(int ordinal = 0; ordinal < m_properties->Length; ordinal++)
+		if(String::Compare(m_properties[ordinal]->Name, column, StringComparison::OrdinalIgnoreCase) == 0) return ordinal;
+
+	throw gcnew ArgumentException(String::Format("Column {0} does not exist", column), "column");
+}
+
+//---------------------------------------------------------------------------
+// SqliteCollectionTable::GetRowID (internal)
+//
+// Gets the ROWID for a row produced by a cursor
+//
+// Arguments:
+//
+//	item		- Row object
+//	position	- One-based position of the row in the cursor sequence
+//	occurrences	- Number of times the cursor has seen each value-type row
+
+generic<typename T>
+__int64 SqliteCollectionTable<T>::GetRowID(T item, __int64 position, Dictionary<T, int>^ occurrences)
+{
+	int					occurrence = 0;			// Occurrence of a value row
+
+	// Value-type rows have no identity, so equal values are told apart by how
+	// many times the cursor has already produced that value.  Equal values
+	// always satisfy the same constraints, so every index returns all of them
+	// or none of them and the n-th occurrence can keep the same ROWID
+
+	if((m_valueRowIDs != nullptr) && (occurrences != nullptr)) {
+
+		occurrences->TryGetValue(item, occurrence);
+		occurrences[item] = occurrence + 1;
+
+		Monitor::Enter(m_valueRowIDs);
+
+		try {
+
+			List<__int64>^ rowids;
+			if(!m_valueRowIDs->TryGetValue(item, rowids)) m_valueRowIDs->Add(item, rowids = gcnew List<__int64>(1));
+
+			while(rowids->Count <= occurrence) rowids->Add(Interlocked::Increment(m_lastRowID));
+			return rowids[occurrence];
+		}
+
+		finally { Monitor::Exit(m_valueRowIDs); }
+	}
+
+	if(m_rowids == nullptr) return position;
+
+	// Null rows can't be tracked; give them a ROWID that can't collide with
+	// the ones assigned to actual objects
+
+	Object^ key = safe_cast<Object^>(item);
+	if(key == nullptr) return -position;
+
+	return safe_cast<__int64>(m_rowids->GetValue(key, m_nextRowID));
+}
+
+//---------------------------------------------------------------------------
+// SqliteCollectionTable::GetRows (internal)
+//
+// Gets the rows for an index selected by SelectBestIndex()
+//
+// Arguments:
+//
+//	code		- Index identifier code
+//	args		- Filter arguments
+
+generic<typename T>
+IEnumerable<T>^ SqliteCollectionTable<T>::GetRows(int code, SqliteArgumentCollection^ args)
+{
+	int					arg = 0;				// Filter argument index
+	Object^				lower = nullptr;		// Range lower bound
+	Object^				upper = nullptr;		// Range upper bound
+
+	int ordinal = (code & PLAN_ORDINAL_MASK) - 1;
+	if(ordinal < 0) return m_source;
+
+	if((code & PLAN_LOOKUP) == PLAN_LOOKUP) return m_lookups[ordinal]->Equal(args[0]->Value);
+
+	SqliteCollectionIndex<T>^ index = m_sorted[ordinal];
+	if((code & PLAN_EQUAL) == PLAN_EQUAL) return index->Equal(args[0]->Value);
+
+	if((code & PLAN_LOWER) == PLAN_LOWER) lower = args[arg++]->Value;
+	if((code & PLAN_UPPER) == PLAN_UPPER) upper = args[arg++]->Value;
+
+	return index->Range(lower, upper, (code & PLAN_DESCENDING) == PLAN_DESCENDING);
+}
+
+//---------------------------------------------------------------------------
+// SqliteCollectionTable::NextRowID (private)
+//
+// ConditionalWeakTable callback that assigns the next stable ROWID
+//
+// Arguments:
+//
+//	key			- Row object being assigned a ROWID
+
+generic<typename T>
+Object^ SqliteCollectionTable<T>::NextRowID(Object^ key)
+{
+	return Interlocked::Increment(m_lastRowID);
+}
+
+//---------------------------------------------------------------------------
+// SqliteCollectionTable::QuoteIdentifier (private, static)
+//
+// Quotes a table or column name for use in the CREATE TABLE statement
+//
+// Arguments:
+//
+//	identifier	- Table or column name to be quoted
+
+generic<typename T>
+String^ SqliteCollectionTable<T>::QuoteIdentifier(String^ identifier)
+{
+	return "\"" + identifier->Replace("\"", "\"\"") + "\"";
+}
+
+//---------------------------------------------------------------------------
+// SqliteCollectionTable::SelectBestIndex (private)
+//
+// Selects the cheapest of a full scan of the source collection, an equality
+// lookup, or a search against one of the sorted indexes
+//
+// Arguments:
+//
+//	args		- Index selection arguments
+
+generic<typename T>
+void SqliteCollectionTable<T>::SelectBestIndex(SqliteIndexSelectionArgs^ args)
+{
+	int						bestCode = 0;			// Selected plan code
+	int						bestFirst = -1;			// Selected first argument
+	int						bestSecond = -1;		// Selected second argument
+
+	ReadOnlyCollection<SqliteIndexConstraint^>^ constraints = args->Constraints;
+	SqliteIndexSortColumn^ sort = (args->SortColumns->Count == 1) ? args->SortColumns[0] : nullptr;
+
+	// Source collections that know how many rows they contain keep the row
+	// count statistic current; everything else uses what the indexes said
+
+	ICollection<T>^ collection = dynamic_cast<ICollection<T>^>(m_source);
+	IReadOnlyCollection<T>^ readOnlyCollection = dynamic_cast<IReadOnlyCollection<T>^>(m_source);
+
+	if(collection != nullptr) m_stats->RowCount = collection->Count;
+	else if(readOnlyCollection != nullptr) m_stats->RowCount = readOnlyCollection->Count;
+
+	// Start with a full scan of the source collection, which satisfies the
+	// ORDER BY only if it matches the declared order of the source.  With no
+	// declared order m_sortOrdinal is -1, which must not match ORDER BY ROWID
+
+	bool bestOrdered = (sort != nullptr) && (m_sortOrdinal >= 0) && (sort->ColumnOrdinal == m_sortOrdinal) && 
+		(sort->Direction == m_sortDirection);
+	double bestCost = EvaluatePlan(args, -1, -1, bestOrdered);
+
+	// Equality constraints against columns with a lookup index
+
+	for(int index = 0; index < constraints->Count; index++) {
+
+		SqliteIndexConstraint^ constraint = constraints[index];
+		if((!constraint->IsUsable) || (constraint->Operator != SqliteSearchOperator::Equal)) continue;
+		if(!m_lookups->ContainsKey(constraint->ColumnOrdinal)) continue;
+
+		// Every row returned from a lookup has the same key, so an ORDER BY on
+		// just that column is satisfied without doing anything
+
+		bool ordered = (sort != nullptr) && (sort->ColumnOrdinal == constraint->ColumnOrdinal);
+		double cost = EvaluatePlan(args, index, -1, ordered);
+
+		if(cost < bestCost) {
+
+			bestCost = cost;
+			bestCode = PLAN_LOOKUP | (constraint->ColumnOrdinal + 1);
+			bestFirst = index;
+			bestSecond = -1;
+			bestOrdered = ordered;
+		}
+	}
+
+	// Equality and range constraints against columns with a sorted index
+
+	for each(KeyValuePair<int, SqliteCollectionIndex<T>^> pair in m_sorted) {
+
+		int			equal = -1;					// Equality constraint
+		int			lower = -1;					// Lower bound constraint
+		int			upper = -1;					// Upper bound constraint
+		int			first = -1;					// First filter argument
+		int			second = -1;				// Second filter argument
+		bool		ordered = false;			// Flag if ORDER BY is satisfied
+
+		for(int index = 0; index < constraints->Count; index++) {
+
+			SqliteIndexConstraint^ constraint = constraints[index];
+			if((!constraint->IsUsable) || (constraint->ColumnOrdinal != pair.Key)) continue;
+
+			switch(constraint->Operator) {
+
+				case SqliteSearchOperator::Equal: 
+					if(equal < 0) equal = index; 
+					break;
+
+				case SqliteSearchOperator::GreaterThan:
+				case SqliteSearchOperator::GreaterThanOrEqual:
+					if(lower < 0) lower = index;
+					break;
+
+				case SqliteSearchOperator::LessThan:
+				case SqliteSearchOperator::LessThanOrEqual:
+					if(upper < 0) upper = index;
+					break;
+
+				default: break;
+			}
+		}
+
+		bool sortable = (sort != nullptr) && (sort->ColumnOrdinal == pair.Key);
+		int code = PLAN_SORTED | (pair.Key + 1);
+
+		if(equal >= 0) { code |= PLAN_EQUAL; first = equal; ordered = sortable; }
+		else {
+
+			// Walking the whole index only makes sense if that satisfies the
+			// ORDER BY, otherwise it's no better than scanning the source
+
+			ordered = sortable && pair.Value->IsOrdered;
+			if((lower < 0) && (upper < 0) && (!ordered)) continue;
+
+			if(lower >= 0) code |= PLAN_LOWER;
+			if(upper >= 0) code |= PLAN_UPPER;
+			if(ordered && (sort->Direction == SqliteSortDirection::Descending)) code |= PLAN_DESCENDING;
+
+			first = (lower >= 0) ? lower : upper;
+			second = ((lower >= 0) && (upper >= 0)) ? upper : -1;
+		}
+
+		double cost = EvaluatePlan(args, first, second, ordered);
+
+		if(cost < bestCost) {
+
+			bestCost = cost;
+			bestCode = code;
+			bestFirst = first;
+			bestSecond = second;
+			bestOrdered = ordered;
+		}
+	}
+
+	// Reapply the winning plan, since the index selection arguments currently
+	// reflect whichever plan happened to be evaluated last
+
+	EvaluatePlan(args, bestFirst, bestSecond, bestOrdered);
+
+	args->Identifier->Code = bestCode;
+	args->SortRequired = !bestOrdered;
+}
+
+//---------------------------------------------------------------------------
+// SqliteCollectionTable::SetSourceOrder
+//
+// Declares the order in which the source collection enumerates its rows
+//
+// Arguments:
+//
+//	column		- Column the source is sorted by, or null if unsorted
+//	direction	- Direction the source is sorted in
+
+generic<typename T>
+void SqliteCollectionTable<T>::SetSourceOrder(String^ column, SqliteSortDirection direction)
+{
+	m_sortOrdinal = (column != nullptr) ? GetOrdinal(column) : -1;
+	m_sortDirection = direction;
+}
+
+//---------------------------------------------------------------------------
+// SqliteCollectionTable::UseStableRowIDs (private)
+//
+// Switches to stable ROWIDs once an index has been added.  The engine uses the
+// ROWID to remove duplicates when it combines the results of several indexes
+// for an OR, so the same row has to have the same ROWID from every index.
+// Value types have no identity to track and are assigned ROWIDs by value
+//
+// Arguments:
+//
+//	NONE
+
+generic<typename T>
+void SqliteCollectionTable<T>::UseStableRowIDs(void)
+{
+	if((m_rowids != nullptr) || (m_valueRowIDs != nullptr)) return;
+
+	if(T::typeid->IsValueType) { m_valueRowIDs = gcnew Dictionary<T, List<__int64>^>(); return; }
+
+	m_nextRowID = gcnew ConditionalWeakTable<Object^, Object^>::CreateValueCallback(this, &SqliteCollectionTable<T>::NextRowID);
+	m_rowids = gcnew ConditionalWeakTable<Object^, Object^>();
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
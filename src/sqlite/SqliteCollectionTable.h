@@ -0,0 +1,388 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __SQLITECOLLECTIONTABLE_H_
+#define __SQLITECOLLECTIONTABLE_H_
+#pragma once
+
+#include "SqliteCollectionIndex.h"			// Include SqliteCollectionIndex decls
+#include "SqliteEnumerations.h"			// Include Sqlite enumeration decls
+#include "SqliteIndexSelectionArgs.h"		// Include SqliteIndexSelectionArgs decls
+#include "SqliteRowBatch.h"				// Include SqliteRowBatch declarations
+#include "SqliteVirtualTableBase.h"		// Include SqliteVirtualTableBase decls
+#include "SqliteVirtualTableStatistics.h"	// Include SqliteVirtualTableStatistics
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+#pragma warning(disable:4100)			// "unreferenced formal parameter"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Collections::ObjectModel;
+using namespace System::Globalization;
+using namespace System::Linq;
+using namespace System::Linq::Expressions;
+using namespace System::Reflection;
+using namespace System::Runtime::CompilerServices;
+using namespace System::Runtime::InteropServices;
+using namespace System::Text;
+using namespace System::Threading;
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// Forward Class Declarations
+//---------------------------------------------------------------------------
+
+generic<typename T> ref class SqliteCollectionTableCursor;	// SqliteCollectionTableCursor.h
+
+//---------------------------------------------------------------------------
+// Class SqliteCollectionTable
+//
+// SqliteCollectionTable exposes an in-memory IEnumerable<T> as a read-only
+// virtual table without having to write a table or cursor class.  Each public
+// readable property of T becomes a column, and the rows are copied into the
+// engine in batches through a single compiled delegate:
+//
+//	SqliteCollectionTable<Order>^ table = gcnew SqliteCollectionTable<Order>(orders);
+//	table->AddIndex("CustomerId", orders->ToLookup(...));
+//	connection->RegisterCollectionTable(table, "orders");
+//
+// Equality constraints can be pushed down into ILookup indexes, and equality
+// and range constraints into arrays sorted by a key.  An ORDER BY against a
+// sorted index key, or against the declared order of the source collection,
+// is satisfied without the engine having to sort the rows.
+//
+// ROWIDs are the position of each row in the sequence that produced it.  Once
+// an index has been added, rows are instead assigned a ROWID the first time
+// they are seen so that it stays the same for every index: reference-type
+// rows by object identity, value-type rows by value and occurrence.  DateTime
+// columns are stored as ISO-8601 text so that they compare chronologically
+//---------------------------------------------------------------------------
+
+generic<typename T>
+public ref class SqliteCollectionTable sealed : public SqliteVirtualTableBase
+{
+public:
+
+	// CONSTRUCTOR
+	SqliteCollectionTable(IEnumerable<T>^ source);
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// AddIndex
+	//
+	// Adds an equality index for a column
+	generic<typename TKey>
+	void AddIndex(String^ column, ILookup<TKey, T>^ lookup)
+	{
+		if(lookup == nullptr) throw gcnew ArgumentNullException("lookup");
+
+		int ordinal = GetOrdinal(column);
+		SqliteCollectionIndex<T>^ index = gcnew SqliteCollectionLookupIndex<T, TKey>(lookup);
+
+		m_lookups[ordinal] = index;
+		m_stats->SetDistinctCount(ordinal, index->DistinctCount);
+
+		UseStableRowIDs();
+	}
+
+	// AddSortedIndex
+	//
+	// Adds an equality and range index for a column, the rows must be sorted
+	// in ascending order by the key using the specified (or default) comparer
+	generic<typename TKey>
+	void AddSortedIndex(String^ column, array<T>^ rows, Func<T, TKey>^ keySelector)
+	{
+		AddSortedIndex(column, rows, keySelector, Comparer<TKey>::Default);
+	}
+
+	generic<typename TKey>
+	void AddSortedIndex(String^ column, array<T>^ rows, Func<T, TKey>^ keySelector, IComparer<TKey>^ comparer)
+	{
+		if(rows == nullptr) throw gcnew ArgumentNullException("rows");
+		if(keySelector == nullptr) throw gcnew ArgumentNullException("keySelector");
+		if(comparer == nullptr) throw gcnew ArgumentNullException("comparer");
+
+		int ordinal = GetOrdinal(column);
+		SqliteCollectionIndex<T>^ index = gcnew SqliteCollectionSortedIndex<T, TKey>(rows, keySelector, comparer);
+
+		m_sorted[ordinal] = index;
+		if(m_stats->RowCount < 0) m_stats->RowCount = index->RowCount;
+
+		UseStableRowIDs();
+	}
+
+	// SetSourceOrder
+	//
+	// Declares the order in which the source collection enumerates its rows,
+	// which must match the order SQLite would produce for the column
+	void SetSourceOrder(String^ column, SqliteSortDirection direction);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Source
+	//
+	// Gets the source collection
+	property IEnumerable<T>^ Source
+	{
+		IEnumerable<T>^ get(void) { return m_source; }
+	}
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// GetRowID
+	//
+	// Gets the ROWID for a row produced by a cursor
+	__int64 GetRowID(T item, __int64 position, Dictionary<T, int>^ occurrences);
+
+	// GetRows
+	//
+	// Gets the rows for an index selected by SelectBestIndex()
+	IEnumerable<T>^ GetRows(int code, SqliteArgumentCollection^ args);
+
+	//-----------------------------------------------------------------------
+	// Internal Properties
+
+	// ColumnCount
+	//
+	// Gets the number of columns in the table
+	property int ColumnCount
+	{
+		int get(void) { return m_properties->Length; }
+	}
+
+	// RowWriter
+	//
+	// Gets the compiled delegate that writes a row into a batch
+	property Action<T, SqliteRowBatch^, int>^ RowWriter
+	{
+		Action<T, SqliteRowBatch^, int>^ get(void) { return m_writer; }
+	}
+
+private:
+
+	// DESTRUCTOR
+	~SqliteCollectionTable() {}
+
+	//-----------------------------------------------------------------------
+	// Private Constants
+
+	// PLAN_XXXX
+	//
+	// Flags used to encode the selected plan into the index identifier code;
+	// the low 16 bits hold the ordinal of the index column plus one
+	literal int PLAN_ORDINAL_MASK	= 0x0000FFFF;
+	literal int PLAN_LOOKUP			= 0x00010000;
+	literal int PLAN_SORTED			= 0x00020000;
+	literal int PLAN_EQUAL			= 0x00040000;
+	literal int PLAN_LOWER			= 0x00080000;
+	literal int PLAN_UPPER			= 0x00100000;
+	literal int PLAN_DESCENDING		= 0x00200000;
+
+	// DATETIME_FORMAT
+	//
+	// ISO-8601 format used for DateTime columns; sorts the same as text
+	literal String^ DATETIME_FORMAT = "yyyy-MM-dd HH:mm:ss.FFFFFFF";
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// BeginTransaction (SqliteVirtualTableBase)
+	//
+	// Not supported; collection tables are read-only
+	virtual void BeginTransaction(void) sealed = SqliteVirtualTableBase::BeginTransaction
+	{
+		throw gcnew NotImplementedException();
+	}
+
+	// Close (SqliteVirtualTableBase)
+	//
+	// The table is owned by the application, nothing to do here
+	virtual void Close(void) sealed = SqliteVirtualTableBase::Close {}
+
+	// CommitTransaction (SqliteVirtualTableBase)
+	//
+	// Not supported; collection tables are read-only
+	virtual void CommitTransaction(void) sealed = SqliteVirtualTableBase::CommitTransaction
+	{
+		throw gcnew NotImplementedException();
+	}
+
+	// CompileRowWriter
+	//
+	// Compiles a delegate that writes every column of a row into a batch
+	static Action<T, SqliteRowBatch^, int>^ CompileRowWriter(array<PropertyInfo^>^ properties);
+
+	// Create (SqliteVirtualTableBase)
+	//
+	// There is no backing store to create
+	virtual void Create(void) sealed = SqliteVirtualTableBase::Create {}
+
+	// CreateCursor (SqliteVirtualTableBase)
+	//
+	// Creates a new cursor over the collection
+	virtual SqliteVirtualTableCursor^ CreateCursor(void) sealed = SqliteVirtualTableBase::CreateCursor;
+
+	// DeleteRow (SqliteVirtualTableBase)
+	//
+	// Not supported; collection tables are read-only
+	virtual void DeleteRow(__int64 rowid) sealed = SqliteVirtualTableBase::DeleteRow
+	{
+		throw gcnew NotImplementedException();
+	}
+
+	// Drop (SqliteVirtualTableBase)
+	//
+	// There is no backing store to drop
+	virtual void Drop(void) sealed = SqliteVirtualTableBase::Drop {}
+
+	// EvaluatePlan
+	//
+	// Applies a candidate plan to the index selection arguments and estimates
+	// the cost, including the cost of sorting when the plan is not ordered
+	double EvaluatePlan(SqliteIndexSelectionArgs^ args, int first, int second, bool ordered);
+
+	// FindFunction (SqliteVirtualTableBase)
+	//
+	// Collection tables do not override any functions
+	virtual bool FindFunction(String^ name, int argc, GCHandle% funcwrapper) sealed = SqliteVirtualTableBase::FindFunction
+	{
+		return false;
+	}
+
+	// GetCreateTableStatement (SqliteVirtualTableBase)
+	//
+	// Generates the CREATE TABLE statement from the properties of T
+	virtual String^ GetCreateTableStatement(String^ name) sealed = SqliteVirtualTableBase::GetCreateTableStatement;
+
+	// GetDeclaredType
+	//
+	// Gets the declared column type for a property type
+	static String^ GetDeclaredType(Type^ type);
+
+	// GetOrdinal
+	//
+	// Gets the ordinal of a column by name
+	int GetOrdinal(String^ column);
+
+	// InsertRow (SqliteVirtualTableBase)
+	//
+	// Not supported; collection tables are read-only
+	virtual void InsertRow(__int64 rowid, SqliteArgumentCollection^ values) sealed = SqliteVirtualTableBase::InsertRow
+	{
+		throw gcnew NotImplementedException();
+	}
+
+	// NewRowID (SqliteVirtualTableBase)
+	//
+	// Not supported; collection tables are read-only
+	virtual __int64 NewRowID(void) sealed = SqliteVirtualTableBase::NewRowID
+	{
+		throw gcnew NotImplementedException();
+	}
+
+	// NextRowID
+	//
+	// ConditionalWeakTable callback that assigns the next stable ROWID
+	Object^ NextRowID(Object^ key);
+
+	// Open (SqliteVirtualTableBase)
+	//
+	// Nothing to do when the table is opened
+	virtual void Open(void) sealed = SqliteVirtualTableBase::Open {}
+
+	// QuoteIdentifier
+	//
+	// Quotes a table or column name for use in the CREATE TABLE statement
+	static String^ QuoteIdentifier(String^ identifier);
+
+	// RollbackTransaction (SqliteVirtualTableBase)
+	//
+	// Not supported; collection tables are read-only
+	virtual void RollbackTransaction(void) sealed = SqliteVirtualTableBase::RollbackTransaction
+	{
+		throw gcnew NotImplementedException();
+	}
+
+	// SelectBestIndex (SqliteVirtualTableBase)
+	//
+	// Selects the cheapest of a full scan or one of the available indexes
+	virtual void SelectBestIndex(SqliteIndexSelectionArgs^ args) sealed = SqliteVirtualTableBase::SelectBestIndex;
+
+	// Synchronize (SqliteVirtualTableBase)
+	//
+	// Not supported; collection tables are read-only
+	virtual void Synchronize(void) sealed = SqliteVirtualTableBase::Synchronize
+	{
+		throw gcnew NotImplementedException();
+	}
+
+	// UpdateRow (SqliteVirtualTableBase)
+	//
+	// Not supported; collection tables are read-only
+	virtual void UpdateRow(__int64 rowid, SqliteArgumentCollection^ values) sealed = SqliteVirtualTableBase::UpdateRow
+	{
+		throw gcnew NotImplementedException();
+	}
+
+	// UpdateRowID (SqliteVirtualTableBase)
+	//
+	// Not supported; collection tables are read-only
+	virtual void UpdateRowID(__int64 oldrowid, __int64 newrowid) sealed = SqliteVirtualTableBase::UpdateRowID
+	{
+		throw gcnew NotImplementedException();
+	}
+
+	// UseStableRowIDs
+	//
+	// Switches to stable ROWIDs once indexed
+	void UseStableRowIDs(void);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	IEnumerable<T>^						m_source;		// Source collection
+	array<PropertyInfo^>^				m_properties;	// Column properties
+	Action<T, SqliteRowBatch^, int>^	m_writer;		// Compiled row writer
+	Dictionary<int, SqliteCollectionIndex<T>^>^	m_lookups;	// Equality indexes
+	Dictionary<int, SqliteCollectionIndex<T>^>^	m_sorted;	// Sorted indexes
+	int									m_sortOrdinal;	// Source sort column
+	SqliteSortDirection					m_sortDirection;	// Source sort direction
+	SqliteVirtualTableStatistics^		m_stats;		// Cost model statistics
+	ConditionalWeakTable<Object^, Object^>^	m_rowids;	// Stable ROWIDs
+	ConditionalWeakTable<Object^, Object^>::CreateValueCallback^ m_nextRowID;	// ROWID callback
+	Dictionary<T, List<__int64>^>^		m_valueRowIDs;	// Stable value-type ROWIDs
+	__int64								m_lastRowID;	// Last stable ROWID
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
+
+#endif		// __SQLITECOLLECTIONTABLE_H_
@@ -0,0 +1,117 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"						// Include project pre-compiled headers
+#include "SqliteCollectionTableCursor.h"	// Include SqliteCollectionTableCursor decls
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// SqliteCollectionTableCursor Constructor
+//
+// Arguments:
+//
+//	table		- Parent SqliteCollectionTable instance
+
+generic<typename T>
+SqliteCollectionTableCursor<T>::SqliteCollectionTableCursor(SqliteCollectionTable<T>^ table) : m_table(table)
+{
+	if(table == nullptr) throw gcnew ArgumentNullException("table");
+	ColumnCount = table->ColumnCount;
+
+	if(T::typeid->IsValueType) m_occurrences = gcnew Dictionary<T, int>();
+}
+
+//---------------------------------------------------------------------------
+// SqliteCollectionTableCursor::Close
+//
+// Invoked when the cursor is being closed
+//
+// Arguments:
+//
+//	NONE
+
+generic<typename T>
+void SqliteCollectionTableCursor<T>::Close(void)
+{
+	if(m_rows != nullptr) delete m_rows;
+	m_rows = nullptr;
+}
+
+//---------------------------------------------------------------------------
+// SqliteCollectionTableCursor::FillBatch
+//
+// Writes the next block of rows into the batch
+//
+// Arguments:
+//
+//	batch		- Row batch to be filled
+
+generic<typename T>
+int SqliteCollectionTableCursor<T>::FillBatch(SqliteRowBatch^ batch)
+{
+	int						count = 0;			// Number of rows written
+
+	if(m_rows == nullptr) return 0;
+
+	Action<T, SqliteRowBatch^, int>^ writer = m_table->RowWriter;
+
+	while((count < batch->Capacity) && m_rows->MoveNext()) {
+
+		T item = m_rows->Current;
+
+		writer(item, batch, count);
+		batch->SetRowID(count, m_table->GetRowID(item, ++m_position, m_occurrences));
+		count++;
+	}
+
+	return count;
+}
+
+//---------------------------------------------------------------------------
+// SqliteCollectionTableCursor::SetBatchFilter
+//
+// Selects the rows to be enumerated based on the chosen index
+//
+// Arguments:
+//
+//	index		- Index identifier from SelectBestIndex()
+//	args		- Filter arguments
+
+generic<typename T>
+void SqliteCollectionTableCursor<T>::SetBatchFilter(SqliteIndexIdentifier^ index, SqliteArgumentCollection^ args)
+{
+	Close();							// Release any previous enumerator
+
+	m_rows = m_table->GetRows(index->Code, args)->GetEnumerator();
+	m_position = 0;
+
+	if(m_occurrences != nullptr) m_occurrences->Clear();
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
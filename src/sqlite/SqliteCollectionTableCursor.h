@@ -0,0 +1,93 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __SQLITECOLLECTIONTABLECURSOR_H_
+#define __SQLITECOLLECTIONTABLECURSOR_H_
+#pragma once
+
+#include "SqliteBatchVirtualTableCursor.h"		// Include SqliteBatchVirtualTableCursor
+#include "SqliteCollectionTable.h"				// Include SqliteCollectionTable decls
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// Class SqliteCollectionTableCursor (internal)
+//
+// Batch cursor implementation for SqliteCollectionTable.  The rows selected
+// by the filter are enumerated and written into each batch using the compiled
+// row writer delegate from the table
+//---------------------------------------------------------------------------
+
+generic<typename T>
+ref class SqliteCollectionTableCursor sealed : public SqliteBatchVirtualTableCursor
+{
+public:
+
+	// CONSTRUCTOR
+	SqliteCollectionTableCursor(SqliteCollectionTable<T>^ table);
+
+protected public:
+
+	//-----------------------------------------------------------------------
+	// Protected/Public Member Functions
+
+	// Close (SqliteVirtualTableCursor)
+	//
+	// Invoked when the cursor is being closed
+	virtual void Close(void) override;
+
+	// FillBatch (SqliteBatchVirtualTableCursor)
+	//
+	// Writes the next block of rows into the batch
+	virtual int FillBatch(SqliteRowBatch^ batch) override;
+
+	// SetBatchFilter (SqliteBatchVirtualTableCursor)
+	//
+	// Selects the rows to be enumerated based on the chosen index
+	virtual void SetBatchFilter(SqliteIndexIdentifier^ index, SqliteArgumentCollection^ args) override;
+
+private:
+
+	// DESTRUCTOR
+	~SqliteCollectionTableCursor() { Close(); }
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	SqliteCollectionTable<T>^			m_table;		// Parent table
+	IEnumerator<T>^						m_rows;			// Row enumerator
+	__int64								m_position;		// Position in the rows
+	Dictionary<T, int>^					m_occurrences;	// Value-type row occurrences
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
+
+#endif		// __SQLITECOLLECTIONTABLECURSOR_H_
@@ -0,0 +1,171 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"						// Include project pre-compiled headers
+#include "SqliteColumnMetaDataCache.h"	// Include SqliteColumnMetaDataCache declarations
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// SqliteColumnMetaDataCache Constructor
+//
+// Arguments:
+//
+//	NONE
+
+SqliteColumnMetaDataCache::SqliteColumnMetaDataCache() : m_cookie(nullptr)
+{
+	m_columns = gcnew Dictionary<Tuple<String^, String^, String^>^, ColumnMetaData>();
+}
+
+//---------------------------------------------------------------------------
+// SqliteColumnMetaDataCache::CheckSchemaCookie
+//
+// Compares the current schema cookie of every attached database against the
+// one the cache was loaded under, and flushes the cache if they are different
+//
+// Arguments:
+//
+//	cookie			- Current schema cookie from SqliteUtil::GetSchemaCookie
+
+void SqliteColumnMetaDataCache::CheckSchemaCookie(String^ cookie)
+{
+	Monitor::Enter(m_columns);
+
+	try {
+
+		if(String::Equals(cookie, m_cookie)) return;
+
+		m_columns->Clear();
+		m_cookie = cookie;
+	}
+
+	finally { Monitor::Exit(m_columns); }
+}
+
+//---------------------------------------------------------------------------
+// SqliteColumnMetaDataCache::Clear
+//
+// Unconditionally flushes the contents of the cache
+//
+// Arguments:
+//
+//	NONE
+
+void SqliteColumnMetaDataCache::Clear(void)
+{
+	Monitor::Enter(m_columns);
+
+	try { m_columns->Clear(); m_cookie = nullptr; }
+	finally { Monitor::Exit(m_columns); }
+}
+
+//---------------------------------------------------------------------------
+// SqliteColumnMetaDataCache::GetColumnMetaData
+//
+// Retrieves the metadata for a column from the cache, asking the engine for
+// it if it hasn't been loaded yet.  Columns that can't be found are cached
+// as well, since expression columns are asked about over and over again
+//
+// Arguments:
+//
+//	hDatabase		- Database handle
+//	catalog			- Database (catalog) name
+//	table			- Table name
+//	column			- Column name
+//	metadata		- On success, receives the column metadata
+
+bool SqliteColumnMetaDataCache::GetColumnMetaData(sqlite3* hDatabase, String^ catalog, String^ table, 
+	String^ column, ColumnMetaData% metadata)
+{
+	ColumnMetaData				cached;			// Cached metadata
+
+	Tuple<String^, String^, String^>^ key = gcnew Tuple<String^, String^, String^>(catalog, table, column);
+
+	Monitor::Enter(m_columns);
+
+	try {
+
+		if(!m_columns->TryGetValue(key, cached)) {
+
+			LoadColumnMetaData(hDatabase, catalog, table, column, cached);
+			m_columns->Add(key, cached);
+		}
+	}
+
+	finally { Monitor::Exit(m_columns); }
+
+	metadata = cached;
+	return cached.Found;
+}
+
+//---------------------------------------------------------------------------
+// SqliteColumnMetaDataCache::LoadColumnMetaData (static)
+//
+// Retrieves the metadata for a column directly from the database engine
+//
+// Arguments:
+//
+//	hDatabase		- Database handle
+//	catalog			- Database (catalog) name
+//	table			- Table name
+//	column			- Column name
+//	metadata		- Receives the column metadata
+
+bool SqliteColumnMetaDataCache::LoadColumnMetaData(sqlite3* hDatabase, String^ catalog, String^ table, 
+	String^ column, ColumnMetaData% metadata)
+{
+	const char*			pszColumnDataType;		// Declared column data type
+	const char*			pszCollationSequence;	// Collation sequence name
+	int					bNotNull;				// NOT NULL flag
+	int					bPrimaryKey;			// PRIMARY KEY flag
+	int					bAutoIncrement;			// AUTOINCREMENT flag
+	int					nResult;				// Result from function call
+
+	metadata = ColumnMetaData();
+
+	// Columns that don't come from a table (expressions and the like) will never
+	// be found by the engine, so don't bother marshaling anything to ask it
+
+	if(String::IsNullOrEmpty(table) || String::IsNullOrEmpty(column)) return false;
+
+	nResult = sqlite3_table_column_metadata(hDatabase, AutoAnsiString(catalog), AutoAnsiString(table), 
+		AutoAnsiString(column), &pszColumnDataType, &pszCollationSequence, &bNotNull, &bPrimaryKey, &bAutoIncrement);
+	if(nResult != SQLITE_OK) return false;
+
+	metadata.Found = true;
+	metadata.DataTypeName = SqliteUtil::FastPtrToStringAnsi(pszColumnDataType);
+	metadata.CollationName = SqliteUtil::FastPtrToStringAnsi(pszCollationSequence);
+	metadata.NotNull = (bNotNull != 0);
+	metadata.PrimaryKey = (bPrimaryKey != 0);
+	metadata.AutoIncrement = (bAutoIncrement != 0);
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
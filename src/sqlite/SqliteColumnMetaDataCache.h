@@ -0,0 +1,113 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __SQLITECOLUMNMETADATACACHE_H_
+#define __SQLITECOLUMNMETADATACACHE_H_
+#pragma once
+
+#include "AutoAnsiString.h"				// Include AutoAnsiString declarations
+#include "SqliteUtil.h"					// Include SqliteUtil declarations
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Threading;
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// Class SqliteColumnMetaDataCache (internal)
+//
+// Connection-wide cache of the information returned by the engine's
+// sqlite3_table_column_metadata function, keyed by database, table and column
+// name.  The whole cache is flushed whenever the schema cookie changes, so
+// there is no need to track which tables were altered or dropped
+//---------------------------------------------------------------------------
+
+ref class SqliteColumnMetaDataCache sealed
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Data Types
+
+	// ColumnMetaData
+	//
+	// Information about a single table column
+	value struct ColumnMetaData
+	{
+		bool			Found;				// Flag if column was found
+		String^			DataTypeName;		// Declared data type
+		String^			CollationName;		// Collation sequence name
+		bool			NotNull;			// NOT NULL constraint
+		bool			PrimaryKey;			// Part of the PRIMARY KEY
+		bool			AutoIncrement;		// AUTOINCREMENT column
+	};
+
+	//-----------------------------------------------------------------------
+	// Constructor
+
+	SqliteColumnMetaDataCache();
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// CheckSchemaCookie
+	//
+	// Flushes the cache if the schema has changed since it was loaded
+	void CheckSchemaCookie(String^ cookie);
+
+	// Clear
+	//
+	// Unconditionally flushes the cache
+	void Clear(void);
+
+	// GetColumnMetaData
+	//
+	// Retrieves the metadata for a column, loading it into the cache as needed
+	bool GetColumnMetaData(sqlite3* hDatabase, String^ catalog, String^ table, String^ column, 
+		ColumnMetaData% metadata);
+
+	// LoadColumnMetaData (static)
+	//
+	// Retrieves the metadata for a column directly from the engine
+	static bool LoadColumnMetaData(sqlite3* hDatabase, String^ catalog, String^ table, String^ column,
+		ColumnMetaData% metadata);
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	Dictionary<Tuple<String^, String^, String^>^, ColumnMetaData>^	m_columns;
+
+	String^						m_cookie;			// Combined schema versions
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
+
+#endif		// __SQLITECOLUMNMETADATACACHE_H_
@@ -0,0 +1,164 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"					// Include project pre-compiled headers
+#include "SqliteColumnStream.h"		// Include SqliteColumnStream declarations
+#include "SqliteExceptions.h"			// Include SqliteExceptions declarations
+
+#pragma warning(push, 4)			// Enable maximum compiler warnings
+#pragma warning(disable:4100)		// "unreferenced formal parameter"
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// SqliteColumnStream Constructor (internal)
+//
+// Arguments:
+//
+//	pStatement		- Pointer to the parent statement handle
+//	ordinal			- Ordinal value of the column to be streamed
+
+SqliteColumnStream::SqliteColumnStream(StatementHandle* pStatement, int ordinal) :
+	m_pStatement(pStatement), m_ordinal(ordinal)
+{
+	if(!m_pStatement) throw gcnew ArgumentNullException();
+	if(ordinal < 0) throw gcnew ArgumentOutOfRangeException();
+
+	// Ask for the blob pointer before the length, so that any conversion the
+	// engine needs to do has already happened when the length is retrieved
+
+	sqlite3_column_blob(m_pStatement->Handle, m_ordinal);
+	m_cb = sqlite3_column_bytes(m_pStatement->Handle, m_ordinal);
+	m_row = m_pStatement->RowVersion;
+
+	m_pStatement->AddRef(this);
+}
+
+//---------------------------------------------------------------------------
+// SqliteColumnStream Finalizer
+
+SqliteColumnStream::!SqliteColumnStream()
+{
+	if(m_pStatement) m_pStatement->Release(this);	// Release statement handle
+	m_pStatement = NULL;							// Reset pointer to NULL
+}
+
+//---------------------------------------------------------------------------
+// SqliteColumnStream::Length::get
+//
+// Gets the length of the column value
+
+__int64 SqliteColumnStream::Length::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_cb;
+}
+
+//---------------------------------------------------------------------------
+// SqliteColumnStream::Position::get
+//
+// Gets the current position of the stream pointer
+
+__int64 SqliteColumnStream::Position::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_position;
+}
+
+//---------------------------------------------------------------------------
+// SqliteColumnStream::Position::set
+//
+// Sets the current position of the stream pointer
+
+void SqliteColumnStream::Position::set(__int64 value)
+{
+	CHECK_DISPOSED(m_disposed);
+	if((value < 0) || (value > m_cb)) throw gcnew ArgumentOutOfRangeException("value");
+
+	m_position = static_cast<int>(value);
+}
+
+//---------------------------------------------------------------------------
+// SqliteColumnStream::Read
+//
+// Reads data from the column value into a buffer
+//
+// Arguments:
+//
+//	buffer		- Destination buffer
+//	offset		- Offset into the destination buffer to begin writing
+//	count		- Maximum number of bytes to copy into the buffer
+
+int SqliteColumnStream::Read(array<System::Byte>^ buffer, int offset, int count)
+{
+	const unsigned char*		puData;			// Pointer to the column data
+
+	CHECK_DISPOSED(m_disposed);
+	if(buffer == nullptr) throw gcnew ArgumentNullException("buffer");
+	if((offset < 0) || (count < 0)) throw gcnew ArgumentOutOfRangeException();
+	if((buffer->Length - offset) < count) throw gcnew ArgumentException();
+
+	// The data pointer is only good while the statement is on the same row,
+	// which is something we can't see from here without the row version
+
+	if(m_pStatement->RowVersion != m_row) throw gcnew SqliteExceptions::ObsoleteRowException();
+
+	count = Math::Min(count, m_cb - m_position);
+	if(count <= 0) return 0;
+
+	puData = reinterpret_cast<const unsigned char*>(sqlite3_column_blob(m_pStatement->Handle, m_ordinal));
+	Marshal::Copy(IntPtr(const_cast<unsigned char*>(puData + m_position)), buffer, offset, count);
+
+	m_position += count;
+	return count;
+}
+
+//---------------------------------------------------------------------------
+// SqliteColumnStream::Seek
+//
+// Moves the stream pointer
+//
+// Arguments:
+//
+//	offset		- Offset to move the stream pointer
+//	origin		- Position from which to apply the offset
+
+__int64 SqliteColumnStream::Seek(__int64 offset, SeekOrigin origin)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	switch(origin) {
+
+		case SeekOrigin::Begin: Position = offset; break;
+		case SeekOrigin::Current: Position = m_position + offset; break;
+		case SeekOrigin::End: Position = m_cb + offset; break;
+		default: throw gcnew ArgumentOutOfRangeException("origin");
+	}
+
+	return m_position;
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
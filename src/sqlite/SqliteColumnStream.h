@@ -0,0 +1,140 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __SQLITECOLUMNSTREAM_H_
+#define __SQLITECOLUMNSTREAM_H_
+#pragma once
+
+#include "StatementHandle.h"			// Include StatementHandle decls
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::IO;
+using namespace System::Runtime::InteropServices;
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// Class SqliteColumnStream (internal)
+//
+// SqliteColumnStream is a read-only Stream returned by GetStream() that reads
+// the bytes of a column value directly out of the statement's current row,
+// without ever making a managed copy of the entire value.  Unlike a 
+// SqliteBinaryReader, these are not tracked by the statement; instead the
+// row version of the statement handle is captured when the stream is created,
+// and any access after the statement has moved on throws an exception
+//---------------------------------------------------------------------------
+
+ref class SqliteColumnStream sealed : public Stream
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Flush (Stream)
+	//
+	// Flushes any changes to this stream to the backing store
+	virtual void Flush() override {}
+	
+	// Read (Stream)
+	//
+	// Reads a set of values from the stream into the provided buffer
+	virtual	int	Read(array<System::Byte>^ buffer, int offset, int count) override;
+	
+	// Seek (Stream)
+	//
+	// Moves the internal stream data pointer
+	virtual __int64	Seek(__int64 offset, SeekOrigin origin) override;
+	
+	// SetLength (Stream)
+	//
+	// Not supported; the stream is read-only
+	virtual void SetLength(__int64 value) override { throw gcnew NotSupportedException(); }
+	
+	// Write (Stream)
+	//
+	// Not supported; the stream is read-only
+	virtual void Write(array<System::Byte>^ buffer, int offset, int count) override { throw gcnew NotSupportedException(); }
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// CanRead (Stream)
+	//
+	// Determines if the stream can currently be read from
+	virtual property bool CanRead { bool get(void) override { return !m_disposed; } }
+	
+	// CanSeek (Stream)
+	//
+	// Determines if the stream pointer can be repositioned
+	virtual property bool CanSeek { bool get(void) override { return !m_disposed; } }
+	
+	// CanWrite (Stream)
+	//
+	// Determines if the stream can currently be written into
+	virtual property bool CanWrite { bool get(void) override { return false; } }
+	
+	// Length (Stream)
+	//
+	// Exposes the overall length of the column value
+	virtual property __int64 Length { __int64 get(void) override; }
+
+	// Position (Stream)
+	//
+	// Gets or sets the absolute position of the stream pointer
+	virtual property __int64 Position 
+	{ 
+		__int64 get(void) override;
+		void set(__int64 value) override;
+	}
+
+internal:
+
+	// INTERNAL CONSTRUCTOR
+	SqliteColumnStream(StatementHandle* pStatement, int ordinal);
+
+private:
+
+	// DESTRUCTOR / FINALIZER
+	~SqliteColumnStream() { this->!SqliteColumnStream(); m_disposed = true; }
+	!SqliteColumnStream();
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	bool						m_disposed;			// Object disposal flag
+	StatementHandle*			m_pStatement;		// Contained statement handle
+	int							m_ordinal;			// Result set ordinal
+	unsigned int				m_row;				// Statement row version
+	int							m_cb;				// Size of the value data
+	int							m_position;			// Current stream position
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
+
+#endif		// __SQLITECOLUMNSTREAM_H_
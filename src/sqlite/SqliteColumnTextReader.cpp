@@ -0,0 +1,145 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"					// Include project pre-compiled headers
+#include "SqliteColumnTextReader.h"	// Include SqliteColumnTextReader declarations
+#include "SqliteExceptions.h"			// Include SqliteExceptions declarations
+
+#pragma warning(push, 4)			// Enable maximum compiler warnings
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// SqliteColumnTextReader Constructor (internal)
+//
+// Arguments:
+//
+//	pStatement		- Pointer to the parent statement handle
+//	ordinal			- Ordinal value of the column to be read
+
+SqliteColumnTextReader::SqliteColumnTextReader(StatementHandle* pStatement, int ordinal) :
+	m_pStatement(pStatement), m_ordinal(ordinal)
+{
+	if(!m_pStatement) throw gcnew ArgumentNullException();
+	if(ordinal < 0) throw gcnew ArgumentOutOfRangeException();
+
+	// Convert the value to UTF-16 before asking for the length, which is the
+	// order the engine wants these calls made in
+
+	sqlite3_column_text16(m_pStatement->Handle, m_ordinal);
+	m_cch = sqlite3_column_bytes16(m_pStatement->Handle, m_ordinal) / sizeof(wchar_t);
+	m_row = m_pStatement->RowVersion;
+
+	m_pStatement->AddRef(this);
+}
+
+//---------------------------------------------------------------------------
+// SqliteColumnTextReader Finalizer
+
+SqliteColumnTextReader::!SqliteColumnTextReader()
+{
+	if(m_pStatement) m_pStatement->Release(this);	// Release statement handle
+	m_pStatement = NULL;							// Reset pointer to NULL
+}
+
+//---------------------------------------------------------------------------
+// SqliteColumnTextReader::GetText (private)
+//
+// Gets a pointer to the column text
+//
+// Arguments:
+//
+//	NONE
+
+const wchar_t* SqliteColumnTextReader::GetText(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(m_pStatement->RowVersion != m_row) throw gcnew SqliteExceptions::ObsoleteRowException();
+	return reinterpret_cast<const wchar_t*>(sqlite3_column_text16(m_pStatement->Handle, m_ordinal));
+}
+
+//---------------------------------------------------------------------------
+// SqliteColumnTextReader::Peek
+//
+// Returns the next available character without consuming it
+//
+// Arguments:
+//
+//	NONE
+
+int SqliteColumnTextReader::Peek(void)
+{
+	const wchar_t*		pwszText = GetText();		// Pointer to the text
+
+	return (m_position < m_cch) ? pwszText[m_position] : -1;
+}
+
+//---------------------------------------------------------------------------
+// SqliteColumnTextReader::Read
+//
+// Reads the next character from the column value
+//
+// Arguments:
+//
+//	NONE
+
+int SqliteColumnTextReader::Read(void)
+{
+	const wchar_t*		pwszText = GetText();		// Pointer to the text
+
+	return (m_position < m_cch) ? pwszText[m_position++] : -1;
+}
+
+//---------------------------------------------------------------------------
+// SqliteColumnTextReader::Read
+//
+// Reads a block of characters from the column value into a buffer
+//
+// Arguments:
+//
+//	buffer		- Destination buffer
+//	index		- Offset into the destination buffer to begin writing
+//	count		- Maximum number of characters to copy into the buffer
+
+int SqliteColumnTextReader::Read(array<Char>^ buffer, int index, int count)
+{
+	const wchar_t*		pwszText = GetText();		// Pointer to the text
+
+	if(buffer == nullptr) throw gcnew ArgumentNullException("buffer");
+	if((index < 0) || (count < 0)) throw gcnew ArgumentOutOfRangeException();
+	if((buffer->Length - index) < count) throw gcnew ArgumentException();
+
+	count = Math::Min(count, m_cch - m_position);
+	if(count <= 0) return 0;
+
+	Marshal::Copy(IntPtr(const_cast<wchar_t*>(pwszText + m_position)), buffer, index, count);
+
+	m_position += count;
+	return count;
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
@@ -0,0 +1,104 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __SQLITECOLUMNTEXTREADER_H_
+#define __SQLITECOLUMNTEXTREADER_H_
+#pragma once
+
+#include "StatementHandle.h"			// Include StatementHandle decls
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::IO;
+using namespace System::Runtime::InteropServices;
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// Class SqliteColumnTextReader (internal)
+//
+// SqliteColumnTextReader is the TextReader returned by GetTextReader(), and
+// reads the characters of a column value directly out of the statement's
+// current row.  Like SqliteColumnStream, it is not tracked by the statement
+// and instead refuses to be used once the statement has moved off of the row
+//---------------------------------------------------------------------------
+
+ref class SqliteColumnTextReader sealed : public TextReader
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Peek (TextReader)
+	//
+	// Returns the next available character without consuming it
+	virtual int Peek(void) override;
+
+	// Read (TextReader)
+	//
+	// Reads the next character from the column value
+	virtual int Read(void) override;
+
+	// Read (TextReader)
+	//
+	// Reads a block of characters from the column value into a buffer
+	virtual int Read(array<Char>^ buffer, int index, int count) override;
+
+internal:
+
+	// INTERNAL CONSTRUCTOR
+	SqliteColumnTextReader(StatementHandle* pStatement, int ordinal);
+
+private:
+
+	// DESTRUCTOR / FINALIZER
+	~SqliteColumnTextReader() { this->!SqliteColumnTextReader(); m_disposed = true; }
+	!SqliteColumnTextReader();
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// GetText
+	//
+	// Gets a pointer to the column text, after verifying the row is still current
+	const wchar_t* GetText(void);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	bool						m_disposed;			// Object disposal flag
+	StatementHandle*			m_pStatement;		// Contained statement handle
+	int							m_ordinal;			// Result set ordinal
+	unsigned int				m_row;				// Statement row version
+	int							m_cch;				// Length of the value text
+	int							m_position;			// Current character position
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
+
+#endif		// __SQLITECOLUMNTEXTREADER_H_
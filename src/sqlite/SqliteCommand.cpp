@@ -25,12 +25,44 @@
 #include "SqliteConnection.h"			// Include SqliteConnection declarations
 #include "SqliteDataAdapter.h"			// Include SqliteDataAdapter declarations
 #include "SqliteDataReader.h"			// Include SqliteDataReader declarations
+#include "SqliteEventSource.h"			// Include SqliteEventSource declarations
 #include "SqliteTransaction.h"			// Include SqliteTransaction declarations
 
 #pragma warning(push, 4)			// Enable maximum compiler warnings
 
 namespace zuki::data::sqlite {
 
+//---------------------------------------------------------------------------
+// sqlitecommand_busy_handler
+//
+// Busy handler installed in place of sqlite3_busy_timeout() so that waits on
+// a locked database can be counted.  Sleeps on the same schedule the engine's
+// own busy timeout handler uses
+//
+// Arguments:
+//
+//	context		- Busy timeout in milliseconds
+//	count		- Number of times the handler has been invoked for this lock
+
+static int sqlitecommand_busy_handler(void* context, int count)
+{
+	static const int delays[] = { 1, 2, 5, 10, 15, 20, 25, 25, 25, 50, 50, 100 };
+	static const int totals[] = { 0, 1, 3, 8, 18, 33, 53, 78, 103, 128, 178, 228 };
+
+	int timeout = static_cast<int>(reinterpret_cast<intptr_t>(context));
+	int delay, prior;					// Next delay and total time waited
+
+	if(count < _countof(delays)) { delay = delays[count]; prior = totals[count]; }
+	else { delay = delays[_countof(delays) - 1]; prior = totals[_countof(totals) - 1] + delay * (count - (_countof(totals) - 1)); }
+
+	if(prior + delay > timeout) { delay = timeout - prior; if(delay <= 0) return 0; }
+
+	SqliteEventSource::BusyWait();		// Count the wait
+	sqlite3_sleep(delay);				// Wait for the lock
+
+	return 1;
+}
+
 //---------------------------------------------------------------------------
 // SqliteCommand Destructor
 
@@ -47,6 +79,22 @@ SqliteCommand::~SqliteCommand()
 	m_disposed = true;				// Object is now disposed of
 }
 
+//---------------------------------------------------------------------------
+// SqliteCommand::AddStatistics (internal)
+//
+// Accumulates the statement counters from an execution of this command, and
+// passes them along to the connection in case they are being sampled
+//
+// Arguments:
+//
+//	statistics		- Statement counters from the execution
+
+void SqliteCommand::AddStatistics(SqliteStatementStatistics statistics)
+{
+	m_stats = m_stats + statistics;
+	if((m_conn != nullptr) && !m_conn->IsDisposed()) m_conn->SampleStatistics(m_commandText, statistics);
+}
+
 //---------------------------------------------------------------------------
 // SqliteCommand::Cancel
 //
@@ -87,6 +135,11 @@ void SqliteCommand::CommandText::set(String^ value)
 	CHECK_DISPOSED(m_disposed);
 	if(m_readerTracker->IsAlive) throw gcnew SqliteExceptions::OpenReaderException();
 
+	// SqliteCommandBuilder resets the command text of the commands it generates
+	// each time they're retrieved, which shouldn't throw away a prepared query
+
+	if(String::Equals(value, m_commandText)) return;
+
 	UncompileQuery();					// Must uncompile if command changes
 	m_commandText = value;				// Change contained command text
 }
@@ -291,8 +344,10 @@ DbDataReader^ SqliteCommand::ExecuteDbDataReader(CommandBehavior behavior)
 int SqliteCommand::ExecuteNonQuery(void)
 {
 	SqliteQuery^				query;				// Reference to the query object
+	SqliteStatement^			statement;			// Current statement in the query
 	int						changes = 0;		// Total number of changes by query
 	int						nResult;			// Result from function call
+	SqliteStatementStatistics	statistics;			// Accumulated statement counters
 
 	CHECK_DISPOSED(m_disposed);
 	SqliteUtil::CheckConnectionReady(m_conn);
@@ -309,7 +364,7 @@ int SqliteCommand::ExecuteNonQuery(void)
 	// a new query based on the current CommandText property value
 
 	if(m_compiledQuery != nullptr) query = m_compiledQuery;
-	else query = gcnew SqliteQuery(m_conn->HandlePointer, GetCommandText());
+	else query = gcnew SqliteQuery(m_conn->HandlePointer, GetCommandText(), false, m_lazyPrepare);
 
 	try { 
 		
@@ -319,17 +374,22 @@ int SqliteCommand::ExecuteNonQuery(void)
 
 			// Always set the busy timeout immediately before executing the command
 
-			nResult = sqlite3_busy_timeout(m_conn->Handle, m_timeout * 1000);
+			nResult = SetBusyTimeout();
 			if(nResult != SQLITE_OK) throw gcnew SqliteException(m_conn->Handle, nResult);
 
 			// For every statement in the compiled query, bind the local parameter
 			// collection to it, and execute it.  It takes care of everything else
 
-			for each(SqliteStatement^ statement in query) {
+			for(int index = 0; (statement = query->GetStatement(index)) != nullptr; index++) {
 				
 				statement->BindParameters(m_params, m_conn);		
+
+				SqliteStatementStatistics baseline = statement->Statistics;
 				changes += statement->ExecuteNonQuery();
+				statistics = statistics + SqliteStatementStatistics::Difference(statement->Statistics, baseline);
 			}
+
+			AddStatistics(statistics);
 		}
 
 		finally { m_params->Unlock(); }					// Unlock the parameters
@@ -390,8 +450,10 @@ SqliteDataReader^ SqliteCommand::ExecuteReader(SqliteCommandBehavior behavior)
 Object^ SqliteCommand::ExecuteScalar(void)
 {
 	SqliteQuery^			query;					// Reference to the query object
+	SqliteStatement^		statement;				// Current statement in the query
 	Object^				result = nullptr;		// Result from this function
 	int					nResult;				// Result from function call
+	SqliteStatementStatistics	statistics;		// Accumulated statement counters
 
 	CHECK_DISPOSED(m_disposed);
 	SqliteUtil::CheckConnectionReady(m_conn);
@@ -408,7 +470,7 @@ Object^ SqliteCommand::ExecuteScalar(void)
 	// a new query based on the current CommandText property value
 
 	if(m_compiledQuery != nullptr) query = m_compiledQuery;
-	else query = gcnew SqliteQuery(m_conn->HandlePointer, GetCommandText());
+	else query = gcnew SqliteQuery(m_conn->HandlePointer, GetCommandText(), false, m_lazyPrepare);
 
 	try { 
 
@@ -418,14 +480,14 @@ Object^ SqliteCommand::ExecuteScalar(void)
 
 			// Always set the busy timeout immediately before executing the command
 
-			nResult = sqlite3_busy_timeout(m_conn->Handle, m_timeout * 1000);
+			nResult = SetBusyTimeout();
 			if(nResult != SQLITE_OK) throw gcnew SqliteException(m_conn->Handle, nResult);
 
 			// Iterate over all of the individual statements and decide what to
 			// do with them.  Once we have a scalar result, any remaining statements
 			// become non-queries from our perspective
 
-			for each(SqliteStatement^ statement in query) {
+			for(int index = 0; (statement = query->GetStatement(index)) != nullptr; index++) {
 
 				statement->BindParameters(m_params, m_conn);	// Bind params
 
@@ -434,9 +496,15 @@ Object^ SqliteCommand::ExecuteScalar(void)
 				// This ends up giving us the very first object returned by the
 				// query, yet still executes all remaining statements ...
 
+				SqliteStatementStatistics baseline = statement->Statistics;
+
 				if(result != nullptr) statement->ExecuteNonQuery();
 				else result = statement->ExecuteScalar();
+
+				statistics = statistics + SqliteStatementStatistics::Difference(statement->Statistics, baseline);
 			}
+
+			AddStatistics(statistics);
 		}
 
 		finally { m_params->Unlock(); }					// Unlock the parameters
@@ -521,6 +589,32 @@ String^ SqliteCommand::GetCommandText(void)
 		m_commandText : String::Empty);
 }
 
+//---------------------------------------------------------------------------
+// SqliteCommand::LazyPrepare::get
+//
+// Gets a flag indicating if multi-statement command text is compiled one
+// statement at a time as execution reaches it
+
+bool SqliteCommand::LazyPrepare::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_lazyPrepare;
+}
+
+//---------------------------------------------------------------------------
+// SqliteCommand::LazyPrepare::set
+//
+// Sets a flag indicating if multi-statement command text is compiled one
+// statement at a time as execution reaches it
+
+void SqliteCommand::LazyPrepare::set(bool value)
+{
+	CHECK_DISPOSED(m_disposed);
+	if(m_readerTracker->IsAlive) throw gcnew SqliteExceptions::OpenReaderException();
+
+	m_lazyPrepare = value;
+}
+
 //---------------------------------------------------------------------------
 // SqliteCommand::Parameters::get
 //
@@ -556,7 +650,50 @@ void SqliteCommand::Prepare(void)
 	// query set up in our local CommandText property
 
 	UncompileQuery();
-	m_compiledQuery = gcnew SqliteQuery(m_conn->HandlePointer, GetCommandText());
+	m_compiledQuery = gcnew SqliteQuery(m_conn->HandlePointer, GetCommandText(), true, false);
+}
+
+//---------------------------------------------------------------------------
+// SqliteCommand::ResetStatistics
+//
+// Resets the performance counters accumulated by this command
+//
+// Arguments:
+//
+//	NONE
+
+void SqliteCommand::ResetStatistics(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	m_stats = SqliteStatementStatistics();
+}
+
+//---------------------------------------------------------------------------
+// SqliteCommand::SetBusyTimeout (private)
+//
+// Installs the counting busy handler with this command's timeout; a timeout
+// of zero removes it, just like sqlite3_busy_timeout() would have
+//
+// Arguments:
+//
+//	NONE
+
+int SqliteCommand::SetBusyTimeout(void)
+{
+	intptr_t timeout = static_cast<intptr_t>(m_timeout) * 1000;
+	return sqlite3_busy_handler(m_conn->Handle, (timeout > 0) ? sqlitecommand_busy_handler : NULL, 
+		reinterpret_cast<void*>(timeout));
+}
+
+//---------------------------------------------------------------------------
+// SqliteCommand::Statistics::get
+//
+// Gets the performance counters accumulated by every execution of this command
+
+SqliteStatementStatistics SqliteCommand::Statistics::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_stats;
 }
 
 //---------------------------------------------------------------------------
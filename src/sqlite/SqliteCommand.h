@@ -107,6 +107,11 @@ public:
 	// Compiles the provided command text for repeated executions
 	virtual void Prepare(void) override;
 
+	// ResetStatistics
+	//
+	// Resets the performance counters accumulated by this command
+	void ResetStatistics(void);
+
 	//-----------------------------------------------------------------------
 	// Properties
 
@@ -174,6 +179,18 @@ public:
 		void set(UpdateRowSource value) = DbCommand::UpdatedRowSource::set;
 	}
 
+	// LazyPrepare
+	//
+	// Gets or sets a flag indicating if multi-statement command text that has
+	// not been prepared is compiled one statement at a time as execution gets
+	// to it, rather than all up front.  A statement that fails to compile is
+	// then only reported after every statement before it has been executed
+	property bool LazyPrepare
+	{
+		bool get(void);
+		void set(bool value);
+	}
+
 	// UpdatedRowSource (DbCommand)
 	//
 	// Gets or sets how results are applied in a SqliteDataAdapter instance
@@ -188,6 +205,12 @@ public:
 	// Gets a reference to the contained SqliteParameterCollection object
 	property SqliteParameterCollection^ Parameters { SqliteParameterCollection^ get(void) new; }
 
+	// Statistics
+	//
+	// Gets the performance counters accumulated by every execution of this
+	// command, including those made through a SqliteDataReader
+	property SqliteStatementStatistics Statistics { SqliteStatementStatistics get(void); }
+
 protected:
 
 	//-----------------------------------------------------------------------
@@ -232,6 +255,29 @@ protected:
 		void set(Data::Common::DbTransaction^ value) override { (value); }
 	}
 
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// AddStatistics
+	//
+	// Accumulates the counters from an execution of this command
+	void AddStatistics(SqliteStatementStatistics statistics);
+
+	// Unprepare
+	//
+	// Releases the query compiled by a previous call to Prepare()
+	void Unprepare(void) { UncompileQuery(); }
+
+	//-----------------------------------------------------------------------
+	// Internal Properties
+
+	// IsPrepared
+	//
+	// Determines if Prepare() has been called and is still in effect
+	property bool IsPrepared { bool get(void) { return (m_compiledQuery != nullptr); } }
+
 private:
 
 	// DESTRUCTOR
@@ -258,6 +304,11 @@ private:
 	// Gets appropriate query command text based on the CommandType
 	String^ GetCommandText(void);
 
+	// SetBusyTimeout
+	//
+	// Installs the busy handler on the connection using this command's timeout
+	int SetBusyTimeout(void);
+
 	// UncompileQuery
 	//
 	// If there is a prepared query in place, this cleans it up
@@ -276,6 +327,8 @@ private:
 	ObjectTracker^			m_readerTracker;		// DataReader tracker
 	SqliteUpdateRowSource		m_updatedRowSource;		// Stupid data adapter property
 	SqliteCommandType			m_commandType;			// Command type code
+	SqliteStatementStatistics	m_stats;				// Accumulated counters
+	bool					m_lazyPrepare;			// Flag to compile lazily
 };
 
 //---------------------------------------------------------------------------
@@ -96,6 +96,62 @@ void SqliteCommandBuilder::CatalogSeparator::set(String^ value)
 	if(value != ".") throw gcnew ArgumentException();
 }
 
+//---------------------------------------------------------------------------
+// SqliteCommandBuilder::GetSchemaTable (protected)
+//
+// Gets the schema table for the SELECT command.  Generating this requires a
+// sqlite3_table_column_metadata call for every column, which adds up quickly
+// when applications create a new command builder for every operation, so the
+// result is cached on the connection until the database schema changes
+//
+// Arguments:
+//
+//	sourceCommand	- SELECT command to get the schema information for
+
+DataTable^ SqliteCommandBuilder::GetSchemaTable(DbCommand^ sourceCommand)
+{
+	SqliteCommand^				command;		// Provider command object
+	DataTable^					schema;			// Schema table to return
+
+	command = safe_cast<SqliteCommand^>(sourceCommand);
+
+	// If the connection isn't ready, let the base class deal with the error
+	// in whatever manner it sees fit -- just don't cache anything
+
+	if((command == nullptr) || (command->Connection == nullptr) || 
+		(command->Connection->State != ConnectionState::Open)) return __super::GetSchemaTable(sourceCommand);
+
+	schema = command->Connection->GetBuilderSchema(command->CommandText);
+	if(schema != nullptr) return schema;
+
+	schema = __super::GetSchemaTable(sourceCommand);
+	command->Connection->CacheBuilderSchema(command->CommandText, schema);
+
+	return schema;
+}
+
+//---------------------------------------------------------------------------
+// SqliteCommandBuilder::PrepareCommand (private, static)
+//
+// Prepares a generated command so that it's compiled statement is reused for
+// each row processed by the data adapter.  Nothing is done if the connection
+// is not open; the command will simply be compiled when it's executed
+//
+// Arguments:
+//
+//	command			- Generated command object
+
+SqliteCommand^ SqliteCommandBuilder::PrepareCommand(IDbCommand^ command)
+{
+	SqliteCommand^ sqlcommand = safe_cast<SqliteCommand^>(command);
+	if(sqlcommand == nullptr) return nullptr;
+
+	if((sqlcommand->Connection != nullptr) && (sqlcommand->Connection->State == ConnectionState::Open) &&
+		!sqlcommand->IsPrepared) sqlcommand->Prepare();
+
+	return sqlcommand;
+}
+
 //---------------------------------------------------------------------------
 // SqliteCommandBuilder::QuoteIdentifier
 //
@@ -63,28 +63,28 @@ public:
 	// GetDeleteCommand
 	//
 	// Gets the automatically generated DELETE command
-	SqliteCommand^ GetDeleteCommand(void) new { return safe_cast<SqliteCommand^>(__super::GetDeleteCommand()); }
+	SqliteCommand^ GetDeleteCommand(void) new { return PrepareCommand(__super::GetDeleteCommand()); }
 	SqliteCommand^ GetDeleteCommand(bool useColumnsForParameterNames) new
 	{ 
-		return safe_cast<SqliteCommand^>(__super::GetDeleteCommand(useColumnsForParameterNames)); 
+		return PrepareCommand(__super::GetDeleteCommand(useColumnsForParameterNames)); 
 	}
 
 	// GetInsertCommand
 	//
 	// Gets the automatically generated INSERT command
-	SqliteCommand^ GetInsertCommand(void) new  { return safe_cast<SqliteCommand^>(__super::GetInsertCommand()); }
+	SqliteCommand^ GetInsertCommand(void) new  { return PrepareCommand(__super::GetInsertCommand()); }
 	SqliteCommand^ GetInsertCommand(bool useColumnsForParameterNames) new
 	{ 
-		return safe_cast<SqliteCommand^>(__super::GetInsertCommand(useColumnsForParameterNames)); \
+		return PrepareCommand(__super::GetInsertCommand(useColumnsForParameterNames));
 	}
 
 	// GetUpdateCommand
 	//
 	// Gets the automatically generated UPDATE command
-	SqliteCommand^ GetUpdateCommand(void) new  { return safe_cast<SqliteCommand^>(__super::GetUpdateCommand()); }
+	SqliteCommand^ GetUpdateCommand(void) new  { return PrepareCommand(__super::GetUpdateCommand()); }
 	SqliteCommand^ GetUpdateCommand(bool useColumnsForParameterNames) new
 	{ 
-		return safe_cast<SqliteCommand^>(__super::GetUpdateCommand(useColumnsForParameterNames)); 
+		return PrepareCommand(__super::GetUpdateCommand(useColumnsForParameterNames)); 
 	}
 
 	// QuoteIdenfifier (DbCommandBuilder)
@@ -175,6 +175,12 @@ protected:
 	// Returns the placeholder for the specified parameter
 	virtual String^ GetParameterPlaceholder(int ordinal) override { return GetParameterName(ordinal); }
 
+	// GetSchemaTable (DbCommandBuilder)
+	//
+	// Gets the schema table for the SELECT command, using the connection's
+	// cache of previously generated schema tables whenever possible
+	virtual DataTable^ GetSchemaTable(DbCommand^ sourceCommand) override;
+
 	// SetRowUpdatingEventHandler (DbCommandBuilder)
 	//
 	// Registers this DbCommandBuilder with the adapter's RowUpdating event
@@ -192,7 +198,13 @@ private:
 	{
 		UNREFERENCED_PARAMETER(sender);
 		__super::RowUpdatingHandler(args);
+		if(args->Command != nullptr) PrepareCommand(args->Command);
 	}
+
+	// PrepareCommand
+	//
+	// Prepares a generated command if it hasn't been already
+	static SqliteCommand^ PrepareCommand(IDbCommand^ command);
 };
 
 //---------------------------------------------------------------------------
@@ -25,6 +25,7 @@
 #include "SqliteConnection.h"
 #include "SqliteCommand.h"
 #include "SqliteDataReader.h"
+#include "SqliteEventSource.h"
 #include "SqliteMetaData.h"
 #include "SqliteTransaction.h"
 
@@ -62,8 +63,19 @@ SqliteConnection::~SqliteConnection()
 
 SqliteConnection::!SqliteConnection()
 {
+	// The database handle can outlive this object.  If it's still open the
+	// trace callback is registered with it, and removing that here would call
+	// into the handle from the finalizer thread, so the handle adopts the
+	// dispatcher instead and destroys it once it has actually been closed
+
+	if(m_pDatabase && m_pTrace) { m_pDatabase->AdoptTraceDispatcher(m_pTrace); m_pTrace = NULL; }
+	if(m_pDatabase) SqliteEventSource::ConnectionClosed(m_pDatabase);
+
 	if(m_pDatabase) m_pDatabase->Release(this);		// Release the reference
 	m_pDatabase = NULL;								// Reset pointer to NULL
+
+	delete m_pTrace;								// Destroy the dispatcher
+	m_pTrace = NULL;								// Reset pointer to NULL
 }
 
 //---------------------------------------------------------------------------
@@ -93,8 +105,8 @@ void SqliteConnection::ApplyConnectionPragmas(void)
 
 	Debug::Assert(m_state == ConnectionState::Open);
 
-	// PRAGMA AUTO_VACUUM = { 0 | 1 }
-	query = String::Format("PRAGMA AUTO_VACUUM = {0}", m_cs->AutoVacuum ? "1" : "0");
+	// PRAGMA AUTO_VACUUM = { 0 | NONE | 1 | FULL | 2 | INCREMENTAL }
+	query = String::Format("PRAGMA AUTO_VACUUM = {0}", static_cast<int>(m_cs->AutoVacuum));
 	SqliteUtil::ExecuteNonQuery(m_pDatabase->Handle, query);
 
 	// PRAGMA CACHE_SIZE = { n }
@@ -156,7 +168,7 @@ void SqliteConnection::Attach(String^ path, String^ databaseName)
 //
 // Retrieves the configured AUTO_VACUUM setting for the open database
 
-bool SqliteConnection::AutoVacuum::get(void)
+SqliteAutoVacuumMode SqliteConnection::AutoVacuum::get(void)
 {
 	CHECK_DISPOSED(m_disposed);
 	SqliteUtil::CheckConnectionOpen(this);
@@ -164,6 +176,152 @@ bool SqliteConnection::AutoVacuum::get(void)
 	return m_autoVacuum;			// Return the configured value
 }
 
+//---------------------------------------------------------------------------
+// SqliteConnection::BackgroundVacuumCallback (private)
+//
+// Timer callback for the background incremental vacuum.  The timer thread
+// never touches the database handle, it only marks a slice as being due so
+// that the next call to PerformBackgroundVacuum on the owning thread runs it
+//
+// Arguments:
+//
+//	state		- Unused timer state object
+
+void SqliteConnection::BackgroundVacuumCallback(Object^ state)
+{
+	(state);
+	m_vacuumDue = true;
+}
+
+//---------------------------------------------------------------------------
+// SqliteConnection::BackupTo
+//
+// Performs an online backup of a database from this connection into the main
+// database of another connection.  The backup is performed in steps, with the
+// BackupProgress event fired after each of them so the caller can monitor and
+// optionally cancel the operation.  Returns FALSE if the backup was cancelled
+//
+// Arguments:
+//
+//	destination		- Connection to receive the copy of the database
+//	databaseName	- Name of the source database in this connection
+//	pagesPerStep	- Number of pages to copy per step, or -1 for all of them
+//	pause			- Time to pause between each step to allow other access
+
+bool SqliteConnection::BackupTo(SqliteConnection^ destination, String^ databaseName, int pagesPerStep, TimeSpan pause)
+{
+	sqlite3_backup*					pBackup;		// Backup object handle
+	SqliteBackupProgressEventArgs^	args;			// Progress event arguments
+	int								nResult;		// Result from function call
+	bool							busy = false;	// Flag if step was busy/locked
+	Diagnostics::Stopwatch^			retry;			// Busy/locked retry stopwatch
+
+	CHECK_DISPOSED(m_disposed);
+	ExecutePermission->Demand();
+	SqliteUtil::CheckConnectionReady(this);
+	SqliteUtil::CheckConnectionReady(destination);
+
+	if(databaseName == nullptr) throw gcnew ArgumentNullException();
+	if(Object::ReferenceEquals(destination, this)) throw gcnew ArgumentException();
+	if((pagesPerStep == 0) || (pagesPerStep < -1)) throw gcnew ArgumentOutOfRangeException("pagesPerStep");
+	if(pause < TimeSpan::Zero) throw gcnew ArgumentOutOfRangeException("pause");
+
+	sqlite3* hDestination = destination->HandlePointer->Handle;
+
+	// Initialize the backup.  On failure the error information is associated
+	// with the destination database handle, not this one
+
+	pBackup = sqlite3_backup_init(hDestination, AutoAnsiString(MAIN_CATALOG_NAME), m_pDatabase->Handle, 
+		AutoAnsiString(databaseName));
+	if(pBackup == NULL) throw gcnew SqliteException(hDestination, sqlite3_errcode(hDestination));
+
+	retry = gcnew Diagnostics::Stopwatch();
+
+	try {
+
+		do {
+
+			nResult = sqlite3_backup_step(pBackup, pagesPerStep);
+			busy = ((nResult == SQLITE_BUSY) || (nResult == SQLITE_LOCKED));
+
+			// SQLITE_BUSY and SQLITE_LOCKED are not fatal, the step can be retried
+			// after waiting for the other connection to release it's lock.  If this
+			// connection holds the write lock itself that will never happen, and
+			// other connections only get BACKUP_BUSY_TIMEOUT_MS to let it go
+
+			if(busy) {
+
+				if((nResult == SQLITE_LOCKED) && (sqlite3_txn_state(m_pDatabase->Handle, 
+					AutoAnsiString(databaseName)) == SQLITE_TXN_WRITE)) break;
+
+				if(!retry->IsRunning) retry->Start();
+				else if(retry->ElapsedMilliseconds >= BACKUP_BUSY_TIMEOUT_MS) break;
+			}
+
+			else if((nResult != SQLITE_OK) && (nResult != SQLITE_DONE)) break;
+			else retry->Reset();
+
+			// Fire the progress event, which gives the handler a chance to cancel
+			// the backup operation before the next step (or retry) is performed
+
+			args = gcnew SqliteBackupProgressEventArgs(sqlite3_backup_pagecount(pBackup), sqlite3_backup_remaining(pBackup));
+			BackupProgress(this, args);
+			if(args->Cancel && (nResult != SQLITE_DONE)) { sqlite3_backup_finish(pBackup); return false; }
+
+			if(busy) Thread::Sleep((pause > TimeSpan::Zero) ? pause : TimeSpan::FromMilliseconds(BACKUP_BUSY_RETRY_MS));
+			else if((nResult == SQLITE_OK) && (pause > TimeSpan::Zero)) Thread::Sleep(pause);
+
+		} while(nResult != SQLITE_DONE);
+	}
+
+	catch(Exception^) { sqlite3_backup_finish(pBackup); throw; }
+
+	// sqlite3_backup_finish doesn't report SQLITE_BUSY or SQLITE_LOCKED from
+	// the last step, so if that's why the loop stopped throw it explicitly
+
+	if(busy) {
+
+		sqlite3_backup_finish(pBackup);
+		throw gcnew SqliteException(nResult, "Performing online backup step");
+	}
+
+	// sqlite3_backup_finish returns the error code from the last failed step,
+	// if any, and sets that error on the destination database handle as well
+
+	nResult = sqlite3_backup_finish(pBackup);
+	if(nResult != SQLITE_OK) throw gcnew SqliteException(hDestination, nResult);
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+// SqliteConnection::BeginBackgroundVacuum
+//
+// Starts a timer that periodically schedules a slice of free pages in the main
+// database to be reclaimed.  The slices themselves are only executed when the
+// owning thread calls PerformBackgroundVacuum, never on the timer thread
+//
+// Arguments:
+//
+//	interval		- Interval between background vacuum slices
+//	pagesPerSlice	- Maximum number of pages to reclaim in each slice
+
+void SqliteConnection::BeginBackgroundVacuum(TimeSpan interval, int pagesPerSlice)
+{
+	CHECK_DISPOSED(m_disposed);
+	SqliteUtil::CheckConnectionOpen(this);
+
+	if(interval <= TimeSpan::Zero) throw gcnew ArgumentOutOfRangeException("interval");
+	if(pagesPerSlice <= 0) throw gcnew ArgumentOutOfRangeException("pagesPerSlice");
+	if(m_autoVacuum != SqliteAutoVacuumMode::Incremental) throw gcnew InvalidOperationException();
+
+	EndBackgroundVacuum();				// Stop any existing background vacuum
+
+	m_vacuumPages = pagesPerSlice;
+	m_vacuumTimer = gcnew Timer(gcnew TimerCallback(this, &SqliteConnection::BackgroundVacuumCallback),
+		nullptr, interval, interval);
+}
+
 //---------------------------------------------------------------------------
 // SqliteConnection::BeginDbTransaction (protected)
 //
@@ -190,6 +348,7 @@ DbTransaction^ SqliteConnection::BeginDbTransaction(Data::IsolationLevel isolati
 SqliteTransaction^ SqliteConnection::BeginTransaction(SqliteLockMode mode)
 {
 	SqliteTransaction^				trans;			// The new transaction object
+	String^							savepoint;		// Nested savepoint name
 
 	CHECK_DISPOSED(m_disposed);
 	ExecutePermission->Demand();
@@ -198,10 +357,7 @@ SqliteTransaction^ SqliteConnection::BeginTransaction(SqliteLockMode mode)
 	if((m_openTrans->Count > 0) && (m_transactionMode == SqliteTransactionMode::Single))
 		throw gcnew Exception("TODO:nested transaction exception");
 
-	if((m_openTrans->Count > 0) && (mode != m_openTransMode))
-		throw gcnew Exception("TODO:different transaction lock mode exception");
-
-	if(Interlocked::Increment(m_openTransCount) == 1) {
+	if(m_openTrans->Count == 0) {
 
 		switch(mode) {
 
@@ -215,11 +371,19 @@ SqliteTransaction^ SqliteConnection::BeginTransaction(SqliteLockMode mode)
 
 			default: SqliteUtil::ExecuteNonQuery(m_pDatabase->Handle, "BEGIN DEFERRED TRANSACTION");
 		}
+	}
+
+	else {
+
+		// Nested transactions are implemented as SAVEPOINTs inside of the outermost
+		// transaction.  The locking mode only applies to the outermost BEGIN, since
+		// the nested transactions simply run under whatever lock it has acquired
 
-		m_openTransMode = mode;
+		savepoint = String::Format("{0}{1}", SAVEPOINT_PREFIX, m_openTrans->Count);
+		SqliteUtil::ExecuteNonQuery(m_pDatabase->Handle, String::Format("SAVEPOINT [{0}]", savepoint));
 	}
 
-	trans = gcnew SqliteTransaction(this);
+	trans = gcnew SqliteTransaction(this, savepoint);
 	m_openTrans->Add(trans);
 	return trans;
 }
@@ -254,6 +418,36 @@ void SqliteConnection::BooleanFormat::set(SqliteBooleanFormat value)
 	if(value != m_cs->BooleanFormat) m_cs->BooleanFormat = value;
 }
 
+//---------------------------------------------------------------------------
+// SqliteConnection::CacheBuilderSchema (internal)
+//
+// Caches a copy of the schema table generated for a SqliteCommandBuilder.  The
+// cache is tied to the schema cookie, so any DDL executed against the database
+// (from this connection or any other) automatically invalidates it
+//
+// Arguments:
+//
+//	commandText		- SELECT command text the schema was generated from
+//	schema			- Schema table to be cached
+
+void SqliteConnection::CacheBuilderSchema(String^ commandText, DataTable^ schema)
+{
+	CHECK_DISPOSED(m_disposed);
+	SqliteUtil::CheckConnectionReady(this);
+
+	if((commandText == nullptr) || (schema == nullptr)) return;
+
+	Monitor::Enter(m_builderSchemas);
+
+	try {
+
+		CheckBuilderCookie();
+		m_builderSchemas[commandText] = schema->Copy();
+	}
+
+	finally { Monitor::Exit(m_builderSchemas); }
+}
+
 //---------------------------------------------------------------------------
 // SqliteConnection::CacheSize::get
 //
@@ -325,6 +519,26 @@ void SqliteConnection::CaseSensitiveLike::set(bool value)
 	if(value != m_cs->CaseSensitiveLike) m_cs->CaseSensitiveLike = value;
 }
 
+//---------------------------------------------------------------------------
+// SqliteConnection::CheckBuilderCookie (private)
+//
+// Compares the current schema cookie of every attached database against the
+// one the command builder schema cache was loaded under, and flushes the cache
+// if they differ.  The caller must hold the lock on m_builderSchemas
+//
+// Arguments:
+//
+//	NONE
+
+void SqliteConnection::CheckBuilderCookie(void)
+{
+	String^ cookie = SqliteUtil::GetSchemaCookie(m_pDatabase->Handle);
+	if(String::Equals(cookie, m_builderCookie)) return;
+
+	m_builderSchemas->Clear();
+	m_builderCookie = cookie;
+}
+
 //---------------------------------------------------------------------------
 // SqliteConnection::CheckIntegrity
 //
@@ -359,11 +573,14 @@ void SqliteConnection::Close(bool fireStateChange)
 	CHECK_DISPOSED(m_disposed);
 	if(m_state == ConnectionState::Closed) return;
 
+	EndBackgroundVacuum();			// Stop any background vacuum operation
 	Interrupt();					// Attempt to interrupt anything going on
 
-	// Rollback any and all outstanding transaction objects against this connection
+	// Rollback any and all outstanding transaction objects against this connection.
+	// Rolling back the outermost transaction closes out any nested ones as well
 
-	for each(SqliteTransaction^ trans in m_openTrans) trans->Rollback();
+	if(m_openTrans->Count > 0) m_openTrans[0]->Rollback();
+	Debug::Assert(m_openTrans->Count == 0);
 
 	// Automatically dispose of any active data readers that remain
 	// open against this connection.  Since the data readers will remove
@@ -392,6 +609,11 @@ void SqliteConnection::Close(bool fireStateChange)
 	m_traceHook->OnCloseConnection();
 	m_updateHook->OnCloseConnection();
 
+	// Remove the sqlite3_trace_v2 callback completely, which also records the
+	// close into the trace buffer if that's being watched for
+
+	m_pTrace->Remove(m_pDatabase->Handle);
+
 	// Invoke all of the OnCloseConnection() handlers for the user-defined
 	// function collections before we shut down SQLite here
 
@@ -402,6 +624,7 @@ void SqliteConnection::Close(bool fireStateChange)
 	// Remove ourselves from the handle mapper before the handle is destroyed
 
 	s_handleMapper->Remove(reinterpret_cast<intptr_t>(m_pDatabase->Handle));
+	SqliteEventSource::ConnectionClosed(m_pDatabase);
 
 	// Remove the field encryption password from the connection when it's closed
 
@@ -426,6 +649,15 @@ void SqliteConnection::Close(bool fireStateChange)
 	for each(GCHandle gchandle in m_modules) gchandle.Free();
 	m_modules->Clear();
 
+	// The next Open() could be against a completely different database, so
+	// the command builder schema cache has to go regardless of the cookie
+
+	Monitor::Enter(m_builderSchemas);
+	try { m_builderSchemas->Clear(); m_builderCookie = nullptr; }
+	finally { Monitor::Exit(m_builderSchemas); }
+
+	m_columnMetaData->Clear();
+
 	m_state = ConnectionState::Closed;		// The connection is now closed
 	
 	if(fireStateChange) 
@@ -443,6 +675,17 @@ SqliteCollationCollection^ SqliteConnection::Collations::get(void)
 	return m_collations;
 }
 
+//---------------------------------------------------------------------------
+// SqliteConnection::ColumnMetaData::get (internal)
+//
+// Exposes the connection-wide cache of table column metadata
+
+SqliteColumnMetaDataCache^ SqliteConnection::ColumnMetaData::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_columnMetaData;
+}
+
 //---------------------------------------------------------------------------
 // SqliteConnection::CommitTransaction (internal)
 //
@@ -464,18 +707,22 @@ void SqliteConnection::CommitTransaction(SqliteTransaction^ trans)
 
 	index = m_openTrans->IndexOf(trans);
 	if(index == -1) throw gcnew ArgumentException();
-	m_openTrans->RemoveAt(index);
 
-	// Even if the SqliteTransaction exists, we can be at a transaction count
-	// of zero if a nested ROLLBACK has occurred on this connection
+	// Only the innermost transaction can be committed.  Allowing an outer one
+	// to commit would silently commit any work done by the nested transactions
+	// that haven't been completed yet, which is almost certainly not desired
+
+	if(index != (m_openTrans->Count - 1)) throw gcnew InvalidOperationException();
 
-	if(m_openTransCount == 0) throw gcnew InvalidOperationException();
+	// The outermost transaction issues the COMMIT, a nested transaction merely
+	// releases it's SAVEPOINT so the changes become part of the parent.  The
+	// transaction object isn't removed until the operation has succeeded, which
+	// leaves it available to be rolled back if the COMMIT fails (SQLITE_BUSY)
 
-	// Decrement the outstanding transaction counter, and if it has fallen
-	// to zero from this commit, go ahead and try to commit the transaction
+	if(index == 0) SqliteUtil::ExecuteNonQuery(m_pDatabase->Handle, "COMMIT TRANSACTION");
+	else SqliteUtil::ExecuteNonQuery(m_pDatabase->Handle, String::Format("RELEASE SAVEPOINT [{0}]", trans->Savepoint));
 
-	if(Interlocked::Decrement(m_openTransCount) == 0)
-		SqliteUtil::ExecuteNonQuery(m_pDatabase->Handle, "COMMIT TRANSACTION");
+	m_openTrans->RemoveAt(index);
 }
 
 //---------------------------------------------------------------------------
@@ -534,18 +781,23 @@ void SqliteConnection::Construct(String^ connectionString)
 	m_cs = gcnew SqliteConnectionStringBuilder(connectionString);
 	m_openTrans = gcnew List<SqliteTransaction^>();
 	m_fieldKey = gcnew SqliteCryptoKey(gcnew SecureString());
+	m_pTrace = new TraceDispatcher();
+	m_traceLock = gcnew Object();
 
 	m_authHook = gcnew SqliteConnectionAuthorizationHook(this);
 	m_collationHook = gcnew SqliteConnectionCollationNeededHook(this);
 	m_commitHook = gcnew SqliteConnectionCommitHook(this);
-	m_profileHook = gcnew SqliteConnectionProfileHook(this);
+	m_profileHook = gcnew SqliteConnectionProfileHook(this, m_pTrace);
 	m_progressHook = gcnew SqliteConnectionProgressHook(this);
 	m_rollbackHook = gcnew SqliteConnectionRollbackHook(this);
-	m_traceHook = gcnew SqliteConnectionTraceHook(this);
+	m_traceHook = gcnew SqliteConnectionTraceHook(this, m_pTrace);
 	m_updateHook = gcnew SqliteConnectionUpdateHook(this);
 
 	m_readers = gcnew Dictionary<__int64, SqliteDataReader^>();
 	m_modules = gcnew List<GCHandle>();
+	m_samples = gcnew Dictionary<String^, SqliteStatementStatistics>();
+	m_builderSchemas = gcnew Dictionary<String^, DataTable^>();
+	m_columnMetaData = gcnew SqliteColumnMetaDataCache();
 
 	m_aggregates = gcnew SqliteAggregateCollection();
 	m_collations = gcnew SqliteCollationCollection();
@@ -691,6 +943,24 @@ SqliteTextEncodingMode SqliteConnection::Encoding::get(void)
 	return m_encoding;				// Return the configured value
 }
 
+//---------------------------------------------------------------------------
+// SqliteConnection::EndBackgroundVacuum
+//
+// Stops the background incremental vacuum and discards any pending slice
+//
+// Arguments:
+//
+//	NONE
+
+void SqliteConnection::EndBackgroundVacuum(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(m_vacuumTimer != nullptr) delete m_vacuumTimer;
+	m_vacuumTimer = nullptr;
+	m_vacuumDue = false;
+}
+
 //---------------------------------------------------------------------------
 // SqliteConnection::FieldEncryptionKey::get (internal)
 //
@@ -739,6 +1009,19 @@ SqliteConnection^ SqliteConnection::FindConnection(sqlite3* hDatabase)
 	else return nullptr;
 }
 
+//---------------------------------------------------------------------------
+// SqliteConnection::FreePageCount::get
+//
+// Retrieves the number of unused pages in the main database file
+
+int SqliteConnection::FreePageCount::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	SqliteUtil::CheckConnectionReady(this);		// <-- READY, not OPEN
+
+	return Convert::ToInt32(SqliteUtil::ExecuteScalar(m_pDatabase->Handle, "PRAGMA FREELIST_COUNT"));
+}
+
 //---------------------------------------------------------------------------
 // SqliteConnection::Functions::get
 //
@@ -750,6 +1033,35 @@ SqliteFunctionCollection^ SqliteConnection::Functions::get(void)
 	return m_functions;
 }
 
+//---------------------------------------------------------------------------
+// SqliteConnection::GetBuilderSchema (internal)
+//
+// Retrieves a copy of a cached SqliteCommandBuilder schema table
+//
+// Arguments:
+//
+//	commandText		- SELECT command text the schema was generated from
+
+DataTable^ SqliteConnection::GetBuilderSchema(String^ commandText)
+{
+	DataTable^					schema;			// Cached schema table
+
+	CHECK_DISPOSED(m_disposed);
+	SqliteUtil::CheckConnectionReady(this);
+
+	if(commandText == nullptr) return nullptr;
+
+	Monitor::Enter(m_builderSchemas);
+
+	try {
+
+		CheckBuilderCookie();
+		return (m_builderSchemas->TryGetValue(commandText, schema)) ? schema->Copy() : nullptr;
+	}
+
+	finally { Monitor::Exit(m_builderSchemas); }
+}
+
 //---------------------------------------------------------------------------
 // SqliteConnection::GetHandle (internal)
 //
@@ -769,6 +1081,28 @@ void SqliteConnection::GetHandle(DatabaseHandle **ppDatabaseHandle)
 	m_pDatabase->AddRef(this);				// AddRef() before returning
 }
 
+//---------------------------------------------------------------------------
+// SqliteConnection::GetStatementStatistics
+//
+// Gets a copy of the statement counters that have been sampled for each
+// command text executed on this connection
+//
+// Arguments:
+//
+//	NONE
+
+Dictionary<String^, SqliteStatementStatistics>^ SqliteConnection::GetStatementStatistics(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	// The samples can be requested from a monitoring thread while commands
+	// are still executing, so always hand back a copy of the collection
+
+	Monitor::Enter(m_samples);
+	try { return gcnew Dictionary<String^, SqliteStatementStatistics>(m_samples); }
+	finally { Monitor::Exit(m_samples); }
+}
+
 //---------------------------------------------------------------------------
 // SqliteConnection::GetSchema
 //
@@ -868,6 +1202,34 @@ void SqliteConnection::Interrupt(void)
 	sqlite3_interrupt(m_pDatabase->Handle);		// Abort pending operations
 }
 
+//---------------------------------------------------------------------------
+// SqliteConnection::IncrementalVacuum
+//
+// Reclaims free pages from the main database without rewriting the entire
+// file like VACUUM does.  Requires SqliteAutoVacuumMode::Incremental
+//
+// Arguments:
+//
+//	pages		- Maximum number of pages to reclaim, or zero for all of them
+
+int SqliteConnection::IncrementalVacuum(int pages)
+{
+	int						before;			// Free pages before the vacuum
+
+	CHECK_DISPOSED(m_disposed);
+	SqliteUtil::CheckConnectionReady(this);		// <-- READY, not OPEN
+
+	if(pages < 0) throw gcnew ArgumentOutOfRangeException();
+	if(m_autoVacuum != SqliteAutoVacuumMode::Incremental) throw gcnew InvalidOperationException();
+
+	before = FreePageCount;
+
+	// PRAGMA INCREMENTAL_VACUUM(N) -- zero or negative means all free pages
+	SqliteUtil::ExecuteNonQuery(m_pDatabase->Handle, String::Format("PRAGMA INCREMENTAL_VACUUM({0})", pages));
+
+	return before - FreePageCount;
+}
+
 //---------------------------------------------------------------------------
 // SqliteConnection::InTransaction::get (internal)
 //
@@ -903,9 +1265,9 @@ void SqliteConnection::LoadConfiguredPragmas(void)
 	Debug::Assert(m_state == ConnectionState::Open);
 
 	// PRAGMA AUTO_VACUUM
-	m_autoVacuum = false;
+	m_autoVacuum = SqliteAutoVacuumMode::None;
 	result = SqliteUtil::ExecuteScalar(m_pDatabase->Handle, "PRAGMA AUTO_VACUUM");
-	if(!String::IsNullOrEmpty(result)) m_autoVacuum = (Convert::ToInt32(result) == 1);
+	if(!String::IsNullOrEmpty(result)) m_autoVacuum = static_cast<SqliteAutoVacuumMode>(Convert::ToInt32(result));
 
 	// PRAGMA LEGACY_FILE_FORMAT
 	//
@@ -939,6 +1301,7 @@ void SqliteConnection::LoadConfiguredPragmas(void)
 void SqliteConnection::Open(void)
 {
 	sqlite3*				hDatabase = NULL;		// The new database handle
+	int						nFlags;					// sqlite3_open_v2 flags
 	int						nResult;				// Result from function call
 
 	CHECK_DISPOSED(m_disposed);
@@ -962,11 +1325,20 @@ void SqliteConnection::Open(void)
 	openPerm->Add(m_cs->ToString(), String::Empty, KeyRestrictionBehavior::AllowOnly);
 	openPerm->Demand();
 
+	// Generate the flags for sqlite3_open_v2 from the connection string.  URI
+	// filenames are always enabled so that the data source can specify things
+	// like "file:name?mode=memory" to share an in-memory database
+
+	nFlags = SQLITE_OPEN_URI;
+	nFlags |= (m_cs->ReadOnly) ? SQLITE_OPEN_READONLY : (SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+	nFlags |= (m_cs->SharedCache) ? SQLITE_OPEN_SHAREDCACHE : SQLITE_OPEN_PRIVATECACHE;
+	if(m_cs->NoMutex) nFlags |= SQLITE_OPEN_NOMUTEX;
+
 	// Attempt to open the main SQLite database handle.  Note that we have to
 	// use the ANSI version at all times, according to the SQLite documentation.
 	// We also have to be sure to call sqlite3_close in the event of an error
 
-	nResult = sqlite3_open(AutoAnsiString(m_cs->DataSource), &hDatabase);
+	nResult = sqlite3_open_v2(AutoAnsiString(m_cs->DataSource), &hDatabase, nFlags, NULL);
 	if(nResult != SQLITE_OK) { sqlite3_close(hDatabase); throw gcnew SqliteException(nResult); }
 
 	// I can't seem to find a place in SQLite that actually uses the extended error
@@ -989,6 +1361,7 @@ void SqliteConnection::Open(void)
 	// before doing anything else so that things like Virtual Tables can find us
 
 	s_handleMapper->Add(reinterpret_cast<intptr_t>(hDatabase), this);
+	SqliteEventSource::ConnectionOpened(m_pDatabase);
 
 	// Apply all of the connection string options IMMEDIATELY so that the special
 	// ones can be set for a new database.  Afterwards, load the non-modifiable
@@ -1028,6 +1401,11 @@ void SqliteConnection::Open(void)
 	m_traceHook->OnOpenConnection(m_pDatabase);
 	m_updateHook->OnOpenConnection(m_pDatabase);
 
+	// The trace buffer isn't a hook, but it shares the sqlite3_trace_v2
+	// registration with them; install it if anything is being recorded
+
+	if(m_pTrace->RingMask != 0) m_pTrace->Install(m_pDatabase->Handle);
+
 	// STATECHANGE: CLOSED->OPEN
 	OnStateChange(gcnew StateChangeEventArgs(ConnectionState::Closed, ConnectionState::Open));
 }
@@ -1045,6 +1423,50 @@ int SqliteConnection::PageSize::get(void)
 	return m_pageSize;				// Return the configured value
 }
 
+//---------------------------------------------------------------------------
+// SqliteConnection::PerformBackgroundVacuum
+//
+// Runs the background vacuum slice scheduled by the timer, if there is one.
+// Only reclaims pages when the connection is idle, and silently skips the
+// slice if the engine refuses to do it (an outstanding statement can cause
+// SQLITE_LOCKED).  Returns true if a slice was actually executed
+//
+// Arguments:
+//
+//	NONE
+
+bool SqliteConnection::PerformBackgroundVacuum(void)
+{
+	int						before;			// Free pages before the slice
+	int						after;			// Free pages after the slice
+
+	CHECK_DISPOSED(m_disposed);
+	SqliteUtil::CheckConnectionOpen(this);
+
+	if((m_vacuumTimer == nullptr) || (!m_vacuumDue)) return false;
+
+	// The connection is considered idle if it's not in a transaction and there
+	// are no data readers outstanding.  A slice that can't run now stays due
+
+	if(InTransaction || (m_openTrans->Count > 0) || (m_readers->Count > 0)) return false;
+
+	m_vacuumDue = false;				// Slice is no longer pending
+
+	try {
+
+		before = Convert::ToInt32(SqliteUtil::ExecuteScalar(m_pDatabase->Handle, "PRAGMA FREELIST_COUNT"));
+		if(before == 0) return false;
+
+		SqliteUtil::ExecuteNonQuery(m_pDatabase->Handle, String::Format("PRAGMA INCREMENTAL_VACUUM({0})", m_vacuumPages));
+		after = Convert::ToInt32(SqliteUtil::ExecuteScalar(m_pDatabase->Handle, "PRAGMA FREELIST_COUNT"));
+	}
+
+	catch(SqliteException^) { return false; }
+
+	BackgroundVacuum(this, gcnew SqliteIncrementalVacuumEventArgs(before, after));
+	return true;
+}
+
 //---------------------------------------------------------------------------
 // SqliteConnection::RegisterDataReader (internal)
 //
@@ -1068,6 +1490,111 @@ __int64 SqliteConnection::RegisterDataReader(SqliteDataReader^ reader)
 	return cookie;						// Return registration cookie
 }
 
+//---------------------------------------------------------------------------
+// SqliteConnection::ReadTraceEntries
+//
+// Drains the trace buffer.  The statement text was captured when each entry
+// was recorded, so nothing here needs to touch the database connection
+//
+// Arguments:
+//
+//	NONE
+
+array<SqliteTraceEntry>^ SqliteConnection::ReadTraceEntries(void)
+{
+	TraceRing::Entry		buffer[64];			// Entries read from the ring
+	int						count;				// Number of entries read
+	List<SqliteTraceEntry>^	entries;			// Entries to be returned
+
+	CHECK_DISPOSED(m_disposed);
+
+	TraceRing* pRing = m_pTrace->Ring;
+	if(pRing == NULL) return gcnew array<SqliteTraceEntry>(0);
+
+	entries = gcnew List<SqliteTraceEntry>();
+
+	Monitor::Enter(m_traceLock);
+
+	try {
+
+		while((count = pRing->Read(buffer, 64)) > 0) {
+
+			for(int index = 0; index < count; index++) {
+
+				String^ sql = nullptr;
+				if(buffer[index].Length > 0) sql = Text::Encoding::UTF8->GetString(reinterpret_cast<unsigned char*>(buffer[index].Text), 
+					buffer[index].Length);
+
+				entries->Add(SqliteTraceEntry(buffer[index], sql));
+			}
+		}
+	}
+
+	finally { Monitor::Exit(m_traceLock); }
+
+	return entries->ToArray();
+}
+
+//---------------------------------------------------------------------------
+// SqliteConnection::RegisterCollectionTable
+//
+// Registers a SqliteCollectionTable instance with the SQLite engine as an
+// eponymous read-only virtual table.  The module name is the table name
+//
+// Arguments:
+//
+//	table			- SqliteCollectionTable instance
+//	name			- Name of the table
+
+generic<typename T>
+void SqliteConnection::RegisterCollectionTable(SqliteCollectionTable<T>^ table, String^ name)
+{
+	GCHandle				gchandle;			// Table GCHandle (strong)
+	int						nResult;			// Result from function call
+
+	CHECK_DISPOSED(m_disposed);
+	SqliteUtil::CheckConnectionOpen(this);
+
+	if((table == nullptr) || (name == nullptr)) throw gcnew ArgumentNullException();
+
+	// Unlike other virtual tables the module context is the table instance
+	// itself rather than a type, there is nothing to construct on connect
+
+	gchandle = GCHandle::Alloc(table);
+
+	nResult = sqlite3_create_module(m_pDatabase->Handle, AutoAnsiString(name),
+		SqliteVirtualTableModule::GetMethods(table->GetType()), GCHandle::ToIntPtr(gchandle).ToPointer());
+	if(nResult != SQLITE_OK) {
+
+		gchandle.Free();
+		throw gcnew SqliteException(m_pDatabase->Handle, nResult);
+	}
+
+	m_modules->Add(gchandle);				// <--- TRACK THE GCHANDLE INSTANCE
+}
+
+//---------------------------------------------------------------------------
+// SqliteConnection::RegisterTableValuedFunction
+//
+// Registers a SqliteTableValuedFunction derived type with the SQLite engine
+// as an eponymous virtual table.  The module name is the function name
+//
+// Arguments:
+//
+//	functionType	- System::Type of the table-valued function
+//	name			- Name of the function
+
+void SqliteConnection::RegisterTableValuedFunction(Type^ functionType, String^ name)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if((functionType == nullptr) || (name == nullptr)) throw gcnew ArgumentNullException();
+	if(!functionType->IsSubclassOf(SqliteTableValuedFunction::typeid))
+		throw gcnew SqliteExceptions::InvalidVirtualTableException(functionType);
+
+	RegisterVirtualTable(functionType, name);
+}
+
 //---------------------------------------------------------------------------
 // SqliteConnection::RegisterVirtualTable
 //
@@ -1115,23 +1642,21 @@ void SqliteConnection::RegisterVirtualTable(Type^ vtableType, String^ moduleName
 }
 
 //---------------------------------------------------------------------------
-// SqliteConnection::RollbackInProgress::get (internal)
+// SqliteConnection::ResetStatementStatistics
 //
-// Plugs a hole in my little pseudo-nested transaction plan.  Determines if
-// a portion of a nested transaction has been rolled back, but there are
-// still outstanding transaction objects that have not been closed yet
+// Discards all of the statement counters sampled by command text
 //
 // Arguments:
 //
 //	NONE
 
-bool SqliteConnection::RollbackInProgress::get(void)
+void SqliteConnection::ResetStatementStatistics(void)
 {
-	// If the current transaction reference count is zero, yet there are 
-	// still open transaction objects, a rollback is currently in progress
-	// and we shouldn't be doing ANYTHING that might change the state
+	CHECK_DISPOSED(m_disposed);
 
-	return ((m_openTransCount == 0) && (m_openTrans->Count > 0));
+	Monitor::Enter(m_samples);
+	try { m_samples->Clear(); m_sampleCount = 0; }
+	finally { Monitor::Exit(m_samples); }
 }
 
 //---------------------------------------------------------------------------
@@ -1141,7 +1666,7 @@ bool SqliteConnection::RollbackInProgress::get(void)
 //
 // Arguments:
 //
-//	trans		- SqliteTransaction to be committed
+//	trans		- SqliteTransaction to be rolled back
 
 void SqliteConnection::RollbackTransaction(SqliteTransaction^ trans)
 {
@@ -1151,23 +1676,70 @@ void SqliteConnection::RollbackTransaction(SqliteTransaction^ trans)
 	if(trans == nullptr) throw gcnew ArgumentNullException();
 
 	// Look for the SqliteTransaction object in our local cache, and if it's
-	// not in there, it wasn't created by us so we can't go committing anything
+	// not in there, it wasn't created by us so we can't go rolling anything back
 
 	index = m_openTrans->IndexOf(trans);
 	if(index == -1) throw gcnew ArgumentException();
-	m_openTrans->RemoveAt(index);
 
-	// Rollback operations are rather different than commit operations, since
-	// we support pseudo-nested transactions in this provider.  We always force
-	// the transaction count to zero, and if there were ANY outstanding transactions
-	// on this connection, we issue the ROLLBACK immediately.
-	//
-	// NOTE: Because of this methodology, it's important to check the RollbackInProgress
-	// property of this connection before executing commands.  It's been mostly taken
-	// care of by exposing the new CheckConnectionReady() helper function.  USE IT.
+	// Certain errors (SQLITE_FULL, SQLITE_IOERR, etc) cause the engine to roll
+	// back the entire transaction on it's own.  If that has happened there is
+	// nothing left to roll back, but every outstanding transaction object is now
+	// dead, including the outer ones, so close them all out
 
-	if(Interlocked::Exchange(m_openTransCount, 0) != 0) 
-		SqliteUtil::ExecuteNonQuery(m_pDatabase->Handle, "ROLLBACK TRANSACTION");
+	if(!InTransaction) {
+
+		for each(SqliteTransaction^ open in m_openTrans) if(open != trans) open->OnClosed();
+		m_openTrans->Clear();
+		return;
+	}
+
+	// The outermost transaction issues the ROLLBACK, a nested transaction rolls
+	// back to it's SAVEPOINT and then releases it, leaving the parent transaction
+	// and all of it's work prior to the SAVEPOINT intact.  As with commit, the
+	// bookkeeping isn't changed unless the operation succeeded
+
+	if(index == 0) SqliteUtil::ExecuteNonQuery(m_pDatabase->Handle, "ROLLBACK TRANSACTION");
+	else SqliteUtil::ExecuteNonQuery(m_pDatabase->Handle, String::Format("ROLLBACK TRANSACTION TO SAVEPOINT [{0}]; "
+		"RELEASE SAVEPOINT [{0}]", trans->Savepoint));
+
+	// Rolling back a transaction also rolls back everything that was nested
+	// inside of it, so any transaction objects above this one in the stack are
+	// closed out along with it.  Unlike commit, this is always the right thing
+	// to do since none of their changes can survive the rollback anyway
+
+	for(int nested = m_openTrans->Count - 1; nested > index; nested--) m_openTrans[nested]->OnClosed();
+	m_openTrans->RemoveRange(index, m_openTrans->Count - index);
+}
+
+//---------------------------------------------------------------------------
+// SqliteConnection::SampleStatistics (internal)
+//
+// Records the statement counters for a command execution into the samples
+// kept by command text, if sampling is enabled and this execution is sampled
+//
+// Arguments:
+//
+//	commandText		- Command text that was executed
+//	statistics		- Statement counters for the execution
+
+void SqliteConnection::SampleStatistics(String^ commandText, SqliteStatementStatistics statistics)
+{
+	SqliteStatementStatistics		existing;			// Existing sample
+
+	if((m_sampleRate == 0) || (commandText == nullptr)) return;
+
+	Monitor::Enter(m_samples);
+
+	try {
+
+		if(++m_sampleCount < m_sampleRate) return;
+		m_sampleCount = 0;
+
+		if(m_samples->TryGetValue(commandText, existing)) statistics = existing + statistics;
+		m_samples[commandText] = statistics;
+	}
+
+	finally { Monitor::Exit(m_samples); }
 }
 
 //---------------------------------------------------------------------------
@@ -1216,6 +1788,32 @@ void SqliteConnection::StatementProgressFrequency::set(int value)
 	m_progressHook->Frequency = value;
 }
 
+//---------------------------------------------------------------------------
+// SqliteConnection::StatisticsSampleRate::get
+//
+// Gets the number of command executions per statement counter sample
+
+int SqliteConnection::StatisticsSampleRate::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_sampleRate;
+}
+
+//---------------------------------------------------------------------------
+// SqliteConnection::StatisticsSampleRate::set
+//
+// Sets the number of command executions per statement counter sample, or
+// zero to disable sampling altogether
+
+void SqliteConnection::StatisticsSampleRate::set(int value)
+{
+	CHECK_DISPOSED(m_disposed);
+	if(value < 0) throw gcnew ArgumentOutOfRangeException("value");
+
+	m_sampleRate = value;
+	m_sampleCount = 0;
+}
+
 //---------------------------------------------------------------------------
 // SqliteConnection::SynchronousMode::get
 //
@@ -1332,6 +1930,50 @@ void SqliteConnection::TemporaryStorageMode::set(SqliteTemporaryStorageMode valu
 	if(value != m_cs->TemporaryStorageMode) m_cs->TemporaryStorageMode = value;
 }
 
+//---------------------------------------------------------------------------
+// SqliteConnection::TraceEntriesDropped::get
+//
+// Gets the number of trace buffer entries that were overwritten unread
+
+__int64 SqliteConnection::TraceEntriesDropped::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	TraceRing* pRing = m_pTrace->Ring;
+	if(pRing == NULL) return 0;
+
+	Monitor::Enter(m_traceLock);
+	try { return pRing->Dropped; }
+	finally { Monitor::Exit(m_traceLock); }
+}
+
+//---------------------------------------------------------------------------
+// SqliteConnection::TraceMask::get
+//
+// Gets the events that are being recorded into the trace buffer
+
+SqliteTraceEventMask SqliteConnection::TraceMask::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return static_cast<SqliteTraceEventMask>(m_pTrace->RingMask);
+}
+
+//---------------------------------------------------------------------------
+// SqliteConnection::TraceMask::set
+//
+// Changes the events that are being recorded into the trace buffer.  Can be
+// set whether or not the connection is open
+
+void SqliteConnection::TraceMask::set(SqliteTraceEventMask value)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	unsigned int mask = static_cast<unsigned int>(value) & 
+		(SQLITE_TRACE_STMT | SQLITE_TRACE_PROFILE | SQLITE_TRACE_ROW | SQLITE_TRACE_CLOSE);
+
+	m_pTrace->SetRingMask((m_pDatabase) ? m_pDatabase->Handle : NULL, mask);
+}
+
 //---------------------------------------------------------------------------
 // SqliteConnection::TransactionMode::get
 //
@@ -1367,8 +2009,8 @@ void SqliteConnection::UnRegisterDataReader(__int64 cookie)
 // SqliteConnection::Vacuum
 //
 // Cleans the main database (but not any attached ones) by copying the entire
-// thing into a temporary file and then reloading it.  This has no effect
-// on databases set up with the PRAGMA AUTO_VACUUM option
+// thing into a temporary file and then reloading it.  See IncrementalVacuum
+// for a less disruptive alternative on SqliteAutoVacuumMode::Incremental databases
 //
 // Arguments:
 //
@@ -28,6 +28,7 @@
 #include "DatabaseHandle.h"				// Include DatabaseHandle declarations
 #include "SqliteAggregateCollection.h"		// Include SqliteAggregateCollection decls
 #include "SqliteCollationCollection.h"		// Include SqliteCollationCollection decls
+#include "SqliteColumnMetaDataCache.h"		// Include SqliteColumnMetaDataCache decls
 #include "SqliteConnectionHooks.h"			// Include Sqlite connection hook decls
 #include "SqliteConnectionStringBuilder.h"	// Include SqliteConnectionStringBuilder
 #include "SqliteCryptoKey.h"				// Include SqliteCryptoKey declarations
@@ -36,6 +37,8 @@
 #include "SqliteExceptions.h"				// Include Sqlite exception declarations
 #include "SqliteFunctionCollection.h"		// Include SqliteFunctionCollection decls
 #include "SqlitePermission.h"				// Include SqlitePermission declarations
+#include "SqliteStatementStatistics.h"		// Include SqliteStatementStatistics decls
+#include "SqliteTraceEntry.h"				// Include SqliteTraceEntry declarations
 #include "SqliteUtil.h"					// Include SqliteUtil class declarations
 #include "SqliteVirtualTableModule.h"		// Include SqliteVirtualTableModule decls
 
@@ -93,6 +96,17 @@ public:
 		void remove(SqliteAuthorizeEventHandler^ handler) { m_authHook->Remove(handler); }
 	}
 
+	// BackgroundVacuum
+	//
+	// Fired from PerformBackgroundVacuum after the background incremental
+	// vacuum started with BeginBackgroundVacuum has reclaimed a slice of pages
+	event SqliteIncrementalVacuumEventHandler^ BackgroundVacuum;
+
+	// BackupProgress
+	//
+	// Fired after each step (or busy retry) of an online backup started with BackupTo
+	event SqliteBackupProgressEventHandler^ BackupProgress;
+
 	// CollationNeeded
 	//
 	// Fired whenever an unknown collation sequence has been encountered to give
@@ -166,10 +180,26 @@ public:
 	// Attaches another SQLite database as a new catalog in this connection
 	void Attach(String^ path, String^ databaseName);
 
+	// BackupTo
+	//
+	// Copies a database from this connection into the main database of another
+	// connection using the online backup API.  Can be used to load a file-based
+	// database into a :memory: connection, or to save one back out to a file
+	bool BackupTo(SqliteConnection^ destination) { return BackupTo(destination, MAIN_CATALOG_NAME, -1, TimeSpan::Zero); }
+	bool BackupTo(SqliteConnection^ destination, String^ databaseName) { return BackupTo(destination, databaseName, -1, TimeSpan::Zero); }
+	bool BackupTo(SqliteConnection^ destination, String^ databaseName, int pagesPerStep, TimeSpan pause);
+
+	// BeginBackgroundVacuum
+	//
+	// Starts periodically scheduling small slices of free pages to be reclaimed
+	// by PerformBackgroundVacuum.  Requires SqliteAutoVacuumMode::Incremental
+	void BeginBackgroundVacuum(TimeSpan interval, int pagesPerSlice);
+
 	// BeginTransaction
 	//
 	// Starts a new database transaction, optionally allowing a non-default
-	// locking mechanism to be specified in the process
+	// locking mechanism to be specified in the process.  Nested transactions
+	// are implemented with SAVEPOINTs and ignore the locking mechanism
 	SqliteTransaction^ BeginTransaction(void) new { return BeginTransaction(SqliteLockMode::Deferred); }
 	SqliteTransaction^ BeginTransaction(SqliteLockMode mode);
 
@@ -203,6 +233,11 @@ public:
 	// Enlists in the specified transaction as a distributed transaction
 	virtual void EnlistTransaction(Transaction^ transaction) override { (transaction); }
 
+	// EndBackgroundVacuum
+	//
+	// Stops the background incremental vacuum started by BeginBackgroundVacuum
+	void EndBackgroundVacuum(void);
+
 	// GetSchema (DbConnection)
 	//
 	// Gets schema information for the data source of this SqliteConnection
@@ -210,16 +245,59 @@ public:
 	virtual DataTable^ GetSchema(String^ collectionName) override { return GetSchema(collectionName, nullptr); }
 	virtual DataTable^ GetSchema(String^ collectionName, array<String^>^ restrictionValues) override;
 
+	// GetStatementStatistics
+	//
+	// Gets a copy of the statement counters that have been sampled for each
+	// command text executed on this connection, see StatisticsSampleRate
+	Dictionary<String^, SqliteStatementStatistics>^ GetStatementStatistics(void);
+
+	// IncrementalVacuum
+	//
+	// Reclaims up to the specified number of free pages from the main database,
+	// or all of them if not specified.  Returns the number of pages reclaimed
+	int IncrementalVacuum(void) { return IncrementalVacuum(0); }
+	int IncrementalVacuum(int pages);
+
 	// Open (DbConnection)
 	//
 	// Opens the database connection using the currently set information
 	virtual void Open(void) override;
 
+	// PerformBackgroundVacuum
+	//
+	// Runs the pending background vacuum slice, if any, on the calling thread.
+	// Call periodically from the thread that owns the connection when it's idle
+	bool PerformBackgroundVacuum(void);
+
+	// ReadTraceEntries
+	//
+	// Removes and returns all of the entries currently held in the trace
+	// buffer, along with the statement text captured for each, see TraceMask
+	array<SqliteTraceEntry>^ ReadTraceEntries(void);
+
+	// RegisterCollectionTable
+	//
+	// Registers a SqliteCollectionTable with this connection as an eponymous
+	// read-only virtual table, which can be used as SELECT * FROM name
+	generic<typename T>
+	void RegisterCollectionTable(SqliteCollectionTable<T>^ table, String^ name);
+
+	// RegisterTableValuedFunction
+	//
+	// Registers a SqliteTableValuedFunction class with this connection as an
+	// eponymous virtual table, which can be used as SELECT * FROM name(...)
+	void RegisterTableValuedFunction(Type^ functionType, String^ name);
+
 	// RegisterVirtualTable
 	//
 	// Registers a Virtual Table class with this connection
 	void RegisterVirtualTable(Type^ vtableType, String^ moduleName);
 
+	// ResetStatementStatistics
+	//
+	// Discards all of the statement counters sampled by command text
+	void ResetStatementStatistics(void);
+
 	// Vacuum
 	//
 	// Cleans the main database by copying it into a temp file and reloading it
@@ -235,8 +313,8 @@ public:
 
 	// AutoVacuum
 	//
-	// Determines if this database was created with auto-vacuuming or not
-	property bool AutoVacuum { bool get(void); }
+	// Determines the auto-vacuum mode this database was created with
+	property SqliteAutoVacuumMode AutoVacuum { SqliteAutoVacuumMode get(void); }
 
 	// BooleanFormat
 	//
@@ -327,6 +405,11 @@ public:
 	// Changes the contained field encyption password
 	property SecureString^ FieldEncryptionPassword { void set(SecureString^ value); }
 
+	// FreePageCount
+	//
+	// Gets the number of unused pages in the main database file
+	property int FreePageCount { int get(void); }
+
 	// Functions
 	//
 	// Gets a reference to the contained function collection
@@ -368,6 +451,17 @@ public:
 		void set(int value);
 	}
 
+	// StatisticsSampleRate
+	//
+	// Determines how often command executions are sampled into the statement
+	// counters kept by command text.  Zero (the default) disables sampling,
+	// one samples every execution, and N samples every Nth execution
+	property int StatisticsSampleRate
+	{
+		int get(void);
+		void set(int value);
+	}
+
 	// SynchronousMode
 	//
 	// Determines the synchronous mode for the database
@@ -398,6 +492,23 @@ public:
 		void set(SqliteTemporaryStorageMode value);
 	}
 
+	// TraceEntriesDropped
+	//
+	// Number of trace buffer entries that were overwritten before they
+	// could be read with ReadTraceEntries
+	property __int64 TraceEntriesDropped { __int64 get(void); }
+
+	// TraceMask
+	//
+	// Determines which sqlite3_trace_v2 events are recorded into the trace
+	// buffer.  Recording is allocation-free and cheap enough to leave on;
+	// None (the default) disables the trace buffer entirely
+	property SqliteTraceEventMask TraceMask
+	{
+		SqliteTraceEventMask get(void);
+		void set(SqliteTraceEventMask value);
+	}
+
 	// TransactionMode
 	//
 	// Determines the custom transaction mode the connection was opened with
@@ -423,6 +534,11 @@ internal:
 	//-----------------------------------------------------------------------
 	// Internal Member Functions
 
+	// CacheBuilderSchema
+	//
+	// Caches a SqliteCommandBuilder schema table against the current schema cookie
+	void CacheBuilderSchema(String^ commandText, DataTable^ schema);
+
 	// CommitTransaction
 	//
 	// Commits an outstanding database transaction
@@ -433,6 +549,12 @@ internal:
 	// Attempts to locate a SqliteConnection instance from a sqlite3* handle
 	static SqliteConnection^ FindConnection(sqlite3* hDatabase);
 
+	// GetBuilderSchema
+	//
+	// Retrieves a cached SqliteCommandBuilder schema table, or NULL if there
+	// isn't one or the database schema has changed since it was cached
+	DataTable^ GetBuilderSchema(String^ commandText);
+
 	// GetHandle
 	//
 	// Retrieves and AddRefs the contained database handle.  The caller must
@@ -466,6 +588,11 @@ internal:
 	// Rolls back an outstanding database transaction
 	void RollbackTransaction(SqliteTransaction^ trans);
 
+	// SampleStatistics
+	//
+	// Records the statement counters for a command execution if it is sampled
+	void SampleStatistics(String^ commandText, SqliteStatementStatistics statistics);
+
 	// UnRegisterDataReader
 	//
 	// Removes a data reader registration from this connection
@@ -474,6 +601,11 @@ internal:
 	//-----------------------------------------------------------------------
 	// Internal Properties
 
+	// ColumnMetaData
+	//
+	// Exposes the connection-wide cache of table column metadata
+	property SqliteColumnMetaDataCache^ ColumnMetaData { SqliteColumnMetaDataCache^ get(void); }
+
 	// FieldEncryptionKey
 	//
 	// Returns a reference to the field-level encryption key
@@ -500,11 +632,6 @@ internal:
 	// a transaction, this better darn well be TRUE as well
 	property bool InTransaction { bool get(void); }
 
-	// RollbackInProgress
-	//
-	// TRUE if the nested transaction manager is in a rollback state
-	property bool RollbackInProgress { bool get(void); }
-
 	//-----------------------------------------------------------------------
 	// Internal Fields
 
@@ -535,6 +662,23 @@ private:
 	// Constant name of the main database instance/catalog
 	literal String^ MAIN_CATALOG_NAME = "main";
 
+	// BACKUP_BUSY_RETRY_MS
+	//
+	// Time to wait before retrying a backup step that failed with SQLITE_BUSY
+	// or SQLITE_LOCKED when no explicit pause between steps was specified
+	literal int BACKUP_BUSY_RETRY_MS = 10;
+
+	// BACKUP_BUSY_TIMEOUT_MS
+	//
+	// Maximum time to keep retrying a backup step that is failing with SQLITE_BUSY
+	// or SQLITE_LOCKED before giving up, same as the default command timeout
+	literal int BACKUP_BUSY_TIMEOUT_MS = 30000;
+
+	// SAVEPOINT_PREFIX
+	//
+	// Prefix used to generate the SAVEPOINT names for nested transactions
+	literal String^ SAVEPOINT_PREFIX = "zuki_savepoint_";
+
 	//-----------------------------------------------------------------------
 	// Private Member Functions
 
@@ -543,6 +687,16 @@ private:
 	// Applies all PRAGMA commands to the connection after it's been opened
 	void ApplyConnectionPragmas(void);
 
+	// BackgroundVacuumCallback
+	//
+	// Timer callback that performs a slice of the background vacuum
+	void BackgroundVacuumCallback(Object^ state);
+
+	// CheckBuilderCookie
+	//
+	// Flushes the command builder schema cache if the schema cookie has changed
+	void CheckBuilderCookie(void);
+
 	// Close
 	//
 	// Internalized version of Close() that can control the firing of the
@@ -576,8 +730,6 @@ private:
 	// TRANSACTION CONTROL
 
 	List<SqliteTransaction^>^		m_openTrans;		// Outstanding transactions
-	SqliteLockMode					m_openTransMode;	// Current transaction mode
-	int							m_openTransCount;	// Outstanding transaction count
 
 	// DATAREADER CONTROL
 
@@ -595,10 +747,36 @@ private:
 	SqliteConnectionTraceHook^				m_traceHook;		// StatementTrace hook
 	SqliteConnectionUpdateHook^			m_updateHook;		// RowChanged hook
 
+	// STATEMENT TRACING
+
+	TraceDispatcher*				m_pTrace;			// sqlite3_trace_v2 dispatcher
+	Object^							m_traceLock;		// Trace buffer reader lock
+
+	// BACKGROUND VACUUM
+
+	Timer^							m_vacuumTimer;		// Background vacuum timer
+	int								m_vacuumPages;		// Pages per vacuum slice
+	bool volatile					m_vacuumDue;		// Vacuum slice is pending
+
 	// VIRTUAL TABLE MODULES
 
 	List<GCHandle>^					m_modules;			// Registered modules
 
+	// STATEMENT STATISTICS SAMPLING
+
+	Dictionary<String^, SqliteStatementStatistics>^	m_samples;		// Counters by command text
+	int								m_sampleRate;		// Executions per sample
+	int								m_sampleCount;		// Executions since last sample
+
+	// COMMAND BUILDER SCHEMA CACHE
+
+	Dictionary<String^, DataTable^>^	m_builderSchemas;	// Schema tables by SELECT text
+	String^							m_builderCookie;	// Combined schema versions
+
+	// COLUMN METADATA CACHE
+
+	SqliteColumnMetaDataCache^			m_columnMetaData;	// Table column metadata
+
 	// FUNCTIONS, AGGREGATES, COLLATIONS
 
 	SqliteAggregateCollection^			m_aggregates;		// Registered aggregates
@@ -607,7 +785,7 @@ private:
 
 	// NON-MODIFIABLE CONNECTION PROPERTIES AND PRAGMAS
 
-	bool					m_autoVacuum;			// PRAGMA AUTO_VACUUM
+	SqliteAutoVacuumMode		m_autoVacuum;			// PRAGMA AUTO_VACUUM
 	bool					m_compatibleFormat;		// PRAGMA LEGACY_FILE_FORMAT
 	SqliteTextEncodingMode		m_encoding;				// PRAGMA ENCODING
 	int						m_pageSize;				// PRAGMA PAGE_SIZE
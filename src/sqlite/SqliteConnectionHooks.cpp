@@ -553,15 +553,16 @@ void SqliteConnectionRollbackHook::RemoveHook(DatabaseHandle* pDatabase)
 //---------------------------------------------------------------------------
 // sqliteconnection_profile_hook
 //
-// Unmanaged callback function for the sqlite3_profile handler
+// Unmanaged callback function for SQLITE_TRACE_PROFILE, invoked through the
+// connection's TraceDispatcher
 //
 // Arguments:
 //
-//	context		- Context pointer passed into sqlite3_trace()
+//	context		- Context pointer passed into SetProfileHandler()
 //	statement	- Statement being profiled
-//	elapsed		- Elapsed statement time
+//	elapsed		- Elapsed statement time in nanoseconds
 
-static void sqliteconnection_profile_hook(void* context, const char* statement, sqlite_uint64 elapsed)
+static void sqliteconnection_profile_hook(void* context, sqlite3_stmt* statement, sqlite3_int64 elapsed)
 {
 	GCHandleRef<SqliteConnectionProfileHook^>	hook(context);	// Hook object instance
 	gcroot<String^>							msg;			// Event argument data
@@ -577,7 +578,7 @@ static void sqliteconnection_profile_hook(void* context, const char* statement,
 	// the message can be HUGE and that uses the stack rather than the heap
 	// when converting the string.  A potentially bad thing.
 
-	try { hook->Raise(gcnew SqliteProfileEventArgs(statement, elapsed)); }
+	try { hook->Raise(gcnew SqliteProfileEventArgs(sqlite3_sql(statement), static_cast<sqlite_uint64>(elapsed))); }
 	catch(Exception^) { /* DO NOTHING */ }
 }
 
@@ -595,7 +596,7 @@ void SqliteConnectionProfileHook::InstallHook(DatabaseHandle* pDatabase, void* c
 {
 	if(!pDatabase) throw gcnew ArgumentNullException();
 
-	sqlite3_profile(pDatabase->Handle, sqliteconnection_profile_hook, context);
+	m_pDispatcher->SetProfileHandler(pDatabase->Handle, sqliteconnection_profile_hook, context);
 
 #ifdef sqlite_TRACE_CONNECTIONHOOKS
 	Debug::WriteLine(String::Format("SqliteConnectionProfileHook 0x{0:X} installed.",
@@ -633,7 +634,7 @@ void SqliteConnectionProfileHook::RemoveHook(DatabaseHandle* pDatabase)
 {
 	if(!pDatabase) throw gcnew ArgumentNullException();
 
-	sqlite3_profile(pDatabase->Handle, NULL, NULL);
+	m_pDispatcher->SetProfileHandler(pDatabase->Handle, NULL, NULL);
 
 #ifdef sqlite_TRACE_CONNECTIONHOOKS
 	Debug::WriteLine(String::Format("SqliteConnectionProfileHook 0x{0:X} removed",
@@ -648,14 +649,16 @@ void SqliteConnectionProfileHook::RemoveHook(DatabaseHandle* pDatabase)
 //---------------------------------------------------------------------------
 // sqliteconnection_trace_hook
 //
-// Unmanaged callback function for the sqlite3_trace handler
+// Unmanaged callback function for SQLITE_TRACE_STMT, invoked through the
+// connection's TraceDispatcher
 //
 // Arguments:
 //
-//	context		- Context pointer passed into sqlite3_trace()
-//	message		- Trace message from the database engine
+//	context		- Context pointer passed into SetTraceHandler()
+//	statement	- Statement starting to execute
+//	sql			- Unexpanded statement text or trigger comment
 
-static void sqliteconnection_trace_hook(void* context, const char* message)
+static void sqliteconnection_trace_hook(void* context, sqlite3_stmt* statement, const char* sql)
 {
 	GCHandleRef<SqliteConnectionTraceHook^>	hook(context);	// Hook object instance
 	gcroot<String^>							msg;			// Event argument data
@@ -671,8 +674,16 @@ static void sqliteconnection_trace_hook(void* context, const char* message)
 	// the message can be HUGE and that uses the stack rather than the heap
 	// when converting the string.  A potentially bad thing.
 
-	try { hook->Raise(gcnew SqliteTraceEventArgs(message)); }
+	// The legacy sqlite3_trace() message had the bound parameters expanded into
+	// the statement text, so keep doing that for the event.  Trigger programs
+	// are reported as a "-- <trigger>" comment, which is passed along as-is
+
+	char* expanded = ((sql) && (strncmp(sql, "--", 2) == 0)) ? NULL : sqlite3_expanded_sql(statement);
+
+	try { hook->Raise(gcnew SqliteTraceEventArgs((expanded) ? expanded : sql)); }
 	catch(Exception^) { /* DO NOTHING */ }
+
+	sqlite3_free(expanded);					// Release the expanded text
 }
 
 //---------------------------------------------------------------------------
@@ -689,7 +700,7 @@ void SqliteConnectionTraceHook::InstallHook(DatabaseHandle* pDatabase, void* con
 {
 	if(!pDatabase) throw gcnew ArgumentNullException();
 
-	sqlite3_trace(pDatabase->Handle, sqliteconnection_trace_hook, context);
+	m_pDispatcher->SetTraceHandler(pDatabase->Handle, sqliteconnection_trace_hook, context);
 
 #ifdef sqlite_TRACE_CONNECTIONHOOKS
 	Debug::WriteLine(String::Format("SqliteConnectionTraceHook 0x{0:X} installed.",
@@ -727,7 +738,7 @@ void SqliteConnectionTraceHook::RemoveHook(DatabaseHandle* pDatabase)
 {
 	if(!pDatabase) throw gcnew ArgumentNullException();
 
-	sqlite3_trace(pDatabase->Handle, NULL, NULL);
+	m_pDispatcher->SetTraceHandler(pDatabase->Handle, NULL, NULL);
 
 #ifdef sqlite_TRACE_CONNECTIONHOOKS
 	Debug::WriteLine(String::Format("SqliteConnectionTraceHook 0x{0:X} removed",
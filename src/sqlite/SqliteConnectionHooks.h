@@ -28,6 +28,7 @@
 #include "SqliteDelegates.h"				// Include Sqlite delegate decls
 #include "SqliteEnumerations.h"			// Include Sqlite enumeration decls
 #include "SqliteEventArgs.h"				// Include Sqlite eventarg declarations
+#include "TraceDispatcher.h"				// Include TraceDispatcher declarations
 
 #pragma warning(push, 4)				// Enable maximum compiler warnings
 
@@ -294,7 +295,9 @@ protected:
 //---------------------------------------------------------------------------
 // Class SqliteConnectionProfileHook (internal)
 //
-// Specializes SqliteConnectionHook<T> to implement the statement trace hook
+// Specializes SqliteConnectionHook<T> to implement the statement profile hook.
+// The sqlite3_trace_v2 registration is shared, so the hook is installed into
+// the connection's TraceDispatcher rather than directly into SQLite
 //
 // Please review the notes in the base class description for some implementation
 // details and explanations about the connection hooks.
@@ -308,8 +311,9 @@ public:
 	//-----------------------------------------------------------------------
 	// Constructors
 
-	SqliteConnectionProfileHook(SqliteConnection^ conn) : 
-		SqliteConnectionHook<SqliteProfileEventHandler^, SqliteProfileEventArgs^>(conn) {}
+	SqliteConnectionProfileHook(SqliteConnection^ conn, TraceDispatcher* pDispatcher) : 
+		SqliteConnectionHook<SqliteProfileEventHandler^, SqliteProfileEventArgs^>(conn),
+		m_pDispatcher(pDispatcher) {}
 
 protected:
 
@@ -331,12 +335,21 @@ protected:
 	//
 	// Uninstalls the underlying SQLite hook
 	virtual void RemoveHook(DatabaseHandle* pDatabase) override;
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	TraceDispatcher*		m_pDispatcher;		// Owned by the connection
 };
 
 //---------------------------------------------------------------------------
 // Class SqliteConnectionTraceHook (internal)
 //
-// Specializes SqliteConnectionHook<T> to implement the statement trace hook
+// Specializes SqliteConnectionHook<T> to implement the statement trace hook.
+// The sqlite3_trace_v2 registration is shared, so the hook is installed into
+// the connection's TraceDispatcher rather than directly into SQLite
 //
 // Please review the notes in the base class description for some implementation
 // details and explanations about the connection hooks.
@@ -350,8 +363,9 @@ public:
 	//-----------------------------------------------------------------------
 	// Constructors
 
-	SqliteConnectionTraceHook(SqliteConnection^ conn) : 
-		SqliteConnectionHook<SqliteTraceEventHandler^, SqliteTraceEventArgs^>(conn) {}
+	SqliteConnectionTraceHook(SqliteConnection^ conn, TraceDispatcher* pDispatcher) : 
+		SqliteConnectionHook<SqliteTraceEventHandler^, SqliteTraceEventArgs^>(conn),
+		m_pDispatcher(pDispatcher) {}
 
 protected:
 
@@ -373,6 +387,13 @@ protected:
 	//
 	// Uninstalls the underlying SQLite hook
 	virtual void RemoveHook(DatabaseHandle* pDatabase) override;
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	TraceDispatcher*		m_pDispatcher;		// Owned by the connection
 };
 
 //---------------------------------------------------------------------------
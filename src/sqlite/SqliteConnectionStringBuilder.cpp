@@ -67,16 +67,18 @@ SqliteConnectionStringBuilder::SqliteConnectionStringBuilder(String^ connectionS
 void SqliteConnectionStringBuilder::AllowExtensions::set(bool value)
 {
 	DbConnectionStringBuilder::default[s_keywords[static_cast<int>(KeywordCode::AllowExtensions)]] = value.ToString();
-	m_autoVacuum = value;
+	m_allowExtensions = value;
 }
 
 //---------------------------------------------------------------------------
 // SqliteConnectionStringBuilder::AutoVacuum::set
 //
-// Sets the option for automatically shrinking the database file on close
+// Sets the option for automatically reclaiming free pages in the database
 
-void SqliteConnectionStringBuilder::AutoVacuum::set(bool value)
+void SqliteConnectionStringBuilder::AutoVacuum::set(SqliteAutoVacuumMode value)
 {
+	if(!Enum::IsDefined(SqliteAutoVacuumMode::typeid, value)) throw gcnew ArgumentOutOfRangeException();
+
 	DbConnectionStringBuilder::default[s_keywords[static_cast<int>(KeywordCode::AutoVacuum)]] = value.ToString();
 	m_autoVacuum = value;
 }
@@ -233,9 +235,18 @@ void SqliteConnectionStringBuilder::default::set(String^ keyword, Object^ value)
 			AllowExtensions = Convert::ToBoolean(value);
 			return;
 
-		case KeywordCode::AutoVacuum:			
-			AutoVacuum = Convert::ToBoolean(value); 
+		case KeywordCode::AutoVacuum:
+		{
+			// Previous versions of the provider only supported a boolean value here,
+			// so continue to accept that with TRUE mapping to FULL mode
+
+			bool legacy;
+			if(Boolean::TryParse(Convert::ToString(value), legacy)) { AutoVacuum = (legacy) ? SqliteAutoVacuumMode::Full : SqliteAutoVacuumMode::None; return; }
+
+			try { AutoVacuum = static_cast<SqliteAutoVacuumMode>(Enum::Parse(SqliteAutoVacuumMode::typeid, Convert::ToString(value), true)); }
+			catch(Exception^) { throw gcnew FormatException(String::Format("'{0}' is not a valid SqliteAutoVacuumMode option", Convert::ToString(value))); }
 			return;
+		}
 
 		case KeywordCode::BooleanFormat:
 			try { BooleanFormat = static_cast<SqliteBooleanFormat>(Enum::Parse(SqliteBooleanFormat::typeid, Convert::ToString(value), true)); }
@@ -282,10 +293,22 @@ void SqliteConnectionStringBuilder::default::set(String^ keyword, Object^ value)
 			catch(Exception^) { throw gcnew FormatException(String::Format("'{0}' is not a valid SqliteGuidFormat option", Convert::ToString(value))); }
 			return;
 
+		case KeywordCode::NoMutex:
+			NoMutex = Convert::ToBoolean(value);
+			return;
+
 		case KeywordCode::PageSize:
 			PageSize = Convert::ToInt32(value);
 			return;
 
+		case KeywordCode::ReadOnly:
+			ReadOnly = Convert::ToBoolean(value);
+			return;
+
+		case KeywordCode::SharedCache:
+			SharedCache = Convert::ToBoolean(value);
+			return;
+
 		case KeywordCode::SynchronousMode:
 			try { SynchronousMode = static_cast<SqliteSynchronousMode>(Enum::Parse(SqliteSynchronousMode::typeid, Convert::ToString(value), true)); }
 			catch(Exception^) { throw gcnew FormatException(String::Format("'{0}' is not a valid SqliteSynchronousMode option", Convert::ToString(value))); }
@@ -331,7 +354,7 @@ void SqliteConnectionStringBuilder::Encoding::set(SqliteTextEncodingMode value)
 void SqliteConnectionStringBuilder::Enlist::set(bool value)
 {
 	DbConnectionStringBuilder::default[s_keywords[static_cast<int>(KeywordCode::Enlist)]] = value.ToString();
-	m_autoVacuum = value;
+	m_enlist = value;
 }
 
 //---------------------------------------------------------------------------
@@ -389,7 +412,10 @@ Object^ SqliteConnectionStringBuilder::GetAt(KeywordCode code)
 		case KeywordCode::Encoding:					return m_textEncodingMode;
 		case KeywordCode::Enlist:					return m_enlist;
 		case KeywordCode::GuidFormat:				return m_guidFormat;
+		case KeywordCode::NoMutex:					return m_noMutex;
 		case KeywordCode::PageSize:					return m_pageSize;
+		case KeywordCode::ReadOnly:					return m_readOnly;
+		case KeywordCode::SharedCache:				return m_sharedCache;
 		case KeywordCode::SynchronousMode:			return m_syncMode;
 		case KeywordCode::TemporaryStorageFolder:	return m_tempStorageFolder;
 		case KeywordCode::TemporaryStorageMode:		return m_tempStorageMode;
@@ -432,6 +458,17 @@ void SqliteConnectionStringBuilder::GuidFormat::set(SqliteGuidFormat value)
 	m_guidFormat = value;
 }
 
+//---------------------------------------------------------------------------
+// SqliteConnectionStringBuilder::NoMutex::set
+//
+// Sets the option to open the connection without a per-connection mutex
+
+void SqliteConnectionStringBuilder::NoMutex::set(bool value)
+{
+	DbConnectionStringBuilder::default[s_keywords[static_cast<int>(KeywordCode::NoMutex)]] = value.ToString();
+	m_noMutex = value;
+}
+
 //---------------------------------------------------------------------------
 // SqliteConnectionStringBuilder::PageSize::set
 //
@@ -450,6 +487,17 @@ void SqliteConnectionStringBuilder::PageSize::set(int value)
 	m_pageSize = value;
 }
 
+//---------------------------------------------------------------------------
+// SqliteConnectionStringBuilder::ReadOnly::set
+//
+// Sets the option to open the database in read-only mode
+
+void SqliteConnectionStringBuilder::ReadOnly::set(bool value)
+{
+	DbConnectionStringBuilder::default[s_keywords[static_cast<int>(KeywordCode::ReadOnly)]] = value.ToString();
+	m_readOnly = value;
+}
+
 //---------------------------------------------------------------------------
 // SqliteConnectionStringBuilder::Remove
 //
@@ -488,7 +536,7 @@ void SqliteConnectionStringBuilder::Reset(KeywordCode code)
 	switch(code) {
 
 		case KeywordCode::AllowExtensions:			m_allowExtensions = true; return;
-		case KeywordCode::AutoVacuum :				m_autoVacuum = false; return;
+		case KeywordCode::AutoVacuum :				m_autoVacuum = SqliteAutoVacuumMode::None; return;
 		case KeywordCode::BooleanFormat:			m_booleanFormat = SqliteBooleanFormat::OneZero; return;
 		case KeywordCode::CacheSize:				m_cacheSize = 2000; return;
 		case KeywordCode::CaseSensitiveLike:		m_caseSensitiveLike = false; return;
@@ -498,7 +546,10 @@ void SqliteConnectionStringBuilder::Reset(KeywordCode code)
 		case KeywordCode::Enlist:					m_enlist = false; return;
 		case KeywordCode::FieldEncryptionPassword:	FieldEncryptionPassword = nullptr; return;
 		case KeywordCode::GuidFormat:				m_guidFormat = SqliteGuidFormat::Binary; return;
+		case KeywordCode::NoMutex:					m_noMutex = false; return;
 		case KeywordCode::PageSize:					m_pageSize = 4096; return;
+		case KeywordCode::ReadOnly:					m_readOnly = false; return;
+		case KeywordCode::SharedCache:				m_sharedCache = false; return;
 		case KeywordCode::SynchronousMode:			m_syncMode = SqliteSynchronousMode::Normal; return;
 		case KeywordCode::TemporaryStorageFolder:	m_tempStorageFolder = String::Empty; return;
 		case KeywordCode::TemporaryStorageMode:		m_tempStorageMode = SqliteTemporaryStorageMode::Default; return;
@@ -521,6 +572,17 @@ void SqliteConnectionStringBuilder::ResetAll(void)
 	for(int index = 0; index < s_keywords->Length; index++) Reset(static_cast<KeywordCode>(index));
 }
 
+//---------------------------------------------------------------------------
+// SqliteConnectionStringBuilder::SharedCache::set
+//
+// Sets the option to share the page cache with other connections
+
+void SqliteConnectionStringBuilder::SharedCache::set(bool value)
+{
+	DbConnectionStringBuilder::default[s_keywords[static_cast<int>(KeywordCode::SharedCache)]] = value.ToString();
+	m_sharedCache = value;
+}
+
 //---------------------------------------------------------------------------
 // SqliteConnectionStringBuilder::ShouldSerialize
 //
@@ -95,14 +95,14 @@ public:
 		void set(bool value);
 	}
 
-	// AutoVacuum = { true | false }
+	// AutoVacuum = { None | Full | Incremental }
 	//
-	// Determines if the SQLite database files will be automatically
-	// vacuumed when they are closed
-	property bool AutoVacuum
+	// Determines the auto-vacuum mode for a new SQLite database file.  For
+	// compatibility, true and false are accepted as Full and None
+	property SqliteAutoVacuumMode AutoVacuum
 	{
-		bool get(void) { return m_autoVacuum; }
-		void set(bool value);
+		SqliteAutoVacuumMode get(void) { return m_autoVacuum; }
+		void set(SqliteAutoVacuumMode value);
 	}
 
 	// BooleanFormat = { OneZero | NegativeOneZero | TrueFalse }
@@ -203,6 +203,16 @@ public:
 		bool get(void) override { return true; }
 	}
 
+	// NoMutex = { true | false }
+	//
+	// Determines if the connection should be opened without a per-connection
+	// mutex.  Only safe if the connection is never used by multiple threads
+	property bool NoMutex
+	{
+		bool get(void) { return m_noMutex; }
+		void set(bool value);
+	}
+
 	// PageSize = { n }
 	//
 	// Determines the page size to use for a new SQLite database file
@@ -212,6 +222,26 @@ public:
 		void set(int value);
 	}
 
+	// ReadOnly = { true | false }
+	//
+	// Determines if the database should be opened in read-only mode
+	property bool ReadOnly
+	{
+		bool get(void) { return m_readOnly; }
+		void set(bool value);
+	}
+
+	// SharedCache = { true | false }
+	//
+	// Determines if the connection should share a page cache with all other
+	// connections to the same database in this process.  Combine with a data
+	// source URI of "file:name?mode=memory" to share an in-memory database
+	property bool SharedCache
+	{
+		bool get(void) { return m_sharedCache; }
+		void set(bool value);
+	}
+
 	// SynchronousMode = { Normal | Full | Off }
 	//
 	// Determines the SQLite synchronous mode, which indicates how much
@@ -302,7 +332,10 @@ private:
 		Enlist,
 		FieldEncryptionPassword,
 		GuidFormat,
+		NoMutex,
 		PageSize,
+		ReadOnly,
+		SharedCache,
 		SynchronousMode,
 		TemporaryStorageFolder,
 		TemporaryStorageMode,
@@ -322,7 +355,7 @@ private:
 	// Member Variables
 
 	bool						m_allowExtensions;		// ALLOW EXTENSIONS=
-	bool						m_autoVacuum;			// AUTO VACUUM=
+	SqliteAutoVacuumMode			m_autoVacuum;			// AUTO VACUUM=
 	SqliteBooleanFormat			m_booleanFormat;		// BOOLEAN FORMAT=
 	int							m_cacheSize;			// CACHESIZE=
 	bool						m_caseSensitiveLike;	// CASE SENSITIVE LIKE=
@@ -332,7 +365,10 @@ private:
 	bool						m_enlist;				// ENLIST =
 	SecureString^				m_fieldPassword;		// FIELD ENCRYPTION PASSWORD =
 	SqliteGuidFormat				m_guidFormat;			// GUID FORMAT=
+	bool						m_noMutex;				// NO MUTEX=
 	int							m_pageSize;				// PAGE SIZE=
+	bool						m_readOnly;				// READ ONLY=
+	bool						m_sharedCache;			// SHARED CACHE=
 	SqliteSynchronousMode			m_syncMode;				// SYNCHRONOUS MODE=
 	String^						m_tempStorageFolder;	// TEMPORARY STORAGE FOLDER=
 	SqliteTemporaryStorageMode		m_tempStorageMode;		// TEMPORARY STORAGE MODE=
@@ -358,7 +394,10 @@ private:
 		"Enlist",
 		"Field Encryption Password",
 		"Guid Format",
+		"No Mutex",
 		"Page Size",
+		"Read Only",
+		"Shared Cache",
 		"Synchronous Mode",
 		"Temporary Storage Folder",
 		"Temporary Storage Mode",
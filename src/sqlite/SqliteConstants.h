@@ -40,6 +40,16 @@ namespace zuki::data::sqlite {
 public ref struct SqliteDataSource abstract sealed
 {
 	static initonly String^	Memory = ":memory:";
+
+	// SharedMemory
+	//
+	// Generates a URI data source for a named in-memory database that can be
+	// shared among all of the connections in the process that open it
+	static String^ SharedMemory(String^ name)
+	{
+		if(name == nullptr) throw gcnew ArgumentNullException();
+		return String::Format("file:{0}?mode=memory&cache=shared", Uri::EscapeDataString(name));
+	}
 };
 
 //---------------------------------------------------------------------------
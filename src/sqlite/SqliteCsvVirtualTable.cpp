@@ -0,0 +1,506 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"							// Include project pre-compiled headers
+#include "SqliteCsvVirtualTable.h"				// Include SqliteCsvVirtualTable decls
+
+#pragma warning(push, 4)					// Enable maximum compiler warnings
+#pragma warning(disable:4100)				// "unreferenced formal parameter"
+
+using namespace System::Globalization;
+using namespace System::Text;
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// SqliteCsvVirtualTable Constructor
+//
+// Arguments:
+//
+//	NONE
+
+SqliteCsvVirtualTable::SqliteCsvVirtualTable() : m_estimate(-1)
+{
+	String^					filename;			// Path to the file
+	Char					delimiter;			// Field delimiter character
+	bool					header;				// Flag if a header is present
+	int						sample;				// Type inference sample size
+	size_t					bytes = 0;			// Bytes occupied by the sample
+	DWORD					dwResult;			// Result from function call
+
+	ParseArguments(filename, delimiter, header, sample);
+
+	// Map the entire file into memory; it's parsed in place from this point
+	// forward rather than being read through a stream
+
+	m_pFile = new CsvFile(static_cast<char>(delimiter));
+
+	PinnedStringPtr pinPath = PtrToStringChars(Path::GetFullPath(filename));
+	dwResult = m_pFile->Open(pinPath);
+	if(dwResult != ERROR_SUCCESS) throw gcnew IOException(String::Format("Unable to open csv file {0}", filename), 
+		gcnew Win32Exception(dwResult));
+
+	if(m_pFile->FirstRecord >= m_pFile->Size) throw gcnew InvalidDataException(String::Format("The csv file {0} does not contain any records", filename));
+
+	// The first record determines the number of columns, and the names of
+	// those columns when it's a header line
+
+	m_names = GetColumnNames(header);
+	m_pTypes = new int[m_names->Length];
+
+	// Infer the column types from a sample of the records.  When the sample
+	// covers the entire file the number of records is known exactly, otherwise
+	// it's estimated from the average length of the sampled records
+
+	if(sample > 0) {
+
+		int records = m_pFile->InferTypes(m_pFile->FirstRecord, sample, m_names->Length, m_pTypes, bytes);
+
+		if((records < sample) || (bytes == 0)) m_estimate = records;
+		else m_estimate = static_cast<__int64>((static_cast<double>(m_pFile->Size - m_pFile->FirstRecord) * records) / bytes);
+	}
+
+	else for(int index = 0; index < m_names->Length; index++) m_pTypes[index] = SQLITE_TEXT;
+}
+
+//---------------------------------------------------------------------------
+// SqliteCsvVirtualTable Destructor
+
+SqliteCsvVirtualTable::~SqliteCsvVirtualTable()
+{
+	if(m_disposed) return;
+
+	this->!SqliteCsvVirtualTable();		// Release unmanaged resources
+	m_disposed = true;					// Object is now disposed of
+}
+
+//---------------------------------------------------------------------------
+// SqliteCsvVirtualTable Finalizer
+
+SqliteCsvVirtualTable::!SqliteCsvVirtualTable()
+{
+	if(m_pFile) delete m_pFile;			// Unmaps and closes the file
+	if(m_pTypes) delete[] m_pTypes;		// Release the column types
+
+	m_pFile = NULL;						// Reset pointer to NULL
+	m_pTypes = NULL;					// Reset pointer to NULL
+}
+
+//---------------------------------------------------------------------------
+// SqliteCsvVirtualTable::Close (protected)
+//
+// Invoked when the virtual table is being closed
+//
+// Arguments:
+//
+//	NONE
+
+void SqliteCsvVirtualTable::Close(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	m_pFile->Close();
+}
+
+//---------------------------------------------------------------------------
+// SqliteCsvVirtualTable::ColumnTypes::get (internal)
+//
+// Gets the inferred SQLITE_xxxx data type of each column
+
+const int* SqliteCsvVirtualTable::ColumnTypes::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_pTypes;
+}
+
+//---------------------------------------------------------------------------
+// SqliteCsvVirtualTable::CreateCursor (protected)
+//
+// Creates a new cursor instance used to read data from the virtual table
+//
+// Arguments:
+//
+//	NONE
+
+SqliteCsvVirtualTableCursor^ SqliteCsvVirtualTable::CreateCursor(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return gcnew SqliteCsvVirtualTableCursor(this);
+}
+
+//---------------------------------------------------------------------------
+// SqliteCsvVirtualTable::File::get (internal)
+//
+// Gets the mapped file instance
+
+CsvFile* SqliteCsvVirtualTable::File::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_pFile;
+}
+
+//---------------------------------------------------------------------------
+// SqliteCsvVirtualTable::GetColumnNames (private)
+//
+// Generates the column names from the header record, if present.  Columns
+// without a name are named c1, c2, ... and duplicate names are made unique
+//
+// Arguments:
+//
+//	header		- Flag if the first record contains the column names
+
+array<String^>^ SqliteCsvVirtualTable::GetColumnNames(bool header)
+{
+	std::vector<CsvFile::Field>		fields;			// First record fields
+	std::string						value;			// Field value
+
+	HashSet<String^>^ unique = gcnew HashSet<String^>(StringComparer::OrdinalIgnoreCase);
+
+	size_t next = m_pFile->ParseRecord(m_pFile->FirstRecord, &fields);
+	array<String^>^ names = gcnew array<String^>(static_cast<int>(fields.size()));
+
+	for(int index = 0; index < names->Length; index++) {
+
+		String^ name = String::Empty;
+
+		if(header) {
+
+			m_pFile->GetField(fields[index], value);
+			name = Encoding::UTF8->GetString(reinterpret_cast<unsigned char*>(const_cast<char*>(value.data())), 
+				static_cast<int>(value.size()))->Replace("]", String::Empty)->Trim();
+		}
+
+		if(name->Length == 0) name = "c" + (index + 1).ToString(CultureInfo::InvariantCulture);
+
+		// SQLite column names are case-insensitive, so a name that is already
+		// in use gets a numeric suffix appended to it
+
+		String^ candidate = name;
+		for(int suffix = 2; !unique->Add(candidate); suffix++) candidate = name + "_" + suffix.ToString(CultureInfo::InvariantCulture);
+
+		names[index] = candidate;
+	}
+
+	if(header) m_pFile->FirstRecord = next;		// Records start after header
+	return names;
+}
+
+//---------------------------------------------------------------------------
+// SqliteCsvVirtualTable::GetRange (internal)
+//
+// Converts the filter arguments for an index code into a record range.  The
+// range may be wider than the constraints; the engine double-checks them
+//
+// Arguments:
+//
+//	code		- Index identifier code from SelectBestIndex()
+//	args		- Filter arguments
+//	first		- On success, set to the first record in the range
+//	last		- On success, set to the last record in the range
+
+void SqliteCsvVirtualTable::GetRange(int code, SqliteArgumentCollection^ args, __int64% first, __int64% last)
+{
+	int						arg = 0;			// Filter argument index
+
+	CHECK_DISPOSED(m_disposed);
+
+	first = 1;
+	last = _I64_MAX;
+
+	// Record numbers start at one, so the lower bound is always clamped to the
+	// first record; "rowid = 0" or a negative ROWID produces an empty range
+
+	if((code & PLAN_EQUAL) == PLAN_EQUAL) {
+
+		first = Math::Max(first, ToRecord(args[0], true));
+		last = ToRecord(args[0], false);
+	}
+
+	else {
+
+		if((code & PLAN_LOWER) == PLAN_LOWER) first = Math::Max(first, ToRecord(args[arg++], true));
+		if((code & PLAN_UPPER) == PLAN_UPPER) last = ToRecord(args[arg++], false);
+	}
+
+	// A lower bound that no ROWID can reach (NULL, or TEXT that isn't numeric)
+	// is reported as an empty range so the cursor doesn't seek for it
+
+	if(first == _I64_MAX) last = 0;
+}
+
+//---------------------------------------------------------------------------
+// SqliteCsvVirtualTable::GetSchema (protected)
+//
+// Returns the column names and inferred data types of the file
+//
+// Arguments:
+//
+//	NONE
+
+DataTable^ SqliteCsvVirtualTable::GetSchema(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	DataTable^ schema = gcnew DataTable();
+
+	for(int index = 0; index < m_names->Length; index++) {
+
+		switch(m_pTypes[index]) {
+
+			case SQLITE_INTEGER: schema->Columns->Add(m_names[index], __int64::typeid); break;
+			case SQLITE_FLOAT: schema->Columns->Add(m_names[index], double::typeid); break;
+			default: schema->Columns->Add(m_names[index], String::typeid); break;
+		}
+	}
+
+	return schema;
+}
+
+//---------------------------------------------------------------------------
+// SqliteCsvVirtualTable::ParseArguments (private)
+//
+// Processes the module arguments from CREATE VIRTUAL TABLE
+//
+// Arguments:
+//
+//	filename	- On success, set to the path of the file
+//	delimiter	- On success, set to the field delimiter character
+//	header		- On success, set to the header line flag
+//	sample		- On success, set to the type inference sample size
+
+void SqliteCsvVirtualTable::ParseArguments(String^% filename, Char% delimiter, bool% header, int% sample)
+{
+	filename = nullptr;
+	delimiter = Char::MinValue;
+	header = true;
+	sample = DEFAULT_SAMPLE_ROWS;
+	m_index = false;
+
+	for each(String^ argument in Arguments) {
+
+		String^ name = nullptr;
+		String^ value = argument->Trim();
+
+		int equals = value->IndexOf('=');
+		if(equals >= 0) {
+
+			name = value->Substring(0, equals)->Trim()->ToLowerInvariant();
+			value = value->Substring(equals + 1)->Trim();
+		}
+
+		// Values may be enclosed in single or double quotes, in which case any
+		// embedded quotes of the same kind will have been doubled
+
+		if((value->Length >= 2) && ((value[0] == '\'') || (value[0] == '"')) && (value[value->Length - 1] == value[0])) {
+
+			String^ quote = gcnew String(value[0], 1);
+			value = value->Substring(1, value->Length - 2)->Replace(quote + quote, quote);
+		}
+
+		if((name == nullptr) || (name == "filename")) filename = value;
+
+		else if(name == "delimiter") {
+
+			if(String::Compare(value, "tab", StringComparison::OrdinalIgnoreCase) == 0 || (value == "\\t")) delimiter = '\t';
+			else if((value->Length == 1) && (value[0] < 0x80) && (value[0] != '"') && (value[0] != '\r') && (value[0] != '\n')) delimiter = value[0];
+			else throw gcnew ArgumentException(String::Format("The csv delimiter '{0}' is not a single ASCII character", value));
+		}
+
+		else if(name == "header") header = ParseBoolean(name, value);
+		else if(name == "index") m_index = ParseBoolean(name, value);
+
+		else if(name == "sample") {
+
+			if(!Int32::TryParse(value, NumberStyles::None, CultureInfo::InvariantCulture, sample)) 
+				throw gcnew ArgumentException(String::Format("The csv sample size '{0}' is not a valid number of records", value));
+		}
+
+		else throw gcnew ArgumentException(String::Format("Unrecognized csv module argument '{0}'", name));
+	}
+
+	if(String::IsNullOrEmpty(filename)) throw gcnew ArgumentException("The csv module requires a filename argument");
+
+	// Without an explicit delimiter, files with a .tsv or .tab extension are
+	// assumed to be tab-delimited and everything else comma-delimited
+
+	if(delimiter == Char::MinValue) {
+
+		String^ extension = Path::GetExtension(filename);
+		delimiter = ((String::Compare(extension, ".tsv", StringComparison::OrdinalIgnoreCase) == 0) || 
+			(String::Compare(extension, ".tab", StringComparison::OrdinalIgnoreCase) == 0)) ? '\t' : ',';
+	}
+}
+
+//---------------------------------------------------------------------------
+// SqliteCsvVirtualTable::ParseBoolean (private, static)
+//
+// Converts a yes/no style module argument into a boolean
+//
+// Arguments:
+//
+//	name		- Name of the module argument
+//	value		- Value of the module argument
+
+bool SqliteCsvVirtualTable::ParseBoolean(String^ name, String^ value)
+{
+	String^ lower = value->ToLowerInvariant();
+
+	if((lower == "yes") || (lower == "true") || (lower == "on") || (lower == "1")) return true;
+	if((lower == "no") || (lower == "false") || (lower == "off") || (lower == "0")) return false;
+
+	throw gcnew ArgumentException(String::Format("The csv module argument {0} must be yes or no", name));
+}
+
+//---------------------------------------------------------------------------
+// SqliteCsvVirtualTable::Seek (internal)
+//
+// Locates the offset of a record.  If enabled, the sparse record index is
+// built the first time a seek past the first record is performed
+//
+// Arguments:
+//
+//	record		- Record number (ROWID) to be located
+
+size_t SqliteCsvVirtualTable::Seek(__int64 record)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(m_index && (record > 1) && !m_pFile->HasIndex) m_pFile->BuildIndex();
+	return m_pFile->Seek(record);
+}
+
+//---------------------------------------------------------------------------
+// SqliteCsvVirtualTable::SelectBestIndex (protected)
+//
+// Consumes equality and range constraints against the ROWID, which is the
+// record number, and estimates the cost of the resultant scan
+//
+// Arguments:
+//
+//	args		- Index selection arguments
+
+void SqliteCsvVirtualTable::SelectBestIndex(SqliteIndexSelectionArgs^ args)
+{
+	int						equal = -1;			// Equality constraint
+	int						lower = -1;			// Lower bound constraint
+	int						upper = -1;			// Upper bound constraint
+	int						code = 0;			// Selected plan code
+	int						arg = 0;			// Filter argument index
+
+	CHECK_DISPOSED(m_disposed);
+
+	ReadOnlyCollection<SqliteIndexConstraint^>^ constraints = args->Constraints;
+
+	for(int index = 0; index < constraints->Count; index++) {
+
+		SqliteIndexConstraint^ constraint = constraints[index];
+		if((!constraint->IsUsable) || (constraint->ColumnOrdinal != -1)) continue;
+
+		switch(constraint->Operator) {
+
+			case SqliteSearchOperator::Equal:
+				if(equal < 0) equal = index;
+				break;
+
+			case SqliteSearchOperator::GreaterThan:
+			case SqliteSearchOperator::GreaterThanOrEqual:
+				if(lower < 0) lower = index;
+				break;
+
+			case SqliteSearchOperator::LessThan:
+			case SqliteSearchOperator::LessThanOrEqual:
+				if(upper < 0) upper = index;
+				break;
+
+			default: break;
+		}
+	}
+
+	// The constraints are left to be double-checked by the engine, the range
+	// that GetRange() produces doesn't distinguish < from <= or > from >=
+
+	if(equal >= 0) { code = PLAN_EQUAL; constraints[equal]->FilterArgumentIndex = ++arg; }
+	else {
+
+		if(lower >= 0) { code |= PLAN_LOWER; constraints[lower]->FilterArgumentIndex = ++arg; }
+		if(upper >= 0) { code |= PLAN_UPPER; constraints[upper]->FilterArgumentIndex = ++arg; }
+	}
+
+	args->Identifier->Code = code;
+
+	// Records are always produced in ROWID order, so an ORDER BY on just the
+	// ROWID doesn't need to be sorted by the engine
+
+	if((args->SortColumns->Count == 1) && (args->SortColumns[0]->ColumnOrdinal == -1) &&
+		(args->SortColumns[0]->Direction == SqliteSortDirection::Ascending)) args->SortRequired = false;
+
+	Statistics->RowCount = (m_pFile->HasIndex) ? m_pFile->RecordCount : m_estimate;
+	Statistics->EstimateCost(args);
+}
+
+//---------------------------------------------------------------------------
+// SqliteCsvVirtualTable::ToRecord (private, static)
+//
+// Converts a ROWID filter argument into an inclusive record number bound
+//
+// Arguments:
+//
+//	arg			- Filter argument to be converted
+//	lower		- Flag if the argument is a lower bound or an upper bound
+
+__int64 SqliteCsvVirtualTable::ToRecord(SqliteArgument^ arg, bool lower)
+{
+	// A NULL never compares true against anything, so it produces a range
+	// that is guaranteed to be empty regardless of which bound it is
+
+	if(arg->IsNull) return (lower) ? _I64_MAX : 0;
+
+	Object^ argvalue = arg->Value;
+	double value = 0.0;
+
+	// Check the storage class before converting anything; TEXT that looks like
+	// a number is compared as one, but any other TEXT or a BLOB is greater than
+	// every ROWID.  That makes it an empty lower bound and an unbounded upper one
+
+	if(argvalue->GetType() == __int64::typeid) return safe_cast<__int64>(argvalue);
+	else if(argvalue->GetType() == double::typeid) value = safe_cast<double>(argvalue);
+	else if(argvalue->GetType() == String::typeid) {
+
+		if(!Double::TryParse(safe_cast<String^>(argvalue)->Trim(), NumberStyles::Float, CultureInfo::InvariantCulture, value)) 
+			return _I64_MAX;
+	}
+	else return _I64_MAX;
+
+	if(Double::IsNaN(value)) return (lower) ? _I64_MAX : 0;
+
+	value = (lower) ? Math::Ceiling(value) : Math::Floor(value);
+
+	if(value <= 0.0) return 0;
+	if(value >= static_cast<double>(_I64_MAX)) return _I64_MAX;
+
+	return static_cast<__int64>(value);
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
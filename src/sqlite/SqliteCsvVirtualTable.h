@@ -0,0 +1,198 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __SQLITECSVVIRTUALTABLE_H_
+#define __SQLITECSVVIRTUALTABLE_H_
+#pragma once
+
+#include "CsvFile.h"							// Include CsvFile declarations
+#include "SqliteCsvVirtualTableCursor.h"		// Include SqliteCsvVirtualTableCursor decls
+#include "SqliteReadOnlyVirtualTable.h"		// Include SqliteReadOnlyVirtualTable decls
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::ComponentModel;
+using namespace System::Data;
+using namespace System::IO;
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// Class SqliteCsvVirtualTable
+//
+// SqliteCsvVirtualTable is a built-in read-only virtual table that exposes a
+// CSV or TSV file.  The file is memory-mapped and parsed in place as it is 
+// queried, so nothing is staged into the database:
+//
+//	connection.RegisterVirtualTable(typeof(SqliteCsvVirtualTable), "csv");
+//	CREATE VIRTUAL TABLE sales USING csv(filename='sales.csv', index=yes);
+//
+// Module arguments are specified as name=value pairs; a lone value is taken
+// to be the file name:
+//
+//	filename	- Path to the file (required)
+//	delimiter	- Field delimiter character, or 'tab' (default , or tab for .tsv)
+//	header		- First line contains the column names (default yes)
+//	sample		- Number of records examined to infer column types (default 100)
+//	index		- Build a sparse record index for ROWID seeks (default no)
+//
+// The ROWID is the one-based record number, and constraints against it are
+// satisfied by seeking directly to the first record in the range
+//---------------------------------------------------------------------------
+
+public ref class SqliteCsvVirtualTable sealed : public SqliteReadOnlyVirtualTable<SqliteCsvVirtualTableCursor^>
+{
+public:
+
+	// CONSTRUCTOR
+	//
+	// Invoked by the engine in response to CREATE VIRTUAL TABLE
+	SqliteCsvVirtualTable();
+
+protected:
+
+	//-----------------------------------------------------------------------
+	// Protected Member Functions
+
+	// Close (SqliteVirtualTable)
+	//
+	// Invoked when the virtual table is being closed
+	virtual void Close(void) override;
+
+	// CreateCursor (SqliteVirtualTable)
+	//
+	// Creates a new cursor instance used to read data from the virtual table
+	virtual SqliteCsvVirtualTableCursor^ CreateCursor(void) override;
+
+	// GetSchema (SqliteVirtualTable)
+	//
+	// Returns the column names and inferred data types of the file
+	virtual DataTable^ GetSchema(void) override;
+
+	// Open (SqliteVirtualTable)
+	//
+	// Invoked when the virtual table is being opened
+	virtual void Open(void) override {}
+
+	// SelectBestIndex (SqliteVirtualTable)
+	//
+	// Consumes constraints against the ROWID and estimates the cost
+	virtual void SelectBestIndex(SqliteIndexSelectionArgs^ args) override;
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// GetRange
+	//
+	// Converts the filter arguments for an index code into a record range
+	void GetRange(int code, SqliteArgumentCollection^ args, __int64% first, __int64% last);
+
+	// Seek
+	//
+	// Locates the offset of a record, building the sparse index if enabled
+	size_t Seek(__int64 record);
+
+	//-----------------------------------------------------------------------
+	// Internal Properties
+
+	// ColumnTypes
+	//
+	// Gets the inferred SQLITE_xxxx data type of each column
+	property const int* ColumnTypes
+	{
+		const int* get(void);
+	}
+
+	// File
+	//
+	// Gets the mapped file instance
+	property CsvFile* File
+	{
+		CsvFile* get(void);
+	}
+
+private:
+
+	// DESTRUCTOR / FINALIZER
+	~SqliteCsvVirtualTable();
+	!SqliteCsvVirtualTable();
+
+	//-----------------------------------------------------------------------
+	// Private Constants
+
+	// DEFAULT_SAMPLE_ROWS
+	//
+	// Default number of records examined to infer the column data types
+	literal int DEFAULT_SAMPLE_ROWS = 100;
+
+	// PLAN_EQUAL / PLAN_LOWER / PLAN_UPPER
+	//
+	// Index code flags indicating which ROWID constraints were consumed
+	literal int PLAN_EQUAL = 0x01;
+	literal int PLAN_LOWER = 0x02;
+	literal int PLAN_UPPER = 0x04;
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// GetColumnNames
+	//
+	// Generates the column names from the header record, if present
+	array<String^>^ GetColumnNames(bool header);
+
+	// ParseArguments
+	//
+	// Processes the module arguments from CREATE VIRTUAL TABLE
+	void ParseArguments(String^% filename, Char% delimiter, bool% header, int% sample);
+
+	// ParseBoolean (static)
+	//
+	// Converts a yes/no style module argument into a boolean
+	static bool ParseBoolean(String^ name, String^ value);
+
+	// ToRecord (static)
+	//
+	// Converts a ROWID filter argument into a record number
+	static __int64 ToRecord(SqliteArgument^ arg, bool lower);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	bool						m_disposed;			// Object disposal flag
+	CsvFile*					m_pFile;			// Mapped file instance
+	int*						m_pTypes;			// Inferred column data types
+	array<String^>^				m_names;			// Column names
+	bool						m_index;			// Flag to build the record index
+	__int64						m_estimate;			// Estimated number of records
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
+
+#endif		// __SQLITECSVVIRTUALTABLE_H_
@@ -0,0 +1,95 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"							// Include project pre-compiled headers
+#include "SqliteCsvVirtualTableCursor.h"		// Include SqliteCsvVirtualTableCursor decls
+#include "SqliteCsvVirtualTable.h"				// Include SqliteCsvVirtualTable decls
+
+#pragma warning(push, 4)					// Enable maximum compiler warnings
+#pragma warning(disable:4100)				// "unreferenced formal parameter"
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// SqliteCsvVirtualTableCursor Constructor (internal)
+//
+// Arguments:
+//
+//	table		- Parent SqliteCsvVirtualTable instance
+
+SqliteCsvVirtualTableCursor::SqliteCsvVirtualTableCursor(SqliteCsvVirtualTable^ table) : m_table(table)
+{
+	if(table == nullptr) throw gcnew ArgumentNullException("table");
+}
+
+//---------------------------------------------------------------------------
+// SqliteCsvVirtualTableCursor::FillBatch
+//
+// Parses the next block of records into the batch
+//
+// Arguments:
+//
+//	batch		- Row batch to be filled
+
+int SqliteCsvVirtualTableCursor::FillBatch(SqliteRowBatch^ batch)
+{
+	size_t				offset = m_offset;		// Offset of the next record
+	__int64				record = m_record;		// Next record number
+
+	// The rows are written into the unmanaged storage behind the batch; the
+	// managed wrapper isn't needed since nothing is converted along the way
+
+	int count = m_table->File->Fill(Batch, offset, record, m_last, m_table->ColumnTypes);
+
+	m_offset = offset;
+	m_record = record;
+
+	return count;
+}
+
+//---------------------------------------------------------------------------
+// SqliteCsvVirtualTableCursor::SetBatchFilter
+//
+// Positions the cursor at the first record in the selected ROWID range
+//
+// Arguments:
+//
+//	index		- Index identifier from SelectBestIndex()
+//	args		- Filter arguments
+
+void SqliteCsvVirtualTableCursor::SetBatchFilter(SqliteIndexIdentifier^ index, SqliteArgumentCollection^ args)
+{
+	__int64				first;				// First record in the range
+	__int64				last;				// Last record in the range
+
+	m_table->GetRange(index->Code, args, first, last);
+
+	m_record = first;
+	m_last = last;
+	m_offset = (first <= last) ? m_table->Seek(first) : m_table->File->Size;
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
@@ -0,0 +1,93 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __SQLITECSVVIRTUALTABLECURSOR_H_
+#define __SQLITECSVVIRTUALTABLECURSOR_H_
+#pragma once
+
+#include "SqliteBatchVirtualTableCursor.h"		// Include SqliteBatchVirtualTableCursor
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// Forward Class Declarations
+//---------------------------------------------------------------------------
+
+ref class SqliteCsvVirtualTable;				// SqliteCsvVirtualTable.h
+
+//---------------------------------------------------------------------------
+// Class SqliteCsvVirtualTableCursor
+//
+// Batch cursor implementation for SqliteCsvVirtualTable.  Records are parsed
+// directly from the mapped file into the unmanaged row batch, starting at the
+// first record in the ROWID range selected by the filter
+//---------------------------------------------------------------------------
+
+public ref class SqliteCsvVirtualTableCursor sealed : public SqliteBatchVirtualTableCursor
+{
+protected public:
+
+	//-----------------------------------------------------------------------
+	// Protected/Public Member Functions
+
+	// Close (SqliteVirtualTableCursor)
+	//
+	// Invoked when the cursor is being closed
+	virtual void Close(void) override {}
+
+	// FillBatch (SqliteBatchVirtualTableCursor)
+	//
+	// Parses the next block of records into the batch
+	virtual int FillBatch(SqliteRowBatch^ batch) override;
+
+	// SetBatchFilter (SqliteBatchVirtualTableCursor)
+	//
+	// Positions the cursor at the first record in the selected ROWID range
+	virtual void SetBatchFilter(SqliteIndexIdentifier^ index, SqliteArgumentCollection^ args) override;
+
+internal:
+
+	// INTERNAL CONSTRUCTOR
+	SqliteCsvVirtualTableCursor(SqliteCsvVirtualTable^ table);
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	SqliteCsvVirtualTable^		m_table;		// Parent table
+	size_t						m_offset;		// Offset of the next record
+	__int64						m_record;		// Next record number (ROWID)
+	__int64						m_last;			// Last record number in range
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
+
+#endif		// __SQLITECSVVIRTUALTABLECURSOR_H_
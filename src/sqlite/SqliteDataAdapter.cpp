@@ -22,6 +22,7 @@
 
 #include "stdafx.h"					// Include project pre-compiled headers
 #include "SqliteDataAdapter.h"			// Include SqliteDataAdapter declarations
+#include "SqliteTransaction.h"			// Include SqliteTransaction declarations
 
 #pragma warning(push, 4)			// Enable maximum compiler warnings
 
@@ -34,7 +35,7 @@ namespace zuki::data::sqlite {
 //
 //	NONE
 
-SqliteDataAdapter::SqliteDataAdapter()
+SqliteDataAdapter::SqliteDataAdapter() : m_batchSize(1)
 {
 	Disposed += gcnew EventHandler(this, &SqliteDataAdapter::OnDispose);
 }
@@ -46,7 +47,7 @@ SqliteDataAdapter::SqliteDataAdapter()
 //
 //	command		- SqliteCommand instance to apply to SelectCommand
 
-SqliteDataAdapter::SqliteDataAdapter(SqliteCommand^ command)
+SqliteDataAdapter::SqliteDataAdapter(SqliteCommand^ command) : m_batchSize(1)
 {
 	Disposed += gcnew EventHandler(this, &SqliteDataAdapter::OnDispose);
 	SelectCommand = command;
@@ -60,7 +61,7 @@ SqliteDataAdapter::SqliteDataAdapter(SqliteCommand^ command)
 //	commandText		- SQL command to initialize SelectCommand with
 //	connection		- SqliteConnection instance to use
 
-SqliteDataAdapter::SqliteDataAdapter(String^ commandText, SqliteConnection^ connection)
+SqliteDataAdapter::SqliteDataAdapter(String^ commandText, SqliteConnection^ connection) : m_batchSize(1)
 {
 	Disposed += gcnew EventHandler(this, &SqliteDataAdapter::OnDispose);
 	SelectCommand = gcnew SqliteCommand(commandText, connection);
@@ -74,12 +75,86 @@ SqliteDataAdapter::SqliteDataAdapter(String^ commandText, SqliteConnection^ conn
 //	commandText			- SQL command to initialize SelectCommand with
 //	connectionString	- Connection string to initialize SelectCommand with
 
-SqliteDataAdapter::SqliteDataAdapter(String^ commandText, String^ connectionString)
+SqliteDataAdapter::SqliteDataAdapter(String^ commandText, String^ connectionString) : m_batchSize(1)
 {
 	Disposed += gcnew EventHandler(this, &SqliteDataAdapter::OnDispose);
 	SelectCommand = gcnew SqliteCommand(commandText, gcnew SqliteConnection(connectionString));
 }
 
+//---------------------------------------------------------------------------
+// SqliteDataAdapter::AddToBatch (protected)
+//
+// Adds a command to the current batch.  The same command object is reused by
+// Update() for every row, so the current parameter values must be captured
+//
+// Arguments:
+//
+//	command		- Command object to be added to the batch
+
+int SqliteDataAdapter::AddToBatch(IDbCommand^ command)
+{
+	SqliteCommand^				sqlcommand;			// Provider command object
+	array<Object^>^				values;				// Parameter values
+
+	CHECK_DISPOSED(m_disposed);
+	if(command == nullptr) throw gcnew ArgumentNullException("command");
+	if(m_batch == nullptr) throw gcnew InvalidOperationException();
+
+	sqlcommand = safe_cast<SqliteCommand^>(command);
+	values = gcnew array<Object^>(sqlcommand->Parameters->Count);
+
+	for(int index = 0; index < values->Length; index++) 
+		values[index] = sqlcommand->Parameters[index]->Value;
+
+	m_batch->Add(gcnew BatchCommand(sqlcommand, values));
+	return m_batch->Count - 1;
+}
+
+//---------------------------------------------------------------------------
+// SqliteDataAdapter::CanFastFill (private)
+//
+// Determines if a Fill operation can be handled directly by this class rather
+// than going through the generic DbDataAdapter implementation, which builds a
+// schema table for every result set and looks up the field metadata for every
+// single value it loads.  Anything that involves table/column mappings, key
+// information or provider-specific types is still left to the base class
+//
+// Arguments:
+//
+//	dataReader		- Data reader that will be used for the Fill operation
+
+bool SqliteDataAdapter::CanFastFill(IDataReader^ dataReader)
+{
+	if(dynamic_cast<SqliteDataReader^>(dataReader) == nullptr) return false;
+	if(dataReader->IsClosed) return false;
+
+	if(TableMappings->Count > 0) return false;
+	if(MissingMappingAction != System::Data::MissingMappingAction::Passthrough) return false;
+	if(ReturnProviderSpecificTypes) return false;
+
+	// MissingSchemaAction::AddWithKey requires the schema table for the key
+	// information, and MissingSchemaAction::Error has specific exception
+	// semantics that are best left to the framework to get right
+
+	return ((MissingSchemaAction == System::Data::MissingSchemaAction::Add) ||
+		(MissingSchemaAction == System::Data::MissingSchemaAction::Ignore));
+}
+
+//---------------------------------------------------------------------------
+// SqliteDataAdapter::ClearBatch (protected)
+//
+// Removes all commands from the current batch
+//
+// Arguments:
+//
+//	NONE
+
+void SqliteDataAdapter::ClearBatch(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	if(m_batch != nullptr) m_batch->Clear();
+}
+
 //---------------------------------------------------------------------------
 // SqliteDataAdapter::DeleteCommand::get
 //
@@ -102,6 +177,425 @@ void SqliteDataAdapter::DeleteCommand::set(SqliteCommand^ value)
 	m_delete = value;
 }
 
+//---------------------------------------------------------------------------
+// SqliteDataAdapter::ExecuteBatch (protected)
+//
+// Executes all of the commands in the current batch.  Each command is only
+// prepared once, and the whole batch runs inside a single transaction unless
+// the application already has one open on the connection.  If a failed command
+// caused the engine to roll back a transaction on it's own, the rest of the
+// batch is failed and nothing is committed
+//
+// Arguments:
+//
+//	NONE
+
+int SqliteDataAdapter::ExecuteBatch(void)
+{
+	List<SqliteTransaction^>^	transactions;		// Transactions started here
+	HashSet<SqliteCommand^>^	commands;			// Commands already set up
+	int							rows = 0;			// Total records affected
+	bool						rolledback = false;	// Flag if work was lost
+
+	CHECK_DISPOSED(m_disposed);
+	if(m_batch == nullptr) throw gcnew InvalidOperationException();
+
+	transactions = gcnew List<SqliteTransaction^>();
+	commands = gcnew HashSet<SqliteCommand^>();
+
+	try {
+
+		for(int batchIndex = 0; (batchIndex < m_batch->Count) && (!rolledback); batchIndex++) {
+
+			BatchCommand^ entry = m_batch[batchIndex];
+			SqliteCommand^ command = entry->Command;
+
+			// The first time a command shows up in the batch, start a transaction on
+			// it's connection as necessary and make sure it's been prepared.  Commands
+			// prepared here stay that way for any subsequent batches, and are put back
+			// the way they were found by TerminateBatching()
+
+			if(commands->Add(command)) {
+
+				SqliteUtil::CheckConnectionReady(command->Connection);
+
+				if(!command->Connection->InTransaction) transactions->Add(command->Connection->BeginTransaction());
+				if(!command->IsPrepared) { command->Prepare(); m_prepared->Add(command); }
+			}
+
+			// Put back the parameter values captured when the command was added to
+			// the batch, and execute it.  Errors are only reported on a per-command
+			// basis if the adapter is set up to continue on errors
+
+			for(int index = 0; index < entry->Values->Length; index++)
+				command->Parameters[index]->Value = entry->Values[index];
+
+			try { entry->RecordsAffected = command->ExecuteNonQuery(); rows += entry->RecordsAffected; }
+			
+			catch(Exception^ ex) { 
+				
+				if(!ContinueUpdateOnError) throw; 
+				entry->Error = ex; 
+
+				// Some errors (ON CONFLICT ROLLBACK, SQLITE_FULL, etc) make the engine
+				// roll back the whole transaction.  The work done so far is gone and
+				// anything else would run in autocommit mode, so stop right here and
+				// fail every other row in the batch that hasn't already failed
+
+				if(!command->Connection->InTransaction) {
+
+					for each(BatchCommand^ other in m_batch) {
+
+						if((other == entry) || (other->Error != nullptr)) continue;
+
+						rows -= other->RecordsAffected;
+						other->RecordsAffected = 0;
+						other->Error = gcnew SqliteExceptions::TransactionRolledBackException(ex);
+					}
+
+					rolledback = true;
+				}
+			}
+		}
+
+		if(!rolledback) for each(SqliteTransaction^ trans in transactions) trans->Commit();
+	}
+
+	// Any transactions that were not committed above get rolled back on disposal,
+	// including when the batch was stopped by an engine rollback
+
+	finally { for each(SqliteTransaction^ trans in transactions) delete trans; }
+
+	return rows;
+}
+
+//---------------------------------------------------------------------------
+// SqliteDataAdapter::Fill (protected)
+//
+// Fills a DataSet with the result sets from a data reader.  The first result
+// set is loaded into srcTable, subsequent ones into srcTable1, srcTable2, etc.
+// As with the framework, only the rows from the first result set are counted
+//
+// Arguments:
+//
+//	dataSet			- DataSet to be filled
+//	srcTable		- Name of the source table to use for table mapping
+//	dataReader		- Data reader to be used for the operation
+//	startRecord		- Zero-based record number to start with
+//	maxRecords		- Maximum number of records to retrieve, or zero for all
+
+int SqliteDataAdapter::Fill(DataSet^ dataSet, String^ srcTable, IDataReader^ dataReader, 
+	int startRecord, int maxRecords)
+{
+	SqliteDataReader^			reader;				// Provider data reader
+	int							results = 0;		// Number of result sets
+	int							rows = 0;			// Number of rows loaded
+
+	CHECK_DISPOSED(m_disposed);
+
+	// Argument validation and record ranges are left to the base class, as is
+	// anything else that the adapter configuration doesn't allow us to handle
+
+	if((dataSet == nullptr) || String::IsNullOrEmpty(srcTable) || (startRecord != 0) || (maxRecords != 0) ||
+		!CanFastFill(dataReader)) return DbDataAdapter::Fill(dataSet, srcTable, dataReader, startRecord, maxRecords);
+
+	reader = safe_cast<SqliteDataReader^>(dataReader);
+
+	do {
+
+		if(reader->FieldCount == 0) continue;
+
+		// Without any table mappings, the DataSet table name is the source table
+		// name with the result set index appended to it after the first one
+
+		String^ name = (results == 0) ? srcTable : srcTable + results.ToString();
+		results++;
+
+		DataTable^ table = dataSet->Tables[name];
+		if(table == nullptr) {
+
+			if(MissingSchemaAction == System::Data::MissingSchemaAction::Ignore) continue;
+			table = dataSet->Tables->Add(name);
+		}
+
+		int count = FillTable(table, reader, 0, 0);
+		if(results == 1) rows = count;
+
+	} while(reader->NextResult());
+
+	return rows;
+}
+
+//---------------------------------------------------------------------------
+// SqliteDataAdapter::Fill (protected)
+//
+// Fills an array of DataTables with the result sets from a data reader; each
+// result set is loaded into the next DataTable in the array.  Result sets that
+// have no fields don't use up a DataTable, and as with the framework only the
+// rows loaded into the first DataTable are counted
+//
+// Arguments:
+//
+//	dataTables		- Array of DataTables to be filled
+//	dataReader		- Data reader to be used for the operation
+//	startRecord		- Zero-based record number to start with
+//	maxRecords		- Maximum number of records to retrieve, or zero for all
+
+int SqliteDataAdapter::Fill(array<DataTable^>^ dataTables, IDataReader^ dataReader, 
+	int startRecord, int maxRecords)
+{
+	SqliteDataReader^			reader;				// Provider data reader
+	int							index = 0;			// Next DataTable to fill
+	int							rows = 0;			// Number of rows loaded
+
+	CHECK_DISPOSED(m_disposed);
+
+	// Argument validation is left to the base class; a record range is only
+	// allowed by the framework when a single DataTable is being filled
+
+	if((dataTables == nullptr) || (dataTables->Length == 0) || (startRecord < 0) || (maxRecords < 0) ||
+		((dataTables->Length > 1) && ((startRecord != 0) || (maxRecords != 0))) || !CanFastFill(dataReader))
+		return DbDataAdapter::Fill(dataTables, dataReader, startRecord, maxRecords);
+
+	for each(DataTable^ table in dataTables) if(table == nullptr) throw gcnew ArgumentNullException("dataTables");
+
+	reader = safe_cast<SqliteDataReader^>(dataReader);
+
+	do {
+
+		if(reader->FieldCount == 0) continue;
+
+		int count = FillTable(dataTables[index], reader, startRecord, maxRecords);
+		if(index++ == 0) rows = count;
+
+	} while((index < dataTables->Length) && reader->NextResult());
+
+	return rows;
+}
+
+//---------------------------------------------------------------------------
+// SqliteDataAdapter::FillTable (private)
+//
+// Loads the current result set of a data reader into a DataTable.  The columns
+// are matched up (or created) once from the cached statement metadata, and the
+// rows are loaded with the field types resolved up front
+//
+// Arguments:
+//
+//	dataTable		- DataTable to be loaded
+//	reader			- Data reader positioned on the result set to load
+//	startRecord		- Zero-based record number to start with
+//	maxRecords		- Maximum number of records to retrieve, or zero for all
+
+int SqliteDataAdapter::FillTable(DataTable^ dataTable, SqliteDataReader^ reader, int startRecord, int maxRecords)
+{
+	int							fields;				// Number of result set fields
+	array<String^>^				names;				// Unique field names
+	array<int>^					positions;			// DataColumn ordinal per field
+	array<Type^>^				types;				// Field data types
+	array<Object^>^				values;				// Row values
+	bool						matched = false;	// Flag if any field has a column
+	int							rows = 0;			// Number of rows loaded
+
+	fields = reader->FieldCount;
+	if(fields == 0) return 0;
+
+	names = GenerateFieldNames(reader);
+	positions = gcnew array<int>(fields);
+	types = gcnew array<Type^>(fields);
+
+	// Match each field up with a DataColumn, adding any missing ones to the table
+
+	for(int index = 0; index < fields; index++) {
+
+		types[index] = reader->GetFieldType(index);
+
+		DataColumn^ column = dataTable->Columns[names[index]];
+		if(column == nullptr) {
+
+			if(MissingSchemaAction == System::Data::MissingSchemaAction::Ignore) { positions[index] = -1; continue; }
+			column = dataTable->Columns->Add(names[index], types[index]);
+		}
+
+		positions[index] = column->Ordinal;
+		matched = true;
+	}
+
+	// The framework doesn't load anything when none of the fields were matched
+	// up with a column, rather than adding rows that are nothing but defaults
+
+	if(!matched) return 0;
+
+	// Skip over the requested number of rows before loading anything
+
+	for(int index = 0; index < startRecord; index++) if(!reader->Read()) return 0;
+
+	// Load the rows.  Any columns not present in the result set are left as null
+	// in the values array, which causes LoadDataRow to apply the column default
+
+	values = gcnew array<Object^>(dataTable->Columns->Count);
+	bool useLoadOption = ShouldSerializeFillLoadOption();
+
+	dataTable->BeginLoadData();
+
+	try {
+
+		while(((maxRecords == 0) || (rows < maxRecords)) && reader->Read()) {
+
+			try {
+
+				reader->GetValues(values, positions, types);
+
+				if(useLoadOption) dataTable->LoadDataRow(values, FillLoadOption);
+				else dataTable->LoadDataRow(values, AcceptChangesDuringFill);
+
+				rows++;
+			}
+
+			catch(Exception^ ex) {
+
+				// Give the FillError event a chance to allow the operation to
+				// continue; without any handlers this always rethrows
+
+				FillErrorEventArgs^ args = gcnew FillErrorEventArgs(dataTable, values);
+				args->Errors = ex;
+				OnFillError(args);
+				if(!args->Continue) throw;
+			}
+		}
+	}
+
+	finally { dataTable->EndLoadData(); }
+
+	return rows;
+}
+
+//---------------------------------------------------------------------------
+// SqliteDataAdapter::GenerateFieldNames (private, static)
+//
+// Generates the names used to match result set fields with DataColumns, the
+// same way the framework does it.  The first use of a name is kept as is, and
+// any later duplicates (compared without regard to case) have an increasing
+// number appended until they are unique.  Unnamed fields become Column1,
+// Column2, etc.
+//
+// Arguments:
+//
+//	reader			- Data reader positioned on the result set
+
+array<String^>^ SqliteDataAdapter::GenerateFieldNames(SqliteDataReader^ reader)
+{
+	array<String^>^					names;			// Generated field names
+	Dictionary<String^, int>^		lookup;			// Lower case name -> ordinal
+	int								first;			// First name to be adjusted
+	int								unnamed = 1;	// Next unnamed field suffix
+
+	names = gcnew array<String^>(reader->FieldCount);
+	lookup = gcnew Dictionary<String^, int>(names->Length);
+	first = names->Length;
+
+	// Work backwards so that the lookup ends up with the first use of each name,
+	// while keeping track of the first field that will need a different name
+
+	for(int index = names->Length - 1; index >= 0; index--) {
+
+		int existing;
+
+		names[index] = reader->GetName(index);
+		if(String::IsNullOrEmpty(names[index])) { names[index] = String::Empty; first = index; continue; }
+
+		String^ lower = names[index]->ToLower(CultureInfo::InvariantCulture);
+		if(lookup->TryGetValue(lower, existing)) first = Math::Min(first, existing);
+		lookup[lower] = index;
+	}
+
+	for(int index = first; index < names->Length; index++) {
+
+		bool isUnnamed = (names[index]->Length == 0);
+
+		// Named fields that are the first use of their name are left alone
+
+		if(!isUnnamed && (lookup[names[index]->ToLower(CultureInfo::InvariantCulture)] == index)) continue;
+
+		String^ basename = (isUnnamed) ? "Column" : names[index];
+		int suffix = (isUnnamed) ? unnamed : 1;
+
+		while(lookup->ContainsKey((basename + suffix.ToString(CultureInfo::InvariantCulture))->ToLower(CultureInfo::InvariantCulture))) suffix++;
+
+		names[index] = basename + suffix.ToString(CultureInfo::InvariantCulture);
+		lookup->Add(names[index]->ToLower(CultureInfo::InvariantCulture), index);
+
+		if(isUnnamed) unnamed = suffix;
+	}
+
+	return names;
+}
+
+//---------------------------------------------------------------------------
+// SqliteDataAdapter::GetBatchedParameter (protected)
+//
+// Returns a parameter from one of the commands in the current batch.  The
+// command's own parameters hold the values of whichever row was executed last,
+// so a detached copy is built with the values captured by AddToBatch()
+//
+// Arguments:
+//
+//	commandIdentifier	- Identifier returned from AddToBatch()
+//	parameterIndex		- Index of the parameter within the command
+
+IDataParameter^ SqliteDataAdapter::GetBatchedParameter(int commandIdentifier, int parameterIndex)
+{
+	CHECK_DISPOSED(m_disposed);
+	if(m_batch == nullptr) throw gcnew InvalidOperationException();
+
+	BatchCommand^ entry = m_batch[commandIdentifier];
+	if((parameterIndex < 0) || (parameterIndex >= entry->Values->Length)) throw gcnew ArgumentOutOfRangeException("parameterIndex");
+
+	SqliteParameter^ param = entry->Command->Parameters[parameterIndex];
+
+	return gcnew SqliteParameter(param->ParameterName, param->DbType, param->Size, param->IsNullable, param->SourceColumn, 
+		param->SourceVersion, entry->Values[parameterIndex]);
+}
+
+//---------------------------------------------------------------------------
+// SqliteDataAdapter::GetBatchedRecordsAffected (protected)
+//
+// Returns the result of executing one of the commands in the current batch
+//
+// Arguments:
+//
+//	commandIdentifier	- Identifier returned from AddToBatch()
+//	recordsAffected		- On success, set to the number of rows affected
+//	error				- On success, set to any error the command generated
+
+bool SqliteDataAdapter::GetBatchedRecordsAffected(int commandIdentifier, int% recordsAffected, Exception^% error)
+{
+	CHECK_DISPOSED(m_disposed);
+	if(m_batch == nullptr) throw gcnew InvalidOperationException();
+
+	recordsAffected = m_batch[commandIdentifier]->RecordsAffected;
+	error = m_batch[commandIdentifier]->Error;
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+// SqliteDataAdapter::InitializeBatching (protected)
+//
+// Initializes the batching state at the start of an Update() operation
+//
+// Arguments:
+//
+//	NONE
+
+void SqliteDataAdapter::InitializeBatching(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	m_batch = gcnew List<BatchCommand^>();
+	m_prepared = gcnew HashSet<SqliteCommand^>();
+}
+
 //---------------------------------------------------------------------------
 // SqliteDataAdapter::InsertCommand::get
 //
@@ -146,6 +640,50 @@ void SqliteDataAdapter::SelectCommand::set(SqliteCommand^ value)
 	m_select = value;
 }
 
+//---------------------------------------------------------------------------
+// SqliteDataAdapter::TerminateBatching (protected)
+//
+// Releases the batching state at the end of an Update() operation, which
+// includes undoing any Prepare() calls made by ExecuteBatch()
+//
+// Arguments:
+//
+//	NONE
+
+void SqliteDataAdapter::TerminateBatching(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(m_prepared != nullptr) for each(SqliteCommand^ command in m_prepared) command->Unprepare();
+
+	m_batch = nullptr;
+	m_prepared = nullptr;
+}
+
+//---------------------------------------------------------------------------
+// SqliteDataAdapter::UpdateBatchSize::get
+//
+// Gets the number of rows processed in each batch by Update()
+
+int SqliteDataAdapter::UpdateBatchSize::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_batchSize;
+}
+
+//---------------------------------------------------------------------------
+// SqliteDataAdapter::UpdateBatchSize::set
+//
+// Sets the number of rows processed in each batch by Update()
+
+void SqliteDataAdapter::UpdateBatchSize::set(int value)
+{
+	CHECK_DISPOSED(m_disposed);
+	if(value < 0) throw gcnew ArgumentOutOfRangeException("value");
+
+	m_batchSize = value;
+}
+
 //---------------------------------------------------------------------------
 // SqliteDataAdapter::UpdateCommand::get
 //
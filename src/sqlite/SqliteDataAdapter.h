@@ -26,6 +26,7 @@
 
 #include "SqliteCommand.h"					// Include SqliteCommand declarations
 #include "SqliteConnection.h"				// Include SqliteConnection declarations
+#include "SqliteDataReader.h"				// Include SqliteDataReader declarations
 #include "SqliteDelegates.h"				// Include Sqlite delegate decls
 #include "SqliteEnumerations.h"			// Include Sqlite enumeration decls
 #include "SqliteEventArgs.h"				// Include Sqlite eventarg declarations
@@ -34,8 +35,11 @@
 #pragma warning(disable:4100)			// "unreferenced formal parameter"
 
 using namespace System;
+using namespace System::Collections::Generic;
 using namespace System::Data;
 using namespace System::Data::Common;
+using namespace System::Globalization;
+using namespace System::Runtime::InteropServices;
 
 namespace zuki::data::sqlite {
 
@@ -101,6 +105,18 @@ public:
 		void set(SqliteCommand^ value);
 	}
 
+	// UpdateBatchSize (DbDataAdapter)
+	//
+	// Gets or sets the number of rows processed in each batch by Update(); a
+	// value of zero places all of the changed rows into a single batch.  Any
+	// commands that are prepared to execute the batches are only prepared for
+	// the duration of the Update() operation
+	virtual property int UpdateBatchSize
+	{
+		int get(void) override;
+		void set(int value) override;
+	}
+
 	// UpdateCommand
 	//
 	// Gets or sets the UPDATE command object instance
@@ -115,6 +131,16 @@ protected:
 	//-----------------------------------------------------------------------
 	// Protected Member Functions
 
+	// AddToBatch (DbDataAdapter)
+	//
+	// Adds a command, with the current values of it's parameters, to the batch
+	virtual int AddToBatch(IDbCommand^ command) override;
+
+	// ClearBatch (DbDataAdapter)
+	//
+	// Removes all commands from the batch
+	virtual void ClearBatch(void) override;
+
 	// CreateRowUpdatedEvent (DbDataAdapter)
 	//
 	// Generates a provider-specific instance of RowUpdatedEventArgs
@@ -133,6 +159,41 @@ protected:
 		return gcnew SqliteRowUpdatingEventArgs(row, cmd, type, mapping); 
 	}
 
+	// ExecuteBatch (DbDataAdapter)
+	//
+	// Executes all of the commands in the batch within a transaction
+	virtual int ExecuteBatch(void) override;
+
+	// Fill (DataAdapter)
+	//
+	// Fills a DataSet from a data reader, bypassing the generic implementation
+	// whenever the adapter configuration allows it
+	virtual int Fill(DataSet^ dataSet, String^ srcTable, IDataReader^ dataReader, 
+		int startRecord, int maxRecords) override;
+
+	// Fill (DataAdapter)
+	//
+	// Fills an array of DataTables from a data reader, bypassing the generic
+	// implementation whenever the adapter configuration allows it
+	virtual int Fill(array<DataTable^>^ dataTables, IDataReader^ dataReader, 
+		int startRecord, int maxRecords) override;
+
+	// GetBatchedParameter (DbDataAdapter)
+	//
+	// Returns a parameter from one of the commands in the batch
+	virtual IDataParameter^ GetBatchedParameter(int commandIdentifier, int parameterIndex) override;
+
+	// GetBatchedRecordsAffected (DbDataAdapter)
+	//
+	// Returns the result of executing one of the commands in the batch
+	virtual bool GetBatchedRecordsAffected(int commandIdentifier, [Out] int% recordsAffected,
+		[Out] Exception^% error) override;
+
+	// InitializeBatching (DbDataAdapter)
+	//
+	// Initializes the batching state for an Update() operation
+	virtual void InitializeBatching(void) override;
+
 	// OnRowUpdated
 	//
 	// Implements the specific version of this event
@@ -149,11 +210,51 @@ protected:
 		RowUpdating(this, safe_cast<SqliteRowUpdatingEventArgs^>(value));
 	}
 
+	// TerminateBatching (DbDataAdapter)
+	//
+	// Releases the batching state at the end of an Update() operation
+	virtual void TerminateBatching(void) override;
+
 private:
 
+	//-----------------------------------------------------------------------
+	// Private Data Types
+
+	// BatchCommand
+	//
+	// Describes a single command added to the batch, along with a copy of
+	// the parameter values at the time it was added and it's results
+	ref class BatchCommand sealed
+	{
+	public:
+
+		BatchCommand(SqliteCommand^ command, array<Object^>^ values) : 
+			Command(command), Values(values) {}
+
+		initonly SqliteCommand^			Command;			// Batched command
+		initonly array<Object^>^		Values;				// Parameter values
+		int								RecordsAffected;	// Execution result
+		Exception^						Error;				// Execution error
+	};
+
 	//-----------------------------------------------------------------------
 	// Private Member Functions
 
+	// CanFastFill
+	//
+	// Determines if a Fill operation can skip the generic DbDataAdapter code
+	bool CanFastFill(IDataReader^ dataReader);
+
+	// FillTable
+	//
+	// Loads the current result set of a data reader into a DataTable
+	int FillTable(DataTable^ dataTable, SqliteDataReader^ reader, int startRecord, int maxRecords);
+
+	// GenerateFieldNames
+	//
+	// Generates unique names for the fields of a result set
+	static array<String^>^ GenerateFieldNames(SqliteDataReader^ reader);
+
 	// OnDispose
 	//
 	// Event handler for the base class's Dispose event
@@ -218,6 +319,9 @@ private:
 	SqliteCommand^				m_insert;			// Contained INSERT command
 	SqliteCommand^				m_select;			// Contained SELECT command
 	SqliteCommand^				m_update;			// Contained UPDATE command
+	int						m_batchSize;		// Update batch size
+	List<BatchCommand^>^		m_batch;			// Current command batch
+	HashSet<SqliteCommand^>^	m_prepared;			// Commands prepared for batches
 };
 
 //---------------------------------------------------------------------------
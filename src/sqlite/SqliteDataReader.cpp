@@ -41,6 +41,8 @@ namespace zuki::data::sqlite {
 SqliteDataReader::SqliteDataReader(SqliteCommand^ command, SqliteQuery^ query, SqliteCommandBehavior behavior) 
 	: m_behavior(behavior), m_query(query), m_disposeQuery(false)
 {
+	m_sequential = IsCommandBehavior(SqliteCommandBehavior::SequentialAccess);
+
 	Debug::Assert(command != nullptr);				// Should never be NULL
 	Debug::Assert(m_query != nullptr);				// Should never be NULL
 
@@ -53,6 +55,7 @@ SqliteDataReader::SqliteDataReader(SqliteCommand^ command, SqliteQuery^ query, S
 
 		m_conn = command->Connection;
 		m_params = command->Parameters;
+		m_command = command;
 
 		SqliteUtil::CheckConnectionOpen(m_conn);			// Check connection status
 		m_cookie = m_conn->RegisterDataReader(this);	// Register this data reader
@@ -76,6 +79,8 @@ SqliteDataReader::SqliteDataReader(SqliteCommand^ command, SqliteQuery^ query, S
 SqliteDataReader::SqliteDataReader(SqliteCommand^ command, String^ query, SqliteCommandBehavior behavior) : 
 	m_behavior(behavior), m_disposeQuery(true)
 {
+	m_sequential = IsCommandBehavior(SqliteCommandBehavior::SequentialAccess);
+
 	Debug::Assert(command != nullptr);
 
 	try {
@@ -87,6 +92,7 @@ SqliteDataReader::SqliteDataReader(SqliteCommand^ command, String^ query, Sqlite
 
 		m_conn = command->Connection;
 		m_params = command->Parameters;
+		m_command = command;
 
 		SqliteUtil::CheckConnectionOpen(m_conn);			// Check connection status
 		m_cookie = m_conn->RegisterDataReader(this);	// Register with the connection
@@ -95,7 +101,7 @@ SqliteDataReader::SqliteDataReader(SqliteCommand^ command, String^ query, Sqlite
 		// We need to create a new query object based on the SQL command, since it was
 		// not prepared in advance on our behalf by the SqliteCommand object instance
 
-		m_query = gcnew SqliteQuery(m_conn->HandlePointer, query);
+		m_query = gcnew SqliteQuery(m_conn->HandlePointer, query, false, command->LazyPrepare);
 
 		NextResult();									// Move to first result set
 	}
@@ -109,6 +115,7 @@ SqliteDataReader::SqliteDataReader(SqliteCommand^ command, String^ query, Sqlite
 SqliteDataReader::~SqliteDataReader()
 {
 	if(m_stmt != nullptr) m_stmt->Reset();	// Reset statement as necessary
+	CompleteStatistics();					// Include the final statement
 
 	// If the SqliteCommand object was not pre-compiled, the m_query object is
 	// something that we compiled in the constructor, and it must be released
@@ -121,6 +128,7 @@ SqliteDataReader::~SqliteDataReader()
 
 	try { 
 	
+		m_command->AddStatistics(m_stats);
 		m_conn->UnRegisterDataReader(m_cookie);
 		if(IsCommandBehavior(SqliteCommandBehavior::CloseConnection)) m_conn->Close(); 
 	}
@@ -166,6 +174,41 @@ Object^ SqliteDataReader::default::get(String^ name)
 	return GetValue(GetOrdinal(name));
 }
 
+//---------------------------------------------------------------------------
+// SqliteDataReader::CompleteStatistics (private)
+//
+// Accumulates the counter activity of the current statement once it has been
+// executed and reset; the RUN counter is only updated by the reset
+//
+// Arguments:
+//
+//	NONE
+
+void SqliteDataReader::CompleteStatistics(void)
+{
+	if(m_stmt == nullptr) return;
+	m_stats = m_stats + SqliteStatementStatistics::Difference(m_stmt->Statistics, m_baseline);
+}
+
+//---------------------------------------------------------------------------
+// SqliteDataReader::CheckSequentialAccess (private)
+//
+// Verifies that a column can be read when the reader was created with the
+// SequentialAccess behavior; columns may only be read in increasing order,
+// although the same column can be read more than once (GetBytes/GetChars)
+//
+// Arguments:
+//
+//	ordinal			- Ordinal of the column about to be read
+
+void SqliteDataReader::CheckSequentialAccess(int ordinal)
+{
+	if(!m_sequential) return;
+
+	if(ordinal < m_column) throw gcnew SqliteExceptions::SequentialAccessException(ordinal, m_column);
+	m_column = ordinal;
+}
+
 //---------------------------------------------------------------------------
 // SqliteDataReader::CheckStatementStatus (private, static)
 //
@@ -221,6 +264,7 @@ bool SqliteDataReader::GetBoolean(int ordinal)
 	CHECK_DISPOSED(m_disposed);
 	SqliteUtil::CheckDataRecordOrdinal(this, ordinal);
 	CheckStatementStatus(m_stmt);
+	CheckSequentialAccess(ordinal);
 
 	return m_stmt->GetBoolean(ordinal);
 }
@@ -242,6 +286,11 @@ SqliteBinaryReader^ SqliteDataReader::GetBinaryReader(int ordinal)
 	SqliteUtil::CheckDataRecordOrdinal(this, ordinal);
 	CheckStatementStatus(m_stmt);
 
+	// SqliteBinaryReader supports random access into the value and keeps the
+	// row alive for its lifetime, neither of which fits SequentialAccess
+
+	if(m_sequential) throw gcnew SqliteExceptions::SequentialAccessException("GetBinaryReader");
+
 	return m_stmt->GetBinaryReader(ordinal);
 }
 
@@ -259,6 +308,7 @@ System::Byte SqliteDataReader::GetByte(int ordinal)
 	CHECK_DISPOSED(m_disposed);
 	SqliteUtil::CheckDataRecordOrdinal(this, ordinal);
 	CheckStatementStatus(m_stmt);
+	CheckSequentialAccess(ordinal);
 
 	return m_stmt->GetByte(ordinal);
 }
@@ -282,6 +332,7 @@ __int64 SqliteDataReader::GetBytes(int ordinal, __int64 fieldOffset, array<Syste
 	CHECK_DISPOSED(m_disposed);
 	SqliteUtil::CheckDataRecordOrdinal(this, ordinal);
 	CheckStatementStatus(m_stmt);
+	CheckSequentialAccess(ordinal);
 
 	// Just call through to the IDataRecord implementation of the statement object
 
@@ -302,6 +353,7 @@ __wchar_t SqliteDataReader::GetChar(int ordinal)
 	CHECK_DISPOSED(m_disposed);
 	SqliteUtil::CheckDataRecordOrdinal(this, ordinal);
 	CheckStatementStatus(m_stmt);
+	CheckSequentialAccess(ordinal);
 
 	return m_stmt->GetChar(ordinal);
 }
@@ -325,6 +377,7 @@ __int64 SqliteDataReader::GetChars(int ordinal, __int64 fieldOffset, array<Char>
 	CHECK_DISPOSED(m_disposed);
 	SqliteUtil::CheckDataRecordOrdinal(this, ordinal);
 	CheckStatementStatus(m_stmt);
+	CheckSequentialAccess(ordinal);
 
 	return m_stmt->GetChars(ordinal, fieldOffset, buffer, bufferOffset, count);
 }
@@ -361,6 +414,7 @@ DateTime SqliteDataReader::GetDateTime(int ordinal)
 	CHECK_DISPOSED(m_disposed);
 	SqliteUtil::CheckDataRecordOrdinal(this, ordinal);
 	CheckStatementStatus(m_stmt);
+	CheckSequentialAccess(ordinal);
 
 	return m_stmt->GetDateTime(ordinal);
 }
@@ -379,6 +433,7 @@ Decimal SqliteDataReader::GetDecimal(int ordinal)
 	CHECK_DISPOSED(m_disposed);
 	SqliteUtil::CheckDataRecordOrdinal(this, ordinal);
 	CheckStatementStatus(m_stmt);
+	CheckSequentialAccess(ordinal);
 
 	return m_stmt->GetDecimal(ordinal);
 }
@@ -398,6 +453,7 @@ double SqliteDataReader::GetDouble(int ordinal)
 	CHECK_DISPOSED(m_disposed);
 	SqliteUtil::CheckDataRecordOrdinal(this, ordinal);
 	CheckStatementStatus(m_stmt);
+	CheckSequentialAccess(ordinal);
 
 	return m_stmt->GetDouble(ordinal);
 }
@@ -450,6 +506,7 @@ float SqliteDataReader::GetFloat(int ordinal)
 	CHECK_DISPOSED(m_disposed);
 	SqliteUtil::CheckDataRecordOrdinal(this, ordinal);
 	CheckStatementStatus(m_stmt);
+	CheckSequentialAccess(ordinal);
 
 	return m_stmt->GetFloat(ordinal);
 }
@@ -468,6 +525,7 @@ Guid SqliteDataReader::GetGuid(int ordinal)
 	CHECK_DISPOSED(m_disposed);
 	SqliteUtil::CheckDataRecordOrdinal(this, ordinal);
 	CheckStatementStatus(m_stmt);
+	CheckSequentialAccess(ordinal);
 
 	return m_stmt->GetGuid(ordinal);
 }
@@ -486,6 +544,7 @@ short SqliteDataReader::GetInt16(int ordinal)
 	CHECK_DISPOSED(m_disposed);
 	SqliteUtil::CheckDataRecordOrdinal(this, ordinal);
 	CheckStatementStatus(m_stmt);
+	CheckSequentialAccess(ordinal);
 
 	return m_stmt->GetInt16(ordinal);
 }
@@ -504,6 +563,7 @@ int SqliteDataReader::GetInt32(int ordinal)
 	CHECK_DISPOSED(m_disposed);
 	SqliteUtil::CheckDataRecordOrdinal(this, ordinal);
 	CheckStatementStatus(m_stmt);
+	CheckSequentialAccess(ordinal);
 
 	return m_stmt->GetInt32(ordinal);
 }
@@ -522,6 +582,7 @@ __int64 SqliteDataReader::GetInt64(int ordinal)
 	CHECK_DISPOSED(m_disposed);
 	SqliteUtil::CheckDataRecordOrdinal(this, ordinal);
 	CheckStatementStatus(m_stmt);
+	CheckSequentialAccess(ordinal);
 
 	return m_stmt->GetInt64(ordinal);
 }
@@ -592,6 +653,7 @@ Object^ SqliteDataReader::GetProviderSpecificValue(int ordinal)
 {
 	CHECK_DISPOSED(m_disposed);
 	if(m_stmt == nullptr) throw gcnew SqliteExceptions::NoDataPresentException();
+	CheckSequentialAccess(ordinal);
 
 	return m_stmt->GetProviderSpecificValue(ordinal);
 }
@@ -613,6 +675,12 @@ int SqliteDataReader::GetProviderSpecificValues(array<Object^>^ values)
 	CHECK_DISPOSED(m_disposed);
 	if(m_stmt == nullptr) throw gcnew SqliteExceptions::NoDataPresentException();
 
+	// In SequentialAccess mode this reads every column in order, so it's only
+	// allowed before any individual column has been read from the row
+
+	CheckSequentialAccess(0);
+	m_column = Math::Max(m_stmt->FieldCount - 1, 0);
+
 	return m_stmt->GetProviderSpecificValues(values);
 }
 
@@ -634,6 +702,27 @@ DataTable^ SqliteDataReader::GetSchemaTable(void)
 	return m_stmt->GetSchemaTable();		// Generate a schema table
 }
 
+//---------------------------------------------------------------------------
+// SqliteDataReader::GetStream
+//
+// Retrieves a read-only Stream over a value from the current row in the
+// current result set.  The stream reads directly from the engine's copy of
+// the value, and becomes unusable as soon as the reader moves off the row
+//
+// Arguments:
+//
+//	ordinal			- Column ordinal to retrieve the value from
+
+Stream^ SqliteDataReader::GetStream(int ordinal)
+{
+	CHECK_DISPOSED(m_disposed);
+	SqliteUtil::CheckDataRecordOrdinal(this, ordinal);
+	CheckStatementStatus(m_stmt);
+	CheckSequentialAccess(ordinal);
+
+	return m_stmt->GetStream(ordinal);
+}
+
 //---------------------------------------------------------------------------
 // SqliteDataReader::GetString
 //
@@ -648,10 +737,31 @@ String^ SqliteDataReader::GetString(int ordinal)
 	CHECK_DISPOSED(m_disposed);
 	SqliteUtil::CheckDataRecordOrdinal(this, ordinal);
 	CheckStatementStatus(m_stmt);
+	CheckSequentialAccess(ordinal);
 
 	return m_stmt->GetString(ordinal);
 }
 
+//---------------------------------------------------------------------------
+// SqliteDataReader::GetTextReader
+//
+// Retrieves a TextReader over a value from the current row in the current
+// result set.  Like GetStream(), the reader is only valid on the current row
+//
+// Arguments:
+//
+//	ordinal			- Column ordinal to retrieve the value from
+
+TextReader^ SqliteDataReader::GetTextReader(int ordinal)
+{
+	CHECK_DISPOSED(m_disposed);
+	SqliteUtil::CheckDataRecordOrdinal(this, ordinal);
+	CheckStatementStatus(m_stmt);
+	CheckSequentialAccess(ordinal);
+
+	return m_stmt->GetTextReader(ordinal);
+}
+
 //---------------------------------------------------------------------------
 // SqliteDataReader::GetValue
 //
@@ -669,6 +779,7 @@ Object^ SqliteDataReader::GetValue(int ordinal)
 	CHECK_DISPOSED(m_disposed);
 	SqliteUtil::CheckDataRecordOrdinal(this, ordinal);
 	CheckStatementStatus(m_stmt);
+	CheckSequentialAccess(ordinal);
 
 	return m_stmt->GetValue(ordinal);			// Call through to get value
 }
@@ -690,9 +801,39 @@ int SqliteDataReader::GetValues(array<Object^>^ values)
 	CHECK_DISPOSED(m_disposed);
 	CheckStatementStatus(m_stmt);
 
+	// In SequentialAccess mode this reads every column in order, so it's only
+	// allowed before any individual column has been read from the row
+
+	CheckSequentialAccess(0);
+	m_column = Math::Max(m_stmt->FieldCount - 1, 0);
+
 	return m_stmt->GetValues(values);
 }
 
+//---------------------------------------------------------------------------
+// SqliteDataReader::GetValues (internal)
+//
+// Loads field data from the current row into an array of objects, using a
+// set of target positions and data types that were resolved in advance.
+// Used by SqliteDataAdapter to avoid per-row metadata lookups during Fill
+//
+// Arguments:
+//
+//	values			- The array of Object references to load with row data
+//	positions		- Target position in values[] for each field, or -1 to skip
+//	types			- Data type to coerce each field value into
+
+void SqliteDataReader::GetValues(array<Object^>^ values, array<int>^ positions, array<Type^>^ types)
+{
+	CHECK_DISPOSED(m_disposed);
+	CheckStatementStatus(m_stmt);
+
+	CheckSequentialAccess(0);
+	m_column = Math::Max(m_stmt->FieldCount - 1, 0);
+
+	m_stmt->GetValues(values, positions, types);
+}
+
 //---------------------------------------------------------------------------
 // SqliteDataReader::HasRows
 //
@@ -732,6 +873,7 @@ bool SqliteDataReader::IsDBNull(int ordinal)
 	CHECK_DISPOSED(m_disposed);
 	SqliteUtil::CheckDataRecordOrdinal(this, ordinal);
 	CheckStatementStatus(m_stmt);
+	CheckSequentialAccess(ordinal);
 
 	return m_stmt->IsDBNull(ordinal);
 }
@@ -757,6 +899,7 @@ bool SqliteDataReader::NextResult(void)
 	
 		m_changes += m_stmt->ChangeCount;	// Tally up the total changes
 		m_stmt->Reset();					// Reset executing statement
+		CompleteStatistics();				// Tally up the statement counters
 
 		// If the command is supposed to only return one result set, and
 		// we're in here because m_stmt was non-NULL, we're going to want 
@@ -765,10 +908,15 @@ bool SqliteDataReader::NextResult(void)
 		if(IsCommandBehavior(SqliteCommandBehavior::SingleResult)) skipResults = true;
 	}
 
-	while(m_stmtIndex < m_query->StatementCount) {
+	m_column = 0;						// Reset sequential column position
+
+	// Ad-hoc queries prepare each statement as it's reached here, which also
+	// releases the statement that was just completed above
+
+	while((m_stmt = m_query->GetStatement(m_stmtIndex)) != nullptr) {
 
-		m_stmt = m_query[m_stmtIndex];
 		m_stmt->BindParameters(m_params, m_conn);
+		m_baseline = m_stmt->Statistics;
 		m_stmtIndex++;
 
 		// If we are set up in SchemaOnly mode, we want to still return TRUE
@@ -787,7 +935,9 @@ bool SqliteDataReader::NextResult(void)
 		// it as a non-query, execute it, and move on to the next one
 
 		if((m_stmt->GeneratesResultSet) && (!skipResults)) return true;
-		else m_changes += m_stmt->ExecuteNonQuery();
+
+		m_changes += m_stmt->ExecuteNonQuery();
+		CompleteStatistics();
 	}
 
 	m_stmt = nullptr;						// No more statement left
@@ -828,6 +978,7 @@ bool SqliteDataReader::Read(void)
 
 	// Move the statement along a step.  If a row is returned, return TRUE
 
+	m_column = 0;
 	return (m_stmt->Step() == SqliteStatementStatus::ResultReady);
 }
 
@@ -842,6 +993,18 @@ int SqliteDataReader::RecordsAffected::get(void)
 	return m_changes;
 }
 
+//---------------------------------------------------------------------------
+// SqliteDataReader::Statistics::get
+//
+// Returns the performance counters accumulated by the statements executed so
+// far, including the activity of the statement currently being read
+
+SqliteStatementStatistics SqliteDataReader::Statistics::get(void)
+{
+	if(m_disposed || (m_stmt == nullptr)) return m_stats;
+	return m_stats + SqliteStatementStatistics::Difference(m_stmt->Statistics, m_baseline);
+}
+
 //---------------------------------------------------------------------------
 
 } // zuki::data::sqlite
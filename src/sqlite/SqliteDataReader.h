@@ -39,6 +39,7 @@ using namespace System;
 using namespace System::Collections;
 using namespace System::Data;
 using namespace System::Data::Common;
+using namespace System::IO;
 
 namespace zuki::data::sqlite {
 
@@ -189,6 +190,16 @@ public:
 	// Retrieves the specified value as a string
 	virtual String^ GetString(int ordinal) override;
 	
+	// GetStream (DbDataReader)
+	//
+	// Retrieves the specified value as a read-only stream
+	virtual Stream^ GetStream(int ordinal) override;
+
+	// GetTextReader (DbDataReader)
+	//
+	// Retrieves the specified value as a text reader
+	virtual TextReader^ GetTextReader(int ordinal) override;
+
 	// GetValue (DbDataReader)
 	//
 	// Retrieves the specified value as a generic object, using the
@@ -243,6 +254,12 @@ public:
 	// Determines the number of rows affected by the current result set
 	virtual property int RecordsAffected { int get(void) override; }
 
+	// Statistics
+	//
+	// Gets the performance counters accumulated by the statements executed so
+	// far.  Unlike most properties, this can be accessed after the reader closes
+	property SqliteStatementStatistics Statistics { SqliteStatementStatistics get(void); }
+
 	// VisibleFieldCount (DbDataReader)
 	//
 	// Gets the number of non-hidden fields in the result set
@@ -267,6 +284,14 @@ internal:
 	SqliteDataReader(SqliteCommand^ command, SqliteQuery^ query, SqliteCommandBehavior behavior);
 	SqliteDataReader(SqliteCommand^ command, String^ query, SqliteCommandBehavior behavior);
 
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// GetValues
+	//
+	// Loads field data into an array at pre-computed positions and types
+	void GetValues(array<Object^>^ values, array<int>^ positions, array<Type^>^ types);
+
 private:
 
 	// DESTRUCTOR
@@ -275,11 +300,21 @@ private:
 	//-----------------------------------------------------------------------
 	// Private Member Functions
 
+	// CheckSequentialAccess
+	//
+	// Enforces increasing column order in SequentialAccess mode
+	void CheckSequentialAccess(int ordinal);
+
 	// CheckStatementStatus
 	//
 	// Simple helper function used to check a SqliteStatement status
 	static void CheckStatementStatus(SqliteStatement^ statement);
 
+	// CompleteStatistics
+	//
+	// Accumulates the counters for the current statement once it has finished
+	void CompleteStatistics(void);
+
 	// IsCommandBehavior
 	//
 	// Determines if the specified command behavior flag is set
@@ -306,6 +341,11 @@ private:
 	SqliteStatement^				m_stmt;				// Current statement object
 	int							m_changes;			// Overall records affected
 	SqliteParameterCollection^		m_params;			// Contained parameters collection
+	SqliteCommand^					m_command;			// Parent command object
+	SqliteStatementStatistics		m_stats;			// Completed statement counters
+	SqliteStatementStatistics		m_baseline;			// Current statement baseline
+	bool						m_sequential;		// SequentialAccess behavior?
+	int							m_column;			// Last column read (SequentialAccess)
 };
 
 //---------------------------------------------------------------------------
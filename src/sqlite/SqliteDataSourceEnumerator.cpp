@@ -35,7 +35,7 @@ namespace zuki::data::sqlite {
 //
 //	NONE
 
-SqliteDataSourceEnumerator::SqliteDataSourceEnumerator()
+SqliteDataSourceEnumerator::SqliteDataSourceEnumerator() : m_pattern("*"), m_recursive(false)
 {
 	Folder = Environment::CurrentDirectory;		// Use the working directory
 }
@@ -47,11 +47,140 @@ SqliteDataSourceEnumerator::SqliteDataSourceEnumerator()
 //
 //	path		- Path to be used for the data source enumeration
 
-SqliteDataSourceEnumerator::SqliteDataSourceEnumerator(String^ path)
+SqliteDataSourceEnumerator::SqliteDataSourceEnumerator(String^ path) : m_pattern("*"), m_recursive(false)
 {
 	Folder = path;			// Use the specified directory for scanning
 }
 
+//---------------------------------------------------------------------------
+// SqliteDataSourceEnumerator::EnumerateDataSources
+//
+// Streams information about all of the databases located in the directory
+// set up in the .Folder property.  The file system walk is lazy and the
+// headers are read in parallel, so results are produced as they are found
+// and in no particular order
+//
+// Arguments:
+//
+//	NONE
+
+IEnumerable<SqliteDataSourceInfo^>^ SqliteDataSourceEnumerator::EnumerateDataSources(void)
+{
+	array<String^>^					patterns;		// Individual file patterns
+	ParallelQuery<String^>^			files;			// Parallel file query
+
+	// Break up the search pattern on semicolons, the scanner needs to make
+	// a separate pass through each directory for each pattern specified
+
+	patterns = m_pattern->Split(gcnew array<Char>{ ';' }, StringSplitOptions::RemoveEmptyEntries);
+	for(int index = 0; index < patterns->Length; index++) patterns[index] = patterns[index]->Trim();
+
+	files = ParallelEnumerable::AsParallel<String^>((gcnew FileScanner(patterns, m_recursive))->EnumerateFiles(m_path));
+
+	// Reading the header is I/O bound; NotBuffered allows each result to be
+	// consumed as soon as it's available rather than waiting for the walk
+
+	return ParallelEnumerable::WithMergeOptions<SqliteDataSourceInfo^>(
+		ParallelEnumerable::Where<SqliteDataSourceInfo^>(
+			ParallelEnumerable::Select<String^, SqliteDataSourceInfo^>(files, 
+				gcnew Func<String^, SqliteDataSourceInfo^>(&SqliteDataSourceEnumerator::ReadDataSourceInfo)),
+			gcnew Func<SqliteDataSourceInfo^, bool>(&SqliteDataSourceEnumerator::IsDataSource)),
+		ParallelMergeOptions::NotBuffered);
+}
+
+//---------------------------------------------------------------------------
+// SqliteDataSourceEnumerator::FileScanner::EnumerateFiles
+//
+// Lazily enumerates all files in a directory that match any of the patterns,
+// followed by the files in each subdirectory when scanning recursively
+//
+// Arguments:
+//
+//	directory		- Directory to be scanned
+
+IEnumerable<String^>^ SqliteDataSourceEnumerator::FileScanner::EnumerateFiles(String^ directory)
+{
+	IEnumerable<String^>^ files = Enumerable::Empty<String^>();
+
+	for each(String^ pattern in m_patterns)
+		files = Enumerable::Concat<String^>(files, EnumerateMatches(directory, pattern));
+
+	// A file can match more than one pattern (*.db;*.d*), but only ever within
+	// the same directory, so duplicates only need to be removed per directory
+
+	if(m_patterns->Length > 1) files = Enumerable::Distinct<String^>(files, StringComparer::OrdinalIgnoreCase);
+
+	// Subdirectories are only expanded as the enumeration reaches them, which
+	// keeps the walk streaming rather than building the entire tree up front
+
+	if(m_recursive) files = Enumerable::Concat<String^>(files, Enumerable::SelectMany<String^, String^>(
+		EnumerateSubdirectories(directory), gcnew Func<String^, IEnumerable<String^>^>(this, &FileScanner::EnumerateFiles)));
+
+	return files;
+}
+
+//---------------------------------------------------------------------------
+// SqliteDataSourceEnumerator::FileScanner::EnumerateMatches (private, static)
+//
+// Enumerates the files in a single directory that match a pattern
+//
+// Arguments:
+//
+//	directory		- Directory to be scanned
+//	pattern			- File name pattern to match
+
+IEnumerable<String^>^ SqliteDataSourceEnumerator::FileScanner::EnumerateMatches(String^ directory, String^ pattern)
+{
+	// Errors can be raised when the enumerator is created or at any point while
+	// it's being iterated (a directory removed during the scan, for example).
+	// Each directory is read in full here so the errors can be caught; one bad
+	// directory shouldn't stop the scan, or surface as an AggregateException
+
+	try { return Enumerable::ToArray<String^>(Directory::EnumerateFiles(directory, pattern, SearchOption::TopDirectoryOnly)); }
+	catch(UnauthorizedAccessException^) { return Enumerable::Empty<String^>(); }
+	catch(IOException^) { return Enumerable::Empty<String^>(); }
+}
+
+//---------------------------------------------------------------------------
+// SqliteDataSourceEnumerator::FileScanner::EnumerateSubdirectories (private, static)
+//
+// Enumerates the subdirectories of a directory that can be traversed
+//
+// Arguments:
+//
+//	directory		- Directory to be scanned
+
+IEnumerable<String^>^ SqliteDataSourceEnumerator::FileScanner::EnumerateSubdirectories(String^ directory)
+{
+	// As with EnumerateMatches(), the directory is read in full so that errors
+	// raised while iterating it can be caught here
+
+	try { 
+		
+		return Enumerable::ToArray<String^>(Enumerable::Where<String^>(Directory::EnumerateDirectories(directory), 
+			gcnew Func<String^, bool>(&FileScanner::IsTraversable))); 
+	}
+
+	catch(UnauthorizedAccessException^) { return Enumerable::Empty<String^>(); }
+	catch(IOException^) { return Enumerable::Empty<String^>(); }
+}
+
+//---------------------------------------------------------------------------
+// SqliteDataSourceEnumerator::FileScanner::IsTraversable (private, static)
+//
+// Determines if a subdirectory should be scanned.  Junctions and symbolic
+// links are skipped, they can easily create cycles in the directory tree
+//
+// Arguments:
+//
+//	directory		- Directory to be tested
+
+bool SqliteDataSourceEnumerator::FileScanner::IsTraversable(String^ directory)
+{
+	try { return (File::GetAttributes(directory) & FileAttributes::ReparsePoint) != FileAttributes::ReparsePoint; }
+	catch(Exception^) { return false; }
+}
+
 //---------------------------------------------------------------------------
 // SqliteDataSourceEnumerator::Folder::set
 //
@@ -72,7 +201,8 @@ void SqliteDataSourceEnumerator::Folder::set(String^ value)
 // SqliteDataSourceEnumerator::GetDataSources
 //
 // Returns a DataTable containing information about all enumerated data
-// sources in the directory currently set up in the .Path property
+// sources in the directory currently set up in the .Path property, sorted
+// by file name
 //
 // Arguments:
 //
@@ -80,77 +210,93 @@ void SqliteDataSourceEnumerator::Folder::set(String^ value)
 
 DataTable^ SqliteDataSourceEnumerator::GetDataSources(void)
 {
-	DataTable^			sources;		// DataTable to return to caller
-	System::Byte		readVer;		// File format read version
-	System::Byte		writeVer;		// File format write version
+	DataTable^						sources;		// DataTable to return to caller
+	array<SqliteDataSourceInfo^>^	infos;			// Located databases
+	array<String^>^					names;			// Database file names
 
 	sources = s_template->Clone();		// Clone the template data table
 
-	// Iterate over each file in the specified directory, and use the 
-	// helper function to determine if the file is a SQLite file or not
+	// EnumerateDataSources produces the databases in whatever order the parallel
+	// query gets to them, so collect and sort them before building the rows
 
-	for each(String^ filename in Directory::GetFiles(m_path)) {
+	infos = Enumerable::ToArray<SqliteDataSourceInfo^>(EnumerateDataSources());
+	names = gcnew array<String^>(infos->Length);
+	for(int index = 0; index < infos->Length; index++) names[index] = infos[index]->FileName;
 
-		if(IsDatabase(filename, writeVer, readVer)) {
+	Array::Sort(names, infos, StringComparer::OrdinalIgnoreCase);
 
-			sources->Rows->Add(gcnew array<Object^>{ 
+	for each(SqliteDataSourceInfo^ info in infos) {
+
+		sources->Rows->Add(gcnew array<Object^>{ 
 				
-				filename,											// ServerName
-				IO::Path::GetFileNameWithoutExtension(filename),	// InstanceName
-				"False",											// IsClustered
-				String::Format("W{0};R{1}", writeVer, readVer),		// Version
-				SqliteFactory::typeid->AssemblyQualifiedName			// FactoryName
-			});
-		}
+			info->FileName,												// ServerName
+			IO::Path::GetFileNameWithoutExtension(info->FileName),		// InstanceName
+			"False",													// IsClustered
+			String::Format("W{0};R{1}", info->WriteVersion, info->ReadVersion),	// Version
+			SqliteFactory::typeid->AssemblyQualifiedName					// FactoryName
+		});
 	}
 
 	return sources;						// Return the generated data table
 }
 
 //---------------------------------------------------------------------------
-// SqliteDataSourceEnumerator::IsDatabase (private, static)
+// SqliteDataSourceEnumerator::ReadDataSourceInfo (private, static)
 //
-// Determines if the specified file is a SQLite database or not.  Requires
-// that the file header be the same for the platform this code was compiled
-// against. At initial implementation --> "SQLite format 3"
+// Reads the header from the specified file and decodes it if the file is a
+// SQLite database.  Requires that the file header be the same for the platform
+// this code was compiled against. At initial implementation --> "SQLite format 3"
 //
 // Arguments:
 //
 //	filename		- File name to be tested
-//	writeVer		- On TRUE, contains the file write version
-//	readVer			- On TRUE, contains the file read version
 
-bool SqliteDataSourceEnumerator::IsDatabase(String^ filename, System::Byte% writeVer, System::Byte% readVer)
+SqliteDataSourceInfo^ SqliteDataSourceEnumerator::ReadDataSourceInfo(String^ filename)
 {
 	HANDLE					hFile;			// File handle
 	PinnedStringPtr			pinFilename;	// Pinned file name string
-	BYTE					rgBuffer[20];	// 20 byte input buffer
-	DWORD					cbRead;			// Bytes read from the file
+	BYTE					rgBuffer[SqliteDataSourceInfo::HEADER_LENGTH];	// Header buffer
+	DWORD					cbRead = 0;		// Bytes read from the file
+	LARGE_INTEGER			length;			// Length of the file
+	BOOL					bResult;		// Result from ReadFile
 
-	if(filename == nullptr) return false;
+	if(filename == nullptr) return nullptr;
 
 	// Attempt to open the file using as optimal of a set of flags as
-	// we can since we only look at the first 16 bytes of the thing.  I
+	// we can since we only look at the first 100 bytes of the thing.  I
 	// didn't use managed code here since I have no idea how efficient it is
 
 	pinFilename = PtrToStringChars(filename);
 	hFile = CreateFile(pinFilename, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
 		NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
-	if(hFile == INVALID_HANDLE_VALUE) return false;
+	if(hFile == INVALID_HANDLE_VALUE) return nullptr;
 
-	memset(rgBuffer, 0, 20);							// Initialize buffer
-	ReadFile(hFile, rgBuffer, 20, &cbRead, NULL);		// Try to read the data
-	CloseHandle(hFile);									// Close the file handle
+	memset(rgBuffer, 0, SqliteDataSourceInfo::HEADER_LENGTH);			// Initialize buffer
+	bResult = ReadFile(hFile, rgBuffer, SqliteDataSourceInfo::HEADER_LENGTH, &cbRead, NULL);
+	if(!GetFileSizeEx(hFile, &length)) length.QuadPart = 0;				// Get the file length
+	CloseHandle(hFile);													// Close the file handle
 	
 	// If the data we got back doesn't match the SQLite header, we're done
 
-	if(cbRead != 20) return false;
-	if(strncmp(reinterpret_cast<char*>(rgBuffer), "SQLite format 3", 16) != 0) return false;
+	if((!bResult) || (cbRead != SqliteDataSourceInfo::HEADER_LENGTH)) return nullptr;
+	if(strncmp(reinterpret_cast<char*>(rgBuffer), "SQLite format 3", 16) != 0) return nullptr;
+
+	return gcnew SqliteDataSourceInfo(filename, rgBuffer, length.QuadPart);
+}
+
+//---------------------------------------------------------------------------
+// SqliteDataSourceEnumerator::SearchPattern::set
+//
+// Changes the file name pattern(s) that will be searched for SQLite databases
+
+void SqliteDataSourceEnumerator::SearchPattern::set(String^ value)
+{
+	if(value == nullptr) throw gcnew ArgumentNullException();
 
-	writeVer = rgBuffer[18];				// Set the write format version
-	readVer = rgBuffer[19];					// Set the read format version
+	// Multiple patterns can be specified by separating them with semicolons;
+	// an empty pattern is treated the same as scanning every file
 
-	return true;
+	m_pattern = (value->Trim()->Length == 0) ? "*" : value;
 }
 
 //---------------------------------------------------------------------------
@@ -24,12 +24,16 @@
 #define __SQLITEDATASOURCEENUMERATOR_H_
 #pragma once
 
+#include "SqliteDataSourceInfo.h"		// Include SqliteDataSourceInfo declarations
+
 #pragma warning(push, 4)				// Enable maximum compiler warnings
 
 using namespace System;
+using namespace System::Collections::Generic;
 using namespace System::Data;
 using namespace System::Data::Common;
 using namespace System::IO;
+using namespace System::Linq;
 
 namespace zuki::data::sqlite {
 
@@ -38,7 +42,8 @@ namespace zuki::data::sqlite {
 //
 // Enumerates all of the SQLite databases present in a specified directory.
 // When the specific constructor or the directory name property cannot be 
-// accessed, this will only scan the current working directory.
+// accessed, this will only scan the current working directory.  Files are
+// examined in parallel, and only the 100 byte header of each is ever read
 //---------------------------------------------------------------------------
 
 public ref class SqliteDataSourceEnumerator sealed : public DbDataSourceEnumerator
@@ -54,6 +59,11 @@ public:
 	//-----------------------------------------------------------------------
 	// Member Functions
 
+	// EnumerateDataSources
+	//
+	// Streams information about each database file as it is located
+	IEnumerable<SqliteDataSourceInfo^>^ EnumerateDataSources(void);
+
 	// GetDataSources (DbDataSourceEnumerator)
 	//
 	// Returns a DataTable with all the enumerated data source information
@@ -71,18 +81,67 @@ public:
 		void set(String^ value);
 	}
 
+	// Recursive
+	//
+	// Gets/sets a flag indicating if subdirectories should be scanned
+	property bool Recursive
+	{
+		bool get(void) { return m_recursive; }
+		void set(bool value) { m_recursive = value; }
+	}
+
+	// SearchPattern
+	//
+	// Gets/sets the file name pattern(s) to scan, separated by semicolons
+	property String^ SearchPattern
+	{
+		String^ get(void) { return m_pattern; }
+		void set(String^ value);
+	}
+
 private:
 
 	// STATIC CONSTRUCTOR
 	static SqliteDataSourceEnumerator() { StaticConstruct(); }
 
+	//-----------------------------------------------------------------------
+	// Private Data Types
+
+	// FileScanner
+	//
+	// Lazily walks a directory tree for files matching a set of patterns.
+	// Directories that cannot be accessed are skipped rather than thrown
+	ref class FileScanner sealed
+	{
+	public:
+
+		FileScanner(array<String^>^ patterns, bool recursive) : 
+			m_patterns(patterns), m_recursive(recursive) {}
+
+		IEnumerable<String^>^ EnumerateFiles(String^ directory);
+
+	private:
+
+		static IEnumerable<String^>^ EnumerateMatches(String^ directory, String^ pattern);
+		static IEnumerable<String^>^ EnumerateSubdirectories(String^ directory);
+		static bool IsTraversable(String^ directory);
+
+		initonly array<String^>^	m_patterns;			// File name patterns
+		initonly bool				m_recursive;		// Flag to recurse
+	};
+
 	//-----------------------------------------------------------------------
 	// Private Member Functions
 
-	// IsDatabase
+	// IsDataSource
+	//
+	// Predicate used to remove files that weren't databases from the results
+	static bool IsDataSource(SqliteDataSourceInfo^ info) { return info != nullptr; }
+
+	// ReadDataSourceInfo
 	//
-	// Determines if the specified file is a database file or not
-	static bool IsDatabase(String^ filename, System::Byte% writeVer, System::Byte% readVer);
+	// Reads the database header from a file, or returns NULL if not a database
+	static SqliteDataSourceInfo^ ReadDataSourceInfo(String^ filename);
 
 	// StaticConstruct
 	//
@@ -93,6 +152,8 @@ private:
 	// Member Variables
 
 	String^					m_path;			// Path to be scanned for files
+	String^					m_pattern;		// File name pattern(s) to scan
+	bool					m_recursive;	// Flag to scan subdirectories
 	static DataTable^		s_template;		// DataTable template instance
 };
 
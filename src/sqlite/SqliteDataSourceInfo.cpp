@@ -0,0 +1,89 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"					// Include project pre-compiled headers
+#include "SqliteDataSourceInfo.h"		// Include SqliteDataSourceInfo declarations
+
+#pragma warning(push, 4)			// Enable maximum compiler warnings
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// SqliteDataSourceInfo Constructor (internal)
+//
+// Arguments:
+//
+//	filename		- Full path to the database file
+//	header			- Pointer to the HEADER_LENGTH byte database file header
+//	length			- Length of the database file, in bytes
+
+SqliteDataSourceInfo::SqliteDataSourceInfo(String^ filename, const BYTE* header, __int64 length)
+{
+	unsigned int			pageCount;		// In-header database size
+
+	if(filename == nullptr) throw gcnew ArgumentNullException();
+	if(!header) throw gcnew ArgumentNullException();
+
+	m_filename = filename;
+
+	// The page size is stored as a 16 bit big-endian value at offset 16, with
+	// the special value of 1 used to indicate the maximum size of 65536 bytes
+
+	m_pageSize = (header[16] << 8) | header[17];
+	if(m_pageSize == 1) m_pageSize = 65536;
+
+	m_writeVer = header[18];
+	m_readVer = header[19];
+	m_cookie = static_cast<int>(ReadBigEndian(header, 40));
+	m_encoding = static_cast<SqliteTextEncodingMode>(ReadBigEndian(header, 56));
+
+	// The in-header database size is only valid when it's non-zero and the
+	// change counter at offset 24 matches the version-valid-for number at
+	// offset 92; older versions of SQLite didn't maintain it, so fall back
+	// on calculating the page count from the length of the file
+
+	pageCount = ReadBigEndian(header, 28);
+	if((pageCount != 0) && (ReadBigEndian(header, 24) == ReadBigEndian(header, 92))) m_pageCount = pageCount;
+	else m_pageCount = (m_pageSize > 0) ? length / m_pageSize : 0;
+}
+
+//---------------------------------------------------------------------------
+// SqliteDataSourceInfo::ReadBigEndian (private, static)
+//
+// Reads a big-endian 32 bit unsigned integer from the database file header
+//
+// Arguments:
+//
+//	header			- Pointer to the database file header
+//	offset			- Offset into the header to read the value from
+
+unsigned int SqliteDataSourceInfo::ReadBigEndian(const BYTE* header, int offset)
+{
+	return (static_cast<unsigned int>(header[offset]) << 24) | (static_cast<unsigned int>(header[offset + 1]) << 16) |
+		(static_cast<unsigned int>(header[offset + 2]) << 8) | static_cast<unsigned int>(header[offset + 3]);
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
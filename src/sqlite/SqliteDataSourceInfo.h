@@ -0,0 +1,163 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __SQLITEDATASOURCEINFO_H_
+#define __SQLITEDATASOURCEINFO_H_
+#pragma once
+
+#include "SqliteEnumerations.h"			// Include Sqlite enumeration declarations
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// Class SqliteDataSourceInfo
+//
+// Describes a single SQLite database file located by SqliteDataSourceEnumerator.
+// All of the information is decoded from the 100 byte database file header,
+// no connection to the database is ever opened to generate it
+//---------------------------------------------------------------------------
+
+public ref class SqliteDataSourceInfo sealed
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// ToString (Object)
+	//
+	// Returns the full path to the database file
+	virtual String^ ToString(void) override { return m_filename; }
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// FileName
+	//
+	// Gets the full path to the database file
+	property String^ FileName
+	{
+		String^ get(void) { return m_filename; }
+	}
+
+	// IsWalMode
+	//
+	// Gets a flag indicating if the database is in write-ahead logging mode
+	property bool IsWalMode
+	{
+		bool get(void) { return (m_writeVer == 2) && (m_readVer == 2); }
+	}
+
+	// PageCount
+	//
+	// Gets the size of the database file, in pages
+	property __int64 PageCount
+	{
+		__int64 get(void) { return m_pageCount; }
+	}
+
+	// PageSize
+	//
+	// Gets the database page size, in bytes
+	property int PageSize
+	{
+		int get(void) { return m_pageSize; }
+	}
+
+	// ReadVersion
+	//
+	// Gets the file format read version (1 = legacy, 2 = WAL)
+	property System::Byte ReadVersion
+	{
+		System::Byte get(void) { return m_readVer; }
+	}
+
+	// SchemaCookie
+	//
+	// Gets the schema cookie, which is incremented on every schema change
+	property int SchemaCookie
+	{
+		int get(void) { return m_cookie; }
+	}
+
+	// TextEncoding
+	//
+	// Gets the text encoding used for all strings stored in the database
+	property SqliteTextEncodingMode TextEncoding
+	{
+		SqliteTextEncodingMode get(void) { return m_encoding; }
+	}
+
+	// WriteVersion
+	//
+	// Gets the file format write version (1 = legacy, 2 = WAL)
+	property System::Byte WriteVersion
+	{
+		System::Byte get(void) { return m_writeVer; }
+	}
+
+internal:
+
+	// INTERNAL CONSTRUCTOR
+	SqliteDataSourceInfo(String^ filename, const BYTE* header, __int64 length);
+
+	//-----------------------------------------------------------------------
+	// Internal Constants
+
+	// HEADER_LENGTH
+	//
+	// Length of the SQLite database file header, in bytes
+	literal int HEADER_LENGTH = 100;
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// ReadBigEndian
+	//
+	// Reads a big-endian 32 bit unsigned integer from the file header
+	static unsigned int ReadBigEndian(const BYTE* header, int offset);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	String^					m_filename;			// Database file name
+	int						m_pageSize;			// Database page size
+	__int64					m_pageCount;		// Database page count
+	System::Byte			m_writeVer;			// File format write version
+	System::Byte			m_readVer;			// File format read version
+	int						m_cookie;			// Schema cookie
+	SqliteTextEncodingMode	m_encoding;			// Database text encoding
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
+
+#endif		// __SQLITEDATASOURCEINFO_H_
@@ -38,12 +38,24 @@ namespace zuki::data::sqlite {
 // Used by SqliteConnection to raise a hooked authorization event
 public delegate void SqliteAuthorizeEventHandler(Object^ sender, SqliteAuthorizeEventArgs^ args);
 
+//---------------------------------------------------------------------------
+// Delegate SqliteBackupProgressEventHandler
+//
+// Used by SqliteConnection to raise a backup progress event
+public delegate void SqliteBackupProgressEventHandler(Object^ sender, SqliteBackupProgressEventArgs^ args);
+
 //---------------------------------------------------------------------------
 // Delegate SqliteCollationNeededEventHandler
 //
 // Used by SqliteConnection to raise a hooked collation needed event
 public delegate void SqliteCollationNeededEventHandler(Object^ sender, SqliteCollationNeededEventArgs^ args);
 
+//---------------------------------------------------------------------------
+// Delegate SqliteIncrementalVacuumEventHandler
+//
+// Used by SqliteConnection to raise a background incremental vacuum event
+public delegate void SqliteIncrementalVacuumEventHandler(Object^ sender, SqliteIncrementalVacuumEventArgs^ args);
+
 //---------------------------------------------------------------------------
 // Delegate SqliteProfileEventHandler
 //
@@ -87,6 +87,20 @@ public enum struct SqliteAuthorizeResponse
 	Ignore				= SQLITE_IGNORE,	// The statement is completely ignored
 };
 
+//---------------------------------------------------------------------------
+// Enum SqliteAutoVacuumMode
+//
+// Defines the current database's SQLite 'auto_vacuum' mode.  The mode can
+// only be changed before any tables have been created in the database
+//---------------------------------------------------------------------------
+
+public enum struct SqliteAutoVacuumMode
+{
+	None				= 0,		// No auto-vacuuming (default)
+	Full				= 1,		// Free pages are reclaimed on every commit
+	Incremental			= 2,		// Free pages are reclaimed by IncrementalVacuum
+};
+
 //---------------------------------------------------------------------------
 // Enum SqliteBooleanFormat
 //
@@ -134,6 +148,7 @@ public enum struct SqliteCommandBehavior
 	SingleResult		= CommandBehavior::SingleResult,		// 0x0001
 	SchemaOnly			= CommandBehavior::SchemaOnly,			// 0x0002
 	SingleRow			= CommandBehavior::SingleRow,			// 0x0008
+	SequentialAccess	= CommandBehavior::SequentialAccess,	// 0x0010
 	CloseConnection		= CommandBehavior::CloseConnection,		// 0x0020
 };
 
@@ -169,6 +184,22 @@ public enum struct SqliteDateTimeFormat
 	Ticks				= 4,		// 100ns ticks since 01/01/0001 00:00:00
 };
 
+//---------------------------------------------------------------------------
+// Enum SqliteDistinctMode
+//
+// Indicates how the engine intends to use the rows returned from a virtual
+// table, see sqlite3_vtab_distinct().  Allows a virtual table to skip sorting
+// or duplicate elimination that the engine does not actually require
+//---------------------------------------------------------------------------
+
+public enum struct SqliteDistinctMode
+{
+	Ordered				= 0,		// Rows must be returned in ORDER BY order
+	Grouped				= 1,		// Rows with equal ORDER BY values must be adjacent
+	Distinct			= 2,		// Only distinct ORDER BY values are required
+	DistinctOrdered		= 3,		// Distinct and in ORDER BY order
+};
+
 //---------------------------------------------------------------------------
 // Enum SqliteGuidFormat
 //
@@ -230,6 +261,17 @@ public enum struct SqliteSearchOperator
 	LessThan			= SQLITE_INDEX_CONSTRAINT_LT,		// 0x10
 	GreaterThanOrEqual	= SQLITE_INDEX_CONSTRAINT_GE,		// 0x20
 	Match				= SQLITE_INDEX_CONSTRAINT_MATCH,	// 0x40
+	Like				= SQLITE_INDEX_CONSTRAINT_LIKE,		// 0x41
+	Glob				= SQLITE_INDEX_CONSTRAINT_GLOB,		// 0x42
+	Regexp				= SQLITE_INDEX_CONSTRAINT_REGEXP,	// 0x43
+	NotEqual			= SQLITE_INDEX_CONSTRAINT_NE,		// 0x44
+	IsNot				= SQLITE_INDEX_CONSTRAINT_ISNOT,	// 0x45
+	IsNotNull			= SQLITE_INDEX_CONSTRAINT_ISNOTNULL,	// 0x46
+	IsNull				= SQLITE_INDEX_CONSTRAINT_ISNULL,	// 0x47
+	Is					= SQLITE_INDEX_CONSTRAINT_IS,		// 0x48
+	Limit				= SQLITE_INDEX_CONSTRAINT_LIMIT,	// 0x49
+	Offset				= SQLITE_INDEX_CONSTRAINT_OFFSET,	// 0x4A
+	Function			= SQLITE_INDEX_CONSTRAINT_FUNCTION,	// 0x96
 };
 
 //---------------------------------------------------------------------------
@@ -303,18 +345,36 @@ public enum struct SqliteTextEncodingMode
 	UTF16BigEndian		= 3,		// Use big-endian (Motorola) UTF16 encoding
 };
 
+//---------------------------------------------------------------------------
+// Enum SqliteTraceEventMask
+//
+// Defines the sqlite3_trace_v2 events that are captured into the connection
+// trace buffer, see SqliteConnection::TraceMask
+//---------------------------------------------------------------------------
+
+[Flags]
+public enum struct SqliteTraceEventMask
+{
+	None				= 0,						// Tracing is disabled
+	Statement			= SQLITE_TRACE_STMT,		// Statement starts executing
+	Profile				= SQLITE_TRACE_PROFILE,		// Statement has completed
+	Row					= SQLITE_TRACE_ROW,			// Statement produced a row
+	Close				= SQLITE_TRACE_CLOSE,		// Connection was closed
+};
+
 //---------------------------------------------------------------------------
 // Enum SqliteTransactionStyle
 //
 // Defines the current connection's transaction style.  By default, SQLite
 // can only handle a single transaction, which leads to problems in modular
-// code, so an additional mode(s) have been defined at the provider level
+// code, so an additional mode(s) have been defined at the provider level.
+// Nested transactions are implemented with SAVEPOINT/RELEASE/ROLLBACK TO
 //---------------------------------------------------------------------------
 
 public enum struct SqliteTransactionMode
 {
 	Single				= 0,		// Default SQLite transaction mode (default)
-	SimulateNested		= 1,		// Simulate nested transaction support
+	SimulateNested		= 1,		// Nested transaction support (SAVEPOINT)
 };
 
 //---------------------------------------------------------------------------
@@ -32,6 +32,7 @@
 
 using namespace System;
 using namespace System::Collections::ObjectModel;
+using namespace System::ComponentModel;
 using namespace System::Data;
 using namespace System::Data::Common;
 using namespace System::Runtime::InteropServices;
@@ -116,6 +117,45 @@ private:
 	SqliteAuthorizeResponse			m_response;		// Response from authorization
 };
 
+//---------------------------------------------------------------------------
+// Class SqliteBackupProgressEventArgs
+//
+// Used as the event argument class for SqliteConnection::BackupProgress.  Set
+// the Cancel property to abort the backup operation after the current step
+//---------------------------------------------------------------------------
+
+public ref class SqliteBackupProgressEventArgs : public CancelEventArgs
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// PageCount
+	//
+	// Gets the total number of pages in the source database
+	property int PageCount { int get(void) { return m_pageCount; } }
+
+	// RemainingPages
+	//
+	// Gets the number of pages that have yet to be copied
+	property int RemainingPages { int get(void) { return m_remaining; } }
+
+internal:
+
+	// INTERNAL CONSTRUCTOR
+	SqliteBackupProgressEventArgs(int pageCount, int remaining) : m_pageCount(pageCount), 
+		m_remaining(remaining) {}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	int						m_pageCount;		// Total source page count
+	int						m_remaining;		// Remaining pages to copy
+};
+
 //---------------------------------------------------------------------------
 // Class SqliteCollationNeededEventArgs
 //
@@ -159,6 +199,43 @@ private:
 	String^							m_name;			// Requested collation name
 };
 
+//---------------------------------------------------------------------------
+// Class SqliteIncrementalVacuumEventArgs
+//
+// Used as the event argument class for SqliteConnection::BackgroundVacuum
+//---------------------------------------------------------------------------
+
+public ref class SqliteIncrementalVacuumEventArgs : public EventArgs
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// FreePagesAfter
+	//
+	// Gets the number of free pages in the database after the vacuum
+	property int FreePagesAfter { int get(void) { return m_after; } }
+
+	// FreePagesBefore
+	//
+	// Gets the number of free pages in the database before the vacuum
+	property int FreePagesBefore { int get(void) { return m_before; } }
+
+internal:
+
+	// INTERNAL CONSTRUCTOR
+	SqliteIncrementalVacuumEventArgs(int before, int after) : m_before(before), m_after(after) {}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	int						m_before;			// PRAGMA FREELIST_COUNT before
+	int						m_after;			// PRAGMA FREELIST_COUNT after
+};
+
 //---------------------------------------------------------------------------
 // Class SqliteProfileEventArgs
 //
@@ -0,0 +1,243 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"					// Include project pre-compiled headers
+#include "SqliteEventSource.h"			// Include SqliteEventSource declarations
+
+#pragma warning(push, 4)			// Enable maximum compiler warnings
+#pragma warning(disable:4100)		// "unreferenced formal parameter"
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// SqliteEventSource Constructor (private)
+//
+// Arguments:
+//
+//	NONE
+
+SqliteEventSource::SqliteEventSource()
+{
+	// PollingCounter isn't available on the .NET Framework, so the counters are
+	// plain EventCounters that CollectMetrics() writes the sampled values into.
+	// The order of these names matches the values written by CollectMetrics()
+
+	array<String^>^ names = gcnew array<String^> { "open-connections", "statements-prepared", 
+		"statements-reprepared", "rows-read", "bytes-bound", "pinned-parameters", "function-calls", 
+		"function-time-ms", "aggregate-calls", "aggregate-time-ms", "collation-calls", "collation-time-ms", 
+		"busy-waits", "memory-used", "page-cache-used", "page-cache-hits", "page-cache-misses", 
+		"schema-memory-used", "statement-memory-used" };
+
+	m_counters = gcnew array<EventCounter^>(names->Length);
+	for(int index = 0; index < names->Length; index++) m_counters[index] = gcnew EventCounter(names[index], this);
+}
+
+//---------------------------------------------------------------------------
+// SqliteEventSource::AggregateInvoked (internal, static)
+//
+// Counts an aggregate invocation
+//
+// Arguments:
+//
+//	start		- Value returned from Timestamp() before the invocation
+
+void SqliteEventSource::AggregateInvoked(__int64 start)
+{
+	if(start == 0) return;				// Not collecting at the time
+
+	Interlocked::Increment(s_aggregateCalls);
+	Interlocked::Add(s_aggregateTicks, Stopwatch::GetTimestamp() - start);
+}
+
+//---------------------------------------------------------------------------
+// SqliteEventSource::CollationInvoked (internal, static)
+//
+// Counts a collation invocation
+//
+// Arguments:
+//
+//	start		- Value returned from Timestamp() before the invocation
+
+void SqliteEventSource::CollationInvoked(__int64 start)
+{
+	if(start == 0) return;				// Not collecting at the time
+
+	Interlocked::Increment(s_collationCalls);
+	Interlocked::Add(s_collationTicks, Stopwatch::GetTimestamp() - start);
+}
+
+//---------------------------------------------------------------------------
+// SqliteEventSource::CollectMetrics (private, static)
+//
+// Timer callback that gathers everything up and writes the sampled values
+// into the counters.  Times are in milliseconds, memory values in bytes
+//
+// Arguments:
+//
+//	state		- Unused
+
+void SqliteEventSource::CollectMetrics(Object^ state)
+{
+	__int64				connections;			// Number of open connections
+	sqlite3_int64		memory = 0;				// Engine memory in use
+	sqlite3_int64		highwater;				// Unused high water mark
+	__int64				status[5] = { 0 };		// Summed sqlite3_db_status values
+	int					current, highest;		// sqlite3_db_status values
+
+	static const int DBSTATUS[] = { SQLITE_DBSTATUS_CACHE_USED, SQLITE_DBSTATUS_CACHE_HIT,
+		SQLITE_DBSTATUS_CACHE_MISS, SQLITE_DBSTATUS_SCHEMA_USED, SQLITE_DBSTATUS_STMT_USED };
+
+	if(!Log->IsEnabled()) return;
+
+	sqlite3_status64(SQLITE_STATUS_MEMORY_USED, &memory, &highwater, 0);
+
+	// The connection status values are summed across every open connection.
+	// Connections remove themselves under the same lock before releasing the
+	// handle, so anything in the list is safe to use here.  sqlite3_db_status
+	// is only safe to call from this thread if the engine serializes access to
+	// the connection; handles opened with SQLITE_OPEN_NOMUTEX have no mutex
+	// and are counted as open connections, but their status is skipped
+
+	Monitor::Enter(s_databases);
+
+	try {
+
+		connections = s_databases->Count;
+
+		for each(IntPtr database in s_databases) {
+
+			sqlite3* hDatabase = reinterpret_cast<DatabaseHandle*>(database.ToPointer())->Handle;
+			if(sqlite3_db_mutex(hDatabase) == NULL) continue;
+
+			for(int index = 0; index < _countof(DBSTATUS); index++)
+				if(sqlite3_db_status(hDatabase, DBSTATUS[index], &current, &highest, 0) == SQLITE_OK) 
+					status[index] += current;
+		}
+	}
+
+	finally { Monitor::Exit(s_databases); }
+
+	double values[] = { static_cast<double>(connections), static_cast<double>(Interlocked::Read(s_prepared)), 
+		static_cast<double>(Interlocked::Read(s_reprepared)), static_cast<double>(Interlocked::Read(s_rowsRead)), 
+		static_cast<double>(Interlocked::Read(s_bytesBound)), static_cast<double>(Interlocked::Read(s_pinned)), 
+		static_cast<double>(Interlocked::Read(s_functionCalls)), ToMilliseconds(Interlocked::Read(s_functionTicks)), 
+		static_cast<double>(Interlocked::Read(s_aggregateCalls)), ToMilliseconds(Interlocked::Read(s_aggregateTicks)), 
+		static_cast<double>(Interlocked::Read(s_collationCalls)), ToMilliseconds(Interlocked::Read(s_collationTicks)), 
+		static_cast<double>(Interlocked::Read(s_busyWaits)), static_cast<double>(memory), static_cast<double>(status[0]), 
+		static_cast<double>(status[1]), static_cast<double>(status[2]), static_cast<double>(status[3]), 
+		static_cast<double>(status[4]) };
+
+	for(int index = 0; index < _countof(values); index++)
+		Log->m_counters[index]->WriteMetric(static_cast<float>(values[index]));
+}
+
+//---------------------------------------------------------------------------
+// SqliteEventSource::ConnectionClosed (internal, static)
+//
+// Removes a database handle from the open connections
+//
+// Arguments:
+//
+//	pDatabase	- Database handle being released by the connection
+
+void SqliteEventSource::ConnectionClosed(DatabaseHandle* pDatabase)
+{
+	Monitor::Enter(s_databases);
+	try { s_databases->Remove(IntPtr(pDatabase)); }
+	finally { Monitor::Exit(s_databases); }
+}
+
+//---------------------------------------------------------------------------
+// SqliteEventSource::ConnectionOpened (internal, static)
+//
+// Adds a database handle to the open connections
+//
+// Arguments:
+//
+//	pDatabase	- Database handle owned by the connection
+
+void SqliteEventSource::ConnectionOpened(DatabaseHandle* pDatabase)
+{
+	Monitor::Enter(s_databases);
+	try { s_databases->Add(IntPtr(pDatabase)); }
+	finally { Monitor::Exit(s_databases); }
+}
+
+//---------------------------------------------------------------------------
+// SqliteEventSource::FunctionInvoked (internal, static)
+//
+// Counts a scalar function invocation
+//
+// Arguments:
+//
+//	start		- Value returned from Timestamp() before the invocation
+
+void SqliteEventSource::FunctionInvoked(__int64 start)
+{
+	if(start == 0) return;				// Not collecting at the time
+
+	Interlocked::Increment(s_functionCalls);
+	Interlocked::Add(s_functionTicks, Stopwatch::GetTimestamp() - start);
+}
+
+//---------------------------------------------------------------------------
+// SqliteEventSource::OnEventCommand (protected)
+//
+// Invoked when a listener enables or disables the event source
+//
+// Arguments:
+//
+//	command		- Event command arguments
+
+void SqliteEventSource::OnEventCommand(EventCommandEventArgs^ command)
+{
+	String^				value;				// EventCounterIntervalSec value
+	double				seconds = 0;		// Sampling interval, in seconds
+
+	if(command->Command == EventCommand::Disable) {
+
+		s_collecting = false;
+		if(m_timer != nullptr) m_timer->Change(Timeout::Infinite, Timeout::Infinite);
+		return;
+	}
+
+	if(command->Command != EventCommand::Enable) return;
+	s_collecting = true;
+
+	// Same argument name EventCounter uses to set the reporting interval, so
+	// existing tooling configurations work against this provider as well
+
+	if((command->Arguments != nullptr) && (command->Arguments->TryGetValue("EventCounterIntervalSec", value)))
+		Double::TryParse(value, Globalization::NumberStyles::Float, Globalization::CultureInfo::InvariantCulture, seconds);
+
+	if(seconds <= 0) return;
+
+	int interval = static_cast<int>(seconds * 1000);
+	if(m_timer == nullptr) m_timer = gcnew Timer(gcnew TimerCallback(&SqliteEventSource::CollectMetrics), nullptr, interval, interval);
+	else m_timer->Change(interval, interval);
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
@@ -0,0 +1,184 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __SQLITEEVENTSOURCE_H_
+#define __SQLITEEVENTSOURCE_H_
+#pragma once
+
+#include "DatabaseHandle.h"				// Include DatabaseHandle declarations
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Diagnostics;
+using namespace System::Diagnostics::Tracing;
+using namespace System::Threading;
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// Class SqliteEventSource
+//
+// Exports runtime metrics about the provider as EventCounters, so they can be
+// collected from a running process with tooling such as PerfView.  Enable the
+// "zuki-data-sqlite" provider with an EventCounterIntervalSec argument, and the
+// counters will be sampled and reported on that interval.  Gauges (open
+// connections and pinned parameters) are always maintained; everything else is
+// only counted while the provider is enabled so it costs nothing otherwise.
+//---------------------------------------------------------------------------
+
+[EventSource(Name = "zuki-data-sqlite")]
+public ref class SqliteEventSource sealed : public EventSource
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Fields
+
+	// Log
+	//
+	// The one and only instance of the event source
+	static initonly SqliteEventSource^ Log = gcnew SqliteEventSource();
+
+protected:
+
+	//-----------------------------------------------------------------------
+	// Protected Member Functions
+
+	// OnEventCommand (EventSource)
+	//
+	// Starts or stops the counter sampling timer as listeners come and go
+	virtual void OnEventCommand(EventCommandEventArgs^ command) override;
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// AggregateInvoked
+	//
+	// Counts an aggregate step or final invocation started at Timestamp()
+	static void AggregateInvoked(__int64 start);
+
+	// BusyWait
+	//
+	// Counts a sleep by the busy handler waiting on a database lock
+	static void BusyWait(void) { if(s_collecting) Interlocked::Increment(s_busyWaits); }
+
+	// BytesBound
+	//
+	// Counts the size of a bound parameter value
+	static void BytesBound(int bytes) { if(s_collecting) Interlocked::Add(s_bytesBound, bytes); }
+
+	// CollationInvoked
+	//
+	// Counts a collation invocation started at Timestamp()
+	static void CollationInvoked(__int64 start);
+
+	// ConnectionClosed
+	//
+	// Removes a database handle before it's released by the connection
+	static void ConnectionClosed(DatabaseHandle* pDatabase);
+
+	// ConnectionOpened
+	//
+	// Adds a newly opened database handle for the engine status values
+	static void ConnectionOpened(DatabaseHandle* pDatabase);
+
+	// FunctionInvoked
+	//
+	// Counts a scalar function invocation started at Timestamp()
+	static void FunctionInvoked(__int64 start);
+
+	// ParametersPinned
+	//
+	// Adjusts the number of parameter values pinned for binding
+	static void ParametersPinned(int count) { Interlocked::Add(s_pinned, count); }
+
+	// RowRead
+	//
+	// Counts a row produced by a statement
+	static void RowRead(void) { if(s_collecting) Interlocked::Increment(s_rowsRead); }
+
+	// StatementPrepared
+	//
+	// Counts a statement that was prepared
+	static void StatementPrepared(void) { if(s_collecting) Interlocked::Increment(s_prepared); }
+
+	// StatementsReprepared
+	//
+	// Counts statements re-prepared by the engine after a schema change
+	static void StatementsReprepared(int count) { if(s_collecting) Interlocked::Add(s_reprepared, count); }
+
+	// Timestamp
+	//
+	// Gets the start time of a callback invocation, or zero if not collecting
+	static __int64 Timestamp(void) { return (s_collecting) ? Stopwatch::GetTimestamp() : 0; }
+
+private:
+
+	// PRIVATE CONSTRUCTOR
+	SqliteEventSource();
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// CollectMetrics
+	//
+	// Timer callback that samples the values of all the counters
+	static void CollectMetrics(Object^ state);
+
+	// ToMilliseconds
+	//
+	// Converts Stopwatch ticks into milliseconds
+	static double ToMilliseconds(__int64 ticks) { return (ticks * 1000.0) / Stopwatch::Frequency; }
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	Timer^							m_timer;			// Counter sampling timer
+	array<EventCounter^>^			m_counters;			// Provider counters
+
+	static volatile bool			s_collecting;		// Flag if counting
+	static List<IntPtr>^			s_databases = gcnew List<IntPtr>();	// Open handles
+	static __int64					s_prepared;			// Statements prepared
+	static __int64					s_reprepared;		// Statements re-prepared
+	static __int64					s_rowsRead;			// Rows read
+	static __int64					s_bytesBound;		// Parameter bytes bound
+	static __int64					s_pinned;			// Pinned parameter values
+	static __int64					s_functionCalls;	// Scalar function calls
+	static __int64					s_functionTicks;	// Scalar function time
+	static __int64					s_aggregateCalls;	// Aggregate calls
+	static __int64					s_aggregateTicks;	// Aggregate time
+	static __int64					s_collationCalls;	// Collation calls
+	static __int64					s_collationTicks;	// Collation time
+	static __int64					s_busyWaits;		// Busy handler sleeps
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
+
+#endif		// __SQLITEEVENTSOURCE_H_
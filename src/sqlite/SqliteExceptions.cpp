@@ -28,19 +28,6 @@
 
 namespace zuki::data::sqlite {
 
-//---------------------------------------------------------------------------
-// SqliteExceptions::BindingTransferException
-//---------------------------------------------------------------------------
-
-SqliteExceptions::BindingTransferException::BindingTransferException(String^ sql, 
-	sqlite3* hDatabase, int nResult) : SqliteException(hDatabase, nResult, GenerateContext(sql)) {}
-
-String^ SqliteExceptions::BindingTransferException::GenerateContext(String^ sql)
-{
-	return String::Format("Transfering parameters for statement [{0}] after the "
-		"statement was recompiled due to a schema change", sql);
-}
-
 //---------------------------------------------------------------------------
 // SqliteExceptions::CommandTypeUnknownException
 //---------------------------------------------------------------------------
@@ -125,6 +112,14 @@ String^ SqliteExceptions::InvalidVirtualTableException::GenerateMessage(Type^ ta
 SqliteExceptions::NoDataPresentException::NoDataPresentException() :
 	InvalidOperationException("Invalid attempt to read when no data is present") {}
 
+//---------------------------------------------------------------------------
+// SqliteExceptions::ObsoleteRowException
+//---------------------------------------------------------------------------
+
+SqliteExceptions::ObsoleteRowException::ObsoleteRowException() :
+	InvalidOperationException("Invalid attempt to read a column value after the "
+		"data reader has moved off of the row it was retrieved from") {}
+
 //---------------------------------------------------------------------------
 // SqliteExceptions::OpenReaderException
 //---------------------------------------------------------------------------
@@ -157,15 +152,19 @@ String^ SqliteExceptions::ParameterBindingException::GenerateMessage(SqliteParam
 }
 
 //---------------------------------------------------------------------------
-// SqliteExceptions::StatementRecompileException
+// SqliteExceptions::SequentialAccessException
 //---------------------------------------------------------------------------
 
-SqliteExceptions::StatementRecompileException::StatementRecompileException(String^ sql, 
-	sqlite3* hDatabase, int nResult) : SqliteException(hDatabase, nResult, GenerateContext(sql)) {}
+SqliteExceptions::SequentialAccessException::SequentialAccessException(String^ operation) :
+	InvalidOperationException(String::Format("{0} cannot be used with SequentialAccess", operation)) {}
+
+SqliteExceptions::SequentialAccessException::SequentialAccessException(int ordinal, int current) :
+	InvalidOperationException(GenerateMessage(ordinal, current)) {}
 
-String^ SqliteExceptions::StatementRecompileException::GenerateContext(String^ sql)
+String^ SqliteExceptions::SequentialAccessException::GenerateMessage(int ordinal, int current)
 {
-	return String::Format("Recompiling statement [{0}] due to schema change", sql);
+	return String::Format("Invalid attempt to read from column ordinal [{0}].  With SequentialAccess, "
+		"only column ordinal [{1}] or greater can be read from the current row", ordinal, current);
 }
 
 //---------------------------------------------------------------------------
@@ -180,6 +179,14 @@ String^ SqliteExceptions::StatementStepException::GenerateContext(String^ sql)
 	return String::Format("Executing statement [{0}]", sql);
 }
 
+//---------------------------------------------------------------------------
+// SqliteExceptions::TransactionRolledBackException
+//---------------------------------------------------------------------------
+
+SqliteExceptions::TransactionRolledBackException::TransactionRolledBackException(Exception^ inner) :
+	InvalidOperationException("The transaction was rolled back by the database engine "
+		"in response to an error; see the inner exception for details", inner) {}
+
 //---------------------------------------------------------------------------
 // SqliteExceptions::UpdateRowSourceUnknownException
 //---------------------------------------------------------------------------
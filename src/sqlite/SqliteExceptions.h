@@ -57,15 +57,6 @@ ref class SqliteParameter;					// SqliteParameter.h
 
 ref struct SqliteExceptions sealed
 {
-	// BindingTransferException (SQLITEEXCEPTION)
-	//
-	// Thrown when parameters cannot be rebound to a recompiled statement
-	ref struct BindingTransferException sealed : public SqliteException
-	{
-		BindingTransferException(String^ sql, sqlite3* hDatabase, int nResult);
-		static String^ GenerateContext(String^ sql);
-	};
-
 	// CommandTypeUnknownException
 	//
 	// Thrown when an invalid SqliteCommandType code is encountered
@@ -129,6 +120,15 @@ ref struct SqliteExceptions sealed
 		NoDataPresentException();
 	};
 
+	// ObsoleteRowException
+	//
+	// Thrown when a column stream or reader is used after the statement it
+	// was created from has moved off of the row it was created for
+	ref struct ObsoleteRowException sealed : public InvalidOperationException
+	{
+		ObsoleteRowException();
+	};
+
 	// OpenReaderException
 	//
 	// Thrown when an attempt is made to modify something about a command
@@ -151,13 +151,15 @@ ref struct SqliteExceptions sealed
 		static String^ GenerateContext(SqliteParameter^ param, int index);
 	};
 
-	// StatementRecompileException (SQLITEEXCEPTION)
+	// SequentialAccessException
 	//
-	// Thrown when a statement fails to recompile after a schema change
-	ref struct StatementRecompileException sealed : public SqliteException
+	// Thrown when a data reader opened with SequentialAccess is asked for a
+	// column that precedes one that has already been read from the row
+	ref struct SequentialAccessException sealed : public InvalidOperationException
 	{
-		StatementRecompileException(String^ sql, sqlite3* hDatabase, int nResult);
-		static String^ GenerateContext(String^ sql);
+		SequentialAccessException(String^ operation);
+		SequentialAccessException(int ordinal, int current);
+		static String^ GenerateMessage(int ordinal, int current);
 	};
 
 	// StatementStepException (SQLITEEXCEPTION)
@@ -169,6 +171,15 @@ ref struct SqliteExceptions sealed
 		static String^ GenerateContext(String^ sql);
 	};
 
+	// TransactionRolledBackException
+	//
+	// Thrown for work that was lost when the engine rolled back an entire
+	// transaction on it's own in response to an error in other work
+	ref struct TransactionRolledBackException sealed : public InvalidOperationException
+	{
+		TransactionRolledBackException(Exception^ inner);
+	};
+
 	// UpdateRowSourceUnknownException
 	//
 	// Thrown when an invalid SqliteUpdateRowSource code is encountered
@@ -244,18 +255,6 @@ internal:
 		"performed against an open database connection.") {}
 };
 
-// ConnectionRollbackException
-//
-// Thrown when a method is called that requires a valid connection and it's in the process
-// of rolling back a nested transaction
-public ref class ConnectionRollbackException sealed : public InvalidOperationException
-{
-internal:
-
-	ConnectionRollbackException() : InvalidOperationException("The database connection "
-		"associated with this operation is in the process of rolling back a nested transaction.") {}
-};
-
 //---------------------------------------------------------------------------
 // PARAMETER EXCEPTIONS
 //---------------------------------------------------------------------------
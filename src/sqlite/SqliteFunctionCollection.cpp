@@ -22,6 +22,7 @@
 
 #include "stdafx.h"					// Include project pre-compiled headers
 #include "SqliteFunctionCollection.h"	// Include SqliteFunctionCollection decls
+#include "SqliteEventSource.h"			// Include SqliteEventSource declarations
 
 #pragma warning(push, 4)			// Enable maximum compiler warnings
 
@@ -42,12 +43,15 @@ namespace zuki::data::sqlite {
 void sqlite_scalar_func(sqlite3_context* context, int argc, sqlite3_value** argv)
 {
 	GCHandleRef<SqliteFunctionWrapper^> func(sqlite3_user_data(context));
+	__int64 start = SqliteEventSource::Timestamp();
 
 	// The invocation logic is really contained in the SqliteFunctionWrapper, so
 	// all we do in here is call that, and convert exceptions into errors
 
 	try { func->Invoke(context, argc, argv); }
 	catch(Exception^ ex) { sqlite3_result_error(context, AutoAnsiString(ex->Message), -1); }
+
+	SqliteEventSource::FunctionInvoked(start);
 }
 
 //---------------------------------------------------------------------------
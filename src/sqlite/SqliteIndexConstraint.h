@@ -24,6 +24,7 @@
 #define __SQLITEINDEXCONSTRAINT_H_
 #pragma once
 
+#include "SqliteArgument.h"				// Include SqliteArgument declarations
 #include "SqliteEnumerations.h"			// Include Sqlite enumeration decls
 
 #pragma warning(push, 4)				// Enable maximum compiler warnings
@@ -50,6 +51,15 @@ public:
 	//-----------------------------------------------------------------------
 	// Properties
 
+	// CanProcessInList
+	//
+	// Determines if this is an IN constraint that can be processed all at
+	// once by the virtual table, see ProcessInList
+	property bool CanProcessInList
+	{
+		bool get(void) { return m_canProcessIn; }
+	}
+
 	// ColumnOrdinal
 	//
 	// Gets the column ordinal on the left-hand size of the constraint
@@ -78,6 +88,14 @@ public:
 		void set(int value) { m_filterArgIndex = value; }
 	}
 
+	// HasRightHandValue
+	//
+	// Determines if the right-hand side of the constraint is a known value
+	property bool HasRightHandValue
+	{
+		bool get(void) { return m_hasRhs; }
+	}
+
 	// IsUsable
 	//
 	// Determines if this constraint is usable or not
@@ -94,18 +112,55 @@ public:
 		SqliteSearchOperator get(void) { return m_op; }
 	}
 
+	// ProcessInList
+	//
+	// Gets/Sets a flag indicating that the virtual table will process all of
+	// the values of an IN constraint in a single Filter() call rather than
+	// being invoked once per value.  Retrieve the values from the Filter()
+	// argument with SqliteArgument.GetInValues()
+	property bool ProcessInList
+	{
+		bool get(void) { return m_processIn; }
+		void set(bool value) { m_processIn = value; }
+	}
+
+	// RightHandValue
+	//
+	// Gets the value on the right-hand side of the constraint, if it is known
+	// at index selection time.  This is always available for LIMIT and OFFSET
+	property Object^ RightHandValue
+	{
+		Object^ get(void) { return m_rhs; }
+	}
+
 internal:
 
 	// INTERNAL CONSTRUCTOR
-	SqliteIndexConstraint(const sqlite3_index_info::sqlite3_index_constraint* constraint,
-		sqlite3_index_info::sqlite3_index_constraint_usage* usage)
+	SqliteIndexConstraint(sqlite3_index_info* info, int index)
 	{
+		sqlite3_value*			pValue = NULL;			// Right-hand value
+
+		const sqlite3_index_info::sqlite3_index_constraint* constraint = &info->aConstraint[index];
+		const sqlite3_index_info::sqlite3_index_constraint_usage* usage = &info->aConstraintUsage[index];
+
 		m_ordinal = constraint->iColumn;
 		m_op = static_cast<SqliteSearchOperator>(constraint->op);
 		m_usable = (constraint->usable != 0);
 
 		m_filterArgIndex = usage->argvIndex;		// Set default value
 		m_doubleCheck = (usage->omit == 0);			// Set default value
+
+		m_canProcessIn = (sqlite3_vtab_in(info, index, -1) != 0);
+
+		// The right-hand value is only available during xBestIndex, so convert
+		// it into a generic object now if the engine can provide one
+
+		if((sqlite3_vtab_rhs_value(info, index, &pValue) == SQLITE_OK) && (pValue != NULL)) {
+
+			SqliteArgument^ value = gcnew SqliteArgument(pValue);
+			try { m_rhs = value->Value; m_hasRhs = true; }
+			finally { delete value; }
+		}
 	}
 
 private:
@@ -118,6 +173,10 @@ private:
 	bool					m_usable;				// aConstraint.usable
 	int						m_filterArgIndex;		// aConstraintUsage.argvIndex
 	bool					m_doubleCheck;			// aConstraintUsage.omit
+	bool					m_canProcessIn;			// sqlite3_vtab_in(-1)
+	bool					m_processIn;			// sqlite3_vtab_in(1)
+	bool					m_hasRhs;				// sqlite3_vtab_rhs_value
+	Object^					m_rhs;					// sqlite3_vtab_rhs_value
 };
 
 //---------------------------------------------------------------------------
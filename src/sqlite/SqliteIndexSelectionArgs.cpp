@@ -43,7 +43,7 @@ SqliteIndexSelectionArgs::SqliteIndexSelectionArgs(sqlite3_index_info* info)
 
 	array<SqliteIndexConstraint^>^ constraints = gcnew array<SqliteIndexConstraint^>(info->nConstraint);
 	for(int index = 0; index < info->nConstraint; index++)
-		constraints[index] = gcnew SqliteIndexConstraint(&info->aConstraint[index], &info->aConstraintUsage[index]);
+		constraints[index] = gcnew SqliteIndexConstraint(info, index);
 
 	m_constraints = Array::AsReadOnly(constraints);		// Store as read-only
 
@@ -61,6 +61,28 @@ SqliteIndexSelectionArgs::SqliteIndexSelectionArgs(sqlite3_index_info* info)
 	m_identifier = gcnew SqliteIndexIdentifier(info->idxNum, info->idxStr);
 	m_sortRequired = (info->orderByConsumed == 0);
 	m_estimatedCost = info->estimatedCost;
+	m_estimatedRows = info->estimatedRows;
+	m_uniqueScan = ((info->idxFlags & SQLITE_INDEX_SCAN_UNIQUE) == SQLITE_INDEX_SCAN_UNIQUE);
+	m_colUsed = info->colUsed;
+	m_distinct = static_cast<SqliteDistinctMode>(sqlite3_vtab_distinct(info));
+}
+
+//---------------------------------------------------------------------------
+// SqliteIndexSelectionArgs::IsColumnUsed
+//
+// Determines if the specified column is used by the statement
+//
+// Arguments:
+//
+//	ordinal		- Column ordinal to be tested
+
+bool SqliteIndexSelectionArgs::IsColumnUsed(int ordinal)
+{
+	if(ordinal < 0) throw gcnew ArgumentOutOfRangeException("ordinal");
+
+	// Bit 63 of colUsed is shared by all columns with an ordinal of 63 or higher
+
+	return ((m_colUsed & (1ui64 << Math::Min(ordinal, 63))) != 0);
 }
 
 //---------------------------------------------------------------------------
@@ -85,6 +107,12 @@ void SqliteIndexSelectionArgs::OutputToStructure(sqlite3_index_info* info)
 		SqliteIndexConstraint^ constraint = m_constraints[index];
 		info->aConstraintUsage[index].argvIndex = constraint->FilterArgumentIndex;
 		info->aConstraintUsage[index].omit = (constraint->DoubleCheck) ? 0 : 1;
+
+		// Constraints processed as a complete IN list need to be flagged as such
+		// with sqlite3_vtab_in(); only valid if they are also passed to Filter()
+
+		if(constraint->ProcessInList && constraint->CanProcessInList && (constraint->FilterArgumentIndex > 0))
+			sqlite3_vtab_in(info, index, 1);
 	}
 
 	info->idxNum = m_identifier->Code;			// Set the identifier code
@@ -97,6 +125,10 @@ void SqliteIndexSelectionArgs::OutputToStructure(sqlite3_index_info* info)
 
 	info->orderByConsumed = (m_sortRequired) ? 0 : 1;	// Set flag opposite
 	info->estimatedCost = m_estimatedCost;				// Set estimated cost
+	info->estimatedRows = m_estimatedRows;				// Set estimated rows
+
+	if(m_uniqueScan) info->idxFlags |= SQLITE_INDEX_SCAN_UNIQUE;
+	else info->idxFlags &= ~SQLITE_INDEX_SCAN_UNIQUE;
 }
 
 //---------------------------------------------------------------------------
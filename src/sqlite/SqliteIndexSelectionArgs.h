@@ -52,9 +52,27 @@ public ref class SqliteIndexSelectionArgs sealed
 {
 public:
 
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// IsColumnUsed
+	//
+	// Determines if the specified column is used by the statement.  Columns
+	// that are not used do not need to be provided by the cursor
+	bool IsColumnUsed(int ordinal);
+
 	//-----------------------------------------------------------------------
 	// Properties
 
+	// ColumnsUsed
+	//
+	// Gets the mask of columns used by the statement.  Bit 63 indicates that
+	// one or more columns with an ordinal of 63 or higher are in use
+	property unsigned __int64 ColumnsUsed
+	{
+		unsigned __int64 get(void) { return m_colUsed; }
+	}
+
 	// Constraints
 	//
 	// Gets a reference to the contained SqliteIndexConstraint collection
@@ -63,6 +81,15 @@ public:
 		ReadOnlyCollection<SqliteIndexConstraint^>^ get(void) { return m_constraints; }
 	}
 
+	// DistinctMode
+	//
+	// Gets a value indicating how the engine will use the rows returned from
+	// the virtual table when SortRequired is set to false
+	property SqliteDistinctMode DistinctMode
+	{
+		SqliteDistinctMode get(void) { return m_distinct; }
+	}
+
 	// EstimatedCost
 	//
 	// Gets/sets a value indicating what the relative cost of the selected index
@@ -74,6 +101,16 @@ public:
 		void set(double value) { m_estimatedCost = value; }
 	}
 
+	// EstimatedRows
+	//
+	// Gets/sets the estimated number of rows that will be returned by the
+	// selected index
+	property __int64 EstimatedRows
+	{
+		__int64 get(void) { return m_estimatedRows; }
+		void set(__int64 value) { m_estimatedRows = value; }
+	}
+
 	// Identifier
 	//
 	// Gets a reference to the contained index identifier class, which wraps up
@@ -101,6 +138,16 @@ public:
 		void set(bool value) { m_sortRequired = value; }
 	}
 
+	// UniqueScan
+	//
+	// Gets/Sets a flag indicating that the selected index will return at most
+	// one row, which allows the engine to plan accordingly
+	property bool UniqueScan
+	{
+		bool get(void) { return m_uniqueScan; }
+		void set(bool value) { m_uniqueScan = value; }
+	}
+
 internal:
 
 	// INTERNAL CONSTRUCTOR
@@ -126,6 +173,10 @@ private:
 	SqliteIndexIdentifier^		m_identifier;				// idxNum, idxStr
 	bool					m_sortRequired;				// orderByConsumed
 	double					m_estimatedCost;			// estimatedCost
+	__int64					m_estimatedRows;			// estimatedRows
+	bool					m_uniqueScan;				// idxFlags
+	unsigned __int64		m_colUsed;					// colUsed
+	SqliteDistinctMode			m_distinct;					// sqlite3_vtab_distinct
 };
 
 //---------------------------------------------------------------------------
@@ -22,12 +22,87 @@
 
 #include "stdafx.h"					// Include project pre-compiled headers
 #include "SqliteMetaData.h"			// Include SqliteMetaData declarations
+#include "SqliteCommand.h"			// Include SqliteCommand declarations
 #include "SqliteConnection.h"			// Include SqliteConnection declarations
+#include "SqliteDataReader.h"			// Include SqliteDataReader declarations
+#include "SqliteParameter.h"			// Include SqliteParameter declarations
 
 #pragma warning(push, 4)			// Enable maximum compiler warnings
 
 namespace zuki::data::sqlite {
 
+//---------------------------------------------------------------------------
+// SqliteMetaData::FillCollection (private, static)
+//
+// Executes a single collection query against the connection and loads the
+// results into a typed DataTable.  Every restriction is bound as a named
+// parameter, unspecified restrictions as NULL, so the query can filter with
+// (:name IS NULL OR ...) predicates rather than filtering rows in managed code
+//
+// Arguments:
+//
+//	conn			- SqliteConnection to execute the query against
+//	dt				- Typed DataTable to be loaded with the results
+//	sql				- Collection query; result columns must match dt
+//	restrictions	- Names of the restrictions supported by the collection
+//	args			- Restriction values provided by the caller
+
+DataTable^ SqliteMetaData::FillCollection(SqliteConnection^ conn, DataTable^ dt, String^ sql,
+	array<String^>^ restrictions, array<String^>^ args)
+{
+	SqliteCommand^			cmd;					// Collection query command
+	SqliteDataReader^		reader = nullptr;		// Collection query results
+	array<Object^>^			values;					// Converted row values
+
+	if(args->Length > restrictions->Length) 
+		throw gcnew ArgumentException(String::Format("More restrictions were provided "
+		"than the requested collection ({0}) supports.", dt->TableName));
+
+	cmd = gcnew SqliteCommand(sql, conn);
+
+	try {
+
+		for(int index = 0; index < restrictions->Length; index++) {
+
+			String^ value = (index < args->Length) ? args[index] : nullptr;
+			cmd->Parameters->Add(gcnew SqliteParameter(":" + restrictions[index], 
+				(value == nullptr) ? DBNull::Value : static_cast<Object^>(value)));
+		}
+
+		values = gcnew array<Object^>(dt->Columns->Count);
+		dt->BeginLoadData();
+
+		try {
+
+			// The pragma functions only report SQLite storage classes, so coerce
+			// each non-NULL value into the data type of the target column
+
+			reader = cmd->ExecuteReader();
+			while(reader->Read()) {
+
+				for(int index = 0; index < values->Length; index++) {
+
+					values[index] = reader->GetValue(index);
+					if(values[index] != DBNull::Value) values[index] = Convert::ChangeType(values[index], 
+						dt->Columns[index]->DataType, CultureInfo::InvariantCulture);
+				}
+
+				dt->LoadDataRow(values, true);
+			}
+		}
+
+		finally { 
+			
+			if(reader != nullptr) delete reader;	// Dispose of the reader
+			dt->EndLoadData();						// Resume notifications
+		}
+	}
+
+	finally { delete cmd; }
+
+	return dt;
+}
+
 //---------------------------------------------------------------------------
 // SqliteMetaData::Generate (static)
 //
@@ -70,12 +145,232 @@ DataTable^ SqliteMetaData::Generate(SqliteConnection^ conn, String^ schema, arra
 	else if(String::Compare(schema, DbMetaDataCollectionNames::ReservedWords, true) == 0)
 		return s_metadata->Tables[DbMetaDataCollectionNames::ReservedWords]->Copy();
 
+	// SQLite: Tables
+	else if(String::Compare(schema, "Tables", true) == 0) return GenerateTables(conn, args);
+
+	// SQLite: Columns
+	else if(String::Compare(schema, "Columns", true) == 0) return GenerateColumns(conn, args);
+
+	// SQLite: Indexes
+	else if(String::Compare(schema, "Indexes", true) == 0) return GenerateIndexes(conn, args);
+
+	// SQLite: IndexColumns
+	else if(String::Compare(schema, "IndexColumns", true) == 0) return GenerateIndexColumns(conn, args);
+
+	// SQLite: ForeignKeys
+	else if(String::Compare(schema, "ForeignKeys", true) == 0) return GenerateForeignKeys(conn, args);
+
+	// SQLite: Views
+	else if(String::Compare(schema, "Views", true) == 0) return GenerateViews(conn, args);
+
 	// Anything else we don't understand generates an ArgumentException ...
 
 	else throw gcnew ArgumentException(String::Format("The requested collection ({0}) "
 		"is not defined.", schema));
 }
 
+//---------------------------------------------------------------------------
+// SqliteMetaData::GenerateColumns (private, static)
+//
+// Generates the Columns collection from pragma_table_xinfo
+//
+// Arguments:
+//
+//	conn		- SqliteConnection requesting a metadata generation
+//	args		- Restrictions: Catalog, Table, Column
+
+DataTable^ SqliteMetaData::GenerateColumns(SqliteConnection^ conn, array<String^>^ args)
+{
+	DataTable^ dt = gcnew DataTable("Columns");
+	dt->Locale = CultureInfo::InvariantCulture;
+
+	dt->Columns->Add("TABLE_CATALOG", String::typeid);
+	dt->Columns->Add("TABLE_NAME", String::typeid);
+	dt->Columns->Add("COLUMN_NAME", String::typeid);
+	dt->Columns->Add("ORDINAL_POSITION", int::typeid);
+	dt->Columns->Add("DATA_TYPE", String::typeid);
+	dt->Columns->Add("COLUMN_DEFAULT", String::typeid);
+	dt->Columns->Add("IS_NULLABLE", bool::typeid);
+	dt->Columns->Add("PRIMARY_KEY_ORDINAL", int::typeid);
+	dt->Columns->Add("IS_HIDDEN", bool::typeid);
+	dt->Columns->Add("IS_GENERATED", bool::typeid);
+
+	// An INTEGER PRIMARY KEY column of a rowid table is an alias for the rowid
+	// and can never be NULL, but it isn't reported as NOT NULL by the pragma
+
+	return FillCollection(conn, dt, "SELECT t.schema, t.name, c.name, c.cid, c.type, "
+		"c.dflt_value, NOT c.\"notnull\" AND NOT (c.pk = 1 AND upper(c.type) = 'INTEGER' AND t.type = 'table' "
+		"AND NOT t.wr AND (SELECT count(*) FROM pragma_table_xinfo(t.name, t.schema) WHERE pk > 0) = 1), "
+		"c.pk, c.hidden = 1, c.hidden IN (2, 3) "
+		"FROM pragma_table_list AS t CROSS JOIN pragma_table_xinfo(t.name, t.schema) AS c "
+		"WHERE (:catalog IS NULL OR t.schema = :catalog) AND (:table IS NULL OR t.name = :table) "
+		"AND (:column IS NULL OR c.name = :column) ORDER BY t.schema, t.name, c.cid",
+		gcnew array<String^>{ "catalog", "table", "column" }, args);
+}
+
+//---------------------------------------------------------------------------
+// SqliteMetaData::GenerateForeignKeys (private, static)
+//
+// Generates the ForeignKeys collection from pragma_foreign_key_list
+//
+// Arguments:
+//
+//	conn		- SqliteConnection requesting a metadata generation
+//	args		- Restrictions: Catalog, Table, ReferencedTable
+
+DataTable^ SqliteMetaData::GenerateForeignKeys(SqliteConnection^ conn, array<String^>^ args)
+{
+	DataTable^ dt = gcnew DataTable("ForeignKeys");
+	dt->Locale = CultureInfo::InvariantCulture;
+
+	dt->Columns->Add("TABLE_CATALOG", String::typeid);
+	dt->Columns->Add("TABLE_NAME", String::typeid);
+	dt->Columns->Add("FOREIGN_KEY_ID", int::typeid);
+	dt->Columns->Add("ORDINAL_POSITION", int::typeid);
+	dt->Columns->Add("COLUMN_NAME", String::typeid);
+	dt->Columns->Add("REFERENCED_TABLE_NAME", String::typeid);
+	dt->Columns->Add("REFERENCED_COLUMN_NAME", String::typeid);
+	dt->Columns->Add("UPDATE_RULE", String::typeid);
+	dt->Columns->Add("DELETE_RULE", String::typeid);
+	dt->Columns->Add("MATCH_OPTION", String::typeid);
+
+	return FillCollection(conn, dt, "SELECT t.schema, t.name, f.id, f.seq, f.\"from\", "
+		"f.\"table\", f.\"to\", f.on_update, f.on_delete, f.\"match\" "
+		"FROM pragma_table_list AS t CROSS JOIN pragma_foreign_key_list(t.name, t.schema) AS f "
+		"WHERE t.type = 'table' AND (:catalog IS NULL OR t.schema = :catalog) "
+		"AND (:table IS NULL OR t.name = :table) AND (:referencedtable IS NULL OR f.\"table\" = :referencedtable) "
+		"ORDER BY t.schema, t.name, f.id, f.seq",
+		gcnew array<String^>{ "catalog", "table", "referencedtable" }, args);
+}
+
+//---------------------------------------------------------------------------
+// SqliteMetaData::GenerateIndexColumns (private, static)
+//
+// Generates the IndexColumns collection from pragma_index_xinfo
+//
+// Arguments:
+//
+//	conn		- SqliteConnection requesting a metadata generation
+//	args		- Restrictions: Catalog, Table, Index, Column
+
+DataTable^ SqliteMetaData::GenerateIndexColumns(SqliteConnection^ conn, array<String^>^ args)
+{
+	DataTable^ dt = gcnew DataTable("IndexColumns");
+	dt->Locale = CultureInfo::InvariantCulture;
+
+	dt->Columns->Add("TABLE_CATALOG", String::typeid);
+	dt->Columns->Add("TABLE_NAME", String::typeid);
+	dt->Columns->Add("INDEX_NAME", String::typeid);
+	dt->Columns->Add("COLUMN_NAME", String::typeid);
+	dt->Columns->Add("ORDINAL_POSITION", int::typeid);
+	dt->Columns->Add("TABLE_ORDINAL", int::typeid);
+	dt->Columns->Add("IS_DESCENDING", bool::typeid);
+	dt->Columns->Add("COLLATION_NAME", String::typeid);
+
+	// Only the key columns of the index are reported; pragma_index_xinfo also
+	// returns the auxiliary rowid/primary key columns with key set to zero.  A
+	// NULL column name indicates an expression, with a table ordinal of -2.
+	// CROSS JOIN keeps the planner from reordering the table-valued functions,
+	// each of which needs the arguments from the one before it
+
+	return FillCollection(conn, dt, "SELECT t.schema, t.name, i.name, x.name, x.seqno, "
+		"x.cid, x.desc, x.coll FROM pragma_table_list AS t "
+		"CROSS JOIN pragma_index_list(t.name, t.schema) AS i CROSS JOIN pragma_index_xinfo(i.name, t.schema) AS x "
+		"WHERE t.type = 'table' AND x.key = 1 AND (:catalog IS NULL OR t.schema = :catalog) "
+		"AND (:table IS NULL OR t.name = :table) AND (:index IS NULL OR i.name = :index) "
+		"AND (:column IS NULL OR x.name = :column) ORDER BY t.schema, t.name, i.name, x.seqno",
+		gcnew array<String^>{ "catalog", "table", "index", "column" }, args);
+}
+
+//---------------------------------------------------------------------------
+// SqliteMetaData::GenerateIndexes (private, static)
+//
+// Generates the Indexes collection from pragma_index_list
+//
+// Arguments:
+//
+//	conn		- SqliteConnection requesting a metadata generation
+//	args		- Restrictions: Catalog, Table, Index
+
+DataTable^ SqliteMetaData::GenerateIndexes(SqliteConnection^ conn, array<String^>^ args)
+{
+	DataTable^ dt = gcnew DataTable("Indexes");
+	dt->Locale = CultureInfo::InvariantCulture;
+
+	dt->Columns->Add("TABLE_CATALOG", String::typeid);
+	dt->Columns->Add("TABLE_NAME", String::typeid);
+	dt->Columns->Add("INDEX_NAME", String::typeid);
+	dt->Columns->Add("IS_UNIQUE", bool::typeid);
+	dt->Columns->Add("IS_PRIMARY_KEY", bool::typeid);
+	dt->Columns->Add("IS_PARTIAL", bool::typeid);
+	dt->Columns->Add("ORIGIN", String::typeid);
+
+	return FillCollection(conn, dt, "SELECT t.schema, t.name, i.name, i.\"unique\", "
+		"i.origin = 'pk', i.partial, i.origin FROM pragma_table_list AS t "
+		"CROSS JOIN pragma_index_list(t.name, t.schema) AS i WHERE t.type = 'table' "
+		"AND (:catalog IS NULL OR t.schema = :catalog) AND (:table IS NULL OR t.name = :table) "
+		"AND (:index IS NULL OR i.name = :index) ORDER BY t.schema, t.name, i.name",
+		gcnew array<String^>{ "catalog", "table", "index" }, args);
+}
+
+//---------------------------------------------------------------------------
+// SqliteMetaData::GenerateTables (private, static)
+//
+// Generates the Tables collection from pragma_table_list
+//
+// Arguments:
+//
+//	conn		- SqliteConnection requesting a metadata generation
+//	args		- Restrictions: Catalog, Table, TableType
+
+DataTable^ SqliteMetaData::GenerateTables(SqliteConnection^ conn, array<String^>^ args)
+{
+	DataTable^ dt = gcnew DataTable("Tables");
+	dt->Locale = CultureInfo::InvariantCulture;
+
+	dt->Columns->Add("TABLE_CATALOG", String::typeid);
+	dt->Columns->Add("TABLE_NAME", String::typeid);
+	dt->Columns->Add("TABLE_TYPE", String::typeid);
+	dt->Columns->Add("COLUMN_COUNT", int::typeid);
+	dt->Columns->Add("WITHOUT_ROWID", bool::typeid);
+	dt->Columns->Add("IS_STRICT", bool::typeid);
+
+	// TABLE_TYPE is reported as TABLE, SYSTEM TABLE, VIRTUAL or SHADOW; the
+	// internal sqlite_ tables are the only ones SQLite itself considers system
+
+	return FillCollection(conn, dt, "SELECT schema, name, table_type, ncol, wr, strict FROM "
+		"(SELECT *, CASE WHEN type = 'table' AND name LIKE 'sqlite\\_%' ESCAPE '\\' THEN 'SYSTEM TABLE' "
+		"ELSE upper(type) END AS table_type FROM pragma_table_list WHERE type <> 'view') "
+		"WHERE (:catalog IS NULL OR schema = :catalog) AND (:table IS NULL OR name = :table) "
+		"AND (:tabletype IS NULL OR table_type = upper(:tabletype)) ORDER BY schema, name",
+		gcnew array<String^>{ "catalog", "table", "tabletype" }, args);
+}
+
+//---------------------------------------------------------------------------
+// SqliteMetaData::GenerateViews (private, static)
+//
+// Generates the Views collection from pragma_table_list
+//
+// Arguments:
+//
+//	conn		- SqliteConnection requesting a metadata generation
+//	args		- Restrictions: Catalog, View
+
+DataTable^ SqliteMetaData::GenerateViews(SqliteConnection^ conn, array<String^>^ args)
+{
+	DataTable^ dt = gcnew DataTable("Views");
+	dt->Locale = CultureInfo::InvariantCulture;
+
+	dt->Columns->Add("TABLE_CATALOG", String::typeid);
+	dt->Columns->Add("TABLE_NAME", String::typeid);
+	dt->Columns->Add("COLUMN_COUNT", int::typeid);
+
+	return FillCollection(conn, dt, "SELECT schema, name, ncol FROM pragma_table_list "
+		"WHERE type = 'view' AND (:catalog IS NULL OR schema = :catalog) "
+		"AND (:view IS NULL OR name = :view) ORDER BY schema, name",
+		gcnew array<String^>{ "catalog", "view" }, args);
+}
+
 //---------------------------------------------------------------------------
 // SqliteMetaData::LoadEmbeddedMetaData (private, static)
 //
@@ -32,6 +32,7 @@
 using namespace System;
 using namespace System::Data;
 using namespace System::Data::Common;
+using namespace System::Globalization;
 using namespace System::IO;
 using namespace System::Reflection;
 
@@ -92,6 +93,14 @@ private:
 	//-----------------------------------------------------------------------
 	// Private Member Functions
 
+	static DataTable^ FillCollection(SqliteConnection^ conn, DataTable^ dt, String^ sql,
+		array<String^>^ restrictions, array<String^>^ args);
+	static DataTable^ GenerateColumns(SqliteConnection^ conn, array<String^>^ args);
+	static DataTable^ GenerateForeignKeys(SqliteConnection^ conn, array<String^>^ args);
+	static DataTable^ GenerateIndexColumns(SqliteConnection^ conn, array<String^>^ args);
+	static DataTable^ GenerateIndexes(SqliteConnection^ conn, array<String^>^ args);
+	static DataTable^ GenerateTables(SqliteConnection^ conn, array<String^>^ args);
+	static DataTable^ GenerateViews(SqliteConnection^ conn, array<String^>^ args);
 	static DataSet^ LoadEmbeddedMetaData(void);
 
 	//-----------------------------------------------------------------------
@@ -22,6 +22,7 @@
 
 #include "stdafx.h"					// Include project pre-compiled headers
 #include "SqliteQuery.h"				// Include SqliteQuery declarations
+#include "SqliteEventSource.h"			// Include SqliteEventSource declarations
 
 #pragma warning(push, 4)			// Enable maximum compiler warnings
 
@@ -34,63 +35,26 @@ namespace zuki::data::sqlite {
 //
 //	pDatabase		- Pointer to the SQLITE database handle wrapper
 //	query			- The complete SQL query to parse into statements
+//	prepared		- Flag if the query is being prepared for repeated execution
+//	lazy			- Flag if statements are compiled as execution reaches them
 
-SqliteQuery::SqliteQuery(DatabaseHandle* pDatabase, String^ query) : m_col(gcnew List<SqliteStatement^>())
+SqliteQuery::SqliteQuery(DatabaseHandle* pDatabase, String^ query, bool prepared, bool lazy) : 
+	m_pDatabase(pDatabase), m_sql((query != nullptr) ? query : String::Empty), 
+	m_lazy(lazy && !prepared), m_col(gcnew List<SqliteStatement^>())
 {
-	PinnedStringPtr			pinSql;			// Pinned SQL string pointer
-	PinnedStringPtr			pinStmt;		// Pointer to the current statement
-	int						nResult;		// Result from function call
-	sqlite3_stmt*			hStatement;		// Next statement handle
-	StatementHandle*		pStatement;		// Statement handle wrapper
-	const void*				pvNext;			// Pointer to the next statement
-	size_t					stmtlen;		// Current statement string length
-	String^					sqlstmt;		// Current SQL statement
-
 	if(!pDatabase) throw gcnew ArgumentNullException();		// Cannot be a NULL handle
-	if(query == nullptr) query = String::Empty;				// Replace NULL with ""
-
-	pinSql = PtrToStringChars(query);		// Pin the SQL string into LPCWSTR
-	pinStmt = pinSql;						// Copy as the initial start point
-
-	try {
-
-		// Continually break up and prepare each distinct SQL statement in the
-		// command text until we hit the NULL terminator
-
-		do {
-
-			nResult = sqlite3_prepare16(pDatabase->Handle, pinStmt, -1, &hStatement, &pvNext);
-
-			// Grab a copy of this particular SQL statement as parsed by the engine
-
-			stmtlen = reinterpret_cast<const wchar_t*>(pvNext) - pinStmt;
-			sqlstmt = query->Substring(static_cast<int>(pinStmt - pinSql), static_cast<int>(stmtlen));
-
-			// If the call to prepare16 failed, throw an exception (now you see why
-			// we take the time to break out a copy of the exact SQL statement)
 
-			if(nResult != SQLITE_OK) throw gcnew SqliteException(pDatabase->Handle, nResult, 
-				String::Format("Preparing SQL statement [{0}]", sqlstmt));
+	// Statements that are going to be kept around for multiple executions are
+	// flagged as persistent so the engine keeps them out of lookaside memory
 
-			// Create a new SqliteStatement object for this statement, and then
-			// add it into our local ArrayList collection for safe keeping ...
+	m_flags = (prepared) ? SQLITE_PREPARE_PERSISTENT : 0;
 
-			if(hStatement) {
-				
-				// It's important to always release the initial reference, just as
-				// if were working with a COM object, since we're not holding the
-				// reference to the wrapped handle anywhere
+	// A lazy query needs to hold onto the database handle itself, since it may
+	// not have any statements (which would otherwise hold it) for a while
 
-				pStatement = new StatementHandle(this, pDatabase, hStatement);
+	m_pDatabase->AddRef(this);
 
-				try { m_col->Add(gcnew SqliteStatement(pStatement, sqlstmt)); }
-				finally { pStatement->Release(this); }
-			}
-
-			pinStmt += stmtlen;					// Move the string pointer along
-		
-		} while(*reinterpret_cast<const wchar_t*>(pvNext));
-	}
+	try { if(!m_lazy) while(PrepareNext()); }
 
 	// It's important to invoke the dtor here, since we need to destroy any
 	// SQL statements that were successfully prepared before the exception
@@ -103,15 +67,27 @@ SqliteQuery::SqliteQuery(DatabaseHandle* pDatabase, String^ query) : m_col(gcnew
 
 SqliteQuery::~SqliteQuery()
 {
+	if(m_disposed) return;
+
 	// Dispose of any and all SqliteStatements that we happen to contain
 	// if this class happens to be deterministically disposed of itself
 
 	for each(SqliteStatement^ statement in m_col) delete statement;
 	m_col->Clear();
 
+	this->!SqliteQuery();				// Invoke the finalizer
 	m_disposed = true;					// Object has been disposed of
 }
 
+//---------------------------------------------------------------------------
+// SqliteQuery Finalizer
+
+SqliteQuery::!SqliteQuery()
+{
+	if(m_pDatabase) m_pDatabase->Release(this);		// Release database handle
+	m_pDatabase = NULL;								// Reset pointer to NULL
+}
+
 //---------------------------------------------------------------------------
 // SqliteQuery::ChangeCount::get
 //
@@ -123,60 +99,126 @@ SqliteQuery::~SqliteQuery()
 
 int SqliteQuery::ChangeCount::get(void)
 {
-	int					changes = 0;		// Total number of changes
+	int					changes = m_changes;		// Total number of changes
 
 	CHECK_DISPOSED(m_disposed);
 
 	// Not too horrible .. just enumerate all the statements and tally up
-	// all of their change counts into a single variable
+	// all of their change counts into a single variable, starting with the
+	// changes made by any statements that have already been released
 
 	for each(SqliteStatement^ statement in m_col) changes += statement->ChangeCount;
 	return changes;
 }
 
 //---------------------------------------------------------------------------
-// SqliteQuery::defualt::get [int]
+// SqliteQuery::GetStatement
 //
-// Returns a SqliteStatement object from the collection via index
+// Gets the statement at the specified index, or nullptr if the query does
+// not contain that many statements
 //
 // Arguments:
 //
-//	index			- Index into the collection
+//	index			- Index of the statement to retrieve
 
-SqliteStatement^ SqliteQuery::default::get(int index)
+SqliteStatement^ SqliteQuery::GetStatement(int index)
 {
 	CHECK_DISPOSED(m_disposed);
-	return m_col[index];
-}
+	if(index < m_first) throw gcnew ArgumentOutOfRangeException("index");
 
-//---------------------------------------------------------------------------
-// SqliteQuery::GetEnumerator
-//
-// Returns an enumerator for SqliteStatement objects
-//
-// Arguments:
-//
-//	NONE
+	// Lazy queries release every statement that execution has moved past, which
+	// keeps only the statement being executed alive at any given time.  Keep the
+	// change count, since that's the only thing anyone may still want from it
 
-Generic::IEnumerator<SqliteStatement^>^ SqliteQuery::GetEnumerator(void)
-{
-	CHECK_DISPOSED(m_disposed);
-	return m_col->GetEnumerator();
+	if(m_lazy) {
+
+		while((m_first < index) && (m_col->Count > 0)) {
+
+			m_changes += m_col[0]->ChangeCount;
+			delete m_col[0];
+			m_col->RemoveAt(0);
+			m_first++;
+		}
+	}
+
+	// Prepare statements from the remaining text until the requested one
+	// has been reached, or there is no more text to be prepared
+
+	while((index - m_first) >= m_col->Count) if(!PrepareNext()) return nullptr;
+
+	return m_col[index - m_first];
 }
 
 //---------------------------------------------------------------------------
-// SqliteQuery::StatementCount::get
+// SqliteQuery::PrepareNext (private)
 //
-// Returns the number of individual statements that have been compiled
+// Prepares the next statement from the remaining query text.  Returns false
+// if there are no statements left to be prepared
 //
 // Arguments:
 //
 //	NONE
 
-int SqliteQuery::StatementCount::get(void)
+bool SqliteQuery::PrepareNext(void)
 {
-	CHECK_DISPOSED(m_disposed);
-	return m_col->Count;
+	PinnedStringPtr			pinSql;			// Pinned SQL string pointer
+	PinnedStringPtr			pinStmt;		// Pointer to the current statement
+	int						nResult;		// Result from function call
+	sqlite3_stmt*			hStatement;		// Next statement handle
+	StatementHandle*		pStatement;		// Statement handle wrapper
+	const void*				pvNext;			// Pointer to the next statement
+	size_t					stmtlen;		// Current statement string length
+	String^					sqlstmt;		// Current SQL statement
+
+	pinSql = PtrToStringChars(m_sql);		// Pin the SQL string into LPCWSTR
+
+	// Continually break up and prepare each distinct SQL statement in the
+	// remaining text until we get one or hit the NULL terminator.  Comments
+	// and whitespace will prepare successfully without a statement handle
+
+	while(m_tail < m_sql->Length) {
+
+		pinStmt = pinSql + m_tail;			// Start at the remaining text
+
+		nResult = sqlite3_prepare16_v3(m_pDatabase->Handle, pinStmt, -1, m_flags, &hStatement, &pvNext);
+
+		// Grab a copy of this particular SQL statement as parsed by the engine
+
+		stmtlen = reinterpret_cast<const wchar_t*>(pvNext) - pinStmt;
+		sqlstmt = m_sql->Substring(m_tail, static_cast<int>(stmtlen));
+
+		// If the call to prepare16_v3 failed, throw an exception (now you see why
+		// we take the time to break out a copy of the exact SQL statement)
+
+		if(nResult != SQLITE_OK) throw gcnew SqliteException(m_pDatabase->Handle, nResult, 
+			String::Format("Preparing SQL statement [{0}]", sqlstmt));
+
+		// Move the offset along; if the engine stopped at the NULL terminator
+		// there is nothing left to prepare after this statement
+
+		m_tail += static_cast<int>(stmtlen);
+		if(*reinterpret_cast<const wchar_t*>(pvNext) == L'\0') m_tail = m_sql->Length;
+
+		if(!hStatement) continue;
+
+		SqliteEventSource::StatementPrepared();
+
+		// Create a new SqliteStatement object for this statement, and then
+		// add it into our local collection for safe keeping ...
+		//
+		// It's important to always release the initial reference, just as
+		// if were working with a COM object, since we're not holding the
+		// reference to the wrapped handle anywhere
+
+		pStatement = new StatementHandle(this, m_pDatabase, hStatement);
+
+		try { m_col->Add(gcnew SqliteStatement(pStatement, sqlstmt)); }
+		finally { pStatement->Release(this); }
+
+		return true;
+	}
+
+	return false;
 }
 
 //---------------------------------------------------------------------------
@@ -32,7 +32,6 @@
 #pragma warning(push, 4)				// Enable maximum compiler warnings
 
 using namespace System;
-using namespace System::Collections;
 using namespace System::Collections::Generic;
 
 namespace zuki::data::sqlite {
@@ -40,27 +39,45 @@ namespace zuki::data::sqlite {
 //---------------------------------------------------------------------------
 // Class SqliteQuery (internal)
 //
-// SqliteQuery implements an enumerable collection of SqliteStatement objects.
-// This collection is build by parsing a single SQL statement string into
+// SqliteQuery implements an ordered collection of SqliteStatement objects.
+// This collection is built by parsing a single SQL statement string into
 // all of it's individual statements.
+//
+// By default every statement is compiled up front, so an error anywhere in
+// the text is reported before any of it has been executed.  A lazy query
+// (see SqliteCommand.LazyPrepare) instead compiles each statement when
+// execution reaches it and releases the statements before it as soon as
+// execution moves past them.  This keeps long scripts from front-loading all
+// of the compile work and memory, and allows a statement to refer to objects
+// created by an earlier one in the same text; the price is that a statement
+// that fails to compile is only reported after the ones before it have run.
+// Queries prepared in advance for repeated execution are never lazy.
 //---------------------------------------------------------------------------
 
-ref class SqliteQuery sealed : public Generic::IEnumerable<SqliteStatement^>
+ref class SqliteQuery sealed
 {
 public:
 
 	// Constructor
 	// 
 	// Accepts an existing SQLITE database handle and the SQL query text
-	SqliteQuery(DatabaseHandle* pDatabase, String^ query);
+	SqliteQuery(DatabaseHandle* pDatabase, String^ query) : SqliteQuery(pDatabase, query, false, false) {}
+
+	// Constructor
+	//
+	// Accepts an existing SQLITE database handle, the SQL query text, a flag
+	// indicating that the query is being prepared for repeated execution and
+	// a flag indicating that the statements should be compiled lazily
+	SqliteQuery(DatabaseHandle* pDatabase, String^ query, bool prepared, bool lazy);
 
 	//-----------------------------------------------------------------------
 	// Member Functions
 
-	// GetEnumerator (IEnumerable<T>)
+	// GetStatement
 	//
-	// Returns an IEnumerator<T> against the member collection
-	virtual Generic::IEnumerator<SqliteStatement^>^ GetEnumerator(void);
+	// Gets the statement at the specified index, or nullptr if there are no 
+	// more statements.  Lazy queries must be accessed in order, see above
+	SqliteStatement^ GetStatement(int index);
 
 	//-----------------------------------------------------------------------
 	// Properties
@@ -70,32 +87,31 @@ public:
 	// Retrieves the total number of rows affected by the entire query
 	property int ChangeCount { int get(void); }
 
-	// StatementCount
-	//
-	// Retrieves the number of statements in the collection
-	property int StatementCount { int get(void); }
-
-	//-----------------------------------------------------------------------
-	// Indexers
-
-	property SqliteStatement^ default[int] { SqliteStatement^ get(int index); }
-
 private:
 
-	// DESTRUCTOR
+	// DESTRUCTOR / FINALIZER
 	~SqliteQuery();
+	!SqliteQuery();
 
 	//-----------------------------------------------------------------------
 	// Private Member Functions
 
-	// IEnumerator::GetEnumerator
-	virtual Collections::IEnumerator^ _GetEnumerator(void) sealed = 
-		Collections::IEnumerable::GetEnumerator { return GetEnumerator(); }
+	// PrepareNext
+	//
+	// Compiles the next statement from the remaining query text
+	bool PrepareNext(void);
 
 	//-----------------------------------------------------------------------
 	// Member Variables
 
 	bool						m_disposed;		// Object disposal flag
+	DatabaseHandle*				m_pDatabase;	// Database handle
+	String^						m_sql;			// Complete SQL query text
+	int							m_tail;			// Offset of remaining text
+	unsigned int				m_flags;		// sqlite3_prepare16_v3 flags
+	bool						m_lazy;			// Flag if preparing lazily
+	int							m_first;		// Index of first statement
+	int							m_changes;		// Released statement changes
 	List<SqliteStatement^>^		m_col;			// Contained collection
 };
 
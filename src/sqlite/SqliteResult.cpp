@@ -379,6 +379,42 @@ void SqliteResult::SetString(String^ value)
 	sqlite3_result_text16(m_context, pinValue, -1, SQLITE_TRANSIENT);
 }
 
+//---------------------------------------------------------------------------
+// SqliteResult::SetValue
+//
+// Sets the result of this function based on the type of a generic object
+//
+// Arguments:
+//
+//	value		- Value to set as the result of this function
+
+void SqliteResult::SetValue(Object^ value)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if((value == nullptr) || (value == DBNull::Value)) return SetNull();
+
+	// SqliteArgument and SqliteBinaryStream only make sense as a function result,
+	// everything else goes through the same coercion as virtual table rows
+
+	Type^ type = value->GetType();
+
+	if(type == SqliteArgument::typeid) return SetArgument(safe_cast<SqliteArgument^>(value));
+	if(type == SqliteBinaryStream::typeid) return SetBinaryStream(safe_cast<SqliteBinaryStream^>(value));
+
+	value = SqliteUtil::CoerceValue(value, 
+		(m_conn != nullptr) ? m_conn->BooleanFormat : SqliteBooleanFormat::OneZero,
+		(m_conn != nullptr) ? m_conn->DateTimeFormat : SqliteDateTimeFormat::ISO8601,
+		(m_conn != nullptr) ? m_conn->GuidFormat : SqliteGuidFormat::Binary);
+
+	type = value->GetType();
+
+	if(type == __int64::typeid) return SetInt64(safe_cast<__int64>(value));
+	if(type == double::typeid) return SetDouble(safe_cast<double>(value));
+	if(type == String::typeid) return SetString(safe_cast<String^>(value));
+	return SetBytes(safe_cast<array<System::Byte>^>(value));
+}
+
 //---------------------------------------------------------------------------
 
 } // zuki::data::sqlite
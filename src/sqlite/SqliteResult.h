@@ -226,12 +226,41 @@ public:
 	// Sets the result to be an unsigned 64bit integer value
 	void SetUInt64(unsigned __int64 value) { SetInt64(static_cast<__int64>(value)); }
 
+	// SetValue
+	//
+	// Sets the result based on the type of a generic object.  Types that have
+	// no native representation, like System.Decimal, are set as strings
+	void SetValue(Object^ value);
+
 internal:
 
 	// INTERNAL CONSTRUCTORS
 	SqliteResult(sqlite3_context* context) : m_context(context) {}
 	SqliteResult(SqliteConnection^ conn, sqlite3_context* context) : m_conn(conn), m_context(context) {}
 
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Attach
+	//
+	// Re-points a detached result at a new context pointer so that a single
+	// instance can be reused rather than constructing one for every value
+	void Attach(sqlite3_context* context) { m_context = context; m_disposed = false; }
+
+	// Detach
+	//
+	// Releases the context pointer; the object acts as if it were disposed
+	// until it has been attached to a new context
+	void Detach(void) { m_context = NULL; m_disposed = true; }
+
+	//-----------------------------------------------------------------------
+	// Internal Properties
+
+	// Handle
+	//
+	// Exposes the internal sqlite3_context handle
+	property sqlite3_context* Handle { sqlite3_context* get(void) { return m_context; } }
+
 private:
 
 	// DESTRUCTOR
@@ -0,0 +1,213 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"					// Include project pre-compiled headers
+#include "SqliteRowBatch.h"			// Include SqliteRowBatch declarations
+#include "SqliteUtil.h"				// Include SqliteUtil declarations
+
+#pragma warning(push, 4)			// Enable maximum compiler warnings
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// SqliteRowBatch::Capacity::get
+//
+// Gets the maximum number of rows that can be written into the batch
+
+int SqliteRowBatch::Capacity::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_batch->Capacity;
+}
+
+//---------------------------------------------------------------------------
+// SqliteRowBatch::CheckCell (private)
+//
+// Verifies that a row and column ordinal are within the batch boundaries
+//
+// Arguments:
+//
+//	row			- Row index within the batch
+//	ordinal		- Column ordinal
+
+void SqliteRowBatch::CheckCell(int row, int ordinal)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if((row < 0) || (row >= m_batch->Capacity)) throw gcnew ArgumentOutOfRangeException("row");
+	if((ordinal < 0) || (ordinal >= m_batch->ColumnCount)) throw gcnew ArgumentOutOfRangeException("ordinal");
+}
+
+//---------------------------------------------------------------------------
+// SqliteRowBatch::ColumnCount::get
+//
+// Gets the number of columns in each row of the batch
+
+int SqliteRowBatch::ColumnCount::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_batch->ColumnCount;
+}
+
+//---------------------------------------------------------------------------
+// SqliteRowBatch::SetBytes
+//
+// Sets a column value to be an array of bytes (BLOB)
+//
+// Arguments:
+//
+//	row			- Row index within the batch
+//	ordinal		- Column ordinal
+//	value		- Value to be set
+
+void SqliteRowBatch::SetBytes(int row, int ordinal, array<System::Byte>^ value)
+{
+	CheckCell(row, ordinal);
+
+	if(value == nullptr) return m_batch->SetNull(row, ordinal);
+	if(value->Length == 0) return m_batch->SetBlob(row, ordinal, NULL, 0);
+
+	PinnedBytePtr pinValue = &value[0];
+	m_batch->SetBlob(row, ordinal, pinValue, value->Length);
+}
+
+//---------------------------------------------------------------------------
+// SqliteRowBatch::SetDouble
+//
+// Sets a column value to be a 64bit floating point value
+//
+// Arguments:
+//
+//	row			- Row index within the batch
+//	ordinal		- Column ordinal
+//	value		- Value to be set
+
+void SqliteRowBatch::SetDouble(int row, int ordinal, double value)
+{
+	CheckCell(row, ordinal);
+	m_batch->SetDouble(row, ordinal, value);
+}
+
+//---------------------------------------------------------------------------
+// SqliteRowBatch::SetInt64
+//
+// Sets a column value to be a 64bit integer value
+//
+// Arguments:
+//
+//	row			- Row index within the batch
+//	ordinal		- Column ordinal
+//	value		- Value to be set
+
+void SqliteRowBatch::SetInt64(int row, int ordinal, __int64 value)
+{
+	CheckCell(row, ordinal);
+	m_batch->SetInt64(row, ordinal, value);
+}
+
+//---------------------------------------------------------------------------
+// SqliteRowBatch::SetNull
+//
+// Sets a column value to be NULL
+//
+// Arguments:
+//
+//	row			- Row index within the batch
+//	ordinal		- Column ordinal
+
+void SqliteRowBatch::SetNull(int row, int ordinal)
+{
+	CheckCell(row, ordinal);
+	m_batch->SetNull(row, ordinal);
+}
+
+//---------------------------------------------------------------------------
+// SqliteRowBatch::SetRowID
+//
+// Sets the ROWID of a row in the batch
+//
+// Arguments:
+//
+//	row			- Row index within the batch
+//	rowid		- ROWID to assign to the row
+
+void SqliteRowBatch::SetRowID(int row, __int64 rowid)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if((row < 0) || (row >= m_batch->Capacity)) throw gcnew ArgumentOutOfRangeException("row");
+	m_batch->SetRowID(row, rowid);
+}
+
+//---------------------------------------------------------------------------
+// SqliteRowBatch::SetString
+//
+// Sets a column value to be a string
+//
+// Arguments:
+//
+//	row			- Row index within the batch
+//	ordinal		- Column ordinal
+//	value		- Value to be set
+
+void SqliteRowBatch::SetString(int row, int ordinal, String^ value)
+{
+	CheckCell(row, ordinal);
+
+	if(value == nullptr) return m_batch->SetNull(row, ordinal);
+
+	PinnedStringPtr pinValue = PtrToStringChars(value);
+	m_batch->SetText(row, ordinal, pinValue, value->Length);
+}
+
+//---------------------------------------------------------------------------
+// SqliteRowBatch::SetValue
+//
+// Sets a column value based on the type of a generic object.  Values are
+// coerced the same way as SqliteResult::SetValue with no connection defaults
+//
+// Arguments:
+//
+//	row			- Row index within the batch
+//	ordinal		- Column ordinal
+//	value		- Value to be set
+
+void SqliteRowBatch::SetValue(int row, int ordinal, Object^ value)
+{
+	value = SqliteUtil::CoerceValue(value, SqliteBooleanFormat::OneZero, SqliteDateTimeFormat::ISO8601, 
+		SqliteGuidFormat::Binary);
+
+	if(value == nullptr) return SetNull(row, ordinal);
+
+	Type^ type = value->GetType();
+
+	if(type == __int64::typeid) return SetInt64(row, ordinal, safe_cast<__int64>(value));
+	if(type == double::typeid) return SetDouble(row, ordinal, safe_cast<double>(value));
+	if(type == String::typeid) return SetString(row, ordinal, safe_cast<String^>(value));
+	return SetBytes(row, ordinal, safe_cast<array<System::Byte>^>(value));
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
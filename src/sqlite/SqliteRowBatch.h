@@ -0,0 +1,142 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __SQLITEROWBATCH_H_
+#define __SQLITEROWBATCH_H_
+#pragma once
+
+#include "RowBatch.h"					// Include RowBatch declarations
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// Class SqliteRowBatch
+//
+// SqliteRowBatch is the managed view of a block of unmanaged row storage that
+// a SqliteBatchVirtualTableCursor fills in.  Values written here are copied
+// directly into native column buffers, which the engine then reads from
+// without calling back into managed code for each row and column
+//---------------------------------------------------------------------------
+
+public ref class SqliteRowBatch sealed
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// SetBytes
+	//
+	// Sets a column value to be an array of bytes (BLOB)
+	void SetBytes(int row, int ordinal, array<System::Byte>^ value);
+
+	// SetDouble
+	//
+	// Sets a column value to be a 64bit floating point value
+	void SetDouble(int row, int ordinal, double value);
+
+	// SetInt32
+	//
+	// Sets a column value to be a 32bit integer value
+	void SetInt32(int row, int ordinal, int value) { SetInt64(row, ordinal, value); }
+
+	// SetInt64
+	//
+	// Sets a column value to be a 64bit integer value
+	void SetInt64(int row, int ordinal, __int64 value);
+
+	// SetNull
+	//
+	// Sets a column value to be NULL.  This is the default for any column
+	// value that is not explicitly set
+	void SetNull(int row, int ordinal);
+
+	// SetRowID
+	//
+	// Sets the ROWID of a row in the batch
+	void SetRowID(int row, __int64 rowid);
+
+	// SetString
+	//
+	// Sets a column value to be a string
+	void SetString(int row, int ordinal, String^ value);
+
+	// SetValue
+	//
+	// Sets a column value based on the type of a generic object
+	void SetValue(int row, int ordinal, Object^ value);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Capacity
+	//
+	// Gets the maximum number of rows that can be written into the batch
+	property int Capacity
+	{
+		int get(void);
+	}
+
+	// ColumnCount
+	//
+	// Gets the number of columns in each row of the batch
+	property int ColumnCount
+	{
+		int get(void);
+	}
+
+internal:
+
+	// INTERNAL CONSTRUCTOR
+	SqliteRowBatch(RowBatch* batch) : m_batch(batch) {}
+
+private:
+
+	// DESTRUCTOR
+	~SqliteRowBatch() { m_batch = NULL; m_disposed = true; }
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// CheckCell
+	//
+	// Verifies that a row and column ordinal are within the batch boundaries
+	void CheckCell(int row, int ordinal);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	bool					m_disposed;			// Object disposal flag
+	RowBatch*				m_batch;			// Unmanaged row storage
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
+
+#endif		// __SQLITEROWBATCH_H_
@@ -22,7 +22,10 @@
 
 #include "stdafx.h"					// Include project pre-compiled headers
 #include "SqliteStatement.h"			// Include SqliteStatement declarations
+#include "SqliteColumnStream.h"		// Include SqliteColumnStream declarations
+#include "SqliteColumnTextReader.h"	// Include SqliteColumnTextReader declarations
 #include "SqliteConnection.h"			// Include SqliteConnection declarations
+#include "SqliteEventSource.h"			// Include SqliteEventSource declarations
 
 #pragma warning(push, 4)			// Enable maximum compiler warnings
 
@@ -101,6 +104,7 @@ void SqliteStatement::BindBinaryParameter(SqliteParameter^ param, int index,
 	// and the pin_ptr<> goes away when we return from this function
 
 	m_pins->Add(GCHandle::Alloc(value, GCHandleType::Pinned));
+	SqliteEventSource::ParametersPinned(1);
 	pinValue = (length) ? &value[0] : nullptr;
 
 	// Attempt to bind the parameter to the statement, using SQLITE_STATIC since it's 
@@ -109,6 +113,8 @@ void SqliteStatement::BindBinaryParameter(SqliteParameter^ param, int index,
 	nResult = sqlite3_bind_blob(m_pStatement->Handle, index, pinValue, length, SQLITE_STATIC);
 	if(nResult != SQLITE_OK) throw gcnew SqliteExceptions::ParameterBindingException(param, 
 		index, m_pStatement->DBHandle, nResult);
+
+	SqliteEventSource::BytesBound(length);
 }
 
 //---------------------------------------------------------------------------
@@ -201,6 +207,8 @@ void SqliteStatement::BindFloatParameter(SqliteParameter^ param, int index, doub
 	int nResult = sqlite3_bind_double(m_pStatement->Handle, index, value);
 	if(nResult != SQLITE_OK) throw gcnew SqliteExceptions::ParameterBindingException(param, 
 		index, m_pStatement->DBHandle, nResult);
+
+	SqliteEventSource::BytesBound(sizeof(double));
 }
 
 //---------------------------------------------------------------------------
@@ -256,6 +264,8 @@ void SqliteStatement::BindIntegerParameter(SqliteParameter^ param, int index, in
 	int nResult = sqlite3_bind_int(m_pStatement->Handle, index, value);
 	if(nResult != SQLITE_OK) throw gcnew SqliteExceptions::ParameterBindingException(param, 
 		index, m_pStatement->DBHandle, nResult);
+
+	SqliteEventSource::BytesBound(sizeof(int));
 }
 
 //---------------------------------------------------------------------------
@@ -274,6 +284,8 @@ void SqliteStatement::BindLongParameter(SqliteParameter^ param, int index, __int
 	int nResult = sqlite3_bind_int64(m_pStatement->Handle, index, value);
 	if(nResult != SQLITE_OK) throw gcnew SqliteExceptions::ParameterBindingException(param, 
 		index, m_pStatement->DBHandle, nResult);
+
+	SqliteEventSource::BytesBound(sizeof(__int64));
 }
 
 //---------------------------------------------------------------------------
@@ -322,6 +334,7 @@ void SqliteStatement::BindStringParameter(SqliteParameter^ param, int index,
 	// and the pin_ptr<> goes away when we return from this function
 
 	m_pins->Add(GCHandle::Alloc(value, GCHandleType::Pinned));
+	SqliteEventSource::ParametersPinned(1);
 	pinValue = (length) ? PtrToStringChars(value) : nullptr;
 
 	// Attempt to bind the parameter to the statement, using SQLITE_STATIC since it's 
@@ -331,6 +344,8 @@ void SqliteStatement::BindStringParameter(SqliteParameter^ param, int index,
 	nResult = sqlite3_bind_text16(m_pStatement->Handle, index, pinValue, length, SQLITE_STATIC);
 	if(nResult != SQLITE_OK) throw gcnew SqliteExceptions::ParameterBindingException(param, 
 		index, m_pStatement->DBHandle, nResult);
+
+	SqliteEventSource::BytesBound(length);
 }
 
 //---------------------------------------------------------------------------
@@ -1246,6 +1261,32 @@ int SqliteStatement::GetProviderSpecificValues(array<Object^>^ values)
 	return count;							// Return number of values copied
 }
 
+//---------------------------------------------------------------------------
+// SqliteStatement::GetValues
+//
+// Loads up an array of Object references with data from the current row,
+// placing each field at a caller-specified position.  This is the path used
+// by SqliteDataAdapter, which resolves the field types once per result set
+// rather than asking the metadata for them on every single row
+//
+// Arguments:
+//
+//	values			- Array of Object references to be loaded with values
+//	positions		- Target position in values[] for each field, or -1 to skip
+//	types			- Data type to coerce each field value into
+
+void SqliteStatement::GetValues(array<Object^>^ values, array<int>^ positions, array<Type^>^ types)
+{
+	CHECK_DISPOSED(m_disposed);
+	if(m_status != SqliteStatementStatus::ResultReady) throw gcnew SqliteExceptions::NoDataPresentException();
+
+	if(positions->Length != m_metadata->FieldCount) throw gcnew ArgumentException();
+	if(types->Length != m_metadata->FieldCount) throw gcnew ArgumentException();
+
+	for(int index = 0; index < positions->Length; index++)
+		if(positions[index] >= 0) values[positions[index]] = GetValueAs(index, types[index]);
+}
+
 //---------------------------------------------------------------------------
 // SqliteStatement::GetSchemaTable
 //
@@ -1261,6 +1302,28 @@ DataTable^ SqliteStatement::GetSchemaTable(void)
 	return m_metadata->BuildSchemaTable();
 }
 
+//---------------------------------------------------------------------------
+// SqliteStatement::GetStream
+//
+// Gets the specified column as a read-only Stream over the engine's copy of
+// the value.  The stream is not tracked; it becomes unusable once the
+// statement moves off of the current row
+//
+// Arguments:
+//
+//	ordinal		- Ordinal value of the column to be retrieved
+
+Stream^ SqliteStatement::GetStream(int ordinal)
+{
+	CHECK_DISPOSED(m_disposed);
+	SqliteUtil::CheckDataRecordOrdinal(this, ordinal);
+
+	if(m_status != SqliteStatementStatus::ResultReady) throw gcnew SqliteExceptions::NoDataPresentException();
+	if(sqlite3_column_type(m_pStatement->Handle, ordinal) == SQLITE_NULL) throw gcnew InvalidCastException();
+
+	return gcnew SqliteColumnStream(m_pStatement, ordinal);
+}
+
 //---------------------------------------------------------------------------
 // SqliteStatement::GetString
 //
@@ -1281,6 +1344,27 @@ String^ SqliteStatement::GetString(int ordinal)
 	return gcnew String(reinterpret_cast<const wchar_t*>(sqlite3_column_text16(m_pStatement->Handle, ordinal)));
 }
 
+//---------------------------------------------------------------------------
+// SqliteStatement::GetTextReader
+//
+// Gets the specified column as a TextReader over the engine's copy of the
+// value.  Like GetStream(), the reader is not tracked by the statement
+//
+// Arguments:
+//
+//	ordinal		- Ordinal value of the column to be retrieved
+
+TextReader^ SqliteStatement::GetTextReader(int ordinal)
+{
+	CHECK_DISPOSED(m_disposed);
+	SqliteUtil::CheckDataRecordOrdinal(this, ordinal);
+
+	if(m_status != SqliteStatementStatus::ResultReady) throw gcnew SqliteExceptions::NoDataPresentException();
+	if(sqlite3_column_type(m_pStatement->Handle, ordinal) == SQLITE_NULL) throw gcnew InvalidCastException();
+
+	return gcnew SqliteColumnTextReader(m_pStatement, ordinal);
+}
+
 //---------------------------------------------------------------------------
 // SqliteStatement::GetValue
 //
@@ -1354,8 +1438,14 @@ Object^ SqliteStatement::GetValueAs(int ordinal, Type^ type)
 
 		// SQLITE_BLOB --> SqliteBinaryReader --> targetType
 		case SQLITE_BLOB:
+		{
+			// The reader is only needed long enough to convert the value, so
+			// don't bother adding it to the tracked collection of readers
 
-			return GetBinaryReader(ordinal)->ToType(type, nullptr);;
+			SqliteBinaryReader^ reader = gcnew SqliteBinaryReader(m_pStatement, ordinal);
+			try { return reader->ToType(type, nullptr); }
+			finally { delete safe_cast<IDisposable^>(reader); }
+		}
 
 		// DEFAULT / SQLITE_TEXT --> String^ --> targetType
 		default:
@@ -1415,40 +1505,6 @@ bool SqliteStatement::IsDBNull(int ordinal)
 	return (sqlite3_column_type(m_pStatement->Handle, ordinal) == SQLITE_NULL);
 }
 
-//---------------------------------------------------------------------------
-// SqliteStatement::RecompileStatement (private)
-//
-// Forces a recompile of the SQL statement, usually due to a schema change
-//
-// Arguments:
-//
-//	NONE
-
-void SqliteStatement::RecompileStatement(void)
-{
-	sqlite3_stmt*		hNewStatement;						// New handle
-	PinnedStringPtr		pinSql = PtrToStringChars(m_sql);	// Original SQL
-	int					nResult;							// SQLite result
-
-	// Attempt to recompile the same SQL statement that was originally used
-
-	nResult = sqlite3_prepare16(m_pStatement->DBHandle, pinSql, -1, &hNewStatement, NULL);
-	if(nResult != SQLITE_OK) throw gcnew SqliteExceptions::StatementRecompileException(m_sql,
-		m_pStatement->DBHandle, nResult);
-
-	// Transfer the bound parameters from the old statement to the new one
-	// (This is an extremely handy feature ... I'm glad you can do this)
-
-	nResult = sqlite3_transfer_bindings(m_pStatement->Handle, hNewStatement);
-	if(nResult != SQLITE_OK) throw gcnew SqliteExceptions::BindingTransferException(m_sql,
-		m_pStatement->DBHandle, nResult);
-
-	// NOTE: StatementHandle::operator= releases the previous handle
-	// when you directly assign a new one to it like this
-
-	*m_pStatement = hNewStatement;				// Presto-chango the handle
-}
-
 //---------------------------------------------------------------------------
 // SqliteStatement::Reset
 //
@@ -1464,12 +1520,18 @@ void SqliteStatement::Reset(void)
 
 	CHECK_DISPOSED(m_disposed);
 
-	// Dispose of any outstanding SqliteBinaryReader objects and clear the collection
+	// Dispose of any outstanding SqliteBinaryReader objects and clear the collection;
+	// streams and text readers check the row version instead of being tracked
+
+	if(m_binaries->Count > 0) {
+
+		for each(ITrackableObject^ obj in m_binaries)
+			if(ObjectTracker::IsObjectAlive(obj)) delete obj;
 
-	for each(ITrackableObject^ obj in m_binaries)
-		if(ObjectTracker::IsObjectAlive(obj)) delete obj;
+		m_binaries->Clear();					// Remove all instances
+	}
 
-	m_binaries->Clear();						// Remove all instances
+	m_pStatement->AdvanceRow();					// Invalidate the current row
 
 	// Reset the SQLITE statement handle itself
 
@@ -1484,6 +1546,7 @@ void SqliteStatement::Reset(void)
 	// Unpin any Byte[] and/or String parameter objects by freeing the GCHandle
 
 	for each(GCHandle item in m_pins) item.Free();
+	SqliteEventSource::ParametersPinned(-m_pins->Count);
 	m_pins->Clear();
 
 	m_status = SqliteStatementStatus::Prepared;		// Back to prepared
@@ -1505,6 +1568,22 @@ String^ SqliteStatement::Sql::get(void)
 	return m_sql;
 }
 
+//---------------------------------------------------------------------------
+// SqliteStatement::Statistics::get
+//
+// Gets a snapshot of the sqlite3_stmt_status() counters for this statement.
+// The counters are cumulative for the lifetime of the prepared statement
+//
+// Arguments:
+//
+//	NONE
+
+SqliteStatementStatistics SqliteStatement::Statistics::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return SqliteStatementStatistics(m_pStatement->Handle);
+}
+
 //---------------------------------------------------------------------------
 // SqliteStatement::Status::Get
 //
@@ -1536,32 +1615,34 @@ SqliteStatementStatus SqliteStatement::Step(void)
 
 	CHECK_DISPOSED(m_disposed);
 
-	// Dispose of any outstanding SqliteBinaryReader objects and clear the collection
+	// Dispose of any outstanding SqliteBinaryReader objects and clear the collection;
+	// streams and text readers check the row version instead of being tracked
+
+	if(m_binaries->Count > 0) {
 
-	for each(ITrackableObject^ obj in m_binaries)
-		if(ObjectTracker::IsObjectAlive(obj)) delete obj;
+		for each(ITrackableObject^ obj in m_binaries)
+			if(ObjectTracker::IsObjectAlive(obj)) delete obj;
 
-	m_binaries->Clear();						// Remove all instances
+		m_binaries->Clear();					// Remove all instances
+	}
+
+	m_pStatement->AdvanceRow();					// Invalidate the current row
 
 	nResult = sqlite3_step(m_pStatement->Handle);		// <--- Execute the next step
 
-	// If the step operation failed, and this was the first step of the query,
-	// we can recover and retry if the problem was SQLITE_SCHEMA.  The only way
-	// we can seemingly tell this is to call sqlite3_reset.  (sqlite3_expired 
-	// does not catch every single bad thing that can happen)....
-	ENGINE_ISSUE(3.3.8, "sqlite3_expired does not catch all possible problems");
+	// Statements prepared with sqlite3_prepare16_v3 are transparently re-prepared
+	// by the engine after a schema change, which can only happen on the first step.
+	// Watch the counter so schema churn shows up in the provider metrics
 
-	if((nResult == SQLITE_ERROR) && (m_status == SqliteStatementStatus::Prepared)) {
-		
-		if(sqlite3_reset(m_pStatement->Handle) == SQLITE_SCHEMA) {
-			
-			m_status = SqliteStatementStatus::Error;			// In case of exception
-			RecompileStatement();							// Attempt a recompile
-			nResult = sqlite3_step(m_pStatement->Handle);	// Retry the operation
-		}
+	if(m_status == SqliteStatementStatus::Prepared) {
+
+		int reprepares = sqlite3_stmt_status(m_pStatement->Handle, SQLITE_STMTSTATUS_REPREPARE, 0);
+		if(reprepares != m_reprepares) SqliteEventSource::StatementsReprepared(reprepares - m_reprepares);
+		m_reprepares = reprepares;
 	}
 
 	m_status = static_cast<SqliteStatementStatus>(nResult);
+	if(nResult == SQLITE_ROW) SqliteEventSource::RowRead();
 
 	// If the engine gave us back something other than SQLITE_DONE or SQLITE_ROW,
 	// bad things have happened.  Note: we don't support the retry on busy thing
@@ -34,6 +34,7 @@
 #include "SqliteParameter.h"				// Include SqliteParameter decls
 #include "SqliteParameterCollection.h"		// Include SqliteParameterCollection decls
 #include "SqliteStatementMetaData.h"		// Include SqliteStatementMetaData decls
+#include "SqliteStatementStatistics.h"		// Include SqliteStatementStatistics decls
 #include "SqliteType.h"					// Include SqliteType declarations
 #include "SqliteUtil.h"					// Include SqliteUtil declarations
 
@@ -43,6 +44,7 @@
 using namespace System;
 using namespace System::Collections::Generic;
 using namespace System::Data;
+using namespace System::IO;
 using namespace System::Runtime::InteropServices;
 
 namespace zuki::data::sqlite {
@@ -203,11 +205,21 @@ public:
 	// Generates a DataTable with result set schema information
 	DataTable^ GetSchemaTable(void);
 	
+	// GetStream
+	//
+	// Retrieves the specified value as an untracked read-only stream
+	Stream^ GetStream(int ordinal);
+
 	// GetString (IDataRecord)
 	//
 	// Retrieves the specified value as a string
 	virtual String^ GetString(int ordinal);
 	
+	// GetTextReader
+	//
+	// Retrieves the specified value as an untracked text reader
+	TextReader^ GetTextReader(int ordinal);
+
 	// GetValue (IDataRecord)
 	//
 	// Retrieves the specified value as the type from GetFieldType()
@@ -218,6 +230,12 @@ public:
 	// Retrieves all of the field data as an array of objects
 	virtual int GetValues(array<Object^>^ values);
 
+	// GetValues
+	//
+	// Loads field data into an array at the specified positions, using the
+	// data types that were resolved in advance by the caller
+	void GetValues(array<Object^>^ values, array<int>^ positions, array<Type^>^ types);
+
 	// IsDBNull (IDataRecord)
 	//
 	// Determines if the value of the specified column is NULL
@@ -256,6 +274,11 @@ public:
 	// Gets a reference to the contained SQL text for this statement
 	property String^ Sql { String^ get(void); }
 
+	// Statistics
+	//
+	// Gets a snapshot of the performance counters for this statement
+	property SqliteStatementStatistics Statistics { SqliteStatementStatistics get(void); }
+
 	// Status
 	//
 	// Exposes the current status of the statement
@@ -274,6 +297,26 @@ public:
 	// Gets a field value by name
 	virtual property Object^ default[String^] { Object^ get(String^ name); }
 
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// FormatBoolean
+	//
+	// Massages a boolean value based on a SqliteBooleanFormat
+	static Object^ FormatBoolean(bool value, SqliteBooleanFormat format);
+
+	// FormatDateTime
+	//
+	// Massages a DateTime value based on a SqliteDateTimeFormat
+	static Object^ FormatDateTime(DateTime value, SqliteDateTimeFormat format);
+
+	// FormatGuid
+	//
+	// Massages a Guid value based on a SqliteGuidFormat
+	static Object^ FormatGuid(Guid value, SqliteGuidFormat format);
+
 private:
 
 	// DESTRUCTOR / FINALIZER
@@ -328,30 +371,10 @@ private:
 	// Binds a string parameter from the collection to the statement
 	void BindStringParameter(SqliteParameter^ param, int index, String^ value, int length);
 
-	// FormatBoolean
-	//
-	// Massages a boolean value based on a SqliteBooleanFormat
-	static Object^ FormatBoolean(bool value, SqliteBooleanFormat format);
-
-	// FormatDateTime
-	//
-	// Massages a DateTime value based on a SqliteDateTimeFormat
-	static Object^ FormatDateTime(DateTime value, SqliteDateTimeFormat format);
-
-	// FormatGuid
-	//
-	// Massages a Guid value based on a SqliteGuidFormat
-	static Object^ FormatGuid(Guid value, SqliteGuidFormat format);
-
 	// GetValueAs
 	//
 	// Retrieves the specified value as the specified data type
 	Object^ GetValueAs(int ordinal, Type^ type);
-	
-	// RecompileStatement
-	//
-	// Recompiles the statement after a step fails with a schema error
-	void RecompileStatement(void);
 
 	//-----------------------------------------------------------------------
 	// Member Variables
@@ -362,6 +385,7 @@ private:
 	String^						m_sql;			// Statement SQL command text
 	SqliteStatementStatus			m_status;		// Current statement status
 	int							m_changes;		// Rows affected by query
+	int							m_reprepares;	// Last reprepare count
 	List<GCHandle>^				m_pins;			// Pinned parameters
 	List<ITrackableObject^>^	m_binaries;		// Open SqliteBinaryReaders
 };
@@ -22,6 +22,7 @@
 
 #include "stdafx.h"					// Include project pre-compiled headers
 #include "SqliteStatementMetaData.h"	// Include SqliteStatementMetaData declarations
+#include "SqliteConnection.h"			// Include SqliteConnection declarations
 
 #pragma warning(push, 4)			// Enable maximum compiler warnings
 
@@ -62,20 +63,18 @@ SqliteStatementMetaData::!SqliteStatementMetaData()
 //
 //	schema		- The schema DataTable to add the new row into
 //	ordinal		- Result set field ordinal to build schema info for
+//	cache		- Connection column metadata cache, or NULL if not available
 
-void SqliteStatementMetaData::AddSchemaTableRow(DataTable^ schema, int ordinal)
+void SqliteStatementMetaData::AddSchemaTableRow(DataTable^ schema, int ordinal, SqliteColumnMetaDataCache^ cache)
 {
 	Type^				fieldType;				// Standard .NET field data type
 	String^				columnName;				// Column result set name
 	String^				catalogName;			// Column catalog name
 	String^				tableName;				// Column table name
 	String^				schemaName;				// Column schema name
-	const char*			pszColumnDataType;		// Declared column data type
-	const char*			pszCollationSequence;	// Collation sequence name
-	int					bNotNull;				// NOT NULL flag
-	int					bPrimaryKey;			// PRIMARY KEY flag
-	int					bAutoIncrement;			// AUTOINCREMENT flag
-	int					nResult;				// Result from function call
+	bool				found;					// Flag if column metadata found
+
+	SqliteColumnMetaDataCache::ColumnMetaData	column;		// Column metadata
 
 	DataRow^ row = schema->NewRow();			// Construct the new table row
 
@@ -111,17 +110,18 @@ void SqliteStatementMetaData::AddSchemaTableRow(DataTable^ schema, int ordinal)
 	// SQLite has added a really wonderful new function that lets us get a lot more
 	// information a lot more easily. If the call fails, just leave those particular 
 	// items at their DataRow defaults, or any special default established above.
+	// The connection caches this information, since it's the same for every
+	// statement that references the same table column
 
-	nResult = sqlite3_table_column_metadata(m_pStatement->DBHandle, AutoAnsiString(catalogName),
-		AutoAnsiString(tableName), AutoAnsiString(schemaName), &pszColumnDataType,
-		&pszCollationSequence, &bNotNull, &bPrimaryKey, &bAutoIncrement);
+	if(cache != nullptr) found = cache->GetColumnMetaData(m_pStatement->DBHandle, catalogName, tableName, schemaName, column);
+	else found = SqliteColumnMetaDataCache::LoadColumnMetaData(m_pStatement->DBHandle, catalogName, tableName, schemaName, column);
 	
-	if(nResult == SQLITE_OK) {
+	if(found) {
 
-		row["DataTypeName"]								= SqliteUtil::FastPtrToStringAnsi(pszColumnDataType);
-		row[SchemaTableColumn::IsKey]					= (bPrimaryKey) ? true : false;
-		row[SchemaTableColumn::AllowDBNull]				= (bNotNull) ? false : true;
-		row[SchemaTableOptionalColumn::IsAutoIncrement] = (bAutoIncrement) ? true : false;
+		row["DataTypeName"]								= column.DataTypeName;
+		row[SchemaTableColumn::IsKey]					= column.PrimaryKey;
+		row[SchemaTableColumn::AllowDBNull]				= !column.NotNull;
+		row[SchemaTableOptionalColumn::IsAutoIncrement] = column.AutoIncrement;
 
 		// Since this is definately a base column, we can set up some final items here
 		//
@@ -146,7 +146,32 @@ void SqliteStatementMetaData::AddSchemaTableRow(DataTable^ schema, int ordinal)
 
 DataTable^ SqliteStatementMetaData::BuildSchemaTable(void)
 {
-	DataTable^			schema;			// Schema table to be returned
+	DataTable^					schema;			// Schema table to be generated
+	SqliteConnection^			conn;			// Parent connection instance
+	SqliteColumnMetaDataCache^	cache;			// Column metadata cache
+	String^						cookie;			// Current schema cookie
+	int							reprepares;		// Statement reprepare count
+
+	CHECK_DISPOSED(m_disposed);
+
+	// The schema table only needs to be generated once for a statement, unless
+	// the schema has changed since then.  The engine only re-prepares a statement
+	// when it's stepped, so a schema change made after the last execution would
+	// not be reflected by the reprepare count alone.  A copy is always returned,
+	// the caller is free to do whatever it wants with it
+
+	reprepares = sqlite3_stmt_status(m_pStatement->Handle, SQLITE_STMTSTATUS_REPREPARE, 0);
+	cookie = SqliteUtil::GetSchemaCookie(m_pStatement->DBHandle);
+
+	if((m_schema != nullptr) && (reprepares == m_reprepares) && String::Equals(cookie, m_cookie))
+		return m_schema->Copy();
+
+	// Use the connection-wide column metadata cache if the connection can be
+	// found, after making sure it's not stale with respect to the schema cookie
+
+	conn = SqliteConnection::FindConnection(m_pStatement->DBHandle);
+	cache = (conn != nullptr) ? conn->ColumnMetaData : nullptr;
+	if(cache != nullptr) cache->CheckSchemaCookie(cookie);
 
 	schema = s_template->Clone();		// Clone the template table
 
@@ -154,10 +179,14 @@ DataTable^ SqliteStatementMetaData::BuildSchemaTable(void)
 	// Not everything is going to be populated quite like Microsoft wants
 	// it to be, but such is life.
 
-	for(int index = 0; index < m_fields; index++) AddSchemaTableRow(schema, index);
+	for(int index = 0; index < m_fields; index++) AddSchemaTableRow(schema, index, cache);
 	schema->AcceptChanges();
 
-	return schema;						// Return the generated schema table
+	m_schema = schema;					// Cache the generated schema table
+	m_reprepares = reprepares;			// Remember the reprepare count
+	m_cookie = cookie;					// Remember the schema cookie
+
+	return m_schema->Copy();			// Return a copy of the schema table
 }
 
 //---------------------------------------------------------------------------
@@ -26,6 +26,7 @@
 
 #include "AutoAnsiString.h"				// Include AutoAnsiString declarations
 #include "StatementHandle.h"			// Include StatementHandle declarations
+#include "SqliteColumnMetaDataCache.h"		// Include SqliteColumnMetaDataCache decls
 #include "SqliteSchemaInfo.h"				// Include SqliteSchemaInfo declarations
 #include "SqliteType.h"					// Include SqliteType declarations
 #include "SqliteUtil.h"					// Include SqliteUtil declarations
@@ -143,7 +144,7 @@ private:
 	// AddSchemaTableRow
 	//
 	// Generates a single DataRow for the schema DataTable
-	void AddSchemaTableRow(DataTable^ schema, int ordinal);
+	void AddSchemaTableRow(DataTable^ schema, int ordinal, SqliteColumnMetaDataCache^ cache);
 
 	// CacheFieldTypes
 	//
@@ -162,6 +163,9 @@ private:
 	StatementHandle*		m_pStatement;	// SQLite statement handle
 	int						m_fields;		// Number of statement fields
 	array<FieldTypes>^		m_types;		// Instance type information
+	DataTable^				m_schema;		// Cached schema table
+	int						m_reprepares;	// Reprepare count for m_schema
+	String^					m_cookie;		// Schema cookie for m_schema
 
 	static Dictionary<String^, FieldTypes>^ s_declarationMapper;
 	static DataTable^						s_template;
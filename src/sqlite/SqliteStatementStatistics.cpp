@@ -0,0 +1,123 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"							// Include project pre-compiled headers
+#include "SqliteStatementStatistics.h"			// Include SqliteStatementStatistics
+
+#pragma warning(push, 4)					// Enable maximum compiler warnings
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// SqliteStatementStatistics Constructor (internal)
+//
+// Arguments:
+//
+//	hStatement		- Prepared statement handle to read the counters from
+
+SqliteStatementStatistics::SqliteStatementStatistics(sqlite3_stmt* hStatement)
+{
+	Debug::Assert(hStatement != NULL);
+
+	// Passing zero as the reset flag leaves the counters alone, so that
+	// snapshots can be taken without interfering with each other
+
+	m_fullScanSteps = sqlite3_stmt_status(hStatement, SQLITE_STMTSTATUS_FULLSCAN_STEP, 0);
+	m_sorts = sqlite3_stmt_status(hStatement, SQLITE_STMTSTATUS_SORT, 0);
+	m_autoIndexes = sqlite3_stmt_status(hStatement, SQLITE_STMTSTATUS_AUTOINDEX, 0);
+	m_vmSteps = sqlite3_stmt_status(hStatement, SQLITE_STMTSTATUS_VM_STEP, 0);
+	m_reprepares = sqlite3_stmt_status(hStatement, SQLITE_STMTSTATUS_REPREPARE, 0);
+	m_runs = sqlite3_stmt_status(hStatement, SQLITE_STMTSTATUS_RUN, 0);
+	m_memoryUsed = sqlite3_stmt_status(hStatement, SQLITE_STMTSTATUS_MEMUSED, 0);
+}
+
+//---------------------------------------------------------------------------
+// SqliteStatementStatistics Constructor (private)
+//
+// Arguments:
+//
+//	fullScanSteps	- SQLITE_STMTSTATUS_FULLSCAN_STEP value
+//	sorts			- SQLITE_STMTSTATUS_SORT value
+//	autoIndexes		- SQLITE_STMTSTATUS_AUTOINDEX value
+//	vmSteps			- SQLITE_STMTSTATUS_VM_STEP value
+//	reprepares		- SQLITE_STMTSTATUS_REPREPARE value
+//	runs			- SQLITE_STMTSTATUS_RUN value
+//	memoryUsed		- SQLITE_STMTSTATUS_MEMUSED value
+
+SqliteStatementStatistics::SqliteStatementStatistics(__int64 fullScanSteps, __int64 sorts, __int64 autoIndexes, 
+	__int64 vmSteps, __int64 reprepares, __int64 runs, __int64 memoryUsed) : m_fullScanSteps(fullScanSteps), 
+	m_sorts(sorts), m_autoIndexes(autoIndexes), m_vmSteps(vmSteps), m_reprepares(reprepares), m_runs(runs), 
+	m_memoryUsed(memoryUsed)
+{
+}
+
+//---------------------------------------------------------------------------
+// SqliteStatementStatistics::operator + (static)
+//
+// Memory usage is a gauge, not a counter, so adding it up every time the same
+// statement is executed would grow without bound; the peak value is kept
+
+SqliteStatementStatistics SqliteStatementStatistics::operator +(SqliteStatementStatistics lhs, SqliteStatementStatistics rhs)
+{
+	return SqliteStatementStatistics(lhs.m_fullScanSteps + rhs.m_fullScanSteps, lhs.m_sorts + rhs.m_sorts,
+		lhs.m_autoIndexes + rhs.m_autoIndexes, lhs.m_vmSteps + rhs.m_vmSteps, lhs.m_reprepares + rhs.m_reprepares,
+		lhs.m_runs + rhs.m_runs, Math::Max(lhs.m_memoryUsed, rhs.m_memoryUsed));
+}
+
+//---------------------------------------------------------------------------
+// SqliteStatementStatistics::Difference (internal, static)
+//
+// Determines the counter activity between two snapshots of the same statement
+//
+// Arguments:
+//
+//	current		- Snapshot taken after the statement was executed
+//	baseline	- Snapshot taken before the statement was executed
+
+SqliteStatementStatistics SqliteStatementStatistics::Difference(SqliteStatementStatistics current, 
+	SqliteStatementStatistics baseline)
+{
+	return SqliteStatementStatistics(current.m_fullScanSteps - baseline.m_fullScanSteps, current.m_sorts - baseline.m_sorts,
+		current.m_autoIndexes - baseline.m_autoIndexes, current.m_vmSteps - baseline.m_vmSteps, 
+		current.m_reprepares - baseline.m_reprepares, current.m_runs - baseline.m_runs, current.m_memoryUsed);
+}
+
+//---------------------------------------------------------------------------
+// SqliteStatementStatistics::ToString
+//
+// Formats the statistics into a single line for diagnostic output
+//
+// Arguments:
+//
+//	NONE
+
+String^ SqliteStatementStatistics::ToString(void)
+{
+	return String::Format("FullScanSteps={0}, Sorts={1}, AutoIndexes={2}, VirtualMachineSteps={3}, Reprepares={4}, Runs={5}, MemoryUsed={6}",
+		m_fullScanSteps, m_sorts, m_autoIndexes, m_vmSteps, m_reprepares, m_runs, m_memoryUsed);
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
@@ -0,0 +1,148 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __SQLITESTATEMENTSTATISTICS_H_
+#define __SQLITESTATEMENTSTATISTICS_H_
+#pragma once
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Diagnostics;
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// Class SqliteStatementStatistics
+//
+// Snapshot of the sqlite3_stmt_status() performance counters for one or more
+// statements.  These are collected for every statement that is executed, and
+// are aggregated by SqliteDataReader, SqliteCommand and (optionally) by the
+// command text on SqliteConnection.  Full table scan steps and automatic
+// indexes are the usual indications of a missing index.
+//
+// MemoryUsed is a gauge rather than a counter; combining statistics keeps the
+// peak value instead of adding it up, every other property is a counter.
+//---------------------------------------------------------------------------
+
+public value class SqliteStatementStatistics
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Overloaded Operators
+
+	// Addition
+	//
+	// Combines the statistics of two sets of statements.  The counters are
+	// added together, MemoryUsed is the larger of the two values
+	static SqliteStatementStatistics operator +(SqliteStatementStatistics lhs, SqliteStatementStatistics rhs);
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// ToString (Object)
+	//
+	// Formats the statistics into a single line for diagnostic output
+	virtual String^ ToString(void) override;
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// AutoIndexes
+	//
+	// Gets the number of rows inserted into automatic (transient) indexes
+	property __int64 AutoIndexes { __int64 get(void) { return m_autoIndexes; } }
+
+	// FullScanSteps
+	//
+	// Gets the number of times a table was stepped forward as part of a full scan
+	property __int64 FullScanSteps { __int64 get(void) { return m_fullScanSteps; } }
+
+	// MemoryUsed
+	//
+	// Gets the number of bytes of heap memory used by the prepared statements.
+	// This is a point-in-time value (the peak, when statistics are combined)
+	property __int64 MemoryUsed { __int64 get(void) { return m_memoryUsed; } }
+
+	// Reprepares
+	//
+	// Gets the number of times the statements were automatically regenerated
+	// due to schema changes or changes to bound parameters
+	property __int64 Reprepares { __int64 get(void) { return m_reprepares; } }
+
+	// Runs
+	//
+	// Gets the number of times the statements were run to completion or reset
+	property __int64 Runs { __int64 get(void) { return m_runs; } }
+
+	// Sorts
+	//
+	// Gets the number of sort operations that were performed
+	property __int64 Sorts { __int64 get(void) { return m_sorts; } }
+
+	// VirtualMachineSteps
+	//
+	// Gets the number of virtual machine operations that were executed
+	property __int64 VirtualMachineSteps { __int64 get(void) { return m_vmSteps; } }
+
+internal:
+
+	// INTERNAL CONSTRUCTOR
+	//
+	// Reads the current counters of a prepared statement
+	SqliteStatementStatistics(sqlite3_stmt* hStatement);
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Difference (static)
+	//
+	// Determines the counter activity between two snapshots of the same
+	// statement.  Memory usage is not a counter; the current value is kept
+	static SqliteStatementStatistics Difference(SqliteStatementStatistics current, SqliteStatementStatistics baseline);
+
+private:
+
+	// PRIVATE CONSTRUCTOR
+	SqliteStatementStatistics(__int64 fullScanSteps, __int64 sorts, __int64 autoIndexes, __int64 vmSteps,
+		__int64 reprepares, __int64 runs, __int64 memoryUsed);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	__int64					m_fullScanSteps;	// SQLITE_STMTSTATUS_FULLSCAN_STEP
+	__int64					m_sorts;			// SQLITE_STMTSTATUS_SORT
+	__int64					m_autoIndexes;		// SQLITE_STMTSTATUS_AUTOINDEX
+	__int64					m_vmSteps;			// SQLITE_STMTSTATUS_VM_STEP
+	__int64					m_reprepares;		// SQLITE_STMTSTATUS_REPREPARE
+	__int64					m_runs;				// SQLITE_STMTSTATUS_RUN
+	__int64					m_memoryUsed;		// SQLITE_STMTSTATUS_MEMUSED
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
+
+#endif		// __SQLITESTATEMENTSTATISTICS_H_
@@ -0,0 +1,220 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"						// Include project pre-compiled headers
+#include "SqliteTableValuedFunction.h"		// Include SqliteTableValuedFunction decls
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// SqliteTableValuedFunction Constructor
+//
+// Arguments:
+//
+//	columns			- Names of the result columns
+//	parameters		- Names of the function parameters
+
+SqliteTableValuedFunction::SqliteTableValuedFunction(array<String^>^ columns, array<String^>^ parameters)
+{
+	Construct(columns, parameters);
+}
+
+//---------------------------------------------------------------------------
+// SqliteTableValuedFunction Constructor
+//
+// Arguments:
+//
+//	columns			- Names of the result columns
+//	parameters		- Names of the function parameters
+//	batchSize		- Maximum number of rows to request from FillBatch()
+
+SqliteTableValuedFunction::SqliteTableValuedFunction(array<String^>^ columns, array<String^>^ parameters, 
+	int batchSize) : SqliteBatchVirtualTableCursor(batchSize)
+{
+	Construct(columns, parameters);
+}
+
+//---------------------------------------------------------------------------
+// SqliteTableValuedFunction Destructor
+
+SqliteTableValuedFunction::~SqliteTableValuedFunction()
+{
+	if(m_disposed) return;
+
+	this->!SqliteTableValuedFunction();
+	m_disposed = true;
+}
+
+//---------------------------------------------------------------------------
+// SqliteTableValuedFunction Finalizer
+
+SqliteTableValuedFunction::!SqliteTableValuedFunction()
+{
+	ReleaseValues();						// Release parameter values
+
+	if(m_pValues) delete[] m_pValues;		// Release the array itself
+	m_pValues = NULL;						// Reset pointer to NULL
+}
+
+//---------------------------------------------------------------------------
+// SqliteTableValuedFunction::Construct (private)
+//
+// Common constructor implementation
+//
+// Arguments:
+//
+//	columns			- Names of the result columns
+//	parameters		- Names of the function parameters
+
+void SqliteTableValuedFunction::Construct(array<String^>^ columns, array<String^>^ parameters)
+{
+	if(columns == nullptr) throw gcnew ArgumentNullException("columns");
+	if(parameters == nullptr) throw gcnew ArgumentNullException("parameters");
+	if(columns->Length == 0) throw gcnew ArgumentException("At least one result column must be specified", "columns");
+	if(parameters->Length > MAX_PARAMETERS) throw gcnew ArgumentOutOfRangeException("parameters");
+
+	m_columns = safe_cast<array<String^>^>(columns->Clone());
+	m_params = safe_cast<array<String^>^>(parameters->Clone());
+	m_args = gcnew array<SqliteArgument^>(m_params->Length);
+
+	// The parameter values are copied with sqlite3_value_dup during each call
+	// so that the hidden columns can be returned without any managed state
+
+	m_pValues = new sqlite3_value*[MAX_PARAMETERS];
+	if(!m_pValues) throw gcnew OutOfMemoryException();
+
+	memset(m_pValues, 0, MAX_PARAMETERS * sizeof(sqlite3_value*));
+}
+
+//---------------------------------------------------------------------------
+// SqliteTableValuedFunction::GetCreateTableStatement (internal)
+//
+// Generates the CREATE TABLE statement used to declare the function schema.
+// The function parameters are declared as HIDDEN columns at the end
+//
+// Arguments:
+//
+//	NONE
+
+String^ SqliteTableValuedFunction::GetCreateTableStatement(void)
+{
+	StringBuilder^ sb = gcnew StringBuilder("CREATE TABLE x(");
+
+	for(int index = 0; index < m_columns->Length; index++) {
+
+		if(index > 0) sb->Append(", ");
+		sb->Append("[")->Append(m_columns[index]->Replace("]", "]]"))->Append("]");
+	}
+
+	for each(String^ param in m_params) 
+		sb->Append(", [")->Append(param->Replace("]", "]]"))->Append("] HIDDEN");
+
+	return sb->Append(")")->ToString();
+}
+
+//---------------------------------------------------------------------------
+// SqliteTableValuedFunction::GetHiddenValue (internal)
+//
+// Gets the value of a hidden parameter column.  The result columns are held
+// in the batch and never get here
+//
+// Arguments:
+//
+//	ordinal		- Ordinal of the column to retrieve
+//	result		- Result object to receive the value
+
+void SqliteTableValuedFunction::GetHiddenValue(int ordinal, SqliteResult^ result)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(ordinal >= (m_columns->Length + m_params->Length)) throw gcnew ArgumentOutOfRangeException("ordinal");
+
+	sqlite3_value* pValue = m_pValues[ordinal - m_columns->Length];
+	if(pValue) sqlite3_result_value(result->Handle, pValue);
+	else sqlite3_result_null(result->Handle);
+}
+
+//---------------------------------------------------------------------------
+// SqliteTableValuedFunction::ReleaseValues (private)
+//
+// Releases the copies of the parameter values from the last call
+//
+// Arguments:
+//
+//	NONE
+
+void SqliteTableValuedFunction::ReleaseValues(void)
+{
+	if(!m_pValues) return;
+
+	for(int index = 0; index < MAX_PARAMETERS; index++) {
+
+		if(m_pValues[index]) sqlite3_value_free(m_pValues[index]);
+		m_pValues[index] = NULL;
+	}
+}
+
+//---------------------------------------------------------------------------
+// SqliteTableValuedFunction::SetBatchFilter
+//
+// Maps the filter arguments onto the function parameters and calls Invoke().
+// The index code is a bitmask of the parameters that were provided, in
+// parameter order, see sqlite_tvf_bestindex
+//
+// Arguments:
+//
+//	index		- Index identifier from sqlite_tvf_bestindex
+//	args		- Filter arguments
+
+void SqliteTableValuedFunction::SetBatchFilter(SqliteIndexIdentifier^ index, SqliteArgumentCollection^ args)
+{
+	int					arg = 0;			// Current filter argument
+
+	CHECK_DISPOSED(m_disposed);
+
+	ReleaseValues();						// Release the previous values
+
+	for(int param = 0; param < m_params->Length; param++) {
+
+		if(((index->Code & (1 << param)) != 0) && (arg < args->Count)) {
+
+			m_args[param] = args[arg++];
+			m_pValues[param] = sqlite3_value_dup(m_args[param]->Handle);
+		}
+
+		else m_args[param] = nullptr;
+	}
+
+	// The argument array is reused, so clear it out after the call to prevent
+	// the derived class from hanging onto any detached arguments through it
+
+	try { Invoke(m_args); }
+	finally { Array::Clear(m_args, 0, m_args->Length); }
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
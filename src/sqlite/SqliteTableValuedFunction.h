@@ -0,0 +1,157 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __SQLITETABLEVALUEDFUNCTION_H_
+#define __SQLITETABLEVALUEDFUNCTION_H_
+#pragma once
+
+#include "SqliteArgument.h"					// Include SqliteArgument declarations
+#include "SqliteBatchVirtualTableCursor.h"		// Include SqliteBatchVirtualTableCursor
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Text;
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// Class SqliteTableValuedFunction
+//
+// SqliteTableValuedFunction is the base class for table-valued functions,
+// which are registered as eponymous virtual tables that only exist for the
+// duration of a query and need no CREATE VIRTUAL TABLE statement:
+//
+//	SELECT * FROM split(:csv, ',')
+//
+// The schema is provided as a simple list of result column names and a list
+// of parameter names, which are declared as HIDDEN columns.  Each instance is
+// a batch cursor; Invoke() is called with the arguments and FillBatch() then
+// produces the rows.  The derived class must have a public default constructor.
+//---------------------------------------------------------------------------
+
+public ref class SqliteTableValuedFunction abstract : public SqliteBatchVirtualTableCursor
+{
+protected public:
+
+	// PROTECTED CONSTRUCTORS
+	SqliteTableValuedFunction(array<String^>^ columns, array<String^>^ parameters);
+	SqliteTableValuedFunction(array<String^>^ columns, array<String^>^ parameters, int batchSize);
+
+	//-----------------------------------------------------------------------
+	// Protected/Public Member Functions
+
+	// Close (overridable)
+	//
+	// Invoked when the function cursor is being closed
+	virtual void Close(void) override {}
+
+	// Invoke (must override)
+	//
+	// Invoked when the function is called.  The arguments are provided in the
+	// same order as the parameter names, and are null if they were omitted.
+	// The arguments are only valid for the duration of this call
+	virtual void Invoke(array<SqliteArgument^>^ arguments) abstract;
+
+	// SetBatchFilter
+	//
+	// Maps the filter arguments onto the function parameters and calls Invoke()
+	virtual void SetBatchFilter(SqliteIndexIdentifier^ index, SqliteArgumentCollection^ args) override sealed;
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// GetCreateTableStatement
+	//
+	// Generates the CREATE TABLE statement used to declare the function schema
+	String^ GetCreateTableStatement(void);
+
+	// GetHiddenValue
+	//
+	// Gets the value of a hidden parameter column
+	virtual void GetHiddenValue(int ordinal, SqliteResult^ result) override sealed;
+
+	//-----------------------------------------------------------------------
+	// Internal Properties
+
+	// ParameterCount
+	//
+	// Gets the number of function parameters (hidden columns)
+	property int ParameterCount
+	{
+		int get(void) { return m_params->Length; }
+	}
+
+	// ResultColumnCount
+	//
+	// Gets the number of result columns, not including the hidden columns
+	property int ResultColumnCount
+	{
+		int get(void) { return m_columns->Length; }
+	}
+
+	//-----------------------------------------------------------------------
+	// Internal Constants
+
+	// MAX_PARAMETERS
+	//
+	// Maximum number of parameters, the index selection uses a bitmask
+	literal int MAX_PARAMETERS = 31;
+
+private:
+
+	// DESTRUCTOR / FINALIZER
+	~SqliteTableValuedFunction();
+	!SqliteTableValuedFunction();
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// Construct
+	//
+	// Common constructor implementation
+	void Construct(array<String^>^ columns, array<String^>^ parameters);
+
+	// ReleaseValues
+	//
+	// Releases the copies of the parameter values from the last call
+	void ReleaseValues(void);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	bool						m_disposed;		// Object disposal flag
+	array<String^>^				m_columns;		// Result column names
+	array<String^>^				m_params;		// Parameter column names
+	array<SqliteArgument^>^		m_args;			// Reusable argument array
+	sqlite3_value**				m_pValues;		// Copied parameter values
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
+
+#endif		// __SQLITETABLEVALUEDFUNCTION_H_
@@ -0,0 +1,102 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __SQLITETRACEENTRY_H_
+#define __SQLITETRACEENTRY_H_
+#pragma once
+
+#include "SqliteEnumerations.h"			// Include Sqlite enumeration decls
+#include "TraceRing.h"					// Include TraceRing declarations
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// Class SqliteTraceEntry
+//
+// SqliteTraceEntry is a single entry read from the connection trace buffer,
+// see SqliteConnection::ReadTraceEntries.  The statement text is captured when
+// the entry is recorded and is truncated if it's very long
+//---------------------------------------------------------------------------
+
+public value class SqliteTraceEntry
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// ElapsedTime
+	//
+	// Time taken to execute the statement; only set for Profile entries
+	property TimeSpan ElapsedTime 
+	{ 
+		TimeSpan get(void) { return TimeSpan::FromTicks(m_elapsed / 100); }	// NS -> 100NS TICKS
+	}
+
+	// Event
+	//
+	// The trace event that was recorded
+	property SqliteTraceEventMask Event
+	{
+		SqliteTraceEventMask get(void) { return static_cast<SqliteTraceEventMask>(m_flags & 0xFF); }
+	}
+
+	// IsTrigger
+	//
+	// Flag if a Statement entry was recorded for a trigger program
+	property bool IsTrigger
+	{
+		bool get(void) { return (m_flags & TraceRing::TRACE_TRIGGER) == TraceRing::TRACE_TRIGGER; }
+	}
+
+	// Statement
+	//
+	// The statement text for Statement and Profile entries, otherwise null
+	property String^ Statement { String^ get(void) { return m_statement; } }
+
+internal:
+
+	// INTERNAL CONSTRUCTOR
+	SqliteTraceEntry(const TraceRing::Entry& entry, String^ statement) : 
+		m_flags(entry.Flags), m_elapsed(entry.Elapsed), m_statement(statement) {}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	unsigned int			m_flags;			// SQLITE_TRACE_XXX and TRACE_XXX flags
+	__int64					m_elapsed;			// Elapsed time in nanoseconds
+	String^					m_statement;		// Statement text
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
+
+#endif		// __SQLITETRACEENTRY_H_
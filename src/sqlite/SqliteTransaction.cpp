@@ -34,8 +34,10 @@ namespace zuki::data::sqlite {
 // Arguments:
 //
 //	conn		- Parent SqliteConnection object instance
+//	savepoint	- SAVEPOINT name for a nested transaction, or NULL
 
-SqliteTransaction::SqliteTransaction(SqliteConnection^ conn) : m_conn(conn) {}
+SqliteTransaction::SqliteTransaction(SqliteConnection^ conn, String^ savepoint) : 
+	m_conn(conn), m_savepoint(savepoint) {}
 
 //---------------------------------------------------------------------------
 // SqliteTransaction Destructor
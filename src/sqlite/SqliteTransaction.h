@@ -88,7 +88,25 @@ protected:
 internal:
 
 	// INTERNAL CONSTRUCTOR
-	SqliteTransaction(SqliteConnection^ conn);
+	SqliteTransaction(SqliteConnection^ conn, String^ savepoint);
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// OnClosed
+	//
+	// Invoked by the connection when the transaction has been closed out
+	// as a side effect of rolling back an outer transaction
+	void OnClosed(void) { m_closed = true; }
+
+	//-----------------------------------------------------------------------
+	// Internal Properties
+
+	// Savepoint
+	//
+	// Gets the SAVEPOINT name for a nested transaction, or NULL if this is
+	// the outermost transaction against the connection
+	property String^ Savepoint { String^ get(void) { return m_savepoint; } }
 
 private:
 
@@ -101,6 +119,7 @@ private:
 	bool					m_disposed;			// Object disposal flag
 	bool					m_closed;			// Transaction closed flag
 	SqliteConnection^			m_conn;				// Referenced connection
+	String^					m_savepoint;		// Nested SAVEPOINT name
 };
 
 //---------------------------------------------------------------------------
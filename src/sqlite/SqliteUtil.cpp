@@ -111,10 +111,6 @@ void SqliteUtil::CheckConnectionReady(SqliteConnection^ conn)
 {
 	CheckConnectionValid(conn);
 
-	// If a rollback is in progress, further commands cannot be executed
-
-	if(conn->RollbackInProgress) throw gcnew ConnectionRollbackException();
-
 	if(conn->State == ConnectionState::Open) return;
 
 	// We want to throw a different exception back up if the connection is
@@ -159,6 +155,61 @@ void SqliteUtil::CheckDataRecordOrdinal(IDataRecord^ record, int ordinal)
 	throw gcnew IndexOutOfRangeException();
 }
 
+//---------------------------------------------------------------------------
+// SqliteUtil::CoerceValue (static)
+//
+// Converts a generic object into one of the types that map directly onto a
+// SQLite storage class.  This is shared by everything that accepts an untyped
+// value (function results, virtual table rows) so that they all agree on how
+// things like DateTime and Guid are represented in the database
+//
+// Arguments:
+//
+//	value			- Value to be coerced
+//	booleanFormat	- Format to apply to boolean values
+//	dateTimeFormat	- Format to apply to date/time values
+//	guidFormat		- Format to apply to GUID values
+
+Object^ SqliteUtil::CoerceValue(Object^ value, SqliteBooleanFormat booleanFormat, 
+	SqliteDateTimeFormat dateTimeFormat, SqliteGuidFormat guidFormat)
+{
+	Object^					formatted;			// Formatted boolean value
+
+	if((value == nullptr) || (value == DBNull::Value)) return nullptr;
+
+	// Check for the types that don't have a TypeCode of their own first,
+	// everything else can be handled by switching on the TypeCode
+
+	Type^ type = value->GetType();
+
+	if(type == array<System::Byte>::typeid) return value;
+	if(type == array<__wchar_t>::typeid) return gcnew String(safe_cast<array<__wchar_t>^>(value));
+	if(type == Guid::typeid) return SqliteStatement::FormatGuid(safe_cast<Guid>(value), guidFormat);
+
+	switch(Type::GetTypeCode(type)) {
+
+		case TypeCode::Boolean:
+			formatted = SqliteStatement::FormatBoolean(safe_cast<bool>(value), booleanFormat);
+			return (formatted->GetType() == int::typeid) ? static_cast<__int64>(safe_cast<int>(formatted)) : formatted;
+
+		case TypeCode::DateTime:	return SqliteStatement::FormatDateTime(safe_cast<DateTime>(value), dateTimeFormat);
+		case TypeCode::Char:		return gcnew String(safe_cast<__wchar_t>(value), 1);
+		case TypeCode::Byte:		return static_cast<__int64>(safe_cast<System::Byte>(value));
+		case TypeCode::Double:		return value;
+		case TypeCode::Int16:		return static_cast<__int64>(safe_cast<short>(value));
+		case TypeCode::Int32:		return static_cast<__int64>(safe_cast<int>(value));
+		case TypeCode::Int64:		return value;
+		case TypeCode::SByte:		return static_cast<__int64>(safe_cast<SByte>(value));
+		case TypeCode::Single:		return static_cast<double>(safe_cast<float>(value));
+		case TypeCode::String:		return value;
+		case TypeCode::UInt16:		return static_cast<__int64>(safe_cast<unsigned short>(value));
+		case TypeCode::UInt32:		return static_cast<__int64>(safe_cast<unsigned int>(value));
+		case TypeCode::UInt64:		return static_cast<__int64>(safe_cast<unsigned __int64>(value));
+
+		default: return Convert::ToString(value, CultureInfo::InvariantCulture);
+	}
+}
+
 ////---------------------------------------------------------------------------
 //// SqliteUtil::ColumnDefinitionToType (static)
 ////
@@ -370,6 +421,69 @@ String^ SqliteUtil::FastPtrToStringAnsi(const char *psz, size_t cch)
 	else return gcnew String(rgwsz, 0, int_cch);
 }
 
+//---------------------------------------------------------------------------
+// SqliteUtil::GetSchemaCookie (static)
+//
+// Builds a single value out of the name, file and schema version of every
+// database attached to a connection.  PRAGMA SCHEMA_VERSION on its own only
+// reports the main database, so changes made to the temp database or to an
+// attached database (or attaching and detaching them) would go unnoticed.
+// The schema name can't be bound as a parameter of the pragma, so it has to
+// be run separately against each database as a quoted identifier
+//
+// Arguments:
+//
+//	hDatabase	- SQLite database handle to be used
+
+String^ SqliteUtil::GetSchemaCookie(sqlite3* hDatabase)
+{
+	sqlite3_stmt*			hList;				// Database list statement
+	StringBuilder^			cookie;				// Generated cookie value
+	int						nResult;			// Result from function call
+
+	cookie = gcnew StringBuilder();
+
+	nResult = sqlite3_prepare_v2(hDatabase, "SELECT name, file FROM pragma_database_list ORDER BY seq", -1, &hList, NULL);
+	if(nResult != SQLITE_OK) throw gcnew SqliteException(hDatabase, nResult);
+
+	try {
+
+		while((nResult = sqlite3_step(hList)) == SQLITE_ROW) {
+
+			sqlite3_stmt*	hVersion;			// Schema version statement
+			char*			pszQuery;			// Schema version query
+
+			// %w doubles up any quotes in the schema name for the identifier
+
+			pszQuery = sqlite3_mprintf("PRAGMA \"%w\".schema_version", sqlite3_column_text(hList, 0));
+			if(pszQuery == NULL) throw gcnew OutOfMemoryException();
+
+			nResult = sqlite3_prepare_v2(hDatabase, pszQuery, -1, &hVersion, NULL);
+			sqlite3_free(pszQuery);
+			if(nResult != SQLITE_OK) throw gcnew SqliteException(hDatabase, nResult);
+
+			try {
+
+				nResult = sqlite3_step(hVersion);
+				if(nResult != SQLITE_ROW) throw gcnew SqliteException(hDatabase, nResult);
+
+				if(cookie->Length > 0) cookie->Append('|');
+				cookie->Append(gcnew String(reinterpret_cast<const wchar_t*>(sqlite3_column_text16(hList, 0))))->Append(':');
+				cookie->Append(gcnew String(reinterpret_cast<const wchar_t*>(sqlite3_column_text16(hList, 1))))->Append(':');
+				cookie->Append(sqlite3_column_int(hVersion, 0));
+			}
+
+			finally { sqlite3_finalize(hVersion); }
+		}
+
+		if(nResult != SQLITE_DONE) throw gcnew SqliteException(hDatabase, nResult);
+	}
+
+	finally { sqlite3_finalize(hList); }
+
+	return cookie->ToString();
+}
+
 //---------------------------------------------------------------------------
 // SqliteUtil::PragmaToEncoding (static)
 //
@@ -398,7 +512,8 @@ SqliteTextEncodingMode SqliteUtil::PragmaToEncoding(String^ pragma)
 // SqliteUtil::ValidateDataSource (static)
 //
 // Validates that the specified data source value does not contain any
-// invalid characters.  Takes into account the ":memory:" data source
+// invalid characters.  Takes into account the ":memory:" data source, and
+// URI filenames ("file:"), which are validated by the engine when opened
 //
 // Arguments:
 //
@@ -409,6 +524,7 @@ bool SqliteUtil::ValidateDataSource(String^ dataSource)
 	Debug::Assert(dataSource != nullptr);
 
 	if(String::Compare(dataSource, SqliteDataSource::Memory, true) == 0) return true;
+	if(dataSource->StartsWith("file:", StringComparison::OrdinalIgnoreCase)) return true;
 	return ValidateFileName(dataSource);
 }
 
@@ -73,6 +73,14 @@ public:
 	// IDataRecord helpers
 	static void CheckDataRecordOrdinal(IDataRecord^ record, int ordinal);
 
+	// Generic object coercion
+	//
+	// Converts a generic object into the value that will be handed to SQLite:
+	// nullptr (NULL), Int64 (INTEGER), Double (REAL), String (TEXT) or an
+	// array of bytes (BLOB)
+	static Object^	CoerceValue(Object^ value, SqliteBooleanFormat booleanFormat, 
+		SqliteDateTimeFormat dateTimeFormat, SqliteGuidFormat guidFormat);
+
 	// Simple SQL query processors
 	//
 	// Used internally for simple stuff like PRAGMAs and whatnot
@@ -82,6 +90,11 @@ public:
 	static String^	FastPtrToStringAnsi(const char* psz);
 	static String^	FastPtrToStringAnsi(const char* psz, size_t cch);
 
+	// Schema cookie
+	//
+	// Combines the schema version of every attached database into one value
+	static String^	GetSchemaCookie(sqlite3* hDatabase);
+
 	// SqliteTextEncodingMode <--> PRAGMA ENCODING
 	static String^				EncodingToPragma(SqliteTextEncodingMode encoding);
 	static SqliteTextEncodingMode  PragmaToEncoding(String^ pragma);
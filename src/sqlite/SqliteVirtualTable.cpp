@@ -48,6 +48,7 @@ SqliteVirtualTable<_cursor>::SqliteVirtualTable()
 
 	m_args = SqliteVirtualTableConstructorArgs::Pop();
 	m_pFuncs = new FunctionMap();
+	m_stats = gcnew SqliteVirtualTableStatistics();
 }
 
 //---------------------------------------------------------------------------
@@ -259,6 +260,18 @@ void SqliteVirtualTable<_cursor>::OverrideFunction(String^ name, int argCount,
 	catch(Exception^) { gchandle.Free(); throw; }
 }
 
+//---------------------------------------------------------------------------
+// SqliteVirtualTable::Statistics::get (protected)
+//
+// Exposes the statistics used to estimate the cost of an index selection
+
+generic<class _cursor>
+SqliteVirtualTableStatistics^ SqliteVirtualTable<_cursor>::Statistics::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_stats;
+}
+
 //---------------------------------------------------------------------------
 // SqliteVirtualTable::TableName::get (protected)
 //
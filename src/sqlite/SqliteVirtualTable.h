@@ -34,6 +34,7 @@
 #include "SqliteVirtualTableBase.h"			// Include SqliteVirtualTableBase decls
 #include "SqliteVirtualTableConstructorArgs.h"	// Include SqliteVirtualTableConstructorArgs
 #include "SqliteVirtualTableCursor.h"			// Include SqliteVirtualTableCursor decls
+#include "SqliteVirtualTableStatistics.h"		// Include SqliteVirtualTableStatistics
 
 #pragma warning(push, 4)			// Enable maximum compiler warnings
 #pragma warning(disable:4100)		// "unreferenced formal parameter"
@@ -150,12 +151,13 @@ protected:
 	// Rolls back the current transaction against the virtual table
 	virtual void RollbackTransaction(void) abstract;
 
-	// SelectBestIndex (must override)
+	// SelectBestIndex (overridable)
 	//
 	// Given the provided constraint and order by information, provides the
 	// SQLite engine with the 'best' index to use for a SQL statement against
-	// this virtual table
-	virtual void SelectBestIndex(SqliteIndexSelectionArgs^ args) abstract;
+	// this virtual table.  The base class version consumes no constraints and
+	// estimates the cost of a full table scan from the table Statistics
+	virtual void SelectBestIndex(SqliteIndexSelectionArgs^ args) { Statistics->EstimateCost(args); }
 
 	// UpdateRow (must override)
 	//
@@ -193,6 +195,12 @@ protected:
 	// Exposes the module name used to create the virtual table
 	property String^ ModuleName { String^ get(void); }
 
+	// Statistics
+	//
+	// Exposes the cardinality information used to estimate index costs; see
+	// SqliteVirtualTableStatistics::EstimateCost
+	property SqliteVirtualTableStatistics^ Statistics { SqliteVirtualTableStatistics^ get(void); }
+
 	// TableName
 	//
 	// Exposes the virtual table name
@@ -244,7 +252,10 @@ private:
 	// Private implementation of SqliteVirtualTableBase::CreateCursor
 	virtual SqliteVirtualTableCursor^ CreateCursorInternal(void) sealed = SqliteVirtualTableBase::CreateCursor
 	{
-		return safe_cast<SqliteVirtualTableCursor^>(CreateCursor());
+		SqliteVirtualTableCursor^ cursor = safe_cast<SqliteVirtualTableCursor^>(CreateCursor());
+		if(cursor != nullptr) cursor->ColumnCount = m_columns;
+
+		return cursor;
 	}
 
 	// DataTableToSchema
@@ -278,7 +289,11 @@ private:
 	// Private implementation of SqliteVirtualTableBase::GetSchema
 	virtual String^ GetCreateTableStatementInternal(String^ name) sealed = SqliteVirtualTableBase::GetCreateTableStatement
 	{
-		return DataTableToSchema(name, GetSchema());
+		DataTable^ schema = GetSchema();
+		String^ statement = DataTableToSchema(name, schema);
+
+		m_columns = schema->Columns->Count;		// Used to size bulk row arrays
+		return statement;
 	}
 
 	// InsertRowInternal (SqliteVirtualTableBase)
@@ -352,6 +367,8 @@ private:
 	bool							m_disposed;		// Object disposal flag
 	SqliteVirtualTableConstructorArgs^	m_args;			// Constructor arguments
 	FunctionMap*					m_pFuncs;		// Overloaded functions
+	int								m_columns;		// Number of table columns
+	SqliteVirtualTableStatistics^		m_stats;		// Table statistics
 };
 
 //---------------------------------------------------------------------------
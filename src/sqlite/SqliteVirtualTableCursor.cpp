@@ -0,0 +1,138 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"						// Include project pre-compiled headers
+#include "SqliteVirtualTableCursor.h"		// Include SqliteVirtualTableCursor decls
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// SqliteVirtualTableCursor::Filter (internal)
+//
+// Invokes SetFilter() on the derived cursor.  The argument collection is
+// constructed once and reused for each call.  The index identifier is only
+// constructed again when the engine passes a different idxNum/idxStr pair
+//
+// Arguments:
+//
+//	indexNum		- Implementation specific index number
+//	indexString		- Implementation specific index string
+//	argc			- Number of filter arguments
+//	argv			- Array of filter argument values
+
+bool SqliteVirtualTableCursor::Filter(int indexNum, const char* indexString, int argc, sqlite3_value** argv)
+{
+	m_rowCached = false;				// Any cached row is no longer valid
+
+	if(FilterIndexChanged(indexNum, indexString)) {
+
+		m_filterIndex = gcnew SqliteIndexIdentifier(indexNum, indexString);
+		m_filterCode = m_filterIndex->Code;
+		m_filterDesc = m_filterIndex->Description;
+	}
+
+	if(m_filterArgs == nullptr) m_filterArgs = gcnew SqliteArgumentCollection(argc, argv);
+	else m_filterArgs->Attach(argc, argv);
+
+	// The arguments must always be detached from the sqlite3_values after
+	// the call so the derived class can't hang onto them and access bad data
+
+	try { return SetFilter(m_filterIndex, m_filterArgs); }
+	finally { m_filterArgs->Detach(); }
+}
+
+//---------------------------------------------------------------------------
+// SqliteVirtualTableCursor::FilterIndexChanged (private)
+//
+// Determines if the cached index identifier needs to be constructed again.
+// The identifier is mutable, so one that was modified by the derived class
+// is also considered to have changed.  The idxStr is compared in place to
+// avoid marshaling it, non-ASCII strings are always treated as changed
+//
+// Arguments:
+//
+//	indexNum		- Implementation specific index number
+//	indexString		- Implementation specific index string
+
+bool SqliteVirtualTableCursor::FilterIndexChanged(int indexNum, const char* indexString)
+{
+	int					index;				// Loop index variable
+
+	if(m_filterIndex == nullptr) return true;
+	if((m_filterIndex->Code != m_filterCode) || !Object::ReferenceEquals(m_filterIndex->Description, m_filterDesc)) return true;
+
+	if(indexNum != m_filterCode) return true;
+	if((indexString == NULL) || (m_filterDesc == nullptr)) return ((indexString == NULL) != (m_filterDesc == nullptr));
+
+	for(index = 0; indexString[index] != '\0'; index++) {
+
+		if((index >= m_filterDesc->Length) || (indexString[index] & 0x80)) return true;
+		if(m_filterDesc[index] != static_cast<wchar_t>(indexString[index])) return true;
+	}
+
+	return (index != m_filterDesc->Length);
+}
+
+//---------------------------------------------------------------------------
+// SqliteVirtualTableCursor::GetColumn (internal)
+//
+// Retrieves a single column value for the current row into a result context
+//
+// Arguments:
+//
+//	context			- Result context pointer
+//	ordinal			- Ordinal of the column to retrieve
+
+void SqliteVirtualTableCursor::GetColumn(sqlite3_context* context, int ordinal)
+{
+	if(m_result == nullptr) m_result = gcnew SqliteResult(context);
+	else m_result->Attach(context);
+
+	try {
+
+		// If the derived cursor supports bulk row access, all of the values are
+		// retrieved on the first column request for a row and the remaining ones
+		// are served from the array until the cursor is moved or filtered
+
+		if(m_getRow && !m_rowCached) {
+
+			if(m_row == nullptr) m_row = gcnew array<Object^>(m_columns);
+			else Array::Clear(m_row, 0, m_row->Length);
+
+			m_getRow = GetRow(m_row);
+			m_rowCached = m_getRow;
+		}
+
+		if(m_rowCached && (ordinal < m_row->Length)) m_result->SetValue(m_row[ordinal]);
+		else GetValue(ordinal, m_result);
+	}
+
+	finally { m_result->Detach(); }		// Always detach from the context
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
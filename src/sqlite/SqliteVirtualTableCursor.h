@@ -54,7 +54,7 @@ public ref class SqliteVirtualTableCursor abstract
 protected public:
 
 	// PROTECTED CONSTRUCTOR
-	SqliteVirtualTableCursor() {}
+	SqliteVirtualTableCursor() : m_getRow(true) {}
 
 	//-----------------------------------------------------------------------
 	// Protected/Public Member Functions
@@ -69,9 +69,18 @@ protected public:
 	//
 	virtual __int64 GetRowID(void) abstract;
 
-	// GetValue
+	// GetRow (overridable)
 	//
+	// Retrieves all of the column values for the current row in a single call,
+	// the array will be sized to the number of columns in the table.  Return
+	// false if bulk access is not supported, GetValue() will then be used for
+	// each column instead for the lifetime of the cursor.
+	virtual bool GetRow(array<Object^>^ values) { (values); return false; }
+
+	// GetValue
 	//
+	// Retrieves a single column value for the current row.  The SqliteResult
+	// instance is reused for every column, it's only valid during the call
 	virtual void GetValue(int ordinal, SqliteResult^ result) abstract;
 
 	// MoveNext
@@ -87,6 +96,62 @@ protected public:
 	// represent all constraints set up with a .FilterArgumentIndex from that
 	// same call into SqliteVirtualTable::SelectBestIndex().
 	virtual bool SetFilter(SqliteIndexIdentifier^ index, SqliteArgumentCollection^ args) abstract;
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Filter
+	//
+	// Invokes SetFilter() using the cursor's reusable filter objects
+	bool Filter(int indexNum, const char* indexString, int argc, sqlite3_value** argv);
+
+	// GetColumn
+	//
+	// Retrieves a single column value into a result context, using either the
+	// cached bulk row values or GetValue() as appropriate
+	void GetColumn(sqlite3_context* context, int ordinal);
+
+	// Next
+	//
+	// Invokes MoveNext() and invalidates any cached bulk row values
+	bool Next(void) { m_rowCached = false; return MoveNext(); }
+
+	//-----------------------------------------------------------------------
+	// Internal Properties
+
+	// ColumnCount
+	//
+	// Gets/sets the number of columns in the parent virtual table
+	property int ColumnCount
+	{
+		int get(void) { return m_columns; }
+		void set(int value) { m_columns = value; }
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// FilterIndexChanged
+	//
+	// Determines if the cached index identifier no longer matches idxNum/idxStr
+	bool FilterIndexChanged(int indexNum, const char* indexString);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	int							m_columns;			// Number of table columns
+	SqliteResult^				m_result;			// Reusable column result
+	SqliteIndexIdentifier^		m_filterIndex;		// Reusable filter index
+	int							m_filterCode;		// idxNum of m_filterIndex
+	String^						m_filterDesc;		// idxStr of m_filterIndex
+	SqliteArgumentCollection^	m_filterArgs;		// Reusable filter arguments
+	array<Object^>^				m_row;				// Bulk row values
+	bool						m_rowCached;		// Flag if m_row is current
+	bool						m_getRow;			// Flag if GetRow() is supported
 };
 
 //---------------------------------------------------------------------------
@@ -29,6 +29,20 @@
 
 namespace zuki::data::sqlite {
 
+//---------------------------------------------------------------------------
+// Struct sqlite_tvf
+//
+// Minimal sqlite3_vtab extension used for table-valued functions.  There is
+// no managed table object, just the function type and the column layout
+//---------------------------------------------------------------------------
+
+struct sqlite_tvf : public sqlite3_vtab
+{
+	void*				type;				// Serialized function Type GCHandle
+	int					columns;			// Number of result columns
+	int					parameters;			// Number of hidden parameter columns
+};
+
 //---------------------------------------------------------------------------
 // Local Function Prototypes
 //---------------------------------------------------------------------------
@@ -54,6 +68,12 @@ static int sqlite_vtab_rollback	(sqlite3_vtab*);
 static int sqlite_vtab_rowid		(sqlite3_vtab_cursor*, sqlite_int64*);
 static int sqlite_vtab_sync		(sqlite3_vtab*);
 static int sqlite_vtab_update		(sqlite3_vtab*, int, sqlite3_value**, sqlite_int64*);
+static int sqlite_coll_connect		(sqlite3*, void*, int, const char* const*, sqlite3_vtab**, char**);
+static int sqlite_coll_disconnect	(sqlite3_vtab*);
+static int sqlite_tvf_bestindex	(sqlite3_vtab*, sqlite3_index_info*);
+static int sqlite_tvf_connect		(sqlite3*, void*, int, const char* const*, sqlite3_vtab**, char**);
+static int sqlite_tvf_disconnect	(sqlite3_vtab*);
+static int sqlite_tvf_open			(sqlite3_vtab*, sqlite3_vtab_cursor**);
 
 //---------------------------------------------------------------------------
 // sqlite_vtab_module
@@ -64,7 +84,7 @@ static int sqlite_vtab_update		(sqlite3_vtab*, int, sqlite3_value**, sqlite_int6
 
 static const sqlite3_module sqlite_vtab_module = {
 
-	0,							// iVersion
+	3,							// iVersion
 	sqlite_vtab_create,			// xCreate
 	sqlite_vtab_connect,			// xConnect
 	sqlite_vtab_bestindex,			// xBestIndex
@@ -83,6 +103,11 @@ static const sqlite3_module sqlite_vtab_module = {
 	sqlite_vtab_commit,			// xCommit
 	sqlite_vtab_rollback,			// xRollback
 	sqlite_vtab_findfunc,			// xFindFunction
+	NULL,						// xRename
+	NULL,						// xSavepoint
+	NULL,						// xRelease
+	NULL,						// xRollbackTo
+	NULL,						// xShadowName
 };
 
 //---------------------------------------------------------------------------
@@ -94,7 +119,7 @@ static const sqlite3_module sqlite_vtab_module = {
 
 static const sqlite3_module sqlite_vtab_module_notrans = {
 
-	0,							// iVersion
+	3,							// iVersion
 	sqlite_vtab_create,			// xCreate
 	sqlite_vtab_connect,			// xConnect
 	sqlite_vtab_bestindex,			// xBestIndex
@@ -113,6 +138,11 @@ static const sqlite3_module sqlite_vtab_module_notrans = {
 	NULL,						// xCommit
 	NULL,						// xRollback
 	sqlite_vtab_findfunc,			// xFindFunction
+	NULL,						// xRename
+	NULL,						// xSavepoint
+	NULL,						// xRelease
+	NULL,						// xRollbackTo
+	NULL,						// xShadowName
 };
 
 //---------------------------------------------------------------------------
@@ -124,7 +154,7 @@ static const sqlite3_module sqlite_vtab_module_notrans = {
 
 static const sqlite3_module sqlite_vtab_module_readonly = {
 
-	0,							// iVersion
+	3,							// iVersion
 	sqlite_vtab_create,			// xCreate
 	sqlite_vtab_connect,			// xConnect
 	sqlite_vtab_bestindex,			// xBestIndex
@@ -143,8 +173,338 @@ static const sqlite3_module sqlite_vtab_module_readonly = {
 	NULL,						// xCommit
 	NULL,						// xRollback
 	sqlite_vtab_findfunc,			// xFindFunction
+	NULL,						// xRename
+	NULL,						// xSavepoint
+	NULL,						// xRelease
+	NULL,						// xRollbackTo
+	NULL,						// xShadowName
+};
+
+//---------------------------------------------------------------------------
+// sqlite_vtab_module_collection
+//
+// Global structure used for all SqliteCollectionTable registrations.  The
+// table instance belongs to the application, so only the connect and
+// disconnect entry points differ from the read-only virtual tables.  xCreate
+// and xConnect are the same, which also makes these eponymous tables
+
+static const sqlite3_module sqlite_vtab_module_collection = {
+
+	3,							// iVersion
+	sqlite_coll_connect,			// xCreate
+	sqlite_coll_connect,			// xConnect
+	sqlite_vtab_bestindex,			// xBestIndex
+	sqlite_coll_disconnect,		// xDisconnect
+	sqlite_coll_disconnect,		// xDestroy
+	sqlite_vtab_open,				// xOpen
+	sqlite_vtab_close,				// xClose
+	sqlite_vtab_filter,			// xFilter
+	sqlite_vtab_next,				// xNext
+	sqlite_vtab_eof,				// xEof
+	sqlite_vtab_column,			// xColumn
+	sqlite_vtab_rowid,				// xRowid
+	NULL,						// xUpdate
+	NULL,						// xBegin
+	NULL,						// xSync
+	NULL,						// xCommit
+	NULL,						// xRollback
+	NULL,						// xFindFunction
+	NULL,						// xRename
+	NULL,						// xSavepoint
+	NULL,						// xRelease
+	NULL,						// xRollbackTo
+	NULL,						// xShadowName
+};
+
+//---------------------------------------------------------------------------
+// sqlite_vtab_module_tvf
+//
+// Global structure used for all table-valued function registrations.  xCreate
+// is NULL, which makes these eponymous-only virtual tables.  The cursor entry
+// points are shared with the regular virtual tables.
+
+static const sqlite3_module sqlite_vtab_module_tvf = {
+
+	3,							// iVersion
+	NULL,						// xCreate
+	sqlite_tvf_connect,			// xConnect
+	sqlite_tvf_bestindex,			// xBestIndex
+	sqlite_tvf_disconnect,			// xDisconnect
+	sqlite_tvf_disconnect,			// xDestroy
+	sqlite_tvf_open,				// xOpen
+	sqlite_vtab_close,				// xClose
+	sqlite_vtab_filter,			// xFilter
+	sqlite_vtab_next,				// xNext
+	sqlite_vtab_eof,				// xEof
+	sqlite_vtab_column,			// xColumn
+	sqlite_vtab_rowid,				// xRowid
+	NULL,						// xUpdate
+	NULL,						// xBegin
+	NULL,						// xSync
+	NULL,						// xCommit
+	NULL,						// xRollback
+	NULL,						// xFindFunction
+	NULL,						// xRename
+	NULL,						// xSavepoint
+	NULL,						// xRelease
+	NULL,						// xRollbackTo
+	NULL,						// xShadowName
 };
 
+//---------------------------------------------------------------------------
+// sqlite_coll_connect
+//
+// Implements the xCreate and xConnect callbacks for collection tables.  The
+// module context is the application's SqliteCollectionTable instance itself
+//
+// Arguments:
+//
+//	hDatabase		- SQLite database handle
+//	context			- Context pointer from call to sqlite3_create_module
+//	argc			- Creation argument count
+//	argv			- Creation arguments (see documentation)
+//	ppVirtualTable	- On success, contains the new sqlite3_vtab structure
+//	ppszError		- Provides engine with an error message on failure
+
+static int sqlite_coll_connect(sqlite3* hDatabase, void* context, int argc, const char* const* argv, 
+	sqlite3_vtab** ppVirtualTable, char** ppszError)
+{
+	GCHandleRef<Object^>		instance(context);	// Collection table instance
+	gcroot<String^>				schema;				// Virtual table schema information
+	int							nResult;			// Result from function call
+
+	Debug::Assert(context != NULL);					// Should never be NULL here
+
+	*ppVirtualTable = NULL;					// Initialize [out] pointer to NULL
+	*ppszError = NULL;						// Initialize [out] pointer to NULL
+
+	try {
+
+		VirtualTable& virtualTable = VirtualTable::Create(instance);
+
+		try {
+
+			schema = virtualTable->GetCreateTableStatement(SqliteUtil::FastPtrToStringAnsi(argv[2]));
+
+			nResult = sqlite3_declare_vtab(hDatabase, AutoAnsiString(schema));
+			if(nResult != SQLITE_OK) throw gcnew SqliteException(hDatabase, nResult);
+
+			*ppVirtualTable = &virtualTable;
+		}
+
+		catch(Exception^) { VirtualTable::Destroy(virtualTable); throw; }
+	}
+
+	catch(Exception^ ex) {
+	
+		*ppszError = sqlite3_mprintf(AutoAnsiString(ex->Message));
+		return SQLITE_ERROR;	
+	}
+
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// sqlite_coll_disconnect
+//
+// Implements the xDisconnect and xDestroy callbacks for collection tables.
+// The table instance is shared with the application and every connection it
+// has been registered with, so only the VirtualTable wrapper is destroyed
+//
+// Arguments:
+//
+//	pVirtualTable		- Pointer to the virtual table to be disconnected
+
+static int sqlite_coll_disconnect(sqlite3_vtab* pVirtualTable)
+{
+	VirtualTable::Destroy(VirtualTable::Cast(pVirtualTable));
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// sqlite_tvf_bestindex
+//
+// Implements the xBestIndex callback for table-valued functions.  This is
+// done entirely in unmanaged code; each equality constraint against a hidden
+// parameter column is passed to xFilter in parameter order, and the set of
+// parameters that were provided is encoded as a bitmask in idxNum
+//
+// Arguments:
+//
+//	pVirtualTable		- Pointer to the virtual table
+//	pIndexInfo			- Pointer to index information from the engine
+
+static int sqlite_tvf_bestindex(sqlite3_vtab* pVirtualTable, sqlite3_index_info* pIndexInfo)
+{
+	int				constraints[SqliteTableValuedFunction::MAX_PARAMETERS];	// Constraint per parameter
+	int				usable = 0;			// Mask of usable parameters
+	int				unusable = 0;		// Mask of unusable parameters
+	int				argc = 0;			// Number of xFilter arguments
+
+	sqlite_tvf* pFunction = static_cast<sqlite_tvf*>(pVirtualTable);
+
+	for(int index = 0; index < pIndexInfo->nConstraint; index++) {
+
+		const sqlite3_index_info::sqlite3_index_constraint* pConstraint = &pIndexInfo->aConstraint[index];
+
+		int param = pConstraint->iColumn - pFunction->columns;
+		if((param < 0) || (param >= pFunction->parameters) || (pConstraint->op != SQLITE_INDEX_CONSTRAINT_EQ)) continue;
+
+		if(pConstraint->usable) { usable |= (1 << param); constraints[param] = index; }
+		else unusable |= (1 << param);
+	}
+
+	// If a parameter was specified but is not usable in this plan, reject the
+	// plan so that the engine will choose one where the arguments are known
+
+	if((unusable & ~usable) != 0) return SQLITE_CONSTRAINT;
+
+	for(int param = 0; param < pFunction->parameters; param++) {
+
+		if((usable & (1 << param)) == 0) continue;
+
+		pIndexInfo->aConstraintUsage[constraints[param]].argvIndex = ++argc;
+		pIndexInfo->aConstraintUsage[constraints[param]].omit = 1;
+	}
+
+	pIndexInfo->idxNum = usable;
+	pIndexInfo->estimatedCost = 1000.0 * (1 + pFunction->parameters - argc);
+	pIndexInfo->estimatedRows = 1000;
+
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// sqlite_tvf_connect
+//
+// Implements the xConnect callback for table-valued functions
+//
+// Arguments:
+//
+//	hDatabase		- SQLite database handle
+//	context			- Context pointer from call to sqlite3_create_module
+//	argc			- Creation argument count
+//	argv			- Creation arguments (see documentation)
+//	ppVirtualTable	- On success, contains the new sqlite3_vtab structure
+//	ppszError		- Provides engine with an error message on failure
+
+static int sqlite_tvf_connect(sqlite3* hDatabase, void* context, int argc, const char* const* argv, 
+	sqlite3_vtab** ppVirtualTable, char** ppszError)
+{
+	GCHandleRef<Type^>				type(context);		// Function data type
+	gcroot<SqliteTableValuedFunction^>	prototype;			// Prototype instance
+	gcroot<String^>					schema;				// Function schema
+	int								columns;			// Number of result columns
+	int								parameters;			// Number of parameters
+	int								nResult;			// Result from function call
+
+	Debug::Assert(context != NULL);					// Should never be NULL here
+
+	*ppVirtualTable = NULL;					// Initialize [out] pointer to NULL
+	*ppszError = NULL;						// Initialize [out] pointer to NULL
+
+	try {
+
+		// Construct a prototype instance of the function to get the schema
+		// information from, there are no creation arguments to worry about
+
+		prototype = safe_cast<SqliteTableValuedFunction^>(Activator::CreateInstance(type));
+
+		try {
+
+			schema = prototype->GetCreateTableStatement();
+			columns = prototype->ResultColumnCount;
+			parameters = prototype->ParameterCount;
+		}
+
+		finally { delete prototype; }
+
+		nResult = sqlite3_declare_vtab(hDatabase, AutoAnsiString(schema));
+		if(nResult != SQLITE_OK) throw gcnew SqliteException(hDatabase, nResult);
+
+		sqlite_tvf* pFunction = new sqlite_tvf();
+		if(!pFunction) throw gcnew OutOfMemoryException();
+
+		pFunction->type = context;
+		pFunction->columns = columns;
+		pFunction->parameters = parameters;
+
+		*ppVirtualTable = pFunction;
+	}
+
+	catch(Exception^ ex) {
+	
+		*ppszError = sqlite3_mprintf(AutoAnsiString(ex->Message));
+		return SQLITE_ERROR;	
+	}
+
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// sqlite_tvf_disconnect
+//
+// Implements the xDisconnect and xDestroy callbacks for table-valued functions
+//
+// Arguments:
+//
+//	pVirtualTable		- Pointer to the virtual table to be disconnected
+
+static int sqlite_tvf_disconnect(sqlite3_vtab* pVirtualTable)
+{
+	delete static_cast<sqlite_tvf*>(pVirtualTable);
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// sqlite_tvf_open
+//
+// Implements the xOpen callback for table-valued functions.  Each cursor is a
+// new instance of the function type
+//
+// Arguments:
+//
+//	pVirtualTable		- Pointer to the current virtual table
+//	ppCursor			- On success, contains the new cursor object
+
+static int sqlite_tvf_open(sqlite3_vtab* pVirtualTable, sqlite3_vtab_cursor** ppCursor)
+{
+	gcroot<SqliteTableValuedFunction^>		instance;		// Managed cursor instance
+	VirtualTableCursor*						pCursor = NULL;	// Unmanaged cursor wrapper
+
+	sqlite_tvf* pFunction = static_cast<sqlite_tvf*>(pVirtualTable);
+	GCHandleRef<Type^> type(pFunction->type);
+
+	try {
+
+		instance = safe_cast<SqliteTableValuedFunction^>(Activator::CreateInstance(type));
+		instance->ColumnCount = pFunction->columns;
+
+		// Construct the VirtualTableCursor wrapper around the instance reference
+		// and hand it the unmanaged row storage for the batch
+
+		pCursor = &VirtualTableCursor::Create(instance);
+		pCursor->Batch = instance->Batch;
+
+		*ppCursor = pCursor;
+	}
+
+	catch(Exception^ ex) { 
+
+		// SQLite won't call xClose for a cursor that failed to open, so release
+		// the wrapper (and its GCHandle) and the function instance here
+
+		if(pCursor) VirtualTableCursor::Destroy(*pCursor);
+		if(static_cast<SqliteTableValuedFunction^>(instance) != nullptr) delete static_cast<SqliteTableValuedFunction^>(instance);
+		
+		if(pVirtualTable->zErrMsg) sqlite3_free(pVirtualTable->zErrMsg);
+		pVirtualTable->zErrMsg = sqlite3_mprintf(AutoAnsiString(ex->Message));
+		return SQLITE_ERROR; 
+	}
+
+	return SQLITE_OK;
+}
+
 //---------------------------------------------------------------------------
 // sqlite_vtab_begin
 //
@@ -234,18 +594,18 @@ static int sqlite_vtab_close(sqlite3_vtab_cursor* pCursor)
 static int sqlite_vtab_column(sqlite3_vtab_cursor* pCursor, sqlite3_context* pResultContext, 
 	int ordinal)
 {
-	gcroot<SqliteResult^>			result;			// Resultant value from cursor
-
 	VirtualTableCursor& cursor = VirtualTableCursor::Cast(pCursor);
 
-	try {
+	// Batch cursors are served directly from their unmanaged row storage
+	// without having to transition into managed code at all
 
-		result = gcnew SqliteResult(pResultContext);		// Construct argument
-		
-		try { cursor->GetValue(ordinal, result); }		// Invoke managed class
-		finally { delete result; }						// Always dispose of this
-	}
+	RowBatch* pBatch = cursor.Batch;
+	if((pBatch != NULL) && (ordinal < pBatch->ColumnCount)) { pBatch->GetColumn(ordinal, pResultContext); return SQLITE_OK; }
+
+	// The managed cursor keeps a single SqliteResult around that gets pointed
+	// at each result context, rather than constructing one for every column
 
+	try { cursor->GetColumn(pResultContext, ordinal); }
 	catch(Exception^ ex) { cursor.SetError(ex->Message); return SQLITE_ERROR; }
 
 	return SQLITE_OK;
@@ -492,23 +852,12 @@ static int sqlite_vtab_eof(sqlite3_vtab_cursor* pCursor)
 static int sqlite_vtab_filter(sqlite3_vtab_cursor* pCursor, int indexNum, const char* indexString, 
 	int argc, sqlite3_value** argv)
 {
-	gcroot<SqliteIndexIdentifier^>			index;		// Selected index information
-	gcroot<SqliteArgumentCollection^>		args;		// Filter argument collection
-
 	VirtualTableCursor& cursor = VirtualTableCursor::Cast(pCursor);
 
-	try {
-
-		index = gcnew SqliteIndexIdentifier(indexNum, indexString);	// Construct object
-		args = gcnew SqliteArgumentCollection(argc, argv);				// Construct object
-		
-		// Invoke the SetFilter() method on the managed cursor object, and be
-		// sure to dispose of the SqliteArgumentCollection under all circumstances
-
-		try { cursor.RowPresent = cursor->SetFilter(index, args); }
-		finally { delete args; }
-	}
+	// The managed cursor reuses the same index identifier and argument
+	// collection for every filter operation, see SqliteVirtualTableCursor
 
+	try { cursor.RowPresent = cursor->Filter(indexNum, indexString, argc, argv); }
 	catch(Exception^ ex) { cursor.SetError(ex->Message); return SQLITE_ERROR; }
 
 	return SQLITE_OK;
@@ -584,7 +933,13 @@ static int sqlite_vtab_next(sqlite3_vtab_cursor* pCursor)
 {
 	VirtualTableCursor& cursor = VirtualTableCursor::Cast(pCursor);
 
-	try { cursor.RowPresent = cursor->MoveNext(); }
+	// Batch cursors only need to call into managed code when the current
+	// block of rows has been exhausted and needs to be refilled
+
+	RowBatch* pBatch = cursor.Batch;
+	if((pBatch != NULL) && pBatch->MoveNext()) { cursor.RowPresent = true; return SQLITE_OK; }
+
+	try { cursor.RowPresent = cursor->Next(); }
 	catch(Exception^ ex) { cursor.SetError(ex->Message); return SQLITE_ERROR; }
 
 	return SQLITE_OK;
@@ -602,7 +957,8 @@ static int sqlite_vtab_next(sqlite3_vtab_cursor* pCursor)
 
 static int sqlite_vtab_open(sqlite3_vtab* pVirtualTable, sqlite3_vtab_cursor** ppCursor)
 {
-	gcroot<SqliteVirtualTableCursor^>		instance;	// Managed cursor instance
+	gcroot<SqliteVirtualTableCursor^>		instance;			// Managed cursor instance
+	VirtualTableCursor*						pCursor = NULL;		// Unmanaged cursor wrapper
 
 	VirtualTable& virtualTable = VirtualTable::Cast(pVirtualTable);
 
@@ -611,13 +967,28 @@ static int sqlite_vtab_open(sqlite3_vtab* pVirtualTable, sqlite3_vtab_cursor** p
 		instance = virtualTable->CreateCursor();		// Generate a new cursor
 
 		// Construct the VirtualTableCursor wrapper around the instance reference
-		// and return a pointer to that back to SQLite
+		pCursor = &VirtualTableCursor::Create(instance);
+
+		// Batch cursors expose their unmanaged row storage so that xNext, xColumn
+		// and xRowid can be served without calling into the managed cursor
 
-		VirtualTableCursor& cursor = VirtualTableCursor::Create(instance);
-		*ppCursor = &cursor;
+		SqliteBatchVirtualTableCursor^ batchCursor = dynamic_cast<SqliteBatchVirtualTableCursor^>(static_cast<SqliteVirtualTableCursor^>(instance));
+		if(batchCursor != nullptr) pCursor->Batch = batchCursor->Batch;
+
+		*ppCursor = pCursor;							// Return the new cursor
 	}
 
-	catch(Exception^ ex) { virtualTable.SetError(ex->Message); return SQLITE_ERROR; }
+	catch(Exception^ ex) { 
+
+		// SQLite won't call xClose for a cursor that failed to open, so release
+		// the wrapper (and its GCHandle) and the managed cursor here
+
+		if(pCursor) VirtualTableCursor::Destroy(*pCursor);
+		if(static_cast<SqliteVirtualTableCursor^>(instance) != nullptr) delete static_cast<SqliteVirtualTableCursor^>(instance);
+
+		virtualTable.SetError(ex->Message); 
+		return SQLITE_ERROR; 
+	}
 
 	return SQLITE_OK;
 }
@@ -655,6 +1026,9 @@ static int sqlite_vtab_rowid(sqlite3_vtab_cursor* pCursor, sqlite_int64* pRowid)
 {
 	VirtualTableCursor& cursor = VirtualTableCursor::Cast(pCursor);
 
+	RowBatch* pBatch = cursor.Batch;
+	if(pBatch != NULL) { *pRowid = pBatch->RowID; return SQLITE_OK; }
+
 	try { *pRowid = cursor->GetRowID(); }
 	catch(Exception^ ex) { cursor.SetError(ex->Message); return SQLITE_ERROR; }
 
@@ -789,6 +1163,10 @@ const sqlite3_module* SqliteVirtualTableModule::GetMethods(Type^ vtableType)
 	// By the time this is called, it is expected that the table type is
 	// valid, so we lose the try/catch and let any exceptions just fly.
 
+	if(vtableType->IsSubclassOf(SqliteTableValuedFunction::typeid)) return &sqlite_vtab_module_tvf;
+	if(vtableType->IsGenericType && (vtableType->GetGenericTypeDefinition() == SqliteCollectionTable::typeid)) 
+		return &sqlite_vtab_module_collection;
+
 	baseType = vtableType->BaseType->GetGenericTypeDefinition();
 
 	if(baseType == SqliteVirtualTable::typeid) return &sqlite_vtab_module;
@@ -810,6 +1188,11 @@ bool SqliteVirtualTableModule::IsValidVirtualTableType(Type^ vtableType)
 {
 	try { 
 
+		// Table-valued functions must be creatable with a default constructor
+
+		if(vtableType->IsSubclassOf(SqliteTableValuedFunction::typeid))
+			return (!vtableType->IsAbstract && (vtableType->GetConstructor(Type::EmptyTypes) != nullptr));
+
 		// All virtual tables must derive from SqliteVirtualTable or SqliteReadOnlyVirtualTable ...
 
 		Type^ type = vtableType->BaseType->GetGenericTypeDefinition();
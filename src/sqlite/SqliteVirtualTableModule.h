@@ -29,6 +29,8 @@
 #include "VirtualTable.h"						// Include VirtualTable declarations
 #include "VirtualTableCursor.h"					// Include VirtualTableCursor decls
 #include "SqliteArgumentCollection.h"				// Include SqliteArgumentCollection decls
+#include "SqliteBatchVirtualTableCursor.h"			// Include SqliteBatchVirtualTableCursor
+#include "SqliteCollectionTable.h"				// Include SqliteCollectionTable decls
 #include "SqliteException.h"						// Include SqliteException declarations
 #include "SqliteExceptions.h"						// Include Sqlite exception declarations
 #include "SqliteFunction.h"						// Include SqliteFunction declarations
@@ -36,6 +38,7 @@
 #include "SqliteNonTransactionalVirtualTable.h"	// Include SqliteNonTransactionalVirtualTable
 #include "SqliteReadOnlyVirtualTable.h"			// Include SqliteReadOnlyVirtualTable decls
 #include "SqliteResult.h"							// Include SqliteResult declarations
+#include "SqliteTableValuedFunction.h"				// Include SqliteTableValuedFunction
 #include "SqliteUtil.h"							// Include SqliteUtil declarations
 #include "SqliteVirtualTable.h"					// Include SqliteVirtualTable declarations
 #include "SqliteVirtualTableBase.h"				// Include SqliteVirtualTableBase decls
@@ -0,0 +1,398 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"						// Include project pre-compiled headers
+#include "SqliteVirtualTableStatistics.h"	// Include SqliteVirtualTableStatistics decls
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// SqliteVirtualTableStatistics Constructor (internal)
+//
+// Arguments:
+//
+//	NONE
+
+SqliteVirtualTableStatistics::SqliteVirtualTableStatistics()
+{
+	Clear();						// Start out with everything unknown
+}
+
+//---------------------------------------------------------------------------
+// SqliteVirtualTableStatistics::BuildHistogram
+//
+// Generates an equi-depth histogram for a column from a set of sample values.
+// The samples can be the entire column or a random subset of it
+//
+// Arguments:
+//
+//	ordinal		- Column ordinal
+//	samples		- Sample values taken from the column
+//	buckets		- Number of histogram buckets to generate
+
+void SqliteVirtualTableStatistics::BuildHistogram(int ordinal, array<double>^ samples, int buckets)
+{
+	if(ordinal < 0) throw gcnew ArgumentOutOfRangeException("ordinal");
+	if(samples == nullptr) throw gcnew ArgumentNullException("samples");
+	if(buckets < 1) throw gcnew ArgumentOutOfRangeException("buckets");
+
+	EnsureColumn(ordinal);
+
+	// No samples means no histogram; the default range selectivity will
+	// be used for this column until a new histogram has been provided
+
+	if(samples->Length == 0) { m_histograms[ordinal] = nullptr; return; }
+
+	array<double>^ sorted = safe_cast<array<double>^>(samples->Clone());
+	Array::Sort(sorted);
+
+	// Each boundary is taken at an evenly spaced position in the sorted samples
+	// so that every bucket represents the same fraction of the table rows
+
+	array<double>^ boundaries = gcnew array<double>(buckets + 1);
+	for(int index = 0; index <= buckets; index++)
+		boundaries[index] = sorted[static_cast<int>((static_cast<__int64>(index) * (sorted->Length - 1)) / buckets)];
+
+	m_histograms[ordinal] = boundaries;
+}
+
+//---------------------------------------------------------------------------
+// SqliteVirtualTableStatistics::Clear
+//
+// Resets all of the statistics back to their unknown state
+//
+// Arguments:
+//
+//	NONE
+
+void SqliteVirtualTableStatistics::Clear(void)
+{
+	m_rows = -1;
+	m_distinct = gcnew array<__int64>(0);
+	m_histograms = gcnew array<array<double>^>(0);
+}
+
+//---------------------------------------------------------------------------
+// SqliteVirtualTableStatistics::EnsureColumn (private)
+//
+// Grows the per-column statistics arrays to accommodate an ordinal
+//
+// Arguments:
+//
+//	ordinal		- Column ordinal
+
+void SqliteVirtualTableStatistics::EnsureColumn(int ordinal)
+{
+	if(ordinal < m_distinct->Length) return;
+
+	Array::Resize(m_distinct, ordinal + 1);
+	Array::Resize(m_histograms, ordinal + 1);
+}
+
+//---------------------------------------------------------------------------
+// SqliteVirtualTableStatistics::EqualSelectivity (private)
+//
+// Estimates the fraction of rows that will match an equality constraint
+//
+// Arguments:
+//
+//	ordinal		- Column ordinal, or -1 for the ROWID
+//	rows		- Number of rows in the table
+
+double SqliteVirtualTableStatistics::EqualSelectivity(int ordinal, __int64 rows)
+{
+	// The ROWID is always unique, and a known distinct count assumes that
+	// the values are evenly distributed among the rows
+
+	if(ordinal < 0) return (rows > 0) ? 1.0 / rows : 1.0;
+
+	__int64 distinct = (ordinal < m_distinct->Length) ? m_distinct[ordinal] : 0;
+	return (distinct > 0) ? 1.0 / distinct : DEFAULT_EQ_SELECTIVITY;
+}
+
+//---------------------------------------------------------------------------
+// SqliteVirtualTableStatistics::EstimateCost
+//
+// Sets the EstimatedCost, EstimatedRows and UniqueScan values of the index
+// selection arguments based on the constraints that have been consumed
+//
+// Arguments:
+//
+//	args		- Index selection arguments to be modified
+
+void SqliteVirtualTableStatistics::EstimateCost(SqliteIndexSelectionArgs^ args)
+{
+	bool				seek = false;			// Flag if constraints were consumed
+	bool				unique = false;			// Flag if at most one row is returned
+	double				selectivity = 1.0;		// Fraction of rows returned
+	double				limit = -1.0;			// LIMIT value, if consumed
+	double				value = 0.0;			// Converted right-hand value
+
+	if(args == nullptr) throw gcnew ArgumentNullException("args");
+
+	__int64 rows = (m_rows >= 0) ? m_rows : DEFAULT_ROW_COUNT;
+
+	// Only the constraints that have been assigned a Filter() argument are
+	// assumed to reduce the amount of work done by the cursor
+
+	for each(SqliteIndexConstraint^ constraint in args->Constraints) {
+
+		if((!constraint->IsUsable) || (constraint->FilterArgumentIndex <= 0)) continue;
+
+		SqliteSearchOperator op = constraint->Operator;
+
+		if(op == SqliteSearchOperator::Offset) continue;
+		if(op == SqliteSearchOperator::Limit) {
+
+			if(constraint->HasRightHandValue && ToDouble(constraint->RightHandValue, value) && (value >= 0.0)) limit = value;
+			continue;
+		}
+
+		// Equality against the ROWID or against a column where every value
+		// is distinct can only ever produce a single row
+
+		if((op == SqliteSearchOperator::Equal) || (op == SqliteSearchOperator::Is)) {
+
+			int ordinal = constraint->ColumnOrdinal;
+			if((ordinal < 0) || ((rows > 0) && (GetDistinctCount(ordinal) == rows))) unique = true;
+		}
+
+		selectivity *= Selectivity(constraint, rows);
+		seek = true;
+	}
+
+	// A full table scan visits every row; otherwise the cursor is assumed to
+	// seek to the matching rows first and then visit only those rows
+
+	double estimated = (unique) ? 1.0 : Math::Max(1.0, Math::Ceiling(rows * selectivity));
+	if(limit >= 0.0) estimated = Math::Min(estimated, limit);
+
+	double cost = (seek) ? Math::Log(static_cast<double>(rows) + 1.0, 2.0) + estimated : static_cast<double>(rows);
+
+	args->EstimatedRows = static_cast<__int64>(estimated);
+	args->EstimatedCost = Math::Max(1.0, cost);
+	args->UniqueScan = unique;
+}
+
+//---------------------------------------------------------------------------
+// SqliteVirtualTableStatistics::GetDistinctCount
+//
+// Gets the number of distinct values in a column, or zero if unknown
+//
+// Arguments:
+//
+//	ordinal		- Column ordinal
+
+__int64 SqliteVirtualTableStatistics::GetDistinctCount(int ordinal)
+{
+	if(ordinal < 0) throw gcnew ArgumentOutOfRangeException("ordinal");
+	return (ordinal < m_distinct->Length) ? m_distinct[ordinal] : 0;
+}
+
+//---------------------------------------------------------------------------
+// SqliteVirtualTableStatistics::GetHistogram
+//
+// Gets a copy of the histogram bucket boundaries for a column
+//
+// Arguments:
+//
+//	ordinal		- Column ordinal
+
+array<double>^ SqliteVirtualTableStatistics::GetHistogram(int ordinal)
+{
+	if(ordinal < 0) throw gcnew ArgumentOutOfRangeException("ordinal");
+
+	array<double>^ histogram = (ordinal < m_histograms->Length) ? m_histograms[ordinal] : nullptr;
+	return (histogram != nullptr) ? safe_cast<array<double>^>(histogram->Clone()) : nullptr;
+}
+
+//---------------------------------------------------------------------------
+// SqliteVirtualTableStatistics::HistogramFraction (private, static)
+//
+// Estimates the fraction of rows with a value less than the specified value,
+// interpolating linearly within the bucket that contains it
+//
+// Arguments:
+//
+//	histogram	- Equi-depth histogram bucket boundaries
+//	value		- Value to be located in the histogram
+
+double SqliteVirtualTableStatistics::HistogramFraction(array<double>^ histogram, double value)
+{
+	int buckets = histogram->Length - 1;
+
+	if(value <= histogram[0]) return 0.0;
+	if(value >= histogram[buckets]) return 1.0;
+
+	// Locate the last boundary that is less than or equal to the value; the
+	// complement of a negative result is the index of the next larger boundary
+
+	int index = Array::BinarySearch(histogram, value);
+	if(index < 0) index = (~index) - 1;
+	index = Math::Min(index, buckets - 1);
+
+	double width = histogram[index + 1] - histogram[index];
+	double partial = (width > 0.0) ? (value - histogram[index]) / width : 0.0;
+
+	return (index + partial) / buckets;
+}
+
+//---------------------------------------------------------------------------
+// SqliteVirtualTableStatistics::RowCount::set
+//
+// Sets the number of rows in the virtual table, or -1 if unknown
+
+void SqliteVirtualTableStatistics::RowCount::set(__int64 value)
+{
+	if(value < -1) throw gcnew ArgumentOutOfRangeException("value");
+	m_rows = value;
+}
+
+//---------------------------------------------------------------------------
+// SqliteVirtualTableStatistics::Selectivity (private)
+//
+// Estimates the fraction of rows that will satisfy a constraint
+//
+// Arguments:
+//
+//	constraint	- Constraint to be estimated
+//	rows		- Number of rows in the table
+
+double SqliteVirtualTableStatistics::Selectivity(SqliteIndexConstraint^ constraint, __int64 rows)
+{
+	int					ordinal = constraint->ColumnOrdinal;	// Column ordinal
+	array<double>^		histogram = nullptr;					// Column histogram
+	double				value = 0.0;							// Right-hand value
+
+	switch(constraint->Operator) {
+
+		case SqliteSearchOperator::Equal:
+		case SqliteSearchOperator::Is:
+			return EqualSelectivity(ordinal, rows);
+
+		case SqliteSearchOperator::NotEqual:
+		case SqliteSearchOperator::IsNot:
+			return 1.0 - EqualSelectivity(ordinal, rows);
+
+		case SqliteSearchOperator::IsNotNull:
+			return 1.0 - DEFAULT_EQ_SELECTIVITY;
+
+		case SqliteSearchOperator::LessThan:
+		case SqliteSearchOperator::LessThanOrEqual:
+		case SqliteSearchOperator::GreaterThan:
+		case SqliteSearchOperator::GreaterThanOrEqual:
+
+			// Range constraints can only use the histogram when the right-hand
+			// value is known now; parameters and joins use the default
+
+			if((ordinal >= 0) && (ordinal < m_histograms->Length)) histogram = m_histograms[ordinal];
+			if((histogram == nullptr) || (!constraint->HasRightHandValue) || (!ToDouble(constraint->RightHandValue, value)))
+				return DEFAULT_RANGE_SELECTIVITY;
+
+			value = HistogramFraction(histogram, value);
+			return ((constraint->Operator == SqliteSearchOperator::LessThan) || (constraint->Operator == SqliteSearchOperator::LessThanOrEqual)) ?
+				value : 1.0 - value;
+
+		default:
+			return DEFAULT_EQ_SELECTIVITY;
+	}
+}
+
+//---------------------------------------------------------------------------
+// SqliteVirtualTableStatistics::SetDistinctCount
+//
+// Sets the number of distinct values in a column
+//
+// Arguments:
+//
+//	ordinal		- Column ordinal
+//	count		- Number of distinct values, or zero if unknown
+
+void SqliteVirtualTableStatistics::SetDistinctCount(int ordinal, __int64 count)
+{
+	if(ordinal < 0) throw gcnew ArgumentOutOfRangeException("ordinal");
+	if(count < 0) throw gcnew ArgumentOutOfRangeException("count");
+
+	EnsureColumn(ordinal);
+	m_distinct[ordinal] = count;
+}
+
+//---------------------------------------------------------------------------
+// SqliteVirtualTableStatistics::SetHistogram
+//
+// Sets the histogram bucket boundaries for a column
+//
+// Arguments:
+//
+//	ordinal		- Column ordinal
+//	boundaries	- Ascending bucket boundaries, or null to remove the histogram
+
+void SqliteVirtualTableStatistics::SetHistogram(int ordinal, array<double>^ boundaries)
+{
+	if(ordinal < 0) throw gcnew ArgumentOutOfRangeException("ordinal");
+
+	if(boundaries != nullptr) {
+
+		if(boundaries->Length < 2) throw gcnew ArgumentException("A histogram requires at least two boundaries", "boundaries");
+		for(int index = 1; index < boundaries->Length; index++)
+			if(boundaries[index] < boundaries[index - 1]) throw gcnew ArgumentException("Histogram boundaries must be in ascending order", "boundaries");
+
+		boundaries = safe_cast<array<double>^>(boundaries->Clone());
+	}
+
+	EnsureColumn(ordinal);
+	m_histograms[ordinal] = boundaries;
+}
+
+//---------------------------------------------------------------------------
+// SqliteVirtualTableStatistics::ToDouble (private, static)
+//
+// Converts a numeric right-hand constraint value into a double
+//
+// Arguments:
+//
+//	value		- Right-hand constraint value
+//	result		- On success, receives the converted value
+
+bool SqliteVirtualTableStatistics::ToDouble(Object^ value, double% result)
+{
+	if(value == nullptr) return false;
+
+	switch(Type::GetTypeCode(value->GetType())) {
+
+		case TypeCode::Int32:
+		case TypeCode::Int64:
+		case TypeCode::Double:
+			result = Convert::ToDouble(value);
+			return true;
+
+		default: return false;
+	}
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
@@ -0,0 +1,174 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __SQLITEVIRTUALTABLESTATISTICS_H_
+#define __SQLITEVIRTUALTABLESTATISTICS_H_
+#pragma once
+
+#include "SqliteEnumerations.h"			// Include Sqlite enumeration decls
+#include "SqliteIndexConstraint.h"			// Include SqliteIndexConstraint decls
+#include "SqliteIndexSelectionArgs.h"		// Include SqliteIndexSelectionArgs decls
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// Class SqliteVirtualTableStatistics
+//
+// SqliteVirtualTableStatistics holds cardinality information about a virtual
+// table (row count, per-column distinct value counts and equi-depth histograms)
+// that can be maintained by the table implementation and used to generate the
+// EstimatedCost and EstimatedRows values reported from xBestIndex.  Statistics
+// that have not been provided fall back to fixed default selectivities
+//---------------------------------------------------------------------------
+
+public ref class SqliteVirtualTableStatistics sealed
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// BuildHistogram
+	//
+	// Generates an equi-depth histogram for a column from a set of sample values
+	void BuildHistogram(int ordinal, array<double>^ samples, int buckets);
+
+	// Clear
+	//
+	// Resets all of the statistics back to their unknown state
+	void Clear(void);
+
+	// EstimateCost
+	//
+	// Sets the EstimatedCost, EstimatedRows and UniqueScan values of the index
+	// selection arguments based on the constraints that have been assigned a
+	// FilterArgumentIndex.  If no constraints are consumed, a full table scan
+	// is assumed
+	void EstimateCost(SqliteIndexSelectionArgs^ args);
+
+	// GetDistinctCount
+	//
+	// Gets the number of distinct values in a column, or zero if unknown
+	__int64 GetDistinctCount(int ordinal);
+
+	// GetHistogram
+	//
+	// Gets the histogram bucket boundaries for a column, or null if unknown
+	array<double>^ GetHistogram(int ordinal);
+
+	// SetDistinctCount
+	//
+	// Sets the number of distinct values in a column; zero means unknown
+	void SetDistinctCount(int ordinal, __int64 count);
+
+	// SetHistogram
+	//
+	// Sets the histogram bucket boundaries for a column.  The boundaries must
+	// be in ascending order, with each bucket holding an equal share of rows
+	void SetHistogram(int ordinal, array<double>^ boundaries);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// RowCount
+	//
+	// Gets/sets the number of rows in the virtual table, or -1 if unknown
+	property __int64 RowCount
+	{
+		__int64 get(void) { return m_rows; }
+		void set(__int64 value);
+	}
+
+internal:
+
+	// INTERNAL CONSTRUCTOR
+	SqliteVirtualTableStatistics();
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Constants
+
+	// DEFAULT_ROW_COUNT
+	//
+	// Number of rows assumed when the row count has not been provided
+	literal __int64 DEFAULT_ROW_COUNT = 1000000;
+
+	// DEFAULT_EQ_SELECTIVITY
+	//
+	// Fraction of rows assumed to match an equality (or similar) constraint
+	// when no distinct value count has been provided for the column
+	literal double DEFAULT_EQ_SELECTIVITY = 0.1;
+
+	// DEFAULT_RANGE_SELECTIVITY
+	//
+	// Fraction of rows assumed to match a range constraint when there is no
+	// histogram or the right-hand value is not known at index selection time
+	literal double DEFAULT_RANGE_SELECTIVITY = 0.25;
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// EnsureColumn
+	//
+	// Grows the per-column statistics arrays to accommodate an ordinal
+	void EnsureColumn(int ordinal);
+
+	// EqualSelectivity
+	//
+	// Estimates the fraction of rows matching an equality constraint
+	double EqualSelectivity(int ordinal, __int64 rows);
+
+	// HistogramFraction
+	//
+	// Estimates the fraction of rows with a value less than the specified value
+	static double HistogramFraction(array<double>^ histogram, double value);
+
+	// Selectivity
+	//
+	// Estimates the fraction of rows that will satisfy a constraint
+	double Selectivity(SqliteIndexConstraint^ constraint, __int64 rows);
+
+	// ToDouble
+	//
+	// Converts a numeric right-hand constraint value into a double
+	static bool ToDouble(Object^ value, double% result);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	__int64					m_rows;					// Table row count
+	array<__int64>^			m_distinct;				// Distinct value counts
+	array<array<double>^>^	m_histograms;			// Column histograms
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
+
+#endif		// __SQLITEVIRTUALTABLESTATISTICS_H_
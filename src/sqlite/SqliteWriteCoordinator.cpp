@@ -0,0 +1,342 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"						// Include project pre-compiled headers
+#include "SqliteWriteCoordinator.h"		// Include SqliteWriteCoordinator decls
+#include "SqliteTransaction.h"				// Include SqliteTransaction declarations
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// SqliteWriteCoordinator Constructor
+//
+// Arguments:
+//
+//	connectionString	- Connection string for the writer connection
+
+SqliteWriteCoordinator::SqliteWriteCoordinator(String^ connectionString)
+{
+	Construct(connectionString, DEFAULT_BATCH_SIZE, TimeSpan::FromMilliseconds(DEFAULT_BATCH_WINDOW_MS));
+}
+
+//---------------------------------------------------------------------------
+// SqliteWriteCoordinator Constructor
+//
+// Arguments:
+//
+//	connectionString	- Connection string for the writer connection
+//	batchSize			- Maximum number of work items per batch
+//	batchWindow			- Time to wait for additional work items
+
+SqliteWriteCoordinator::SqliteWriteCoordinator(String^ connectionString, int batchSize, TimeSpan batchWindow)
+{
+	Construct(connectionString, batchSize, batchWindow);
+}
+
+//---------------------------------------------------------------------------
+// SqliteWriteCoordinator Destructor
+//
+// Signals the writer thread to shut down once it has drained the queue, and
+// closes the writer connection after it has done so
+
+SqliteWriteCoordinator::~SqliteWriteCoordinator()
+{
+	if(m_disposed) return;
+
+	Monitor::Enter(m_lock);
+
+	try { m_shutdown = true; Monitor::Pulse(m_lock); }
+	finally { Monitor::Exit(m_lock); }
+
+	m_thread->Join();				// Wait for the queue to drain
+	delete m_conn;					// Dispose of the writer connection
+
+	m_disposed = true;				// Object has been disposed of
+}
+
+//---------------------------------------------------------------------------
+// SqliteWriteCoordinator::BatchSize::get
+//
+// Gets the maximum number of work items that will be executed in a batch
+
+int SqliteWriteCoordinator::BatchSize::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_batchSize;
+}
+
+//---------------------------------------------------------------------------
+// SqliteWriteCoordinator::BatchSize::set
+//
+// Sets the maximum number of work items that will be executed in a batch
+
+void SqliteWriteCoordinator::BatchSize::set(int value)
+{
+	CHECK_DISPOSED(m_disposed);
+	if(value <= 0) throw gcnew ArgumentOutOfRangeException();
+
+	Monitor::Enter(m_lock);
+
+	try { m_batchSize = value; Monitor::Pulse(m_lock); }
+	finally { Monitor::Exit(m_lock); }
+}
+
+//---------------------------------------------------------------------------
+// SqliteWriteCoordinator::BatchWindow::get
+//
+// Gets the amount of time to wait for additional work items
+
+TimeSpan SqliteWriteCoordinator::BatchWindow::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_batchWindow;
+}
+
+//---------------------------------------------------------------------------
+// SqliteWriteCoordinator::BatchWindow::set
+//
+// Sets the amount of time to wait for additional work items
+
+void SqliteWriteCoordinator::BatchWindow::set(TimeSpan value)
+{
+	CHECK_DISPOSED(m_disposed);
+	if(value < TimeSpan::Zero) throw gcnew ArgumentOutOfRangeException();
+
+	Monitor::Enter(m_lock);
+
+	try { m_batchWindow = value; Monitor::Pulse(m_lock); }
+	finally { Monitor::Exit(m_lock); }
+}
+
+//---------------------------------------------------------------------------
+// SqliteWriteCoordinator::Construct (private)
+//
+// Helper function used to implement the meat of the various constructors
+//
+// Arguments:
+//
+//	connectionString	- Connection string for the writer connection
+//	batchSize			- Maximum number of work items per batch
+//	batchWindow			- Time to wait for additional work items
+
+void SqliteWriteCoordinator::Construct(String^ connectionString, int batchSize, TimeSpan batchWindow)
+{
+	SqliteConnectionStringBuilder^		builder;		// Connection string builder
+
+	if(connectionString == nullptr) throw gcnew ArgumentNullException();
+	if(batchSize <= 0) throw gcnew ArgumentOutOfRangeException("batchSize");
+	if(batchWindow < TimeSpan::Zero) throw gcnew ArgumentOutOfRangeException("batchWindow");
+
+	// The individual work items are isolated from each other with nested
+	// transactions, so the writer connection must always allow them
+
+	builder = gcnew SqliteConnectionStringBuilder(connectionString);
+	builder->TransactionMode = SqliteTransactionMode::SimulateNested;
+
+	m_lock = gcnew Object();
+	m_queue = gcnew Queue<WorkItem^>();
+	m_batchSize = batchSize;
+	m_batchWindow = batchWindow;
+
+	// Open the writer connection right away so that any problems with the
+	// connection string are reported to the caller rather than to every task
+
+	m_conn = gcnew SqliteConnection(builder->ConnectionString);
+	m_conn->Open();
+
+	m_thread = gcnew Thread(gcnew ThreadStart(this, &SqliteWriteCoordinator::WriterThread));
+	m_thread->Name = "SqliteWriteCoordinator";
+	m_thread->IsBackground = true;
+	m_thread->Start();
+}
+
+//---------------------------------------------------------------------------
+// SqliteWriteCoordinator::Enqueue
+//
+// Queues a unit of write work for the writer thread
+//
+// Arguments:
+//
+//	work		- Delegate that performs the work against the connection
+
+Task^ SqliteWriteCoordinator::Enqueue(Action<SqliteConnection^>^ work)
+{
+	WorkItem^				item;			// The new work item
+
+	CHECK_DISPOSED(m_disposed);
+	if(work == nullptr) throw gcnew ArgumentNullException();
+
+	item = gcnew WorkItem(work);
+
+	Monitor::Enter(m_lock);
+
+	try {
+
+		if(m_shutdown) throw gcnew ObjectDisposedException(SqliteWriteCoordinator::typeid->Name);
+
+		m_queue->Enqueue(item);
+		Monitor::Pulse(m_lock);
+	}
+
+	finally { Monitor::Exit(m_lock); }
+
+	return item->Completion->Task;
+}
+
+//---------------------------------------------------------------------------
+// SqliteWriteCoordinator::ExecuteBatch (private)
+//
+// Executes a batch of work items inside of a single IMMEDIATE transaction,
+// wrapping each work item in a nested transaction (SAVEPOINT).  The tasks are
+// not completed until the outer transaction has been committed
+//
+// Arguments:
+//
+//	batch		- Batch of work items to be executed
+
+void SqliteWriteCoordinator::ExecuteBatch(List<WorkItem^>^ batch)
+{
+	SqliteTransaction^			trans;			// Outer batch transaction
+	SqliteTransaction^			savepoint;		// Nested work item transaction
+	array<Exception^>^			failures;		// Individual work item failures
+
+	failures = gcnew array<Exception^>(batch->Count);
+
+	try {
+
+		trans = m_conn->BeginTransaction(SqliteLockMode::Immediate);
+
+		try {
+
+			for(int index = 0; index < batch->Count; index++) {
+
+				savepoint = m_conn->BeginTransaction();
+
+				try { batch[index]->Work(m_conn); savepoint->Commit(); }
+
+				catch(Exception^ ex) { 
+					
+					failures[index] = ex; 
+					if(m_conn->InTransaction) savepoint->Rollback(); 
+				}
+
+				// Some errors (ON CONFLICT ROLLBACK, SQLITE_FULL, SQLITE_IOERR, etc)
+				// cause the engine to roll back the entire batch transaction.  The
+				// work of every item is gone, and continuing would only execute the
+				// remaining items in autocommit mode, so fail them all right here
+
+				if(!m_conn->InTransaction) {
+
+					Exception^ rolledback = gcnew SqliteExceptions::TransactionRolledBackException(failures[index]);
+					for(int other = 0; other < batch->Count; other++)
+						if(failures[other] == nullptr) failures[other] = rolledback;
+
+					savepoint->Rollback();			// Closes out the transaction objects
+					break;
+				}
+			}
+
+			if(m_conn->InTransaction) trans->Commit();	// Commit the entire batch
+		}
+
+		finally { delete trans; }				// Rolls back if not committed
+	}
+
+	// If the batch itself failed (BEGIN or COMMIT), every work item that didn't
+	// already fail on it's own fails with the exception from the batch
+
+	catch(Exception^ ex) {
+
+		for(int index = 0; index < batch->Count; index++)
+			if(failures[index] == nullptr) failures[index] = ex;
+	}
+
+	// Complete all of the tasks now that the outcome of the batch is known
+
+	for(int index = 0; index < batch->Count; index++) {
+
+		if(failures[index] != nullptr) batch[index]->Completion->SetException(failures[index]);
+		else batch[index]->Completion->SetResult(true);
+	}
+}
+
+//---------------------------------------------------------------------------
+// SqliteWriteCoordinator::WriterThread (private)
+//
+// Entry point for the writer thread.  Waits for work to arrive, then waits
+// up to the batch window for the batch to fill before executing it
+//
+// Arguments:
+//
+//	NONE
+
+void SqliteWriteCoordinator::WriterThread(void)
+{
+	List<WorkItem^>^		batch;			// Current batch of work items
+	Stopwatch^				window;			// Batch window stopwatch
+	TimeSpan				remaining;		// Remaining batch window
+
+	batch = gcnew List<WorkItem^>();
+	window = gcnew Stopwatch();
+
+	while(true) {
+
+		batch->Clear();
+		Monitor::Enter(m_lock);
+
+		try {
+
+			// Wait for the first work item to arrive, or for shutdown.  When shutting
+			// down, any work items still in the queue are executed before exiting
+
+			while((m_queue->Count == 0) && (!m_shutdown)) Monitor::Wait(m_lock);
+			if(m_queue->Count == 0) return;
+
+			// Give other callers the batch window to add more work items, unless
+			// the batch is already full or the coordinator is shutting down
+
+			window->Restart();
+
+			while((m_queue->Count < m_batchSize) && (!m_shutdown)) {
+
+				remaining = m_batchWindow - window->Elapsed;
+				if(remaining <= TimeSpan::Zero) break;
+
+				Monitor::Wait(m_lock, remaining);
+			}
+
+			while((m_queue->Count > 0) && (batch->Count < m_batchSize)) batch->Add(m_queue->Dequeue());
+		}
+
+		finally { Monitor::Exit(m_lock); }
+
+		ExecuteBatch(batch);
+	}
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
@@ -0,0 +1,162 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __SQLITEWRITECOORDINATOR_H_
+#define __SQLITEWRITECOORDINATOR_H_
+#pragma once
+
+#include "SqliteConnection.h"				// Include SqliteConnection declarations
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Diagnostics;
+using namespace System::Threading;
+using namespace System::Threading::Tasks;
+
+namespace zuki::data::sqlite {
+
+//---------------------------------------------------------------------------
+// Class SqliteWriteCoordinator
+//
+// Implements "group commit" for applications that have many threads issuing
+// small write transactions against the same database file.  Work items from
+// any number of callers are queued and executed by a single writer connection
+// inside one BEGIN IMMEDIATE ... COMMIT per batch, with each work item being
+// isolated in a SAVEPOINT so that a failure only rolls back that item.  The
+// Task returned for each item completes once the batch has been committed.
+//---------------------------------------------------------------------------
+
+public ref class SqliteWriteCoordinator sealed
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Constructors
+
+	SqliteWriteCoordinator(String^ connectionString);
+	SqliteWriteCoordinator(String^ connectionString, int batchSize, TimeSpan batchWindow);
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Enqueue
+	//
+	// Queues a unit of write work to be executed against the writer connection
+	// as part of the next batch.  The work must not commit or roll back any
+	// transactions it did not start itself
+	Task^ Enqueue(Action<SqliteConnection^>^ work);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// BatchSize
+	//
+	// Gets/sets the maximum number of work items executed in a single batch
+	property int BatchSize
+	{
+		int get(void);
+		void set(int value);
+	}
+
+	// BatchWindow
+	//
+	// Gets/sets the amount of time the writer will wait for additional work
+	// items to arrive after the first one before executing the batch
+	property TimeSpan BatchWindow
+	{
+		TimeSpan get(void);
+		void set(TimeSpan value);
+	}
+
+private:
+
+	// DESTRUCTOR
+	~SqliteWriteCoordinator();
+
+	//-----------------------------------------------------------------------
+	// Private Constants
+
+	// DEFAULT_BATCH_SIZE
+	//
+	// Default maximum number of work items to execute in a single batch
+	literal int DEFAULT_BATCH_SIZE = 256;
+
+	// DEFAULT_BATCH_WINDOW_MS
+	//
+	// Default batch window, in milliseconds
+	literal int DEFAULT_BATCH_WINDOW_MS = 10;
+
+	//-----------------------------------------------------------------------
+	// Private Data Types
+
+	// WorkItem
+	//
+	// Individual unit of queued write work and it's completion source
+	ref struct WorkItem sealed
+	{
+		WorkItem(Action<SqliteConnection^>^ work) : Work(work),
+			Completion(gcnew TaskCompletionSource<bool>(TaskCreationOptions::RunContinuationsAsynchronously)) {}
+
+		Action<SqliteConnection^>^		Work;			// Work to be executed
+		TaskCompletionSource<bool>^		Completion;		// Completion source
+	};
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// Construct
+	//
+	// Helper function to the class constructors
+	void Construct(String^ connectionString, int batchSize, TimeSpan batchWindow);
+
+	// ExecuteBatch
+	//
+	// Executes a batch of work items inside a single transaction
+	void ExecuteBatch(List<WorkItem^>^ batch);
+
+	// WriterThread
+	//
+	// Entry point for the writer thread that executes the queued work
+	void WriterThread(void);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	bool						m_disposed;			// Object disposal flag
+	SqliteConnection^			m_conn;				// Writer connection
+	Thread^						m_thread;			// Writer thread
+	Object^						m_lock;				// Synchronization object
+	Queue<WorkItem^>^			m_queue;			// Queued work items
+	bool						m_shutdown;			// Shutdown requested flag
+	int							m_batchSize;		// Maximum batch size
+	TimeSpan					m_batchWindow;		// Batch window
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::data::sqlite
+
+#pragma warning(pop)
+
+#endif		// __SQLITEWRITECOORDINATOR_H_
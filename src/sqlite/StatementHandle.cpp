@@ -36,7 +36,7 @@
 //	hStatement		- Statement handle to wrap and take ownership of
 
 StatementHandle::StatementHandle(Object^ caller, DatabaseHandle* pDatabase, sqlite3_stmt* hStatement)
-	: m_pDatabase(pDatabase), m_hStatement(hStatement), m_cRefCount(1)
+	: m_pDatabase(pDatabase), m_hStatement(hStatement), m_cRefCount(1), m_row(0)
 {
 	if(!m_pDatabase) throw gcnew ArgumentNullException();
 	if(!m_hStatement) throw gcnew ArgumentNullException();
@@ -69,6 +69,7 @@ public:
 	// Member Functions
 
 	void AddRef(Object^ caller);
+	void AdvanceRow(void) { ++m_row; }
 	void Release(Object^ caller);
 
 	//-----------------------------------------------------------------------
@@ -76,12 +77,14 @@ public:
 
 	__declspec(property(get=GetDatabaseHandle))	sqlite3*		DBHandle;
 	__declspec(property(get=GetHandle))			sqlite3_stmt*	Handle;
+	__declspec(property(get=GetRowVersion))		unsigned int	RowVersion;
 
 	//-----------------------------------------------------------------------
 	// Property Accessors
 
 	sqlite3*		GetDatabaseHandle(void) { return m_pDatabase->Handle; }
 	sqlite3_stmt*	GetHandle(void)			{ return m_hStatement; }
+	unsigned int	GetRowVersion(void)		{ return m_row; }
 
 private:
 
@@ -99,6 +102,7 @@ private:
 	DatabaseHandle*			m_pDatabase;		// Contained database reference
 	sqlite3_stmt*			m_hStatement;		// Contained statement handle
 	volatile long			m_cRefCount;		// Reference counter
+	unsigned int			m_row;				// Current row version
 };
 
 //---------------------------------------------------------------------------
@@ -0,0 +1,236 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __TRACEDISPATCHER_H_
+#define __TRACEDISPATCHER_H_
+#pragma once
+
+#include <string.h>						// Include CRT string declarations
+#include "TraceRing.h"					// Include TraceRing declarations
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+#pragma managed(push, off)				// Keep the trace callback native
+
+//---------------------------------------------------------------------------
+// Class TraceDispatcher
+//
+// SQLite only allows a single sqlite3_trace_v2 callback per connection, so
+// TraceDispatcher owns that registration on behalf of the StatementTrace and
+// StatementProfile hooks and the connection trace buffer.  The mask passed to
+// the engine is always the union of what has actually been subscribed to, so
+// nothing is paid for events nobody is listening for.  Recording into the
+// trace buffer happens entirely in native code and never allocates; the hook
+// callbacks are only invoked when managed handlers have been registered.
+//---------------------------------------------------------------------------
+
+class TraceDispatcher
+{
+public:
+
+	// Constructor / Destructor
+	//
+	TraceDispatcher() : m_pRing(NULL), m_ringmask(0), m_profileproc(NULL), m_profilecontext(NULL),
+		m_traceproc(NULL), m_tracecontext(NULL) {}
+
+	~TraceDispatcher() { delete m_pRing; }
+
+	//-----------------------------------------------------------------------
+	// Type Declarations
+
+	// PROFILEPROC
+	//
+	// Invoked for SQLITE_TRACE_PROFILE when a profile handler is set
+	typedef void (*PROFILEPROC)(void* context, sqlite3_stmt* statement, sqlite3_int64 elapsed);
+
+	// TRACEPROC
+	//
+	// Invoked for SQLITE_TRACE_STMT when a trace handler is set
+	typedef void (*TRACEPROC)(void* context, sqlite3_stmt* statement, const char* sql);
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Install
+	//
+	// Registers (or unregisters) the trace callback based on the current mask
+	void Install(sqlite3* hDatabase)
+	{
+		unsigned int mask = Mask;
+		sqlite3_trace_v2(hDatabase, mask, (mask) ? TraceCallback : NULL, (mask) ? this : NULL);
+	}
+
+	// Remove
+	//
+	// Unregisters the trace callback ahead of the connection being closed.  The
+	// database handle can outlive the connection object, so the engine's own
+	// SQLITE_TRACE_CLOSE may never reach us; it's recorded here instead
+	void Remove(sqlite3* hDatabase)
+	{
+		if(m_ringmask & SQLITE_TRACE_CLOSE) m_pRing->Write(NULL, 0, SQLITE_TRACE_CLOSE);
+		sqlite3_trace_v2(hDatabase, 0, NULL, NULL);
+	}
+
+	// SetProfileHandler
+	//
+	// Sets or clears the StatementProfile hook callback
+	void SetProfileHandler(sqlite3* hDatabase, PROFILEPROC proc, void* context)
+	{
+		sqlite3_mutex_enter(sqlite3_db_mutex(hDatabase));
+
+		m_profileproc = proc;
+		m_profilecontext = context;
+		Install(hDatabase);
+
+		sqlite3_mutex_leave(sqlite3_db_mutex(hDatabase));
+	}
+
+	// SetRingMask
+	//
+	// Sets the events recorded in the trace buffer, which is created on first
+	// use.  The database handle is NULL if the connection is not open
+	void SetRingMask(sqlite3* hDatabase, unsigned int mask)
+	{
+		if((mask) && (!m_pRing)) m_pRing = new TraceRing(RING_CAPACITY);
+		if(!hDatabase) { m_ringmask = mask; return; }
+
+		sqlite3_mutex_enter(sqlite3_db_mutex(hDatabase));
+
+		m_ringmask = mask;
+		Install(hDatabase);
+
+		sqlite3_mutex_leave(sqlite3_db_mutex(hDatabase));
+	}
+
+	// SetTraceHandler
+	//
+	// Sets or clears the StatementTrace hook callback
+	void SetTraceHandler(sqlite3* hDatabase, TRACEPROC proc, void* context)
+	{
+		sqlite3_mutex_enter(sqlite3_db_mutex(hDatabase));
+
+		m_traceproc = proc;
+		m_tracecontext = context;
+		Install(hDatabase);
+
+		sqlite3_mutex_leave(sqlite3_db_mutex(hDatabase));
+	}
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Mask
+	//
+	// Union of all the trace events currently subscribed to
+	__declspec(property(get=GetMask)) unsigned int Mask;
+
+	unsigned int GetMask(void) const
+	{
+		return m_ringmask | ((m_profileproc) ? SQLITE_TRACE_PROFILE : 0) | 
+			((m_traceproc) ? SQLITE_TRACE_STMT : 0);
+	}
+
+	// Ring
+	//
+	// The trace buffer, or NULL if one has never been needed
+	__declspec(property(get=GetRing)) TraceRing* Ring;
+
+	TraceRing* GetRing(void) const { return m_pRing; }
+
+	// RingMask
+	//
+	// Events that are currently being recorded into the trace buffer
+	__declspec(property(get=GetRingMask)) unsigned int RingMask;
+
+	unsigned int GetRingMask(void) const { return m_ringmask; }
+
+private:
+
+	TraceDispatcher(const TraceDispatcher&);
+	TraceDispatcher& operator=(const TraceDispatcher&);
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// TraceCallback
+	//
+	// sqlite3_trace_v2 callback function
+	static int TraceCallback(unsigned int type, void* context, void* p, void* x)
+	{
+		TraceDispatcher*	pThis = reinterpret_cast<TraceDispatcher*>(context);
+		sqlite3_stmt*		statement = NULL;		// Statement handle
+		sqlite3_int64		elapsed = 0;			// Elapsed nanoseconds
+		unsigned int		flags = type;			// Entry flags
+
+		// P is the connection rather than a statement for SQLITE_TRACE_CLOSE, and
+		// X is only meaningful for SQLITE_TRACE_STMT and SQLITE_TRACE_PROFILE.
+		// Trigger programs are reported to SQLITE_TRACE_STMT as "-- <name>"
+
+		if(type != SQLITE_TRACE_CLOSE) statement = reinterpret_cast<sqlite3_stmt*>(p);
+		if(type == SQLITE_TRACE_PROFILE) elapsed = *reinterpret_cast<sqlite3_int64*>(x);
+		if((type == SQLITE_TRACE_STMT) && (x) && (strncmp(reinterpret_cast<const char*>(x), "--", 2) == 0))
+			flags |= TraceRing::TRACE_TRIGGER;
+
+		// The statement text is captured now; the handle itself can't be trusted
+		// by the time the trace buffer is read.  SQLITE_TRACE_ROW fires for every
+		// result row and SQLITE_TRACE_CLOSE has no statement, so neither of them
+		// copies any text into the buffer
+
+		if(pThis->m_ringmask & type) {
+
+			const char* sql = ((type == SQLITE_TRACE_STMT) || (type == SQLITE_TRACE_PROFILE)) ? sqlite3_sql(statement) : NULL;
+			pThis->m_pRing->Write(sql, elapsed, flags);
+		}
+
+		if((type == SQLITE_TRACE_PROFILE) && (pThis->m_profileproc))
+			pThis->m_profileproc(pThis->m_profilecontext, statement, elapsed);
+
+		if((type == SQLITE_TRACE_STMT) && (pThis->m_traceproc))
+			pThis->m_traceproc(pThis->m_tracecontext, statement, reinterpret_cast<const char*>(x));
+
+		return 0;
+	}
+
+	//-----------------------------------------------------------------------
+	// Private Constants
+
+	// RING_CAPACITY
+	//
+	// Number of entries held in the trace buffer (must be a power of two)
+	static const int RING_CAPACITY = 4096;
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	TraceRing*				m_pRing;			// Trace buffer
+	unsigned int			m_ringmask;			// Events recorded in the buffer
+	PROFILEPROC				m_profileproc;		// StatementProfile callback
+	void*					m_profilecontext;	// StatementProfile context
+	TRACEPROC				m_traceproc;		// StatementTrace callback
+	void*					m_tracecontext;		// StatementTrace context
+};
+
+//---------------------------------------------------------------------------
+
+#pragma managed(pop)
+#pragma warning(pop)
+
+#endif	// __TRACEDISPATCHER_H_
@@ -0,0 +1,226 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2008-2022 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __TRACERING_H_
+#define __TRACERING_H_
+#pragma once
+
+#include <string.h>						// Include CRT string declarations
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+#pragma managed(push, off)				// Written from the engine's trace callback
+
+//---------------------------------------------------------------------------
+// Class TraceRing
+//
+// TraceRing is a fixed size, lock-free ring buffer of statement trace entries.
+// Writing an entry never allocates or blocks; the writer claims a position with
+// an interlocked increment and publishes the slot by stamping it with that
+// position.  When the reader falls more than a full lap behind, the oldest
+// entries are overwritten and counted as dropped rather than stalling the
+// engine.  Writers are serialized by the database connection mutex in practice,
+// but only a single reader may call Read() at any given time.
+//
+// The statement text is copied into the slot when the entry is written, since
+// the statement handle may have been finalized (and its address reused) by the
+// time the entry is read.  Text longer than TEXT_LENGTH - 1 bytes is truncated.
+//---------------------------------------------------------------------------
+
+class TraceRing
+{
+public:
+
+	// Constructor / Destructor
+	//
+	// The capacity must be a power of two
+	explicit TraceRing(int capacity) : m_mask(capacity - 1), m_head(0), m_tail(0), m_dropped(0)
+	{
+		m_slots = new Slot[capacity];
+		for(int index = 0; index < capacity; index++) m_slots[index].Sequence = -1;
+	}
+
+	~TraceRing() { delete[] m_slots; }
+
+	//-----------------------------------------------------------------------
+	// Public Constants
+
+	// TEXT_LENGTH
+	//
+	// Size of the statement text buffer in each entry
+	static const int TEXT_LENGTH = 256;
+
+	// TRACE_TRIGGER
+	//
+	// Set along with SQLITE_TRACE_STMT when the statement is a trigger program
+	static const unsigned int TRACE_TRIGGER = 0x100;
+
+	//-----------------------------------------------------------------------
+	// Type Declarations
+
+	// Entry
+	//
+	// A single trace entry as returned from Read()
+	struct Entry
+	{
+		__int64				Elapsed;		// Elapsed time in nanoseconds
+		unsigned int		Flags;			// SQLITE_TRACE_XXX and TRACE_XXX flags
+		int					Length;			// Length of the statement text
+		char				Text[TEXT_LENGTH];	// Statement text (UTF-8)
+	};
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Read
+	//
+	// Copies up to count of the oldest unread entries into the caller's buffer
+	// and returns the number of entries that were copied
+	int Read(Entry* entries, int count)
+	{
+		__int64			head = Load(&m_head);	// Next position to be claimed
+		int				read = 0;				// Number of entries read
+
+		// Anything more than a full lap behind the writer has already been
+		// overwritten, skip right over it
+
+		if(head - m_tail > m_mask + 1) {
+
+			m_dropped += (head - (m_mask + 1)) - m_tail;
+			m_tail = head - (m_mask + 1);
+		}
+
+		while((m_tail < head) && (read < count)) {
+
+			Slot& slot = m_slots[m_tail & m_mask];
+			__int64 sequence = Load(&slot.Sequence);
+
+			// A sequence ahead of the tail means the slot was lapped; anything
+			// else means the writer hasn't published it yet, so stop for now
+
+			if(sequence != m_tail) {
+
+				if(sequence > m_tail) { m_dropped++; m_tail++; continue; }
+				break;
+			}
+
+			Entry& entry = entries[read];
+
+			entry.Elapsed = slot.Elapsed;
+			entry.Flags = slot.Flags;
+			entry.Length = slot.Length;
+			memcpy(entry.Text, slot.Text, slot.Length);
+
+			// If the slot was claimed again while it was being copied, the
+			// copy may be torn and the entry has been lost
+
+			if(Load(&slot.Sequence) != sequence) { m_dropped++; m_tail++; continue; }
+
+			read++;
+			m_tail++;
+		}
+
+		return read;
+	}
+
+	// Write
+	//
+	// Writes a new entry into the ring, overwriting the oldest entry if full
+	void Write(const char* sql, __int64 elapsed, unsigned int flags)
+	{
+		int length = (sql) ? static_cast<int>(strnlen(sql, TEXT_LENGTH)) : 0;
+
+		// Truncated text is cut back to a UTF-8 character boundary so that the
+		// reader doesn't end up decoding half of a multibyte sequence
+
+		if(length == TEXT_LENGTH) {
+
+			length = TEXT_LENGTH - 1;
+			while((length > 0) && ((sql[length] & 0xC0) == 0x80)) length--;
+		}
+
+		__int64 position = InterlockedIncrement64(&m_head) - 1;
+		Slot& slot = m_slots[position & m_mask];
+
+		InterlockedExchange64(&slot.Sequence, -1);		// Claim the slot
+
+		slot.Elapsed = elapsed;
+		slot.Flags = flags;
+		slot.Length = length;
+		if(length) memcpy(slot.Text, sql, length);
+
+		InterlockedExchange64(&slot.Sequence, position);	// Publish the slot
+	}
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Dropped
+	//
+	// Number of entries that were overwritten before they could be read
+	__declspec(property(get=GetDropped)) __int64 Dropped;
+
+	__int64 GetDropped(void) const { return m_dropped; }
+
+private:
+
+	TraceRing(const TraceRing&);
+	TraceRing& operator=(const TraceRing&);
+
+	//-----------------------------------------------------------------------
+	// Private Type Declarations
+
+	// Slot
+	//
+	// Storage for an entry; the sequence is -1 while the slot is being written
+	struct Slot
+	{
+		volatile __int64	Sequence;		// Position the slot was written for
+		__int64				Elapsed;		// Elapsed time in nanoseconds
+		unsigned int		Flags;			// SQLITE_TRACE_XXX and TRACE_XXX flags
+		int					Length;			// Length of the statement text
+		char				Text[TEXT_LENGTH];	// Statement text (UTF-8)
+	};
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// Load
+	//
+	// Atomically reads a 64-bit value, even on 32-bit builds
+	static __int64 Load(volatile __int64* value) { return InterlockedCompareExchange64(value, 0, 0); }
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	Slot*					m_slots;		// Ring buffer slots
+	__int64					m_mask;			// Capacity - 1
+	volatile __int64		m_head;			// Next position to be claimed
+	__int64					m_tail;			// Next position to be read
+	__int64					m_dropped;		// Number of entries lost
+};
+
+//---------------------------------------------------------------------------
+
+#pragma managed(pop)
+#pragma warning(pop)
+
+#endif	// __TRACERING_H_
@@ -24,6 +24,7 @@
 #define __VIRTUALTABLECURSOR_H_
 #pragma once
 
+#include "RowBatch.h"						// Include RowBatch declarations
 #include "SqliteVirtualTableCursor.h"		// Include SqliteVirtualTableCursor decls
 
 using namespace System;
@@ -124,6 +125,15 @@ public:
 	//-----------------------------------------------------------------------
 	// Properties
 
+	// Batch
+	//
+	// Pointer to the unmanaged row storage owned by a batch cursor, or NULL if
+	// the managed cursor does not derive from SqliteBatchVirtualTableCursor
+	__declspec(property(get=GetBatch, put=SetBatch)) RowBatch* Batch;
+
+	RowBatch* GetBatch(void) const { return m_batch; }
+	void SetBatch(RowBatch* value) { m_batch = value; }
+
 	// RowPresent
 	//
 	// Boolean value representing if a row is present at the current cursor
@@ -154,6 +164,7 @@ private:
 
 	void*						m_ptr;			// Pointer to managed object
 	bool						m_row;			// Flag if a row is present
+	RowBatch*					m_batch;		// Batch cursor row storage
 };
 
 //---------------------------------------------------------------------------
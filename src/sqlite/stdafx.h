@@ -68,6 +68,7 @@ typedef pin_ptr<void>				PinnedVoidPtr;
 //
 struct sqlite3 {};
 struct sqlite3_api_routines {};
+struct sqlite3_backup {};
 struct sqlite3_context {};
 struct sqlite3_stmt {};
 struct sqlite3_value {};